@@ -0,0 +1,176 @@
+#!/usr/bin/env python
+"""
+Run a DuMuX executable for a series of problem sizes and process counts,
+record runtime, Newton statistics and peak memory, and append the results
+to a JSON history file. A run is flagged as a regression if its wall time
+exceeds the one of the last recorded run with the same configuration by more
+than the given tolerance.
+
+Example (strong scaling of a 2D problem on 1, 2 and 4 processes):
+    runbenchmark.py --name 1p_tpfa --command "./test_1p_tpfa params.input"
+                    --parameter Grid.Cells --values "200 200" --dofs 40000
+                    --ranks 1 2 4 --history benchmarks.json
+"""
+import argparse
+import datetime
+import json
+import os
+import re
+import shlex
+import socket
+import subprocess
+import sys
+import time
+
+# parse arguments
+parser = argparse.ArgumentParser()
+parser.add_argument('-n', '--name', required=True, help='The name of the benchmark')
+parser.add_argument('-c', '--command', required=True, help='The executable and optional arguments as a single string')
+parser.add_argument('-p', '--parameter', default='Grid.Cells', help='The runtime parameter setting the problem size (default: Grid.Cells)')
+parser.add_argument('-v', '--values', nargs='+', required=True, help='The values of the size parameter, one per problem size')
+parser.add_argument('-d', '--dofs', nargs='+', type=int, help='The number of degrees of freedom for each problem size (used for the time per dof)')
+parser.add_argument('-r', '--ranks', nargs='+', type=int, default=[1], help='The numbers of MPI processes (default: 1)')
+parser.add_argument('-s', '--scaling', choices=['strong', 'weak'], default='strong',
+                    help='strong: run every size on every process count; weak: the i-th size runs on the i-th process count')
+parser.add_argument('-m', '--mpirun', default='mpirun -np', help='The MPI launcher including the flag for the process count')
+parser.add_argument('-w', '--workdir', default='.', help='The directory to run the executable in')
+parser.add_argument('-o', '--history', default='benchmarks.json', help='The JSON file the results are appended to')
+parser.add_argument('-t', '--tolerance', type=float, default=0.2, help='Relative wall time increase flagged as regression (default: 0.2)')
+parser.add_argument('-f', '--failOnRegression', action='store_true', help='Return an error code if a regression was detected')
+args = parser.parse_args()
+
+if args.dofs and len(args.dofs) != len(args.values):
+    sys.stderr.write("Specify the number of dofs for each problem size.\n")
+    sys.exit(1)
+if args.scaling == 'weak' and len(args.values) != len(args.ranks):
+    sys.stderr.write("For weak scaling, specify one problem size per process count.\n")
+    sys.exit(1)
+
+
+def git_revision():
+    """the revision of the source tree (if available)"""
+    try:
+        source_dir = os.path.dirname(os.path.abspath(__file__))
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'], cwd=source_dir).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def parse_output(output):
+    """extract the Newton statistics from the output of a simulation"""
+    stats = {'assembleTime': 0.0, 'solveTime': 0.0, 'updateTime': 0.0, 'newtonIterations': 0, 'timeSteps': 0}
+    number = r'([0-9.eE+-]+)'
+    pattern = re.compile(r'Assemble/solve/update time: ' + number + r'\(.*?\)/' + number + r'\(.*?\)/' + number)
+    for match in pattern.finditer(output):
+        stats['assembleTime'] += float(match.group(1))
+        stats['solveTime'] += float(match.group(2))
+        stats['updateTime'] += float(match.group(3))
+        stats['timeSteps'] += 1
+
+    # the iteration counter is printed after every iteration, the last one of each solve counts
+    iterations = [int(i) for i in re.findall(r'Newton iteration\s+(\d+) done', output)]
+    stats['newtonIterations'] = count_iterations(iterations)
+    return stats
+
+
+def count_iterations(iterations):
+    """sum up the iterations of all Newton solves given the sequence of iteration counters"""
+    total = 0
+    for i, it in enumerate(iterations):
+        if i + 1 == len(iterations) or iterations[i + 1] <= it:
+            total += it
+    return total
+
+
+def run(size_idx, num_ranks):
+    """run a single configuration and return its measurements"""
+    value = args.values[size_idx]
+    command = shlex.split(args.command) + ['-' + args.parameter, value]
+    if num_ranks > 1:
+        command = shlex.split(args.mpirun) + [str(num_ranks)] + command
+
+    print('Running "{}"'.format(' '.join(command)))
+    start = time.time()
+    process = subprocess.Popen(command, cwd=args.workdir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = process.stdout.read().decode(errors='replace')
+    # wait for the process ourselves to obtain its resource usage
+    _, status, usage = os.wait4(process.pid, 0)
+    wall_time = time.time() - start
+    return_code = os.WEXITSTATUS(status) if os.WIFEXITED(status) else 1
+    if return_code:
+        print(output)
+        sys.stderr.write("The benchmark run failed with return code {}.\n".format(return_code))
+        sys.exit(return_code)
+
+    # peak resident set size in kB (for MPI runs, of the launcher and the largest reaped descendant)
+    result = {'size': value, 'ranks': num_ranks, 'wallTime': wall_time, 'peakRSS': usage.ru_maxrss}
+    result.update(parse_output(output))
+    if args.dofs:
+        result['dofs'] = args.dofs[size_idx]
+        if result['newtonIterations'] > 0:
+            result['assembleTimePerDof'] = result['assembleTime']/(result['newtonIterations']*result['dofs'])
+    return result
+
+
+# run all configurations
+if args.scaling == 'strong':
+    configurations = [(i, r) for i in range(len(args.values)) for r in args.ranks]
+else:
+    configurations = list(zip(range(len(args.values)), args.ranks))
+
+runs = []
+for size_idx, num_ranks in configurations:
+    runs.append(run(size_idx, num_ranks))
+
+# compute the parallel efficiency w.r.t. the run on the smallest number of processes
+for run_result in runs:
+    reference = [r for r in runs if (r['size'] == run_result['size'] if args.scaling == 'strong' else True)]
+    reference = min(reference, key=lambda r: r['ranks'])
+    if args.scaling == 'strong':
+        ideal = reference['wallTime']*reference['ranks']/run_result['ranks']
+    else:
+        ideal = reference['wallTime']
+    run_result['parallelEfficiency'] = ideal/run_result['wallTime'] if run_result['wallTime'] > 0 else None
+
+# compare with the last recorded runs and append to the history
+history = []
+if os.path.isfile(args.history):
+    with open(args.history) as history_file:
+        history = json.load(history_file)
+
+regressions = []
+previous = [entry for entry in history if entry['name'] == args.name]
+if previous:
+    for run_result in runs:
+        for old in previous[-1]['runs']:
+            if old['size'] == run_result['size'] and old['ranks'] == run_result['ranks']:
+                if run_result['wallTime'] > (1.0 + args.tolerance)*old['wallTime']:
+                    regressions.append((run_result, old))
+
+history.append({
+    'name': args.name,
+    'date': datetime.datetime.now().isoformat(),
+    'revision': git_revision(),
+    'host': socket.gethostname(),
+    'command': args.command,
+    'parameter': args.parameter,
+    'scaling': args.scaling,
+    'runs': runs
+})
+with open(args.history, 'w') as history_file:
+    json.dump(history, history_file, indent=2)
+
+# print a summary
+print('\nBenchmark {}:'.format(args.name))
+print('{:>16} {:>6} {:>12} {:>12} {:>12} {:>8} {:>12} {:>10}'.format(
+      'size', 'ranks', 'wall [s]', 'assemble [s]', 'solve [s]', 'newton', 'RSS [kB]', 'efficiency'))
+for r in runs:
+    print('{:>16} {:>6} {:>12.4g} {:>12.4g} {:>12.4g} {:>8} {:>12} {:>10.3g}'.format(
+          r['size'], r['ranks'], r['wallTime'], r['assembleTime'], r['solveTime'],
+          r['newtonIterations'], r['peakRSS'], r['parallelEfficiency'] or 0.0))
+
+for new, old in regressions:
+    print('Regression: size {} on {} process(es) took {:.4g}s, previously {:.4g}s'.format(
+          new['size'], new['ranks'], new['wallTime'], old['wallTime']))
+
+sys.exit(1 if regressions and args.failOnRegression else 0)
@@ -14,3 +14,17 @@ find_package(PTScotch)
 find_package(PVPython)
 find_package(Valgrind)
 find_package(Quadmath)
+find_package(ZLIB)
+set(HAVE_ZLIB ${ZLIB_FOUND})
+if(ZLIB_FOUND)
+  dune_register_package_flags(COMPILE_DEFINITIONS "ENABLE_ZLIB=1"
+                              LIBRARIES "${ZLIB_LIBRARIES}"
+                              INCLUDE_DIRS "${ZLIB_INCLUDE_DIRS}")
+endif()
+find_package(HDF5 COMPONENTS C)
+set(HAVE_HDF5 ${HDF5_FOUND})
+if(HDF5_FOUND)
+  dune_register_package_flags(COMPILE_DEFINITIONS "ENABLE_HDF5=1"
+                              LIBRARIES "${HDF5_C_LIBRARIES}"
+                              INCLUDE_DIRS "${HDF5_INCLUDE_DIRS}")
+endif()
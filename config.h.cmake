@@ -73,6 +73,12 @@
 /* Define to 1 if quadmath was found */
 #cmakedefine HAVE_QUAD 1
 
+/* Define to ENABLE_ZLIB if zlib was found */
+#cmakedefine HAVE_ZLIB ENABLE_ZLIB
+
+/* Define to ENABLE_HDF5 if HDF5 was found */
+#cmakedefine HAVE_HDF5 ENABLE_HDF5
+
 /* end dumux
    Everything below here will be overwritten
 */
@@ -0,0 +1,409 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Adaptive
+ * \brief A model-agnostic indicator for grid adaptation based on the
+ *        jumps of a primary variable or its normal flux across the element faces.
+ */
+#ifndef DUMUX_ADAPTIVE_JUMP_INDICATOR_HH
+#define DUMUX_ADAPTIVE_JUMP_INDICATOR_HH
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/partitionset.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/discretization/elementsolution.hh>
+#include <dumux/discretization/evalsolution.hh>
+#include <dumux/linear/vectorexchange.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Adaptive
+ * \brief The error estimators available in the jump indicator
+ */
+enum class JumpIndicatorEstimator
+{
+    //! the maximum jump of the primary variable over the faces of an element
+    maxJump,
+    //! a discrete L2 norm of the jumps: the square root of the sum over the faces of
+    //! the face area times the squared jump divided by the distance of the cell centers
+    l2Jump,
+    //! a residual estimator based on the jumps of the normal flux \f$ -\lambda \nabla u \cdot n \f$:
+    //! the square root of the sum over the faces of the face area times the distance of the
+    //! cell centers times the squared flux jump (see JumpIndicator::setFluxCoefficient)
+    fluxJump
+};
+
+/*!
+ * \ingroup Adaptive
+ * \brief Indicator for grid adaptation based on the jumps of an arbitrary
+ *        primary variable across the element faces.
+ *
+ * The primary variable is evaluated once per element at the element center
+ * (this works for box, cell-centered tpfa and mpfa schemes) and every face
+ * of the leaf grid is visited only once. For the flux jump estimator, the
+ * gradient of every element is reconstructed once by least squares from the
+ * values of its face neighbors and the normal fluxes are weighted with a
+ * coefficient per element, e.g. permeability times mobility. Elements are
+ * refined if their indicator exceeds a fraction of the global range of the
+ * primary variable (maxJump) or of the maximum indicator (l2Jump, fluxJump),
+ * respectively. In parallel, the indicator is made consistent on ghost/overlap elements.
+ *
+ * \tparam FVGridGeometry The finite volume grid geometry
+ * \tparam Scalar The type used for scalar values
+ */
+template<class FVGridGeometry, class Scalar>
+class JumpIndicator
+{
+    using GridView = typename FVGridGeometry::GridView;
+    using Element = typename GridView::template Codim<0>::Entity;
+    using GlobalPosition = typename Element::Geometry::GlobalCoordinate;
+    using ElementMapper = typename FVGridGeometry::ElementMapper;
+    static constexpr int dimWorld = GridView::dimensionworld;
+    using Matrix = Dune::FieldMatrix<Scalar, dimWorld, dimWorld>;
+
+public:
+    /*!
+     * \brief The Constructor
+     *
+     * \param fvGridGeometry The finite volume grid geometry
+     * \param pvIdx The index of the primary variable the indicator is computed for
+     * \param estimator The error estimator to be used
+     * \param paramGroup The parameter group in which to look for runtime parameters first (default is "")
+     *
+     * \note The bounds are chosen in a way such that the indicator returns
+     *       false for all elements before having been calculated.
+     */
+    JumpIndicator(std::shared_ptr<const FVGridGeometry> fvGridGeometry,
+                  int pvIdx,
+                  JumpIndicatorEstimator estimator = JumpIndicatorEstimator::maxJump,
+                  const std::string& paramGroup = "")
+    : fvGridGeometry_(fvGridGeometry)
+    , pvIdx_(pvIdx)
+    , estimator_(estimator)
+    , refineBound_(std::numeric_limits<Scalar>::max())
+    , coarsenBound_(std::numeric_limits<Scalar>::lowest())
+    , indicator_(fvGridGeometry_->gridView().size(0), 0.0)
+    , minLevel_(getParamFromGroup<std::size_t>(paramGroup, "Adaptive.MinLevel", 0))
+    , maxLevel_(getParamFromGroup<std::size_t>(paramGroup, "Adaptive.MaxLevel", 0))
+    {}
+
+    //! Function to set the minimum allowed level.
+    void setMinLevel(std::size_t minLevel)
+    { minLevel_ = minLevel; }
+
+    //! Function to set the maximum allowed level.
+    void setMaxLevel(std::size_t maxLevel)
+    { maxLevel_ = maxLevel; }
+
+    //! Function to set the minumum/maximum allowed levels.
+    void setLevels(std::size_t minLevel, std::size_t maxLevel)
+    {
+        minLevel_ = minLevel;
+        maxLevel_ = maxLevel;
+    }
+
+    /*!
+     * \brief Set the coefficient \f$ \lambda \f$ of the normal flux \f$ -\lambda \nabla u \cdot n \f$
+     *        used by the flux jump estimator (default is 1)
+     * \param coefficient A function returning the coefficient for an element, e.g. the
+     *                    (scalar) permeability times the mobility
+     */
+    void setFluxCoefficient(const std::function<Scalar(const Element&)>& coefficient)
+    { fluxCoefficient_ = coefficient; }
+
+    /*!
+     * \brief Calculates the indicator used for refinement/coarsening for each grid cell.
+     *
+     * \param sol The solution vector
+     * \param refineTol The refinement tolerance
+     * \param coarsenTol The coarsening tolerance
+     */
+    template<class SolutionVector>
+    void calculate(const SolutionVector& sol,
+                   Scalar refineTol = 0.05,
+                   Scalar coarsenTol = 0.001)
+    {
+        const auto& gridView = fvGridGeometry_->gridView();
+        const auto& elementMapper = fvGridGeometry_->elementMapper();
+
+        //! Reset the indicator to a state that returns false for all elements
+        refineBound_ = std::numeric_limits<Scalar>::max();
+        coarsenBound_ = std::numeric_limits<Scalar>::lowest();
+        indicator_.assign(gridView.size(0), 0.0);
+
+        //! maxLevel_ must be higher than minLevel_ to allow for refinement
+        if (minLevel_ >= maxLevel_)
+            return;
+
+        //! Check for inadmissible tolerance combination
+        if (coarsenTol > refineTol)
+            DUNE_THROW(Dune::InvalidStateException, "Refine tolerance must be higher than coarsen tolerance");
+
+        //! Evaluate the primary variable (and the flux coefficient) at the element centers once
+        const bool fluxJump = estimator_ == JumpIndicatorEstimator::fluxJump;
+        cellValues_.resize(gridView.size(0));
+        cellCenters_.resize(gridView.size(0));
+        if (fluxJump)
+        {
+            cellCoefficients_.assign(gridView.size(0), 1.0);
+            cellGradients_.assign(gridView.size(0), GlobalPosition(0.0));
+            leastSquaresMatrices_.assign(gridView.size(0), Matrix(0.0));
+            faces_.clear();
+        }
+
+        Scalar globalMax = std::numeric_limits<Scalar>::lowest();
+        Scalar globalMin = std::numeric_limits<Scalar>::max();
+        for (const auto& element : elements(gridView))
+        {
+            const auto eIdx = elementMapper.index(element);
+            const auto geometry = element.geometry();
+            const auto elemSol = elementSolution(element, sol, *fvGridGeometry_);
+            cellCenters_[eIdx] = geometry.center();
+            cellValues_[eIdx] = evalSolution(element, geometry, *fvGridGeometry_, elemSol, cellCenters_[eIdx])[pvIdx_];
+            if (fluxJump && fluxCoefficient_)
+                cellCoefficients_[eIdx] = fluxCoefficient_(element);
+
+            using std::min; using std::max;
+            globalMin = min(cellValues_[eIdx], globalMin);
+            globalMax = max(cellValues_[eIdx], globalMax);
+        }
+
+        //! Compute the jump over each face once and add it to both adjacent elements
+        for (const auto& element : elements(gridView))
+        {
+            const auto eIdxI = elementMapper.index(element);
+            for (const auto& intersection : intersections(gridView, element))
+            {
+                if (!intersection.neighbor())
+                    continue;
+
+                const auto outside = intersection.outside();
+                const auto eIdxJ = elementMapper.index(outside);
+
+                //! Visit intersection only once
+                if (element.level() > outside.level() || (element.level() == outside.level() && eIdxI < eIdxJ))
+                {
+                    using std::abs;
+                    const Scalar jump = abs(cellValues_[eIdxI] - cellValues_[eIdxJ]);
+                    if (fluxJump)
+                    {
+                        //! Add the face to the least-squares systems of both elements
+                        //! and keep it for the evaluation of the flux jumps
+                        const auto distanceVector = cellCenters_[eIdxJ] - cellCenters_[eIdxI];
+                        const auto difference = cellValues_[eIdxJ] - cellValues_[eIdxI];
+                        for (int i = 0; i < dimWorld; ++i)
+                        {
+                            cellGradients_[eIdxI][i] += distanceVector[i]*difference;
+                            cellGradients_[eIdxJ][i] += distanceVector[i]*difference;
+                            for (int j = 0; j < dimWorld; ++j)
+                            {
+                                leastSquaresMatrices_[eIdxI][i][j] += distanceVector[i]*distanceVector[j];
+                                leastSquaresMatrices_[eIdxJ][i][j] += distanceVector[i]*distanceVector[j];
+                            }
+                        }
+
+                        faces_.push_back({eIdxI, eIdxJ, intersection.geometry().volume(),
+                                          distanceVector.two_norm(), intersection.centerUnitOuterNormal()});
+                    }
+                    else if (estimator_ == JumpIndicatorEstimator::maxJump)
+                    {
+                        using std::max;
+                        indicator_[eIdxI] = max(indicator_[eIdxI], jump);
+                        indicator_[eIdxJ] = max(indicator_[eIdxJ], jump);
+                    }
+                    else
+                    {
+                        const auto distance = (cellCenters_[eIdxJ] - cellCenters_[eIdxI]).two_norm();
+                        const Scalar faceContribution = intersection.geometry().volume()*jump*jump/distance;
+                        indicator_[eIdxI] += faceContribution;
+                        indicator_[eIdxJ] += faceContribution;
+                    }
+                }
+            }
+        }
+
+        //! Reconstruct the gradients and add the flux jump over each face to both adjacent elements
+        if (fluxJump)
+        {
+            for (std::size_t eIdx = 0; eIdx < cellGradients_.size(); ++eIdx)
+                cellGradients_[eIdx] = leastSquaresGradient_(leastSquaresMatrices_[eIdx], cellGradients_[eIdx]);
+
+            for (const auto& face : faces_)
+            {
+                const auto fluxI = cellCoefficients_[face.eIdxI]*(cellGradients_[face.eIdxI]*face.normal);
+                const auto fluxJ = cellCoefficients_[face.eIdxJ]*(cellGradients_[face.eIdxJ]*face.normal);
+                const Scalar faceContribution = face.area*face.distance*(fluxI - fluxJ)*(fluxI - fluxJ);
+                indicator_[face.eIdxI] += faceContribution;
+                indicator_[face.eIdxJ] += faceContribution;
+            }
+        }
+
+        Scalar maxIndicator = 0.0;
+        if (estimator_ != JumpIndicatorEstimator::maxJump)
+        {
+            for (const auto& element : elements(gridView, Dune::Partitions::interior))
+            {
+                const auto eIdx = elementMapper.index(element);
+                using std::sqrt; using std::max;
+                indicator_[eIdx] = sqrt(indicator_[eIdx]);
+                maxIndicator = max(maxIndicator, indicator_[eIdx]);
+            }
+        }
+
+        //! Make the indicator and the bounds consistent among the processes
+        if (gridView.comm().size() > 1)
+        {
+            VectorExchange<ElementMapper, std::vector<Scalar>> dataHandle(elementMapper, indicator_);
+            gridView.communicate(dataHandle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+
+            globalMax = gridView.comm().max(globalMax);
+            globalMin = gridView.comm().min(globalMin);
+            maxIndicator = gridView.comm().max(maxIndicator);
+        }
+
+        //! Compute the refinement/coarsening bounds
+        const auto reference = estimator_ == JumpIndicatorEstimator::maxJump ? globalMax - globalMin : maxIndicator;
+        refineBound_ = refineTol*reference;
+        coarsenBound_ = coarsenTol*reference;
+
+        //! check if neighbors have to be refined too
+        for (const auto& element : elements(gridView, Dune::Partitions::interior))
+            if (this->operator()(element) > 0)
+                checkNeighborsRefine_(element);
+    }
+
+    /*!
+     * \brief function call operator to return mark
+     *
+     * \return  1 if an element should be refined
+     *         -1 if an element should be coarsened
+     *          0 otherwise
+     *
+     * \param element A grid element
+     */
+    int operator() (const Element& element) const
+    {
+        const auto eIdx = fvGridGeometry_->elementMapper().index(element);
+        if (element.hasFather() && indicator_[eIdx] < coarsenBound_)
+            return -1;
+        else if (element.level() < maxLevel_ && indicator_[eIdx] > refineBound_)
+            return 1;
+        else
+            return 0;
+    }
+
+    //! The indicator value of an element (e.g. for output)
+    Scalar value(const Element& element) const
+    { return indicator_[fvGridGeometry_->elementMapper().index(element)]; }
+
+private:
+    //! A face between two elements as needed for the flux jumps
+    struct Face
+    {
+        std::size_t eIdxI, eIdxJ;
+        Scalar area;
+        Scalar distance;
+        GlobalPosition normal; //!< the unit normal pointing from element I to element J
+    };
+
+    /*!
+     * \brief Solve the least-squares system for the gradient of an element
+     * \note The system is regularized, such that directions without neighbors
+     *       (e.g. normal to the grid of a lower-dimensional domain) get a vanishing gradient.
+     */
+    static GlobalPosition leastSquaresGradient_(Matrix matrix, const GlobalPosition& rhs)
+    {
+        Scalar trace = 0.0;
+        for (int i = 0; i < dimWorld; ++i)
+            trace += matrix[i][i];
+
+        GlobalPosition gradient(0.0);
+        if (trace <= 0.0)
+            return gradient;
+
+        for (int i = 0; i < dimWorld; ++i)
+            matrix[i][i] += 1e-10*trace;
+
+        matrix.solve(gradient, rhs);
+        return gradient;
+    }
+
+    /*!
+     * \brief Method ensuring the refinement ratio of 2:1
+     *
+     * \param element Element of interest that is to be refined
+     * \param level level of the refined element: it is at least 1
+     */
+    void checkNeighborsRefine_(const Element &element, std::size_t level = 1)
+    {
+        for (const auto& intersection : intersections(fvGridGeometry_->gridView(), element))
+        {
+            if (!intersection.neighbor())
+                continue;
+
+            // obtain outside element
+            const auto outside = intersection.outside();
+
+            // only mark non-ghost elements
+            if (outside.partitionType() == Dune::GhostEntity)
+                continue;
+
+            if (outside.level() < maxLevel_ && outside.level() < element.level())
+            {
+                // ensure refinement for outside element
+                indicator_[fvGridGeometry_->elementMapper().index(outside)] = std::numeric_limits<Scalar>::max();
+                if (level < maxLevel_)
+                    checkNeighborsRefine_(outside, ++level);
+            }
+        }
+    }
+
+    std::shared_ptr<const FVGridGeometry> fvGridGeometry_;
+    int pvIdx_;
+    JumpIndicatorEstimator estimator_;
+
+    Scalar refineBound_;
+    Scalar coarsenBound_;
+    std::vector<Scalar> indicator_;
+    std::vector<Scalar> cellValues_;
+    std::vector<GlobalPosition> cellCenters_;
+    std::vector<Scalar> cellCoefficients_;
+    std::vector<GlobalPosition> cellGradients_;
+    std::vector<Matrix> leastSquaresMatrices_;
+    std::vector<Face> faces_;
+    std::function<Scalar(const Element&)> fluxCoefficient_;
+    std::size_t minLevel_;
+    std::size_t maxLevel_;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,239 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Adaptive
+ * \brief Free functions and a data handle to redistribute an adapted grid
+ *        among the processes while migrating the solution.
+ */
+#ifndef DUMUX_ADAPTIVE_LOADBALANCE_HH
+#define DUMUX_ADAPTIVE_LOADBALANCE_HH
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <dune/common/unused.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/utility/persistentcontainer.hh>
+
+#include <dumux/discretization/method.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Adaptive
+ * \brief Data handle migrating solution vectors along with the grid entities
+ *        carrying the degrees of freedom (elements for cell-centered schemes,
+ *        vertices for the box scheme) when the grid is redistributed.
+ *
+ * The values are stored in a persistent container before the grid is load balanced.
+ * Values of entities leaving the process are sent with the entities, values of entities
+ * that stay on the process are kept in the persistent container. After load balancing,
+ * the grid geometry is updated and the solution vectors are rebuilt from the container.
+ *
+ * \tparam FVGridGeometry the finite volume grid geometry
+ * \tparam SolutionVector the type of the solution vectors to be migrated
+ */
+template<class FVGridGeometry, class SolutionVector>
+class SolutionMigrationDataHandle
+: public Dune::CommDataHandleIF<SolutionMigrationDataHandle<FVGridGeometry, SolutionVector>,
+                                typename SolutionVector::block_type>
+{
+    using GridView = typename FVGridGeometry::GridView;
+    using Grid = typename GridView::Grid;
+    using PrimaryVariables = typename SolutionVector::block_type;
+    using PersistentContainer = Dune::PersistentContainer<Grid, std::vector<PrimaryVariables>>;
+
+    static constexpr int dim = GridView::dimension;
+    static constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+    static constexpr int dofCodim = isBox ? dim : 0;
+
+public:
+    //! export type of data for message buffer
+    using DataType = PrimaryVariables;
+
+    /*!
+     * \brief Constructor
+     *
+     * \param fvGridGeometry The finite volume grid geometry
+     * \param solutions The solution vectors to be migrated, e.g. the current and the previous solution
+     */
+    template<class... Solutions>
+    SolutionMigrationDataHandle(std::shared_ptr<FVGridGeometry> fvGridGeometry, Solutions&... solutions)
+    : fvGridGeometry_(fvGridGeometry)
+    , solutions_({&solutions...})
+    , container_(fvGridGeometry->gridView().grid(), dofCodim)
+    {}
+
+    //! Copy the solution values into the persistent container (call before load balancing)
+    void store()
+    {
+        container_.resize();
+        const auto& gridView = fvGridGeometry_->gridView();
+        for (const auto& entity : entities(gridView, Dune::Codim<dofCodim>()))
+        {
+            auto& values = container_[entity];
+            values.resize(solutions_.size());
+            const auto dofIdxGlobal = fvGridGeometry_->dofMapper().index(entity);
+            for (std::size_t i = 0; i < solutions_.size(); ++i)
+                values[i] = (*solutions_[i])[dofIdxGlobal];
+        }
+    }
+
+    /*!
+     * \brief Update the grid geometry and rebuild the solution vectors (call after load balancing)
+     *
+     * The values of ghost and overlap entities which are new on this process are
+     * received from the processes owning these entities.
+     */
+    void reconstruct()
+    {
+        container_.resize();
+        fvGridGeometry_->update();
+
+        const auto& gridView = fvGridGeometry_->gridView();
+        if (gridView.comm().size() > 1)
+            gridView.communicate(*this, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+
+        for (auto* sol : solutions_)
+            sol->resize(fvGridGeometry_->numDofs());
+
+        for (const auto& entity : entities(gridView, Dune::Codim<dofCodim>()))
+        {
+            const auto& values = container_[entity];
+            const auto dofIdxGlobal = fvGridGeometry_->dofMapper().index(entity);
+            for (std::size_t i = 0; i < values.size(); ++i)
+                (*solutions_[i])[dofIdxGlobal] = values[i];
+        }
+
+        // free the memory of the container
+        container_.resize(typename PersistentContainer::Value());
+        container_.shrinkToFit();
+        container_.fill(typename PersistentContainer::Value());
+    }
+
+    //! returns true if data for this codim should be communicated
+    bool contains(int dim, int codim) const
+    { return codim == dofCodim; }
+
+    //! returns true if size per entity of given dim and codim is a constant
+    bool fixedsize(int dim, int codim) const
+    { return true; }
+
+    //! the number of objects to be sent per entity
+    template<class Entity>
+    std::size_t size(const Entity& entity) const
+    { return solutions_.size(); }
+
+    //! pack data from user to message buffer
+    template<class MessageBuffer, class Entity>
+    void gather(MessageBuffer& buff, const Entity& entity) const
+    {
+        const auto& values = container_[entity];
+        for (std::size_t i = 0; i < solutions_.size(); ++i)
+            buff.write(i < values.size() ? values[i] : PrimaryVariables(0.0));
+    }
+
+    //! unpack data from message buffer to user
+    template<class MessageBuffer, class Entity>
+    void scatter(MessageBuffer& buff, const Entity& entity, std::size_t n)
+    {
+        auto& values = container_[entity];
+        values.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+            buff.read(values[i]);
+    }
+
+private:
+    std::shared_ptr<FVGridGeometry> fvGridGeometry_;
+    std::vector<SolutionVector*> solutions_;
+    PersistentContainer container_;
+};
+
+/*!
+ * \ingroup Adaptive
+ * \brief Compute the load imbalance of a distributed grid view
+ *
+ * The load of a process is the number of its interior elements.
+ * \return the ratio of the maximum load to the average load (1.0 for a perfectly balanced grid)
+ */
+template<class GridView>
+double loadImbalance(const GridView& gridView)
+{
+    std::size_t numInteriorElements = 0;
+    for (const auto& element : elements(gridView, Dune::Partitions::interior))
+    {
+        DUNE_UNUSED_PARAMETER(element);
+        ++numInteriorElements;
+    }
+
+    const auto& comm = gridView.comm();
+    const double maxLoad = comm.max(numInteriorElements);
+    const double averageLoad = static_cast<double>(comm.sum(numInteriorElements))/comm.size();
+
+    return averageLoad > 0.0 ? maxLoad/averageLoad : 1.0;
+}
+
+/*!
+ * \ingroup Adaptive
+ * \brief Redistribute the leaf grid among the processes if it is imbalanced
+ *        and migrate the solution using the given data handle
+ *
+ * \param grid The grid to redistribute
+ * \param dataHandle A data handle, e.g. a SolutionMigrationDataHandle, providing
+ *                   store() and reconstruct() besides the Dune data handle interface
+ * \param imbalanceTolerance The grid is only redistributed if the ratio of the maximum
+ *                           to the average number of interior elements exceeds this value
+ * \param verbose If verbose output to std::cout is enabled
+ * \return bool whether or not the grid has been redistributed
+ *
+ * \note If the grid has been redistributed, the grid variables, the assembler's
+ *       Jacobian pattern and the parallel linear solver have to be updated
+ *       as after a grid adaptation.
+ */
+template<class Grid, class DataHandle>
+bool loadBalance(Grid& grid, DataHandle& dataHandle, double imbalanceTolerance = 1.0, bool verbose = true)
+{
+    if (grid.comm().size() == 1)
+        return false;
+
+    const auto imbalance = loadImbalance(grid.leafGridView());
+    if (imbalance <= imbalanceTolerance)
+        return false;
+
+    dataHandle.store();
+    const bool wasRedistributed = grid.loadBalance(dataHandle);
+    if (wasRedistributed)
+        dataHandle.reconstruct();
+
+    if (grid.comm().rank() == 0 && verbose)
+        std::cout << "Load imbalance of " << imbalance << " exceeded the tolerance of " << imbalanceTolerance
+                  << (wasRedistributed ? ", the grid has been redistributed." : ", but the grid could not be redistributed.")
+                  << std::endl;
+
+    return wasRedistributed;
+}
+
+} // end namespace Dumux
+
+#endif /* DUMUX_ADAPTIVE_LOADBALANCE_HH */
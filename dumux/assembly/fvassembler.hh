@@ -29,6 +29,8 @@
 #include <dune/istl/matrixindexset.hh>
 
 #include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh>
 #include <dumux/common/timeloop.hh>
 #include <dumux/discretization/method.hh>
 #include <dumux/parallel/vertexhandles.hh>
@@ -369,6 +371,10 @@ private:
         // a state that will be checked on all processes
         bool succeeded = false;
 
+        // optionally report parameter lookups inside the assembly
+        ParameterLookupRegion parameterLookupRegion("assembly");
+        DUMUX_PROFILE_REGION("assembly");
+
         // try assembling using the local assembly function
         try
         {
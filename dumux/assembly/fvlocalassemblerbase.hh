@@ -31,6 +31,7 @@
 #include <dumux/common/reservedblockvector.hh>
 #include <dumux/common/properties.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh>
 #include <dumux/assembly/diffmethod.hh>
 
 namespace Dumux {
@@ -135,6 +136,7 @@ public:
      */
     ElementResidualVector evalLocalResidual(const ElementVolumeVariables& elemVolVars) const
     {
+        DUMUX_PROFILE_REGION("local residual");
         if (!assembler().isStationaryProblem())
         {
             ElementResidualVector residual = evalLocalFluxAndSourceResidual(elemVolVars);
@@ -164,6 +166,7 @@ public:
      */
     ElementResidualVector evalLocalFluxAndSourceResidual(const ElementVolumeVariables& elemVolVars) const
     {
+        DUMUX_PROFILE_REGION("flux and source");
         return localResidual_.evalFluxAndSource(element_, fvGeometry_, elemVolVars, elemFluxVarsCache_, elemBcTypes_);
     }
 
@@ -183,6 +186,8 @@ public:
      */
     void bindLocalViews()
     {
+        DUMUX_PROFILE_REGION("volume variables");
+
         // get some references for convenience
         const auto& element = this->element();
         const auto& curSol = this->curSol();
@@ -393,6 +393,19 @@ public:
                               const VolumeVariables& volVars,
                               const SubControlVolume& scv) const {}
 
+    /*!
+     * \brief Add the derivatives of solution-dependent Neumann (Robin) fluxes to the Jacobian
+     * \note Only needed in case of analytic differentiation and solution dependent Neumann fluxes.
+     *       The default assumes Neumann fluxes that do not depend on the solution.
+     */
+    template<class PartialDerivativeMatrices, class ElementVolumeVariables, class ElementFluxVariablesCache>
+    void addRobinFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                                 const Element& element,
+                                 const FVElementGeometry& fvGeometry,
+                                 const ElementVolumeVariables& elemVolVars,
+                                 const ElementFluxVariablesCache& elemFluxVarsCache,
+                                 const SubControlVolumeFace& scvf) const {}
+
     /*!
      * \brief Adds contribution of point sources for a specific sub control volume
      *        to the values.
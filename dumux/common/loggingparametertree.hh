@@ -62,6 +62,31 @@ public:
     bool hasKey(const std::string& key) const
     { return params_.hasKey(key); }
 
+    /** \brief test for key in the sub-tree of a group
+     *
+     * The key is searched like in getFromGroup(): first with the group prefix,
+     * then with the parent groups, then without prefix, first in the runtime
+     * and then in the default parameters.
+     * So if this returns true, getFromGroup() without default value succeeds.
+     *
+     * \param groupPrefix The prefix of the sub tree the search should start in
+     * \param key key name
+     */
+    bool hasKeyInGroup(const std::string& groupPrefix, const std::string& key) const
+    {
+        const auto hasKeyInTree = [&](const Dune::ParameterTree& tree)
+        {
+            if (groupPrefix == "")
+                return tree.hasKey(key);
+
+            return tree.hasKey(groupPrefix + "." + key)
+                   || findKeyInGroup(tree, key, groupPrefix) != ""
+                   || tree.hasKey(key);
+        };
+
+        return hasKeyInTree(params_) || hasKeyInTree(defaultParams_);
+    }
+
 
     /** \brief print the hierarchical parameter tree to stream
      *
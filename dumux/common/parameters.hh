@@ -24,9 +24,14 @@
 #ifndef DUMUX_PARAMETERS_HH
 #define DUMUX_PARAMETERS_HH
 
+#include <cassert>
 #include <iostream>
 #include <list>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <unordered_map>
 #include <fstream>
 
@@ -40,6 +45,67 @@
 
 namespace Dumux {
 
+#ifndef DOXYGEN
+namespace Detail {
+/*!
+ * \ingroup Common
+ * \brief Records parameter lookups happening inside a ParameterLookupRegion
+ *
+ * Each thread has its own stack of active regions, the recorded lookups
+ * of all threads are collected in a map protected by a mutex.
+ */
+class ParameterLookupMonitor
+{
+public:
+    //! the names of the regions currently active in this thread (innermost last)
+    static std::vector<std::string>& regions()
+    {
+        thread_local std::vector<std::string> regions;
+        return regions;
+    }
+
+    //! the number of lookups per region and key (lock mutex() when accessing it concurrently)
+    static std::map<std::string, std::size_t>& lookups()
+    {
+        static std::map<std::string, std::size_t> lookups;
+        return lookups;
+    }
+
+    //! the mutex protecting the recorded lookups
+    static std::mutex& mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    //! record a lookup if a region is active (further arguments, e.g. default values, are ignored)
+    template<class Group, class Key, class... Args>
+    static void record(const Group& paramGroup, const Key& key, const Args&...)
+    {
+        if (regions().empty())
+            return;
+
+        const std::string group = paramGroup;
+        const auto entry = regions().back() + ": " + (group == "" ? std::string(key) : group + "." + key);
+        std::lock_guard<std::mutex> lock(mutex());
+        ++lookups()[entry];
+    }
+
+    //! print all recorded lookups
+    static void report(std::ostream& stream)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        if (lookups().empty())
+            return;
+
+        stream << "\n# Parameter lookups inside hot regions (resolve them once, e.g. with a ParameterHandle):" << std::endl;
+        for (const auto& lookup : lookups())
+            stream << "# " << lookup.first << " (" << lookup.second << " times)" << std::endl;
+    }
+};
+} // end namespace Detail
+#endif
+
 /*!
  * \ingroup Common
  * \brief Parameter class managing runtime input parameters
@@ -256,6 +322,7 @@ public:
     static void print()
     {
         getTree().reportAll();
+        Detail::ParameterLookupMonitor::report(std::cout);
     }
 
     //! returns the logging parameter tree recording which parameters are used during the simulation
@@ -355,6 +422,7 @@ template<typename T, typename... Args>
 T getParam(Args&&... args)
 {
     const auto& p = Parameters::getTree();
+    Detail::ParameterLookupMonitor::record("", args...);
     return p.template get<T>(std::forward<Args>(args)... );
 }
 
@@ -367,6 +435,7 @@ template<typename T, typename... Args>
 T getParamFromGroup(Args&&... args)
 {
     const auto& p = Parameters::getTree();
+    Detail::ParameterLookupMonitor::record(args...);
     return p.template getFromGroup<T>(std::forward<Args>(args)... );
 }
 
@@ -377,6 +446,7 @@ T getParamFromGroup(Args&&... args)
 bool hasParam(const std::string& param)
 {
     const auto& p = Parameters::getTree();
+    Detail::ParameterLookupMonitor::record("", param);
     return p.hasKey(param);
 }
 
@@ -388,12 +458,129 @@ template<typename... Args>
 bool hasParamInGroup(const std::string& paramGroup, const std::string& param)
 {
     const auto& p = Parameters::getTree();
+    Detail::ParameterLookupMonitor::record(paramGroup, param);
     if (paramGroup == "")
         return p.hasKey(param);
     else
         return p.hasKey(paramGroup + "." + param);
 }
 
+/*!
+ * \ingroup Common
+ * \brief A typed handle to a parameter which is resolved once on construction.
+ *
+ * Looking up a parameter with getParam() involves string operations, a hierarchical
+ * search in the parameter tree and the conversion of the value from a string.
+ * Hot paths (e.g. constitutive relations evaluated during the assembly) should
+ * resolve their parameters once, e.g. in the constructor of the owning object,
+ * and store the handle instead of calling getParam() for every evaluation:
+ * \code
+ * ParameterHandle<double> upwindWeight_(paramGroup, "Flux.UpwindWeight");
+ * ...
+ * const auto weight = upwindWeight_.value();
+ * \endcode
+ * Accessing the value of a handle is as cheap as accessing a member variable.
+ *
+ * \tparam T the type of the parameter value
+ */
+template<class T>
+class ParameterHandle
+{
+public:
+    //! Resolve a parameter which has to be specified (or has a global default)
+    ParameterHandle(const std::string& paramGroup, const std::string& key)
+    : key_(key)
+    , value_(getParamFromGroup<T>(paramGroup, key))
+    , hasValue_(true)
+    {}
+
+    //! Resolve a parameter with a default value
+    ParameterHandle(const std::string& paramGroup, const std::string& key, const T& defaultValue)
+    : key_(key)
+    , value_(getParamFromGroup<T>(paramGroup, key, defaultValue))
+    , hasValue_(true)
+    {}
+
+    /*!
+     * \brief Resolve a parameter that does not need to be specified
+     * \note Check with hasValue() whether the parameter was specified. As for the other
+     *       constructors, the key is also searched in the parent groups, without group prefix
+     *       and in the global defaults.
+     */
+    static ParameterHandle optional(const std::string& paramGroup, const std::string& key)
+    {
+        Detail::ParameterLookupMonitor::record(paramGroup, key);
+        if (Parameters::getTree().hasKeyInGroup(paramGroup, key))
+            return ParameterHandle(paramGroup, key);
+
+        ParameterHandle handle;
+        handle.key_ = key;
+        return handle;
+    }
+
+    //! Whether the parameter was specified (always true for non-optional parameters)
+    bool hasValue() const
+    { return hasValue_; }
+
+    //! The value of the parameter
+    const T& value() const
+    {
+        assert(hasValue_ && "Accessing the value of an unspecified optional parameter");
+        return value_;
+    }
+
+    //! The value of the parameter
+    operator const T& () const
+    { return value(); }
+
+    //! The key of the parameter (without group prefix)
+    const std::string& key() const
+    { return key_; }
+
+private:
+    ParameterHandle() = default;
+
+    std::string key_;
+    T value_ = T{};
+    bool hasValue_ = false;
+};
+
+/*!
+ * \ingroup Common
+ * \brief Marks a region in which no parameters should be looked up, e.g. the assembly.
+ *
+ * If the runtime parameter Parameters.ReportHotPathLookups is set to true, all calls of
+ * getParam(), getParamFromGroup(), hasParam() and hasParamInGroup() inside such regions
+ * are counted and reported by Parameters::print(). This helps to find parameter lookups
+ * that should be replaced by ParameterHandle members. Lookups hidden behind function-local
+ * static variables are only reported for the first call. A region is only active in the
+ * thread that created it. If the report is disabled (default), a region has no effect.
+ */
+class ParameterLookupRegion
+{
+public:
+    //! Enter a region with the given name
+    explicit ParameterLookupRegion(const std::string& name)
+    : active_(Parameters::getTree().get<bool>("Parameters.ReportHotPathLookups", false))
+    {
+        if (active_)
+            Detail::ParameterLookupMonitor::regions().push_back(name);
+    }
+
+    //! Leave the region
+    ~ParameterLookupRegion()
+    {
+        if (active_)
+            Detail::ParameterLookupMonitor::regions().pop_back();
+    }
+
+    ParameterLookupRegion(const ParameterLookupRegion&) = delete;
+    ParameterLookupRegion& operator=(const ParameterLookupRegion&) = delete;
+
+private:
+    bool active_;
+};
+
 DUNE_DEPRECATED_MSG("haveParam is deprecated, please use hasParam instead.")
 bool haveParam(const std::string& param)
 { return hasParam(param); }
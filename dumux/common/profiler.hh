@@ -0,0 +1,366 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief Hierarchical profiling of named code regions
+ */
+#ifndef DUMUX_PROFILER_HH
+#define DUMUX_PROFILER_HH
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+/*!
+ * \ingroup Common
+ * \brief Set to 1 (e.g. with -DDUMUX_PROFILING=1) to enable the profiling regions.
+ *        If disabled, DUMUX_PROFILE_REGION expands to nothing.
+ */
+#ifndef DUMUX_PROFILING
+#define DUMUX_PROFILING 0
+#endif
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief Measures the time spent in nested named regions.
+ *
+ * Regions are entered and left with DUMUX_PROFILE_REGION("name") which creates a
+ * scope guard. Regions entered inside other regions form a tree, e.g.
+ * newton/assembly/local residual/flux and source. For each node of the tree the number
+ * of calls and the accumulated wall time are recorded. Optionally, every single
+ * call is recorded as an event that can be written in the Chrome trace event format
+ * (viewable with chrome://tracing or https://ui.perfetto.dev).
+ *
+ * The report and the JSON export reduce the times over all processes (minimum,
+ * maximum and average). Regions have to be entered in the same order on all
+ * processes (the tree of the first process is used for the reduction).
+ *
+ * \note The profiler is not thread-safe. Regions have to be entered from one thread only.
+ * \note Compile with DUMUX_PROFILING=1 to enable the regions. Otherwise the profiler
+ *       records nothing and adds no overhead.
+ */
+class Profiler
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Node
+    {
+        Node(const char* n, Node* p) : name(n), parent(p) {}
+
+        std::string name;
+        Node* parent;
+        std::size_t calls = 0;
+        double time = 0.0;
+        std::vector<std::unique_ptr<Node>> children;
+    };
+
+    struct Event
+    {
+        const Node* node;
+        double start;
+        double duration;
+    };
+
+public:
+    //! The profiler singleton
+    static Profiler& instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    //! Enter a region (nested in the currently active region)
+    void enter(const char* name)
+    {
+        Node* node = nullptr;
+        for (auto& child : current_->children)
+        {
+            if (child->name == name)
+            {
+                node = child.get();
+                break;
+            }
+        }
+
+        if (!node)
+        {
+            current_->children.emplace_back(std::make_unique<Node>(name, current_));
+            node = current_->children.back().get();
+        }
+
+        current_ = node;
+        startTimes_.push_back(Clock::now());
+    }
+
+    //! Leave the currently active region
+    void leave()
+    {
+        const auto end = Clock::now();
+        const auto start = startTimes_.back();
+        startTimes_.pop_back();
+
+        const double duration = std::chrono::duration<double>(end - start).count();
+        ++current_->calls;
+        current_->time += duration;
+
+        if (recordEvents_)
+            events_.push_back({current_, std::chrono::duration<double>(start - begin_).count(), duration});
+
+        current_ = current_->parent;
+    }
+
+    //! Record every call of a region for the export in the Chrome trace format
+    void setRecordEvents(bool recordEvents = true)
+    { recordEvents_ = recordEvents; }
+
+    //! Discard all measurements
+    void reset()
+    {
+        if (!startTimes_.empty())
+            DUNE_THROW(Dune::InvalidStateException, "Cannot reset the profiler inside a region");
+
+        root_.children.clear();
+        events_.clear();
+        begin_ = Clock::now();
+    }
+
+    /*!
+     * \brief Print the region tree with the times reduced over all processes
+     * \param comm The communication object of the grid view (e.g. gridView.comm())
+     * \param stream The output stream (written on rank 0 only)
+     */
+    template<class Communication>
+    void report(const Communication& comm, std::ostream& stream = std::cout) const
+    {
+        const auto stats = reduce_(comm);
+        if (comm.rank() != 0)
+            return;
+
+        stream << "\nProfiling report (" << comm.size() << " process(es)):\n"
+               << std::left << std::setw(50) << "region" << std::right
+               << std::setw(10) << "calls" << std::setw(14) << "min [s]"
+               << std::setw(14) << "max [s]" << std::setw(14) << "avg [s]" << "\n";
+        for (const auto& s : stats)
+        {
+            const std::string name = std::string(2*s.depth, ' ') + s.node->name;
+            stream << std::left << std::setw(50) << name << std::right
+                   << std::setw(10) << s.node->calls
+                   << std::setw(14) << s.min << std::setw(14) << s.max << std::setw(14) << s.avg << "\n";
+        }
+        stream << std::flush;
+    }
+
+    /*!
+     * \brief Write the region tree with the times reduced over all processes as JSON
+     * \param fileName The name of the file (written on rank 0 only)
+     * \param comm The communication object of the grid view (e.g. gridView.comm())
+     */
+    template<class Communication>
+    void writeJson(const std::string& fileName, const Communication& comm) const
+    {
+        const auto stats = reduce_(comm);
+        if (comm.rank() != 0)
+            return;
+
+        std::ofstream file(fileName);
+        file << std::setprecision(10) << "{\n  \"processes\": " << comm.size() << ",\n  \"regions\": [";
+        for (std::size_t i = 0; i < stats.size(); ++i)
+        {
+            const auto& s = stats[i];
+            file << (i > 0 ? "," : "") << "\n    {\"path\": \"" << escape_(path_(s.node)) << "\""
+                 << ", \"calls\": " << s.node->calls
+                 << ", \"min\": " << s.min << ", \"max\": " << s.max << ", \"avg\": " << s.avg << "}";
+        }
+        file << "\n  ]\n}\n";
+    }
+
+    /*!
+     * \brief Write the recorded events of this process in the Chrome trace event format
+     * \param fileName The name of the file
+     * \param rank The rank of the process (used as process id in the trace)
+     * \note Call setRecordEvents() before entering the regions. In parallel, use one file per
+     *       process; the files can be merged by concatenating their trace events.
+     */
+    void writeChromeTrace(const std::string& fileName, int rank = 0) const
+    {
+        std::ofstream file(fileName);
+        file << std::setprecision(15) << "{\"traceEvents\": [";
+        for (std::size_t i = 0; i < events_.size(); ++i)
+        {
+            const auto& e = events_[i];
+            file << (i > 0 ? "," : "") << "\n{\"name\": \"" << escape_(e.node->name) << "\""
+                 << ", \"ph\": \"X\", \"pid\": " << rank << ", \"tid\": 0"
+                 << ", \"ts\": " << 1e6*e.start << ", \"dur\": " << 1e6*e.duration << "}";
+        }
+        file << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    }
+
+private:
+    struct Statistics
+    {
+        const Node* node;
+        int depth;
+        double min, max, avg;
+    };
+
+    Profiler()
+    : root_("root", nullptr)
+    , current_(&root_)
+    , begin_(Clock::now())
+    {}
+
+    // collect the nodes of the tree in depth-first order
+    void collect_(const Node& node, int depth, std::vector<Statistics>& stats) const
+    {
+        for (const auto& child : node.children)
+        {
+            stats.push_back({child.get(), depth, child->time, child->time, child->time});
+            collect_(*child, depth + 1, stats);
+        }
+    }
+
+    // the tree of the first process determines the regions, missing regions count as zero
+    template<class Communication>
+    std::vector<Statistics> reduce_(const Communication& comm) const
+    {
+        std::vector<Statistics> stats;
+        collect_(root_, 0, stats);
+        if (comm.size() == 1)
+            return stats;
+
+        // broadcast the region paths of the first process
+        std::string paths;
+        for (const auto& s : stats)
+            paths += path_(s.node) + '\n';
+        int numChars = paths.size();
+        comm.broadcast(&numChars, 1, 0);
+        std::vector<char> buffer(paths.begin(), paths.end());
+        buffer.resize(numChars);
+        comm.broadcast(buffer.data(), numChars, 0);
+
+        // find the local times of these regions
+        std::vector<double> minTimes, maxTimes, sumTimes;
+        std::istringstream pathStream(std::string(buffer.begin(), buffer.end()));
+        std::string path;
+        while (std::getline(pathStream, path))
+        {
+            double time = 0.0;
+            for (const auto& s : stats)
+                if (path_(s.node) == path)
+                    time = s.node->time;
+            minTimes.push_back(time);
+            maxTimes.push_back(time);
+            sumTimes.push_back(time);
+        }
+
+        const int numRegions = sumTimes.size();
+        comm.min(minTimes.data(), numRegions);
+        comm.max(maxTimes.data(), numRegions);
+        comm.sum(sumTimes.data(), numRegions);
+
+        // only the first process knows the nodes belonging to the paths
+        if (comm.rank() != 0)
+            return {};
+
+        for (int i = 0; i < numRegions; ++i)
+        {
+            stats[i].min = minTimes[i];
+            stats[i].max = maxTimes[i];
+            stats[i].avg = sumTimes[i]/comm.size();
+        }
+        return stats;
+    }
+
+    // the path of a node, e.g. "newton/assembly"
+    static std::string path_(const Node* node)
+    {
+        std::string path = node->name;
+        for (node = node->parent; node && node->parent; node = node->parent)
+            path = node->name + "/" + path;
+        return path;
+    }
+
+    // escape a string for JSON output
+    static std::string escape_(const std::string& s)
+    {
+        std::string escaped;
+        for (const char c : s)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    Node root_;
+    Node* current_;
+    std::vector<Clock::time_point> startTimes_;
+    Clock::time_point begin_;
+    bool recordEvents_ = false;
+    std::vector<Event> events_;
+};
+
+/*!
+ * \ingroup Common
+ * \brief Scope guard entering a profiling region on construction and leaving it on destruction
+ * \note Use the macro DUMUX_PROFILE_REGION which vanishes if profiling is disabled.
+ */
+class ProfilingRegion
+{
+public:
+    explicit ProfilingRegion(const char* name)
+    { Profiler::instance().enter(name); }
+
+    ~ProfilingRegion()
+    { Profiler::instance().leave(); }
+
+    ProfilingRegion(const ProfilingRegion&) = delete;
+    ProfilingRegion& operator=(const ProfilingRegion&) = delete;
+};
+
+} // end namespace Dumux
+
+#ifndef DOXYGEN
+#define DUMUX_PROFILE_CONCAT_IMPL_(a, b) a##b
+#define DUMUX_PROFILE_CONCAT_(a, b) DUMUX_PROFILE_CONCAT_IMPL_(a, b)
+#endif
+
+/*!
+ * \ingroup Common
+ * \brief Profile the enclosing scope as region with the given name (a string literal)
+ */
+#if DUMUX_PROFILING
+#define DUMUX_PROFILE_REGION(name) \
+    ::Dumux::ProfilingRegion DUMUX_PROFILE_CONCAT_(dumuxProfilingRegion, __LINE__)(name)
+#else
+#define DUMUX_PROFILE_REGION(name) do {} while (false)
+#endif
+
+#endif
@@ -36,6 +36,7 @@
 #include <dumux/common/defaultmappertraits.hh>
 #include <dumux/discretization/basefvgridgeometry.hh>
 #include <dumux/discretization/checkoverlapsize.hh>
+#include <dumux/discretization/previouselementindices.hh>
 #include <dumux/discretization/box/boxgeometryhelper.hh>
 #include <dumux/discretization/box/fvelementgeometry.hh>
 #include <dumux/discretization/box/subcontrolvolume.hh>
@@ -118,6 +119,7 @@ public:
     //! Constructor
     BoxFVGridGeometry(const GridView gridView)
     : ParentType(gridView)
+    , previousElementIndices_(gridView.grid())
     {
         // Check if the overlap size is what we expect
         if (!CheckOverlapSize<DiscretizationMethod::box>::isValid(gridView))
@@ -147,18 +149,27 @@ public:
     std::size_t numDofs() const
     { return this->vertexMapper().size(); }
 
-    //! update all fvElementGeometries (do this again after grid adaption)
+    /*!
+     * \brief update all fvElementGeometries (do this again after grid adaption)
+     * \note After grid adaption, the scvs and scvfs of elements that have not been
+     *       refined or coarsened are reused and only the indices are updated.
+     */
     void update()
     {
         ParentType::update();
 
+        // keep the geometries of the last update to reuse them for unchanged elements
+        auto oldScvs = std::move(scvs_);
+        auto oldScvfs = std::move(scvfs_);
+        previousElementIndices_.resize();
+
         scvs_.clear();
         scvfs_.clear();
 
         auto numElements = this->gridView().size(0);
         scvs_.resize(numElements);
         scvfs_.resize(numElements);
-        hasBoundaryScvf_.resize(numElements, false);
+        hasBoundaryScvf_.assign(numElements, false);
 
         boundaryDofIndices_.assign(numDofs(), false);
 
@@ -171,6 +182,15 @@ public:
             // fill the element map with seeds
             auto eIdx = this->elementMapper().index(element);
 
+            // reuse the geometries of elements which did not change during grid adaption
+            // (periodic boundaries require the element geometry, so we recompute everything)
+            const auto oldEIdx = previousElementIndices_[element];
+            if (!this->isPeriodic() && oldEIdx != PreviousElementIndices<GV>::invalidIndex && oldEIdx < oldScvs.size())
+            {
+                reuseElementGeometry_(element, eIdx, std::move(oldScvs[oldEIdx]), std::move(oldScvfs[oldEIdx]));
+                continue;
+            }
+
             // count
             numScv_ += element.subEntities(dim);
             numScvf_ += element.subEntities(dim-1);
@@ -291,6 +311,9 @@ public:
                 }
             }
         }
+
+        // store the element indices to reuse the geometries after the next grid adaption
+        previousElementIndices_.store(this->gridView(), this->elementMapper());
     }
 
     //! The finite element cache for creating local FE bases
@@ -326,6 +349,34 @@ public:
     { return hasBoundaryScvf_[eIdx]; }
 
 private:
+    //! Reuse the scvs and scvfs of an element that did not change during grid adaption
+    void reuseElementGeometry_(const Element& element, GridIndexType eIdx,
+                               std::vector<SubControlVolume>&& oldScvs,
+                               std::vector<SubControlVolumeFace>&& oldScvfs)
+    {
+        // the scvs store the global element and dof indices which have to be updated
+        scvs_[eIdx].reserve(oldScvs.size());
+        for (const auto& oldScv : oldScvs)
+        {
+            const auto dofIdxGlobal = this->vertexMapper().subIndex(element, oldScv.localDofIndex(), dim);
+            scvs_[eIdx].emplace_back(oldScv, eIdx, dofIdxGlobal);
+        }
+
+        // the scvfs only store element-local indices
+        scvfs_[eIdx] = std::move(oldScvfs);
+
+        numScv_ += scvs_[eIdx].size();
+        numScvf_ += scvfs_[eIdx].size();
+        for (const auto& scvf : scvfs_[eIdx])
+        {
+            if (!scvf.boundary())
+                continue;
+
+            ++numBoundaryScvf_;
+            hasBoundaryScvf_[eIdx] = true;
+            boundaryDofIndices_[scvs_[eIdx][scvf.insideScvIdx()].dofIndex()] = true;
+        }
+    }
 
     const FeCache feCache_;
 
@@ -342,6 +393,9 @@ private:
 
     // a map for periodic boundary vertices
     std::unordered_map<GridIndexType, GridIndexType> periodicVertexMap_;
+
+    // the element indices of the last update to reuse data after grid adaption
+    PreviousElementIndices<GV> previousElementIndices_;
 };
 
 /*!
@@ -123,6 +123,19 @@ public:
         center_ /= corners_.size();
     }
 
+    /*!
+     * \brief Constructor copying the geometric data of another scv but using new global indices
+     *        (used to reuse scvs of unchanged elements after grid adaption)
+     */
+    BoxSubControlVolume(const BoxSubControlVolume& other,
+                        GridIndexType elementIndex,
+                        GridIndexType dofIndex)
+    : BoxSubControlVolume(other)
+    {
+        elementIndex_ = elementIndex;
+        dofIndex_ = dofIndex;
+    }
+
     //! The center of the sub control volume
     const GlobalPosition& center() const
     {
@@ -130,6 +130,16 @@ public:
     const std::vector<DataJ>& operator[] (const GridIndexType globalI) const
     { return map_[globalI]; }
 
+    //! Write the map to a grid geometry cache file
+    template<class CacheWriter>
+    void write(CacheWriter& writer) const
+    { writer.write(map_); }
+
+    //! Read the map from a grid geometry cache file
+    template<class CacheReader>
+    void read(CacheReader& reader)
+    { reader.read(map_); }
+
 private:
     Map map_;
 };
@@ -27,13 +27,22 @@
 #define DUMUX_DISCRETIZATION_CCTPFA_FV_GRID_GEOMETRY_HH
 
 #include <algorithm>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <dumux/common/indextraits.hh>
 #include <dumux/common/defaultmappertraits.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/typetraits/isvalid.hh>
 
 #include <dumux/discretization/method.hh>
 #include <dumux/discretization/basefvgridgeometry.hh>
 #include <dumux/discretization/checkoverlapsize.hh>
+#include <dumux/discretization/gridgeometrycache.hh>
+#include <dumux/discretization/previouselementindices.hh>
 #include <dumux/discretization/cellcentered/subcontrolvolume.hh>
 #include <dumux/discretization/cellcentered/connectivitymap.hh>
 #include <dumux/discretization/cellcentered/tpfa/fvelementgeometry.hh>
@@ -41,6 +50,20 @@
 
 namespace Dumux {
 
+#ifndef DOXYGEN
+namespace Detail {
+// helper struct detecting if a connectivity map can be stored in grid geometry cache files
+struct isCacheableConnectivityMap
+{
+    template<class ConnectivityMap>
+    auto operator()(ConnectivityMap&& map)
+    -> decltype(map.write(std::declval<GridGeometryCacheWriter&>()),
+                map.read(std::declval<GridGeometryCacheReader&>()))
+    {}
+};
+} // end namespace Detail
+#endif
+
 /*!
  * \ingroup CCTpfaDiscretization
  * \brief The default traits for the tpfa finite volume grid geometry
@@ -97,6 +120,9 @@ class CCTpfaFVGridGeometry<GV, true, Traits>
     static const int dim = GV::dimension;
     static const int dimWorld = GV::dimensionworld;
 
+    using CacheableScvfs = std::is_trivially_copyable<typename Traits::SubControlVolumeFace>;
+    using CacheableConnectivityMap = decltype(isValid(Detail::isCacheableConnectivityMap()).template check<ConnectivityMap>());
+
 public:
     //! export the type of the fv element geometry (the local view type)
     using LocalView = typename Traits::template LocalView<ThisType, true>;
@@ -119,6 +145,7 @@ public:
     //! Constructor
     CCTpfaFVGridGeometry(const GridView& gridView)
     : ParentType(gridView)
+    , previousElementIndices_(gridView.grid())
     {
         // Check if the overlap size is what we expect
         if (!CheckOverlapSize<DiscretizationMethod::cctpfa>::isValid(gridView))
@@ -153,11 +180,40 @@ public:
     std::size_t numDofs() const
     { return this->gridView().size(0); }
 
-    //! update all fvElementGeometries (do this again after grid adaption)
+    /*!
+     * \brief update all fvElementGeometries (do this again after grid adaption)
+     * \note After grid adaption, the geometric data of the scvfs of elements whose neighbors
+     *       did not change is reused and only the indices are updated (not for network grids).
+     * \note If the parameter Grid.GeometryCache is set, the data is read from a binary cache file
+     *       named after the parameter value and a hash of the grid view if it has been written by an
+     *       earlier update on the same grid (e.g. in an earlier run). Otherwise, the data is computed
+     *       and written to the cache file. In parallel runs, each process has its own cache file.
+     *       The parameter is ignored by the other grid geometries (e.g. the mpfa interaction volume
+     *       index sets and the box geometries are always computed).
+     */
     void update()
     {
         ParentType::update();
 
+        // use the data of an earlier update on the same grid if there is a cache file
+        const auto cachePrefix = getParam<std::string>("Grid.GeometryCache", "");
+        const bool useCache = !cachePrefix.empty();
+        std::uint64_t hash = 0;
+        if (useCache)
+        {
+            if (!CacheableScvfs::value)
+                DUNE_THROW(Dune::NotImplemented, "Grid geometry cache files for grids with dim < dimWorld");
+
+            hash = gridGeometryHash(this->gridView(), this->elementMapper(), this->vertexMapper());
+            if (readCache_(gridGeometryCacheFileName(cachePrefix, hash), hash, CacheableScvfs()))
+                return;
+        }
+
+        // keep the scvfs of the last update to reuse them for unchanged elements
+        auto oldScvfs = std::move(scvfs_);
+        auto oldScvfIndicesOfScv = std::move(scvfIndicesOfScv_);
+        previousElementIndices_.resize();
+
         // clear containers (necessary after grid refinement)
         scvs_.clear();
         scvfs_.clear();
@@ -174,11 +230,12 @@ public:
         scvs_.resize(numScvs);
         scvfs_.reserve(numScvf);
         scvfIndicesOfScv_.resize(numScvs);
-        hasBoundaryScvf_.resize(numScvs, false);
+        hasBoundaryScvf_.assign(numScvs, false);
 
         // Build the scvs and scv faces
         GridIndexType scvfIdx = 0;
         numBoundaryScvf_ = 0;
+        std::vector<GridIndexType> neighborIndices;
         for (const auto& element : elements(this->gridView()))
         {
             const auto eIdx = this->elementMapper().index(element);
@@ -188,9 +245,33 @@ public:
             std::vector<GridIndexType> scvfsIndexSet;
             scvfsIndexSet.reserve(element.subEntities(1));
 
+            using ScvfGridIndexStorage = typename SubControlVolumeFace::Traits::GridIndexStorage;
+
+            // reuse the scvfs of elements which did not change during grid adaption
+            if (dim == dimWorld && canReuseScvfs_(element, oldScvfs, oldScvfIndicesOfScv, neighborIndices))
+            {
+                const auto& oldScvfIndices = oldScvfIndicesOfScv[previousElementIndices_[element]];
+                for (std::size_t localScvfIdx = 0; localScvfIdx < oldScvfIndices.size(); ++localScvfIdx)
+                {
+                    const auto& oldScvf = oldScvfs[oldScvfIndices[localScvfIdx]];
+                    if (oldScvf.boundary())
+                    {
+                        const auto boundaryIdx = static_cast<GridIndexType>(this->gridView().size(0) + numBoundaryScvf_++);
+                        scvfs_.emplace_back(oldScvf, scvfIdx, ScvfGridIndexStorage({eIdx, boundaryIdx}));
+                        hasBoundaryScvf_[eIdx] = true;
+                    }
+                    else
+                        scvfs_.emplace_back(oldScvf, scvfIdx, ScvfGridIndexStorage({eIdx, neighborIndices[localScvfIdx]}));
+
+                    scvfsIndexSet.push_back(scvfIdx++);
+                }
+
+                scvfIndicesOfScv_[eIdx] = std::move(scvfsIndexSet);
+                continue;
+            }
+
             // for network grids there might be multiple intersection with the same geometryInInside
             // we indentify those by the indexInInside for now (assumes conforming grids at branching facets)
-            using ScvfGridIndexStorage = typename SubControlVolumeFace::Traits::GridIndexStorage;
             std::vector<ScvfGridIndexStorage> outsideIndices;
             if (dim < dimWorld)
             {
@@ -263,9 +344,12 @@ public:
             }
 
             // Save the scvf indices belonging to this scv to build up fv element geometries fast
-            scvfIndicesOfScv_[eIdx] = scvfsIndexSet;
+            scvfIndicesOfScv_[eIdx] = std::move(scvfsIndexSet);
         }
 
+        // store the element indices to reuse the scvfs after the next grid adaption
+        previousElementIndices_.store(this->gridView(), this->elementMapper());
+
         // Make the flip index set for network, surface, and periodic grids
         if (dim < dimWorld || this->isPeriodic())
         {
@@ -285,6 +369,9 @@ public:
 
         // build the connectivity map for an effecient assembly
         connectivityMap_.update(*this);
+
+        if (useCache)
+            writeCache_(gridGeometryCacheFileName(cachePrefix, hash), hash, CacheableScvfs());
     }
 
     //! Get a sub control volume with a global scv index
@@ -324,6 +411,136 @@ public:
     { return hasBoundaryScvf_[eIdx]; }
 
 private:
+    /*!
+     * \brief Checks if the scvfs of an element can be reused from the last update, i.e.
+     *        if the element and all of its neighbors existed before the grid adaption
+     *        and the faces are visited in the same order. On success, neighborIndices
+     *        contains the new index of the neighbor of each (inner) scvf.
+     */
+    bool canReuseScvfs_(const Element& element,
+                        const std::vector<SubControlVolumeFace>& oldScvfs,
+                        const std::vector<std::vector<GridIndexType>>& oldScvfIndicesOfScv,
+                        std::vector<GridIndexType>& neighborIndices) const
+    {
+        const auto oldEIdx = previousElementIndices_[element];
+        if (oldEIdx == PreviousElementIndices<GV>::invalidIndex || oldEIdx >= oldScvfIndicesOfScv.size())
+            return false;
+
+        const auto& oldScvfIndices = oldScvfIndicesOfScv[oldEIdx];
+        neighborIndices.clear();
+        for (const auto& intersection : intersections(this->gridView(), element))
+        {
+            if (!intersection.neighbor() && !intersection.boundary())
+                continue;
+
+            const auto localScvfIdx = neighborIndices.size();
+            if (localScvfIdx >= oldScvfIndices.size())
+                return false;
+
+            const auto& oldScvf = oldScvfs[oldScvfIndices[localScvfIdx]];
+            if (intersection.neighbor())
+            {
+                const auto outside = intersection.outside();
+                if (oldScvf.boundary() || oldScvf.outsideScvIdx() != previousElementIndices_[outside])
+                    return false;
+
+                neighborIndices.push_back(this->elementMapper().index(outside));
+            }
+            else
+            {
+                if (!oldScvf.boundary())
+                    return false;
+
+                neighborIndices.push_back(PreviousElementIndices<GV>::invalidIndex);
+            }
+        }
+
+        return neighborIndices.size() == oldScvfIndices.size();
+    }
+
+    /*!
+     * \brief Reads the data from the cache file if it has been written for this grid.
+     *        The scvs are built from the element geometries which are not cached.
+     * \return Whether the data has been read
+     */
+    bool readCache_(const std::string& fileName, std::uint64_t hash, std::true_type)
+    {
+        GridGeometryCacheReader cache(fileName, hash, cacheLayout_());
+        if (!cache.valid())
+            return false;
+
+        scvs_.clear();
+        scvs_.resize(numDofs());
+        for (const auto& element : elements(this->gridView()))
+        {
+            const auto eIdx = this->elementMapper().index(element);
+            scvs_[eIdx] = SubControlVolume(element.geometry(), eIdx);
+        }
+
+        std::uint8_t periodic;
+        std::uint64_t numBoundaryScvf;
+        cache.read(periodic);
+        cache.read(numBoundaryScvf);
+        cache.read(scvfs_);
+        cache.read(scvfIndicesOfScv_);
+        cache.read(flipScvfIndices_);
+
+        if (scvfIndicesOfScv_.size() != scvs_.size())
+            DUNE_THROW(Dune::IOError, "The grid geometry cache file " << fileName << " does not match the grid");
+
+        this->setPeriodic(periodic);
+        numBoundaryScvf_ = numBoundaryScvf;
+        hasBoundaryScvf_.assign(scvs_.size(), false);
+        for (const auto& scvf : scvfs_)
+            if (scvf.boundary())
+                hasBoundaryScvf_[scvf.insideScvIdx()] = true;
+
+        readConnectivityMap_(cache, CacheableConnectivityMap());
+
+        previousElementIndices_.store(this->gridView(), this->elementMapper());
+        return true;
+    }
+
+    //! Writes the data to the cache file
+    void writeCache_(const std::string& fileName, std::uint64_t hash, std::true_type) const
+    {
+        GridGeometryCacheWriter cache(fileName, hash, cacheLayout_());
+        cache.write(std::uint8_t(this->isPeriodic()));
+        cache.write(std::uint64_t(numBoundaryScvf_));
+        cache.write(scvfs_);
+        cache.write(scvfIndicesOfScv_);
+        cache.write(flipScvfIndices_);
+        writeConnectivityMap_(cache, CacheableConnectivityMap());
+        cache.close();
+    }
+
+    //! The layout of the cached types: the cache file is only used by grid geometries of the same type
+    static std::vector<std::uint64_t> cacheLayout_()
+    {
+        using ConnectivityMapData = typename std::decay_t<decltype(std::declval<const ConnectivityMap&>()[0])>::value_type;
+        return gridGeometryCacheLayout<ThisType, SubControlVolumeFace, GridIndexType, ConnectivityMapData>();
+    }
+
+    //! The scvfs of network and surface grids store their neighbors in dynamic containers and are not cached
+    bool readCache_(const std::string& fileName, std::uint64_t hash, std::false_type)
+    { return false; }
+
+    void writeCache_(const std::string& fileName, std::uint64_t hash, std::false_type) const
+    {}
+
+    void readConnectivityMap_(GridGeometryCacheReader& cache, std::true_type)
+    { connectivityMap_.read(cache); }
+
+    //! connectivity maps that cannot be cached are rebuilt from the cached scvfs
+    void readConnectivityMap_(GridGeometryCacheReader& cache, std::false_type)
+    { connectivityMap_.update(*this); }
+
+    void writeConnectivityMap_(GridGeometryCacheWriter& cache, std::true_type) const
+    { connectivityMap_.write(cache); }
+
+    void writeConnectivityMap_(GridGeometryCacheWriter& cache, std::false_type) const
+    {}
+
     // find the scvf that has insideScvIdx in its outsideScvIdx list and outsideScvIdx as its insideScvIdx
     GridIndexType findFlippedScvfIndex_(GridIndexType insideScvIdx, GridIndexType outsideScvIdx)
     {
@@ -351,6 +568,9 @@ private:
 
     //! needed for embedded surface and network grids (dim < dimWorld)
     std::vector<std::vector<GridIndexType>> flipScvfIndices_;
+
+    //! the element indices of the last update to reuse data after grid adaption
+    PreviousElementIndices<GV> previousElementIndices_;
 };
 
 /*!
@@ -136,6 +136,23 @@ public:
             corners_[i] = isGeometry.corner(i);
     }
 
+    /*!
+     * \brief Constructor copying the geometric data of another scv face but using new indices
+     *        (used to reuse scv faces of unchanged elements after grid adaption)
+     *
+     * \param other The scv face to copy the geometric data from
+     * \param scvfIndex The global index of this scv face
+     * \param scvIndices The inside/outside scv indices connected to this face
+     */
+    CCTpfaSubControlVolumeFace(const CCTpfaSubControlVolumeFace& other,
+                               GridIndexType scvfIndex,
+                               const GridIndexStorage& scvIndices)
+    : CCTpfaSubControlVolumeFace(other)
+    {
+        scvfIndex_ = scvfIndex;
+        scvIndices_ = scvIndices;
+    }
+
     //! The center of the sub control volume face
     const GlobalPosition& center() const
     {
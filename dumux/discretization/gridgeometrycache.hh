@@ -0,0 +1,340 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Discretization
+ * \brief Binary cache files for the data computed by finite volume grid geometries
+ */
+#ifndef DUMUX_DISCRETIZATION_GRID_GEOMETRY_CACHE_HH
+#define DUMUX_DISCRETIZATION_GRID_GEOMETRY_CACHE_HH
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Discretization
+ * \brief A hash identifying the geometry, topology and partitioning of a grid view
+ *
+ * Hashes the element and vertex indices and the corner coordinates of all elements
+ * in iteration order as well as the rank and size of the communicator. Grid geometries
+ * built on grid views with equal hashes are identical.
+ */
+template<class GridView, class ElementMapper, class VertexMapper>
+std::uint64_t gridGeometryHash(const GridView& gridView,
+                               const ElementMapper& elementMapper,
+                               const VertexMapper& vertexMapper)
+{
+    static constexpr int dim = GridView::dimension;
+
+    // 64-bit FNV-1a
+    std::uint64_t hash = 14695981039346656037ULL;
+    const auto hashValue = [&hash](const auto& value)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for (std::size_t i = 0; i < sizeof(value); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    hashValue(std::uint64_t(gridView.comm().rank()));
+    hashValue(std::uint64_t(gridView.comm().size()));
+    hashValue(std::uint64_t(gridView.size(0)));
+    hashValue(std::uint64_t(gridView.size(dim)));
+    for (const auto& element : elements(gridView))
+    {
+        hashValue(std::uint64_t(elementMapper.index(element)));
+        const auto geometry = element.geometry();
+        hashValue(std::uint64_t(geometry.corners()));
+        for (int i = 0; i < geometry.corners(); ++i)
+        {
+            hashValue(std::uint64_t(vertexMapper.subIndex(element, i, dim)));
+            const auto corner = geometry.corner(i);
+            for (const auto& coord : corner)
+                hashValue(coord);
+        }
+    }
+
+    return hash;
+}
+
+/*!
+ * \ingroup Discretization
+ * \brief The name of the cache file of a grid with the given hash
+ * \param prefix The file name prefix (may contain a directory)
+ * \param hash The hash of the grid (see gridGeometryHash)
+ */
+inline std::string gridGeometryCacheFileName(const std::string& prefix, std::uint64_t hash)
+{
+    std::ostringstream fileName;
+    fileName << prefix << "-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".ggc";
+    return fileName.str();
+}
+
+namespace Detail {
+
+//! the identifier at the beginning of all grid geometry cache files
+constexpr char gridGeometryCacheMagic[8] = {'D', 'U', 'M', 'U', 'X', 'G', 'G', 'C'};
+
+//! the version of the cache file format
+constexpr std::uint32_t gridGeometryCacheVersion = 2;
+
+//! 64-bit FNV-1a hash of a string
+inline std::uint64_t gridGeometryCacheStringHash(const char* str)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (; *str != '\0'; ++str)
+    {
+        hash ^= static_cast<unsigned char>(*str);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Discretization
+ * \brief The layout of the types stored in a cache file
+ *
+ * For each type, the size, the alignment and a hash of its (implementation-defined)
+ * type name are stored in the header of the cache file. Files written by a program in
+ * which one of the types has a different layout, e.g. because it has been compiled
+ * with other template arguments, another index type or another compiler, are rejected.
+ */
+template<class... Types>
+std::vector<std::uint64_t> gridGeometryCacheLayout()
+{
+    return { std::uint64_t(sizeof(Types))...,
+             std::uint64_t(alignof(Types))...,
+             Detail::gridGeometryCacheStringHash(typeid(Types).name())... };
+}
+
+/*!
+ * \ingroup Discretization
+ * \brief Writes the data of a grid geometry to a binary cache file
+ *
+ * Values and vectors of values are stored as raw bytes, so only trivially copyable
+ * types can be written. The data is written to a temporary file which is renamed on
+ * close() such that other processes never read incomplete cache files.
+ */
+class GridGeometryCacheWriter
+{
+public:
+    /*!
+     * \brief Open the cache file
+     * \param fileName The name of the cache file
+     * \param hash The hash of the grid the data belongs to
+     * \param layout The layout of the cached types (see gridGeometryCacheLayout)
+     */
+    GridGeometryCacheWriter(const std::string& fileName, std::uint64_t hash,
+                            const std::vector<std::uint64_t>& layout)
+    : fileName_(fileName)
+    , tmpFileName_(fileName + ".tmp")
+    , file_(tmpFileName_, std::ios::binary | std::ios::trunc)
+    {
+        if (!file_)
+            DUNE_THROW(Dune::IOError, "Could not open the grid geometry cache file " << tmpFileName_);
+
+        file_.write(Detail::gridGeometryCacheMagic, sizeof(Detail::gridGeometryCacheMagic));
+        write(Detail::gridGeometryCacheVersion);
+        write(hash);
+        write(layout);
+    }
+
+    //! Remove incomplete cache files
+    ~GridGeometryCacheWriter()
+    {
+        if (file_.is_open())
+        {
+            file_.close();
+            std::remove(tmpFileName_.c_str());
+        }
+    }
+
+    //! Write a value
+    template<class T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached");
+        file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    //! Write a vector of values
+    template<class T>
+    void write(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached");
+        write(std::uint64_t(values.size()));
+        file_.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(T));
+    }
+
+    //! Write a vector of vectors of values
+    template<class T>
+    void write(const std::vector<std::vector<T>>& values)
+    {
+        write(std::uint64_t(values.size()));
+        for (const auto& v : values)
+            write(v);
+    }
+
+    //! Finish writing and make the cache file available
+    void close()
+    {
+        file_.close();
+        if (!file_ || std::rename(tmpFileName_.c_str(), fileName_.c_str()) != 0)
+        {
+            std::remove(tmpFileName_.c_str());
+            DUNE_THROW(Dune::IOError, "Could not write the grid geometry cache file " << fileName_);
+        }
+    }
+
+private:
+    std::string fileName_;
+    std::string tmpFileName_;
+    std::ofstream file_;
+};
+
+/*!
+ * \ingroup Discretization
+ * \brief Reads the data of a grid geometry from a binary cache file
+ *
+ * The file is read into memory at once and the data is copied into the
+ * containers in the order it was written by the GridGeometryCacheWriter.
+ */
+class GridGeometryCacheReader
+{
+public:
+    /*!
+     * \brief Read the cache file
+     * \param fileName The name of the cache file
+     * \param hash The hash of the grid the data has to belong to
+     * \param layout The layout of the cached types (see gridGeometryCacheLayout)
+     * \note The reader is invalid if the file does not exist, does not belong to the grid
+     *       or has been written for types with another layout
+     */
+    GridGeometryCacheReader(const std::string& fileName, std::uint64_t hash,
+                            const std::vector<std::uint64_t>& layout)
+    : fileName_(fileName)
+    {
+        std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+        if (!file)
+            return;
+
+        buffer_.resize(file.tellg());
+        file.seekg(0);
+        file.read(buffer_.data(), buffer_.size());
+        if (!file)
+            return;
+
+        constexpr std::size_t headerSize = sizeof(Detail::gridGeometryCacheMagic) + sizeof(std::uint32_t) + 2*sizeof(std::uint64_t);
+        if (buffer_.size() < headerSize
+            || std::memcmp(buffer_.data(), Detail::gridGeometryCacheMagic, sizeof(Detail::gridGeometryCacheMagic)) != 0)
+            return;
+
+        pos_ = sizeof(Detail::gridGeometryCacheMagic);
+        std::uint32_t version; std::uint64_t fileHash;
+        read(version);
+        read(fileHash);
+        if (version != Detail::gridGeometryCacheVersion || fileHash != hash)
+            return;
+
+        std::uint64_t layoutSize;
+        read(layoutSize);
+        if (layoutSize != layout.size() || layoutSize > (buffer_.size() - pos_)/sizeof(std::uint64_t))
+            return;
+
+        std::vector<std::uint64_t> fileLayout(layoutSize);
+        readBytes_(fileLayout.data(), layoutSize*sizeof(std::uint64_t));
+        valid_ = fileLayout == layout;
+    }
+
+    //! Whether the file exists and contains the data of the grid
+    bool valid() const
+    { return valid_; }
+
+    //! Read a value
+    template<class T>
+    void read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached");
+        readBytes_(&value, sizeof(T));
+    }
+
+    //! Read a vector of values
+    template<class T>
+    void read(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached");
+        std::uint64_t size;
+        read(size);
+        if (size > (buffer_.size() - pos_)/sizeof(T))
+            DUNE_THROW(Dune::IOError, "The grid geometry cache file " << fileName_ << " is corrupt");
+
+        values.resize(size);
+        readBytes_(values.data(), size*sizeof(T));
+    }
+
+    //! Read a vector of vectors of values
+    template<class T>
+    void read(std::vector<std::vector<T>>& values)
+    {
+        std::uint64_t size;
+        read(size);
+        if (size > buffer_.size() - pos_)
+            DUNE_THROW(Dune::IOError, "The grid geometry cache file " << fileName_ << " is corrupt");
+
+        values.resize(size);
+        for (auto& v : values)
+            read(v);
+    }
+
+private:
+    void readBytes_(void* data, std::size_t size)
+    {
+        if (size > buffer_.size() - pos_)
+            DUNE_THROW(Dune::IOError, "The grid geometry cache file " << fileName_ << " is corrupt");
+
+        std::memcpy(data, buffer_.data() + pos_, size);
+        pos_ += size;
+    }
+
+    std::string fileName_;
+    std::vector<char> buffer_;
+    std::size_t pos_ = 0;
+    bool valid_ = false;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,89 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Discretization
+ * \brief Stores the element indices of the last grid geometry update
+ */
+#ifndef DUMUX_DISCRETIZATION_PREVIOUS_ELEMENT_INDICES_HH
+#define DUMUX_DISCRETIZATION_PREVIOUS_ELEMENT_INDICES_HH
+
+#include <limits>
+
+#include <dune/grid/utility/persistentcontainer.hh>
+
+#include <dumux/common/indextraits.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Discretization
+ * \brief Stores the element indices of the last grid geometry update such that
+ *        grid geometries can reuse the data of elements not changed by grid adaption.
+ *
+ * Elements created by the grid adaption (refined elements and fathers of
+ * coarsened elements) are assigned the invalid index.
+ *
+ * \tparam GridView the grid view type
+ */
+template<class GridView>
+class PreviousElementIndices
+{
+    using Grid = typename GridView::Grid;
+    using Element = typename GridView::template Codim<0>::Entity;
+    using GridIndexType = typename IndexTraits<GridView>::GridIndex;
+
+public:
+    //! the index of elements that did not exist at the last update
+    static constexpr GridIndexType invalidIndex = std::numeric_limits<GridIndexType>::max();
+
+    //! Constructor
+    explicit PreviousElementIndices(const Grid& grid)
+    : container_(grid, 0, invalidIndex)
+    {}
+
+    //! Resize the container after the grid has changed (new elements get the invalid index)
+    void resize()
+    { container_.resize(invalidIndex); }
+
+    //! The element index at the last call to store(), or invalidIndex for new elements
+    GridIndexType operator[] (const Element& element) const
+    { return container_[element]; }
+
+    //! Store the current element indices
+    template<class ElementMapper>
+    void store(const GridView& gridView, const ElementMapper& elementMapper)
+    {
+        container_.resize();
+        container_.shrinkToFit();
+        container_.fill(invalidIndex);
+        for (const auto& element : elements(gridView))
+            container_[element] = elementMapper.index(element);
+    }
+
+private:
+    Dune::PersistentContainer<Grid, GridIndexType> container_;
+};
+
+template<class GridView>
+constexpr typename PreviousElementIndices<GridView>::GridIndexType PreviousElementIndices<GridView>::invalidIndex;
+
+} // end namespace Dumux
+
+#endif
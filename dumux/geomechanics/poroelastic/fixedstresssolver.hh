@@ -0,0 +1,418 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Geomechanics
+ * \brief Sequential fixed-stress solver for porous medium flow problems
+ *        coupled to a poro-mechanical problem
+ */
+#ifndef DUMUX_POROMECHANICS_FIXED_STRESS_SOLVER_HH
+#define DUMUX_POROMECHANICS_FIXED_STRESS_SOLVER_HH
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/indices.hh>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/properties.hh>
+#include <dumux/common/timeloop.hh>
+#include <dumux/discretization/method.hh>
+
+namespace Dumux {
+namespace Detail {
+
+/*!
+ * \ingroup Geomechanics
+ * \brief A time loop representing a flow sub-step within a time step of the poro-mechanical problem
+ */
+template<class Scalar>
+class FixedStressSubTimeLoop : public TimeLoopBase<Scalar>
+{
+public:
+    //! set the time at the beginning of the sub-step and the sub-step size
+    void setTime(Scalar time, Scalar dt)
+    { time_ = time; dt_ = dt; }
+
+    Scalar time() const override
+    { return time_; }
+
+    Scalar timeStepSize() const override
+    { return dt_; }
+
+private:
+    Scalar time_ = 0.0;
+    Scalar dt_ = 0.0;
+};
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Geomechanics
+ * \brief Sequential solver for porous medium flow problems coupled to a poro-mechanical
+ *        problem using the fixed-stress splitting scheme.
+ *
+ * Instead of solving the monolithic system, the flow and the mechanics problem are solved
+ * alternately until the coupled residual is reduced below a tolerance. Only the diagonal
+ * blocks of the Jacobian are assembled and each sub-problem is solved with its own linear
+ * solver, e.g. AMG for the elasticity and a CPR-like solver for the flow problem.
+ * The flow problem is stabilized by the fixed-stress term
+ * \f[
+ *    \frac{\alpha^2}{K_\mathrm{dr}} \frac{\varrho \left( p^{k+1} - p^k \right)}{\Delta t},
+ *    \quad K_\mathrm{dr} = \lambda + \frac{2}{d} \mu,
+ * \f]
+ * where \f$ p^k \f$ is the pressure of the previous coupling iteration. The term vanishes
+ * upon convergence, such that the converged solution is the one of the monolithic scheme.
+ * The flow problem can be solved with several sub-steps per (quasi-static) mechanics step.
+ *
+ * The runtime parameters are read from the group "FixedStress":
+ * - MaxIterations: the maximum number of coupling iterations (default 50)
+ * - ResidualReduction: the required reduction of the coupled residual (default 1e-8)
+ * - StabilizationFactor: scaling of the fixed-stress term (default 1.0)
+ * - NumFlowSubSteps: the number of flow time steps per mechanics time step (default 1)
+ * - MaxNewtonSteps: the maximum number of Newton steps for each sub-problem (default 20)
+ * - NewtonResidualReduction: the residual reduction required for each sub-problem (default 1e-10)
+ * - Verbosity: the verbosity level (default 1)
+ *
+ * \note The spatial parameters of the poro-mechanical problem have to implement
+ *       lameParamsAtPos() and biotCoefficientAtPos(). The stabilization acts on the
+ *       first mass balance equation with respect to the pressure primary variable.
+ * \note This uses the two-norm of the process-local residuals.
+ *
+ * \tparam Assembler the multidomain assembler (shared with the monolithic scheme)
+ * \tparam FlowLinearSolver the linear solver for the flow problem
+ * \tparam PoroMechLinearSolver the linear solver for the poro-mechanical problem
+ * \tparam CouplingManager the poromechanics coupling manager
+ */
+template<class Assembler, class FlowLinearSolver, class PoroMechLinearSolver, class CouplingManager>
+class PoroMechanicsFixedStressSolver
+{
+    using Scalar = typename Assembler::Scalar;
+    using SolutionVector = typename Assembler::SolutionVector;
+    using TimeLoop = TimeLoopBase<Scalar>;
+    using SubTimeLoop = Detail::FixedStressSubTimeLoop<Scalar>;
+
+    static constexpr auto pmFlowId = CouplingManager::pmFlowId;
+    static constexpr auto poroMechId = CouplingManager::poroMechId;
+
+    using FlowTypeTag = typename Assembler::Traits::template SubDomain<pmFlowId>::TypeTag;
+    using FlowIndices = typename GetPropType<FlowTypeTag, Properties::ModelTraits>::Indices;
+    using FlowSolutionVector = std::decay_t<decltype(std::declval<SolutionVector>()[pmFlowId])>;
+    using FlowFVGridGeometry = typename Assembler::template FVGridGeometry<pmFlowId>;
+
+    static constexpr int dim = FlowFVGridGeometry::GridView::dimension;
+    static_assert(FlowFVGridGeometry::discMethod == DiscretizationMethod::cctpfa
+                  || FlowFVGridGeometry::discMethod == DiscretizationMethod::ccmpfa,
+                  "The fixed-stress solver requires a cell-centered scheme for the flow problem");
+
+public:
+    /*!
+     * \brief The constructor for stationary problems
+     */
+    PoroMechanicsFixedStressSolver(std::shared_ptr<Assembler> assembler,
+                                   std::shared_ptr<FlowLinearSolver> flowLinearSolver,
+                                   std::shared_ptr<PoroMechLinearSolver> poroMechLinearSolver,
+                                   std::shared_ptr<CouplingManager> couplingManager,
+                                   const std::string& paramGroup = "")
+    : PoroMechanicsFixedStressSolver(assembler, flowLinearSolver, poroMechLinearSolver,
+                                     couplingManager, nullptr, paramGroup)
+    {}
+
+    /*!
+     * \brief The constructor for instationary problems
+     * \note The time loop has to be the one the assembler has been constructed with.
+     */
+    PoroMechanicsFixedStressSolver(std::shared_ptr<Assembler> assembler,
+                                   std::shared_ptr<FlowLinearSolver> flowLinearSolver,
+                                   std::shared_ptr<PoroMechLinearSolver> poroMechLinearSolver,
+                                   std::shared_ptr<CouplingManager> couplingManager,
+                                   std::shared_ptr<const TimeLoop> timeLoop,
+                                   const std::string& paramGroup = "")
+    : assembler_(assembler)
+    , flowLinearSolver_(flowLinearSolver)
+    , poroMechLinearSolver_(poroMechLinearSolver)
+    , couplingManager_(couplingManager)
+    , timeLoop_(timeLoop)
+    , subTimeLoop_(std::make_shared<SubTimeLoop>())
+    {
+        maxIterations_ = getParamFromGroup<int>(paramGroup, "FixedStress.MaxIterations", 50);
+        residualReduction_ = getParamFromGroup<Scalar>(paramGroup, "FixedStress.ResidualReduction", 1e-8);
+        stabilizationFactor_ = getParamFromGroup<Scalar>(paramGroup, "FixedStress.StabilizationFactor", 1.0);
+        numFlowSubSteps_ = getParamFromGroup<int>(paramGroup, "FixedStress.NumFlowSubSteps", 1);
+        maxNewtonSteps_ = getParamFromGroup<int>(paramGroup, "FixedStress.MaxNewtonSteps", 20);
+        newtonResidualReduction_ = getParamFromGroup<Scalar>(paramGroup, "FixedStress.NewtonResidualReduction", 1e-10);
+        verbosity_ = getParamFromGroup<int>(paramGroup, "FixedStress.Verbosity", 1);
+
+        if (numFlowSubSteps_ < 1)
+            DUNE_THROW(ParameterException, "FixedStress.NumFlowSubSteps has to be positive");
+
+        verbose_ = verbosity_ > 0 && assembler_->gridView(pmFlowId).comm().rank() == 0;
+    }
+
+    /*!
+     * \brief Solve the coupled problem for the current time step
+     * \param x The solution vector, containing the initial guess on entry
+     * \throws NumericalProblem if the coupling iteration or a sub-problem did not converge
+     */
+    void solve(SolutionVector& x)
+    {
+        const bool isStationary = assembler_->isStationaryProblem();
+        if (!isStationary && !timeLoop_)
+            DUNE_THROW(Dune::InvalidStateException, "Solving instationary problem but no time loop was given!");
+
+        const int numFlowSubSteps = isStationary ? 1 : numFlowSubSteps_;
+        prevIterFlowSol_.assign(numFlowSubSteps, x[pmFlowId]);
+
+        Scalar flowResidualReference = 0.0;
+        Scalar poroMechResidualReference = 0.0;
+        for (int couplingIter = 0; couplingIter < maxIterations_; ++couplingIter)
+        {
+            couplingManager_->updateSolution(x);
+            if (!isStationary)
+                updateFixedStressWeights_(x);
+
+            // the initial residuals of the sub-problems are the residuals of the coupled system
+            const auto flowResidualNorm = solveFlow_(x, numFlowSubSteps);
+            const auto poroMechResidualNorm = solveSubDomain_(poroMechId, x, *poroMechLinearSolver_);
+
+            if (couplingIter == 0)
+            {
+                flowResidualReference = flowResidualNorm;
+                poroMechResidualReference = poroMechResidualNorm;
+            }
+
+            using std::max;
+            const Scalar reduction = max(relativeReduction_(flowResidualNorm, flowResidualReference),
+                                         relativeReduction_(poroMechResidualNorm, poroMechResidualReference));
+
+            if (verbose_)
+                std::cout << "Fixed-stress iteration " << couplingIter
+                          << ": flow residual " << flowResidualNorm
+                          << ", mechanics residual " << poroMechResidualNorm
+                          << ", reduction " << reduction << std::endl;
+
+            if (couplingIter > 0 && reduction <= residualReduction_)
+            {
+                couplingManager_->updateSolution(x);
+                numIterations_ = couplingIter + 1;
+                if (verbose_)
+                    std::cout << "Fixed-stress iteration converged after " << numIterations_ << " iterations" << std::endl;
+                return;
+            }
+        }
+
+        couplingManager_->updateSolution(x);
+        DUNE_THROW(NumericalProblem, "Fixed-stress iteration didn't converge after " << maxIterations_ << " iterations");
+    }
+
+    //! the number of coupling iterations of the last call to solve()
+    int numIterations() const
+    { return numIterations_; }
+
+    //! set the number of flow time steps per mechanics time step
+    void setNumFlowSubSteps(int numFlowSubSteps)
+    { numFlowSubSteps_ = numFlowSubSteps; }
+
+private:
+    //! the reduction of a residual norm with respect to the reference
+    Scalar relativeReduction_(Scalar norm, Scalar reference) const
+    { return reference > 0.0 ? norm/reference : 0.0; }
+
+    /*!
+     * \brief Solve the flow problem for the mechanics time step, possibly with sub-steps
+     * \return the maximum initial residual norm of all sub-steps
+     */
+    Scalar solveFlow_(SolutionVector& x, int numFlowSubSteps)
+    {
+        if (numFlowSubSteps == 1)
+        {
+            currentTimeStepSize_ = assembler_->isStationaryProblem() ? 0.0 : timeLoop_->timeStepSize();
+            const auto norm = solveSubDomain_(pmFlowId, x, *flowLinearSolver_, 0);
+            prevIterFlowSol_[0] = x[pmFlowId];
+            return norm;
+        }
+
+        // solve the flow sub-steps, the mechanics is kept fixed within the time step
+        const SolutionVector& prevSol = assembler_->prevSol();
+        subStepPrevSol_ = prevSol;
+        assembler_->setPreviousSolution(subStepPrevSol_);
+        assembler_->setTimeManager(subTimeLoop_);
+
+        currentTimeStepSize_ = timeLoop_->timeStepSize()/numFlowSubSteps;
+        Scalar maxNorm = 0.0;
+        try
+        {
+            for (int subStepIdx = 0; subStepIdx < numFlowSubSteps; ++subStepIdx)
+            {
+                subTimeLoop_->setTime(timeLoop_->time() + subStepIdx*currentTimeStepSize_, currentTimeStepSize_);
+                x[pmFlowId] = prevIterFlowSol_[subStepIdx];
+
+                using std::max;
+                maxNorm = max(maxNorm, solveSubDomain_(pmFlowId, x, *flowLinearSolver_, subStepIdx));
+
+                prevIterFlowSol_[subStepIdx] = x[pmFlowId];
+                subStepPrevSol_[pmFlowId] = x[pmFlowId];
+            }
+        }
+        catch (...)
+        {
+            assembler_->setPreviousSolution(prevSol);
+            assembler_->setTimeManager(timeLoop_);
+            throw;
+        }
+
+        assembler_->setPreviousSolution(prevSol);
+        assembler_->setTimeManager(timeLoop_);
+        return maxNorm;
+    }
+
+    /*!
+     * \brief Solve the (nonlinear) sub-problem with the coupling variables kept fixed
+     * \return the initial residual norm
+     */
+    template<std::size_t i, class LinearSolver>
+    Scalar solveSubDomain_(Dune::index_constant<i> domainId, SolutionVector& x,
+                           LinearSolver& linearSolver, int subStepIdx = 0)
+    {
+        auto deltaU = x[domainId];
+        Scalar initialResidualNorm = 0.0;
+        for (int newtonStep = 0; ; ++newtonStep)
+        {
+            couplingManager_->updateSolution(x);
+            assembler_->assembleJacobianAndResidual(domainId, x);
+            addFixedStressTerm_(domainId, x, subStepIdx);
+
+            auto& A = assembler_->jacobian()[domainId][domainId];
+            auto& r = assembler_->residual()[domainId];
+
+            const auto residualNorm = r.two_norm();
+            if (newtonStep == 0)
+                initialResidualNorm = residualNorm;
+            else if (residualNorm <= newtonResidualReduction_*initialResidualNorm)
+                break;
+
+            if (residualNorm == 0.0)
+                break;
+
+            if (newtonStep == maxNewtonSteps_)
+                DUNE_THROW(NumericalProblem, "Newton solver of sub-domain " << i << " didn't converge after "
+                                              << maxNewtonSteps_ << " iterations");
+
+            deltaU = 0.0;
+            if (!linearSolver.solve(A, deltaU, r))
+                DUNE_THROW(NumericalProblem, "Linear solver of sub-domain " << i << " didn't converge");
+
+            x[domainId] -= deltaU;
+            assembler_->gridVariables(domainId).update(x[domainId]);
+
+            if (verbosity_ > 1 && verbose_)
+                std::cout << "  sub-domain " << i << ", Newton step " << newtonStep
+                          << ": residual " << residualNorm << std::endl;
+        }
+
+        return initialResidualNorm;
+    }
+
+    //! The mechanics problem is not stabilized
+    template<std::size_t i, std::enable_if_t<(i != CouplingManager::pmFlowId), int> = 0>
+    void addFixedStressTerm_(Dune::index_constant<i> domainId, const SolutionVector& x, int subStepIdx)
+    {}
+
+    //! Add the fixed-stress term to the flow residual and the diagonal Jacobian block
+    template<std::size_t i, std::enable_if_t<(i == CouplingManager::pmFlowId), int> = 0>
+    void addFixedStressTerm_(Dune::index_constant<i> domainId, const SolutionVector& x, int subStepIdx)
+    {
+        if (assembler_->isStationaryProblem())
+            return;
+
+        static constexpr int pressureIdx = FlowIndices::pressureIdx;
+        static constexpr int conti0EqIdx = FlowIndices::conti0EqIdx;
+
+        auto& A = assembler_->jacobian()[domainId][domainId];
+        auto& r = assembler_->residual()[domainId];
+        const auto& prevIterSol = prevIterFlowSol_[subStepIdx];
+        for (std::size_t dofIdx = 0; dofIdx < r.size(); ++dofIdx)
+        {
+            const Scalar weight = fixedStressWeights_[dofIdx]/currentTimeStepSize_;
+            r[dofIdx][conti0EqIdx] += weight*(x[domainId][dofIdx][pressureIdx] - prevIterSol[dofIdx][pressureIdx]);
+            A[dofIdx][dofIdx][conti0EqIdx][pressureIdx] += weight;
+        }
+    }
+
+    //! Compute the fixed-stress weights alpha^2/K_dr*rho*V for the current iterate
+    void updateFixedStressWeights_(const SolutionVector& x)
+    {
+        const auto& fvGridGeometry = assembler_->fvGridGeometry(pmFlowId);
+        const auto& spatialParams = couplingManager_->template problem<poroMechId>().spatialParams();
+
+        fixedStressWeights_.resize(fvGridGeometry.numDofs());
+        auto fvGeometry = localView(fvGridGeometry);
+        auto elemVolVars = localView(assembler_->gridVariables(pmFlowId).curGridVolVars());
+        for (const auto& element : elements(fvGridGeometry.gridView()))
+        {
+            fvGeometry.bindElement(element);
+            elemVolVars.bindElement(element, fvGeometry, x[pmFlowId]);
+
+            const auto center = element.geometry().center();
+            const auto& lameParams = spatialParams.lameParamsAtPos(center);
+            const Scalar biotCoeff = spatialParams.biotCoefficientAtPos(center);
+            const Scalar drainedBulkModulus = lameParams.lambda() + 2.0/dim*lameParams.mu();
+            const Scalar beta = stabilizationFactor_*biotCoeff*biotCoeff/drainedBulkModulus;
+
+            for (const auto& scv : scvs(fvGeometry))
+            {
+                const auto& volVars = elemVolVars[scv];
+                fixedStressWeights_[scv.dofIndex()] = beta*volVars.density(0)*scv.volume()*volVars.extrusionFactor();
+            }
+        }
+    }
+
+    std::shared_ptr<Assembler> assembler_;
+    std::shared_ptr<FlowLinearSolver> flowLinearSolver_;
+    std::shared_ptr<PoroMechLinearSolver> poroMechLinearSolver_;
+    std::shared_ptr<CouplingManager> couplingManager_;
+    std::shared_ptr<const TimeLoop> timeLoop_;
+    std::shared_ptr<SubTimeLoop> subTimeLoop_;
+
+    std::vector<Scalar> fixedStressWeights_;
+    std::vector<FlowSolutionVector> prevIterFlowSol_;
+    SolutionVector subStepPrevSol_;
+    Scalar currentTimeStepSize_ = 0.0;
+
+    int maxIterations_;
+    Scalar residualReduction_;
+    Scalar stabilizationFactor_;
+    int numFlowSubSteps_;
+    int maxNewtonSteps_;
+    Scalar newtonResidualReduction_;
+    int verbosity_;
+    bool verbose_;
+    int numIterations_ = 0;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -77,6 +77,7 @@
 #include <dumux/discretization/method.hh>
 
 #include "griddata.hh"
+#include "parallelgmshreader.hh"
 
 namespace Dumux {
 
@@ -1021,6 +1022,8 @@ private:
  * - Refinement : the number of global refines to perform
  * - Verbosity : whether the grid construction should output to standard out
  * - BoundarySegments : whether to insert boundary segments into the grid
+ * - ParallelRead : whether all processes read a part of a gmsh file and insert a
+ *                  partition of the grid instead of rank 0 reading the whole file
  *
  */
 template<int dim, int dimworld, Dune::ALUGridElementType elType, Dune::ALUGridRefinementType refinementType>
@@ -1120,8 +1123,28 @@ public:
             if (domainMarkers)
                 ParentType::enableGmshDomainMarkers_ = true;
 
+            // every process reads a part of the file and inserts a partition of the grid
+            if (getParamFromGroup<bool>(modelParamGroup, "Grid.ParallelRead", false))
+            {
+                if (boundarySegments)
+                    DUNE_THROW(Dune::NotImplemented, "Parallel reading of Gmsh files with boundary segments");
+
+                ParallelGmshReader<Grid> reader(fileName, verbose);
+                auto gridFactory = std::make_unique<Dune::GridFactory<Grid>>();
+                reader.insertInto(*gridFactory);
+                ParentType::gridPtr() = std::shared_ptr<Grid>(gridFactory->createGrid());
+
+                if (domainMarkers)
+                {
+                    std::vector<int> boundaryMarkers, faceMarkers;
+                    reader.boundaryMarkers(*ParentType::gridPtr(), *gridFactory, boundaryMarkers, faceMarkers);
+                    ParentType::gridData_ = std::make_shared<typename ParentType::GridData>(ParentType::gridPtr(), std::move(gridFactory),
+                                                           reader.elementMarkers(), std::move(boundaryMarkers), std::move(faceMarkers));
+                }
+            }
+
             // only filll the factory for rank 0
-            if (domainMarkers)
+            else if (domainMarkers)
             {
                 std::vector<int> boundaryMarkersInsertionIndex, boundaryMarkers, faceMarkers, elementMarkers;
                 auto gridFactory = std::make_unique<Dune::GridFactory<Grid>>();
@@ -0,0 +1,797 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief A parallel reader for Gmsh mesh files creating a distributed coarse grid
+ */
+#ifndef DUMUX_IO_GRID_PARALLEL_GMSH_READER_HH
+#define DUMUX_IO_GRID_PARALLEL_GMSH_READER_HH
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#include <dune/common/parallel/mpitraits.hh>
+#endif
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/geometry/type.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/common/partitionset.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief Reads a Gmsh mesh file (ASCII format version 2) in parallel and
+ *        inserts a partition of the elements on each process into a grid factory.
+ *
+ * In contrast to Dune::GmshReader, no process reads or holds the complete mesh:
+ * - rank 0 scans the file once (without storing it) to determine the file offsets
+ *   of equally sized slices of the node and element lists,
+ * - every process reads its slice of the nodes and elements; node coordinates are
+ *   stored in a distributed directory (node id modulo the number of processes),
+ * - the elements are partitioned by sorting their centroids along a Morton space filling curve
+ *   (parallel sample sort) and sent to their target process together with their node coordinates,
+ * - every process inserts its vertices (with their Gmsh node ids as global ids) and elements
+ *   into the grid factory, which creates a distributed grid.
+ *
+ * The Gmsh physical entities of the elements and the boundary faces are carried along
+ * and are available as element markers (by insertion index) and, after the grid was created,
+ * as boundary segment and face markers.
+ *
+ * \note This requires a grid factory supporting the parallel insertion of a distributed
+ *       coarse grid with global vertex ids, e.g. the one of Dune::ALUGrid.
+ */
+template<class Grid>
+class ParallelGmshReader
+{
+    static constexpr int dim = Grid::dimension;
+    static constexpr int dimWorld = Grid::dimensionworld;
+    using GlobalPosition = Dune::FieldVector<typename Grid::ctype, dimWorld>;
+    using Coordinates = std::array<double, 3>;
+    using NodeIds = std::vector<std::int64_t>;
+
+    //! an element read from file
+    struct Element
+    {
+        int gmshType;
+        int marker;
+        NodeIds nodes;
+    };
+
+public:
+    /*!
+     * \brief Read the mesh file (collective)
+     * \param fileName the name of the Gmsh mesh file
+     * \param verbose if the output should be verbose
+     */
+    ParallelGmshReader(const std::string& fileName, bool verbose = false)
+    : fileName_(fileName)
+    , verbose_(verbose)
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+
+        // the sizes and the file offsets of the slices of the node and element lists
+        const auto sections = scanFile_();
+        const std::int64_t numNodes = sections[0];
+        const std::int64_t numElements = sections[1];
+        const auto nodeOffset = [&](int rank){ return sections[2 + rank]; };
+        const auto elementOffset = [&](int rank){ return sections[3 + comm.size() + rank]; };
+
+        if (verbose_ && comm.rank() == 0)
+            std::cout << "Reading " << numNodes << " nodes and " << numElements << " elements from "
+                      << fileName_ << " on " << comm.size() << " processes." << std::endl;
+
+        // read the slices of this process
+        std::vector<Element> elements, faces;
+        const auto directory = readNodes_(nodeOffset(comm.rank()), sliceSize_(numNodes, comm.rank()));
+        readElements_(elementOffset(comm.rank()), sliceSize_(numElements, comm.rank()), elements, faces);
+
+        // partition the elements and insert them
+        partitionElements_(std::move(elements), directory);
+        distributeBoundaryFaces_(std::move(faces));
+
+        if (verbose_)
+            std::cout << "Process " << comm.rank() << " received " << elements_.size() << " elements, "
+                      << vertexIds_.size() << " vertices and " << boundaryFaces_.size() << " boundary faces." << std::endl;
+    }
+
+    /*!
+     * \brief Insert the vertices and elements of this process into a grid factory
+     * \note The factory has to support the insertion of vertices with global ids.
+     */
+    void insertInto(Dune::GridFactory<Grid>& factory) const
+    {
+        for (std::size_t vIdx = 0; vIdx < vertexIds_.size(); ++vIdx)
+        {
+            GlobalPosition pos;
+            for (int i = 0; i < dimWorld; ++i)
+                pos[i] = vertexCoordinates_[vIdx][i];
+            factory.insertVertex(pos, static_cast<unsigned int>(vertexIds_[vIdx]));
+        }
+
+        std::vector<unsigned int> corners;
+        for (const auto& element : elements_)
+        {
+            const auto& renumbering = renumbering_(element.gmshType);
+            corners.resize(element.nodes.size());
+            for (std::size_t i = 0; i < corners.size(); ++i)
+                corners[i] = localVertexIndex_(element.nodes[renumbering[i]]);
+            factory.insertElement(geometryType_(element.gmshType), corners);
+        }
+    }
+
+    /*!
+     * \brief The Gmsh physical entities of the elements of this process by insertion index
+     */
+    std::vector<int> elementMarkers() const
+    {
+        std::vector<int> markers(elements_.size());
+        std::transform(elements_.begin(), elements_.end(), markers.begin(),
+                       [](const Element& e){ return e.marker; });
+        return markers;
+    }
+
+    /*!
+     * \brief The Gmsh physical entities of the boundary segments and faces of the created grid
+     * \param grid the grid created from the factory
+     * \param factory the factory the elements were inserted into with insertInto()
+     * \param boundaryMarkers the markers by boundary segment index
+     * \param faceMarkers the markers by face index of the leaf grid view
+     */
+    void boundaryMarkers(const Grid& grid, const Dune::GridFactory<Grid>& factory,
+                         std::vector<int>& boundaryMarkers, std::vector<int>& faceMarkers) const
+    {
+        const auto gridView = grid.leafGridView();
+        boundaryMarkers.assign(grid.numBoundarySegments(), 0);
+        faceMarkers.assign(gridView.size(1), 0);
+
+        NodeIds faceNodes;
+        for (const auto& element : elements(gridView, Dune::Partitions::interior))
+        {
+            const auto refElement = Dune::ReferenceElements<typename Grid::ctype, dim>::general(element.type());
+            for (const auto& intersection : intersections(gridView, element))
+            {
+                if (!intersection.boundary())
+                    continue;
+
+                const int faceIdx = intersection.indexInInside();
+                faceNodes.resize(refElement.size(faceIdx, 1, dim));
+                for (std::size_t i = 0; i < faceNodes.size(); ++i)
+                {
+                    const auto vertex = element.template subEntity<dim>(refElement.subEntity(faceIdx, 1, i, dim));
+                    faceNodes[i] = vertexIds_[factory.insertionIndex(vertex)];
+                }
+
+                std::sort(faceNodes.begin(), faceNodes.end());
+                const auto face = boundaryFaces_.find(faceNodes);
+                if (face == boundaryFaces_.end())
+                    continue;
+
+                const auto segmentIdx = intersection.boundarySegmentIndex();
+                if (segmentIdx >= boundaryMarkers.size())
+                    boundaryMarkers.resize(segmentIdx + 1, 0);
+                boundaryMarkers[segmentIdx] = face->second;
+                faceMarkers[gridView.indexSet().index(element.template subEntity<1>(faceIdx))] = face->second;
+            }
+        }
+    }
+
+private:
+    /*!
+     * \brief Determine the sizes of the node and element lists and the file offsets of the slices of all processes
+     * \note Only rank 0 reads the file, the result is broadcasted. The layout is
+     *       [numNodes, numElements, node slice offsets (size + 1), element slice offsets (size + 1)].
+     */
+    std::vector<std::int64_t> scanFile_() const
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+        std::vector<std::int64_t> sections(4 + 2*comm.size(), 0);
+
+        // errors on rank 0 are communicated via a negative number of nodes
+        std::string errorMessage;
+        if (comm.rank() == 0)
+        {
+            try { scanFileSequential_(sections, comm.size()); }
+            catch (std::exception& e)
+            {
+                errorMessage = e.what();
+                sections[0] = -1;
+            }
+        }
+
+        comm.broadcast(sections.data(), sections.size(), 0);
+        if (sections[0] < 0)
+            DUNE_THROW(Dune::IOError, "Couldn't read " << fileName_ << ": " << errorMessage);
+
+        return sections;
+    }
+
+    /*!
+     * \brief Throw on all processes if reading failed on any process (collective)
+     * \note Errors in a slice only occur on the processes reading it. They are caught there and
+     *       agreed on before the next exchange, such that no process waits for the failed ones.
+     */
+    void throwIfFailedOnAnyProcess_(bool failed, const std::string& errorMessage) const
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+        if (comm.max(int(failed)))
+            DUNE_THROW(Dune::IOError, "Couldn't read " << fileName_ << ": "
+                       << (failed ? errorMessage : "error on another process"));
+    }
+
+    void scanFileSequential_(std::vector<std::int64_t>& sections, int numSlices) const
+    {
+        std::ifstream file(fileName_);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Couldn't open " << fileName_);
+
+        std::string line;
+        std::int64_t offset = 0;
+        const auto nextLine = [&]()
+        {
+            if (!std::getline(file, line))
+                DUNE_THROW(Dune::IOError, "Unexpected end of file " << fileName_);
+            offset += line.size() + 1;
+        };
+
+        // the offsets of the first line of each slice of a list and the end of the list
+        const auto scanList = [&](std::int64_t size, std::int64_t* offsets)
+        {
+            for (int slice = 0; slice < numSlices; ++slice)
+            {
+                offsets[slice] = offset;
+                for (std::int64_t i = sliceSize_(size, slice, numSlices); i > 0; --i)
+                    nextLine();
+            }
+            offsets[numSlices] = offset;
+        };
+
+        bool foundNodes = false, foundElements = false;
+        while (std::getline(file, line))
+        {
+            offset += line.size() + 1;
+            if (line.compare(0, 11, "$MeshFormat") == 0)
+            {
+                nextLine();
+                double version; int fileType;
+                std::istringstream format(line);
+                if (!(format >> version >> fileType) || version < 2.0 || version >= 3.0 || fileType != 0)
+                    DUNE_THROW(Dune::NotImplemented, "Only ASCII Gmsh files of version 2 can be read in parallel");
+            }
+            else if (line.compare(0, 6, "$Nodes") == 0)
+            {
+                nextLine();
+                sections[0] = std::stoll(line);
+                scanList(sections[0], sections.data() + 2);
+                foundNodes = true;
+            }
+            else if (line.compare(0, 9, "$Elements") == 0)
+            {
+                nextLine();
+                sections[1] = std::stoll(line);
+                scanList(sections[1], sections.data() + 3 + numSlices);
+                foundElements = true;
+            }
+        }
+
+        if (!foundNodes || !foundElements)
+            DUNE_THROW(Dune::IOError, "No $Nodes or $Elements section in " << fileName_);
+    }
+
+    /*!
+     * \brief Read a slice of the node list and build the distributed node directory
+     * \return the coordinates of the nodes with id % size == rank
+     */
+    std::unordered_map<std::int64_t, Coordinates> readNodes_(std::int64_t offset, std::int64_t numNodes) const
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+        std::vector<std::vector<std::int64_t>> sendIds(comm.size());
+        std::vector<std::vector<double>> sendCoordinates(comm.size());
+
+        bool failed = false;
+        std::string errorMessage;
+        try
+        {
+            std::ifstream file(fileName_);
+            file.seekg(offset);
+            std::string line;
+            for (std::int64_t i = 0; i < numNodes; ++i)
+            {
+                if (!std::getline(file, line))
+                    DUNE_THROW(Dune::IOError, "Unexpected end of the node list in " << fileName_);
+
+                const char* pos = line.c_str();
+                char* end;
+                const std::int64_t id = std::strtoll(pos, &end, 10);
+                const auto owner = directoryOwner_(id);
+                sendIds[owner].push_back(id);
+                for (int j = 0; j < 3; ++j)
+                {
+                    pos = end;
+                    sendCoordinates[owner].push_back(std::strtod(pos, &end));
+                }
+            }
+        }
+        catch (std::exception& e)
+        {
+            failed = true;
+            errorMessage = e.what();
+        }
+
+        throwIfFailedOnAnyProcess_(failed, errorMessage);
+
+        const auto ids = exchange_(sendIds);
+        const auto coordinates = exchange_(sendCoordinates);
+
+        std::unordered_map<std::int64_t, Coordinates> directory;
+        for (int rank = 0; rank < comm.size(); ++rank)
+            for (std::size_t i = 0; i < ids[rank].size(); ++i)
+                directory[ids[rank][i]] = Coordinates{{ coordinates[rank][3*i], coordinates[rank][3*i+1], coordinates[rank][3*i+2] }};
+
+        return directory;
+    }
+
+    /*!
+     * \brief Read a slice of the element list
+     * \note Elements of the grid dimension are grid elements, elements of dimension
+     *       dim-1 are boundary faces, all other elements are ignored.
+     */
+    void readElements_(std::int64_t offset, std::int64_t numElements,
+                       std::vector<Element>& elements, std::vector<Element>& faces) const
+    {
+        bool failed = false;
+        std::string errorMessage;
+        try
+        {
+            std::ifstream file(fileName_);
+            file.seekg(offset);
+            std::string line;
+            for (std::int64_t i = 0; i < numElements; ++i)
+            {
+                if (!std::getline(file, line))
+                    DUNE_THROW(Dune::IOError, "Unexpected end of the element list in " << fileName_);
+
+                // id, type, number of tags, tags (physical entity first), node ids
+                const char* pos = line.c_str();
+                char* end;
+                std::strtoll(pos, &end, 10);
+                pos = end;
+                const int gmshType = std::strtol(pos, &end, 10);
+                pos = end;
+                const int numTags = std::strtol(pos, &end, 10);
+                int marker = 0;
+                for (int tag = 0; tag < numTags; ++tag)
+                {
+                    pos = end;
+                    const int value = std::strtol(pos, &end, 10);
+                    if (tag == 0)
+                        marker = value;
+                }
+
+                const int elementDim = dimension_(gmshType);
+                if (elementDim != dim && elementDim != dim - 1)
+                    continue;
+
+                Element element{gmshType, marker, NodeIds(numNodes_(gmshType))};
+                for (auto& node : element.nodes)
+                {
+                    pos = end;
+                    node = std::strtoll(pos, &end, 10);
+                }
+
+                if (elementDim == dim)
+                    elements.push_back(std::move(element));
+                else
+                    faces.push_back(std::move(element));
+            }
+        }
+        catch (std::exception& e)
+        {
+            failed = true;
+            errorMessage = e.what();
+        }
+
+        throwIfFailedOnAnyProcess_(failed, errorMessage);
+    }
+
+    /*!
+     * \brief Partition the elements along a Morton curve through their centroids and send them to their target processes
+     */
+    void partitionElements_(std::vector<Element>&& elements, const std::unordered_map<std::int64_t, Coordinates>& directory)
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+
+        // the coordinates of all nodes of the elements read by this process
+        const auto coordinates = lookUpCoordinates_(elements, directory);
+
+        // the bounding box of the mesh
+        std::array<double, 3> lower, upper;
+        lower.fill(std::numeric_limits<double>::max());
+        upper.fill(std::numeric_limits<double>::lowest());
+        for (const auto& c : coordinates)
+            for (int i = 0; i < 3; ++i)
+            {
+                lower[i] = std::min(lower[i], c.second[i]);
+                upper[i] = std::max(upper[i], c.second[i]);
+            }
+        comm.min(lower.data(), 3);
+        comm.max(upper.data(), 3);
+
+        // Morton keys of the element centroids
+        std::vector<std::uint64_t> keys(elements.size());
+        for (std::size_t eIdx = 0; eIdx < elements.size(); ++eIdx)
+        {
+            Coordinates centroid{{0.0, 0.0, 0.0}};
+            for (const auto node : elements[eIdx].nodes)
+                for (int i = 0; i < 3; ++i)
+                    centroid[i] += coordinates.at(node)[i]/elements[eIdx].nodes.size();
+            keys[eIdx] = mortonKey_(centroid, lower, upper);
+        }
+
+        // determine the splitters of the key ranges of the processes by weighted sampling:
+        // every process contributes one sample per process, representing a block of its sorted keys
+        const int size = comm.size();
+        std::vector<std::uint64_t> sortedKeys(keys);
+        std::sort(sortedKeys.begin(), sortedKeys.end());
+        std::vector<std::uint64_t> samples(size, std::numeric_limits<std::uint64_t>::max());
+        std::vector<std::int64_t> weights(size, 0);
+        for (int i = 0; i < size; ++i)
+        {
+            const std::size_t begin = i*sortedKeys.size()/size;
+            const std::size_t end = (i + 1)*sortedKeys.size()/size;
+            if (end > begin)
+            {
+                samples[i] = sortedKeys[begin];
+                weights[i] = end - begin;
+            }
+        }
+
+        std::vector<std::uint64_t> allSamples(size*size);
+        std::vector<std::int64_t> allWeights(size*size);
+        comm.allgather(samples.data(), size, allSamples.data());
+        comm.allgather(weights.data(), size, allWeights.data());
+
+        std::vector<std::size_t> order(allSamples.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){ return allSamples[a] < allSamples[b]; });
+
+        // the blocks starting at a splitter belong to the next process
+        const std::int64_t totalWeight = std::accumulate(allWeights.begin(), allWeights.end(), std::int64_t(0));
+        std::vector<std::uint64_t> splitters;
+        std::int64_t cumulativeWeight = 0;
+        for (const auto i : order)
+        {
+            while (int(splitters.size()) < size - 1 && cumulativeWeight >= std::int64_t(splitters.size() + 1)*totalWeight/size)
+                splitters.push_back(allSamples[i]);
+            cumulativeWeight += allWeights[i];
+        }
+        splitters.resize(size - 1, std::numeric_limits<std::uint64_t>::max());
+
+        // send the elements with the coordinates of their nodes to their target process
+        std::vector<std::vector<std::int64_t>> sendElements(size);
+        std::vector<std::vector<double>> sendCoordinates(size);
+        for (std::size_t eIdx = 0; eIdx < elements.size(); ++eIdx)
+        {
+            const auto& element = elements[eIdx];
+            const auto target = std::upper_bound(splitters.begin(), splitters.end(), keys[eIdx]) - splitters.begin();
+            sendElements[target].push_back(element.gmshType);
+            sendElements[target].push_back(element.marker);
+            for (const auto node : element.nodes)
+            {
+                sendElements[target].push_back(node);
+                const auto& c = coordinates.at(node);
+                sendCoordinates[target].insert(sendCoordinates[target].end(), c.begin(), c.end());
+            }
+        }
+        elements.clear();
+        elements.shrink_to_fit();
+
+        const auto receivedElements = exchange_(sendElements);
+        const auto receivedCoordinates = exchange_(sendCoordinates);
+
+        // unpack the elements and number the vertices of this process
+        std::unordered_map<std::int64_t, Coordinates> vertexCoordinates;
+        for (int rank = 0; rank < size; ++rank)
+        {
+            const auto& data = receivedElements[rank];
+            std::size_t nodeIdx = 0;
+            for (std::size_t pos = 0; pos < data.size(); )
+            {
+                Element element{static_cast<int>(data[pos]), static_cast<int>(data[pos+1]), NodeIds()};
+                element.nodes.assign(data.begin() + pos + 2, data.begin() + pos + 2 + numNodes_(element.gmshType));
+                pos += 2 + element.nodes.size();
+                for (const auto node : element.nodes)
+                {
+                    const auto* c = &receivedCoordinates[rank][3*nodeIdx++];
+                    vertexCoordinates.emplace(node, Coordinates{{c[0], c[1], c[2]}});
+                }
+                elements_.push_back(std::move(element));
+            }
+        }
+
+        vertexIds_.reserve(vertexCoordinates.size());
+        for (const auto& vertex : vertexCoordinates)
+            vertexIds_.push_back(vertex.first);
+        std::sort(vertexIds_.begin(), vertexIds_.end());
+
+        vertexCoordinates_.resize(vertexIds_.size());
+        for (std::size_t vIdx = 0; vIdx < vertexIds_.size(); ++vIdx)
+            vertexCoordinates_[vIdx] = vertexCoordinates[vertexIds_[vIdx]];
+    }
+
+    /*!
+     * \brief Get the coordinates of the nodes of the given elements from the node directory
+     */
+    std::unordered_map<std::int64_t, Coordinates>
+    lookUpCoordinates_(const std::vector<Element>& elements, const std::unordered_map<std::int64_t, Coordinates>& directory) const
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+
+        NodeIds nodes;
+        for (const auto& element : elements)
+            nodes.insert(nodes.end(), element.nodes.begin(), element.nodes.end());
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        std::vector<std::vector<std::int64_t>> requests(comm.size());
+        for (const auto node : nodes)
+            requests[directoryOwner_(node)].push_back(node);
+
+        const auto receivedRequests = exchange_(requests);
+        std::vector<std::vector<double>> replies(comm.size());
+        bool failed = false;
+        std::string errorMessage;
+        for (int rank = 0; rank < comm.size() && !failed; ++rank)
+            for (const auto node : receivedRequests[rank])
+            {
+                const auto c = directory.find(node);
+                if (c == directory.end())
+                {
+                    failed = true;
+                    errorMessage = "Node " + std::to_string(node) + " referenced by an element is missing";
+                    break;
+                }
+                replies[rank].insert(replies[rank].end(), c->second.begin(), c->second.end());
+            }
+
+        throwIfFailedOnAnyProcess_(failed, errorMessage);
+
+        const auto receivedReplies = exchange_(replies);
+        std::unordered_map<std::int64_t, Coordinates> coordinates;
+        for (int rank = 0; rank < comm.size(); ++rank)
+            for (std::size_t i = 0; i < requests[rank].size(); ++i)
+            {
+                const auto* c = &receivedReplies[rank][3*i];
+                coordinates.emplace(requests[rank][i], Coordinates{{c[0], c[1], c[2]}});
+            }
+
+        return coordinates;
+    }
+
+    /*!
+     * \brief Send the boundary faces to all processes with elements containing them
+     * \note The users of each node are registered in the node directory, a face is sent to the
+     *       directory of its smallest node id, which forwards it to the users of this node.
+     */
+    void distributeBoundaryFaces_(std::vector<Element>&& faces)
+    {
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+        const int size = comm.size();
+
+        // register this process as user of its vertices
+        std::vector<std::vector<std::int64_t>> registrations(size);
+        for (const auto vertexId : vertexIds_)
+            registrations[directoryOwner_(vertexId)].push_back(vertexId);
+
+        const auto receivedRegistrations = exchange_(registrations);
+        std::unordered_map<std::int64_t, std::vector<int>> nodeUsers;
+        for (int rank = 0; rank < size; ++rank)
+            for (const auto node : receivedRegistrations[rank])
+                nodeUsers[node].push_back(rank);
+
+        // send the faces (marker, number of nodes, sorted node ids) to the directory of the smallest node
+        std::vector<std::vector<std::int64_t>> sendFaces(size);
+        for (auto& face : faces)
+        {
+            std::sort(face.nodes.begin(), face.nodes.end());
+            auto& buffer = sendFaces[directoryOwner_(face.nodes.front())];
+            buffer.push_back(face.marker);
+            buffer.push_back(face.nodes.size());
+            buffer.insert(buffer.end(), face.nodes.begin(), face.nodes.end());
+        }
+        faces.clear();
+        faces.shrink_to_fit();
+
+        // forward them to the users of that node
+        const auto facesAtDirectory = exchange_(sendFaces);
+        std::vector<std::vector<std::int64_t>> forwardFaces(size);
+        for (const auto& data : facesAtDirectory)
+        {
+            for (std::size_t pos = 0; pos < data.size(); pos += 2 + data[pos+1])
+            {
+                const auto users = nodeUsers.find(data[pos+2]);
+                if (users == nodeUsers.end())
+                    continue;
+
+                for (const auto rank : users->second)
+                    forwardFaces[rank].insert(forwardFaces[rank].end(), data.begin() + pos, data.begin() + pos + 2 + data[pos+1]);
+            }
+        }
+
+        // keep the faces of which all nodes are vertices of this process
+        const auto receivedFaces = exchange_(forwardFaces);
+        for (const auto& data : receivedFaces)
+        {
+            for (std::size_t pos = 0; pos < data.size(); pos += 2 + data[pos+1])
+            {
+                NodeIds nodes(data.begin() + pos + 2, data.begin() + pos + 2 + data[pos+1]);
+                const bool isLocal = std::all_of(nodes.begin(), nodes.end(), [&](std::int64_t node)
+                                                 { return std::binary_search(vertexIds_.begin(), vertexIds_.end(), node); });
+                if (isLocal)
+                    boundaryFaces_.emplace(std::move(nodes), static_cast<int>(data[pos]));
+            }
+        }
+    }
+
+    //! the local index of the vertex with the given Gmsh node id
+    unsigned int localVertexIndex_(std::int64_t nodeId) const
+    { return std::lower_bound(vertexIds_.begin(), vertexIds_.end(), nodeId) - vertexIds_.begin(); }
+
+    //! the process storing the coordinates of a node in the distributed directory
+    static int directoryOwner_(std::int64_t nodeId)
+    { return nodeId % Dune::MPIHelper::getCollectiveCommunication().size(); }
+
+    //! the number of list entries read by a process
+    static std::int64_t sliceSize_(std::int64_t size, int rank, int numSlices = Dune::MPIHelper::getCollectiveCommunication().size())
+    { return (rank + 1)*size/numSlices - rank*size/numSlices; }
+
+    //! interleave the bits of the quantized coordinates (21 bits per direction)
+    static std::uint64_t mortonKey_(const Coordinates& x, const Coordinates& lower, const Coordinates& upper)
+    {
+        std::uint64_t key = 0;
+        std::array<std::uint64_t, 3> q;
+        for (int i = 0; i < 3; ++i)
+        {
+            const double extent = upper[i] - lower[i];
+            const double t = extent > 0.0 ? (x[i] - lower[i])/extent : 0.0;
+            q[i] = std::min<std::uint64_t>(static_cast<std::uint64_t>(t*(1 << 21)), (1 << 21) - 1);
+        }
+
+        for (int bit = 20; bit >= 0; --bit)
+            for (int i = 0; i < 3; ++i)
+                key = (key << 1) | ((q[i] >> bit) & 1);
+
+        return key;
+    }
+
+    /*!
+     * \brief Send a buffer to every process and receive the buffers sent to this process
+     * \param sendData the data to send to each rank
+     * \return the data received from each rank
+     */
+    template<class T>
+    static std::vector<std::vector<T>> exchange_(const std::vector<std::vector<T>>& sendData)
+    {
+#if HAVE_MPI
+        const int size = sendData.size();
+        if (size > 1)
+        {
+            const auto comm = Dune::MPIHelper::getCommunicator();
+            std::vector<int> sendCounts(size), recvCounts(size), sendOffsets(size, 0), recvOffsets(size, 0);
+            for (int rank = 0; rank < size; ++rank)
+                sendCounts[rank] = sendData[rank].size();
+            MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+
+            std::vector<T> sendBuffer, recvBuffer;
+            for (int rank = 0; rank < size; ++rank)
+            {
+                sendOffsets[rank] = sendBuffer.size();
+                sendBuffer.insert(sendBuffer.end(), sendData[rank].begin(), sendData[rank].end());
+                recvOffsets[rank] = rank > 0 ? recvOffsets[rank-1] + recvCounts[rank-1] : 0;
+            }
+            recvBuffer.resize(recvOffsets[size-1] + recvCounts[size-1]);
+
+            MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendOffsets.data(), Dune::MPITraits<T>::getType(),
+                          recvBuffer.data(), recvCounts.data(), recvOffsets.data(), Dune::MPITraits<T>::getType(), comm);
+
+            std::vector<std::vector<T>> recvData(size);
+            for (int rank = 0; rank < size; ++rank)
+                recvData[rank].assign(recvBuffer.begin() + recvOffsets[rank],
+                                      recvBuffer.begin() + recvOffsets[rank] + recvCounts[rank]);
+            return recvData;
+        }
+#endif
+        return sendData;
+    }
+
+    //! the dimension of a Gmsh element type
+    int dimension_(int gmshType) const
+    {
+        switch (gmshType)
+        {
+            case 15: return 0; // point
+            case 1: return 1; // line
+            case 2: case 3: return 2; // triangle, quadrilateral
+            case 4: case 5: case 6: case 7: return 3; // tetrahedron, hexahedron, prism, pyramid
+            default: DUNE_THROW(Dune::NotImplemented, "Gmsh element type " << gmshType << " in " << fileName_);
+        }
+    }
+
+    //! the number of nodes of a Gmsh element type
+    static std::size_t numNodes_(int gmshType)
+    {
+        static const std::map<int, std::size_t> numNodes = {{15, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 4}, {5, 8}, {6, 6}, {7, 5}};
+        return numNodes.at(gmshType);
+    }
+
+    //! the Dune geometry type of a Gmsh element type
+    static Dune::GeometryType geometryType_(int gmshType)
+    {
+        switch (gmshType)
+        {
+            case 1: return Dune::GeometryTypes::line;
+            case 2: return Dune::GeometryTypes::triangle;
+            case 3: return Dune::GeometryTypes::quadrilateral;
+            case 4: return Dune::GeometryTypes::tetrahedron;
+            case 5: return Dune::GeometryTypes::hexahedron;
+            case 6: return Dune::GeometryTypes::prism;
+            default: return Dune::GeometryTypes::pyramid;
+        }
+    }
+
+    //! the Gmsh node of each Dune element corner
+    static const std::vector<std::size_t>& renumbering_(int gmshType)
+    {
+        static const std::map<int, std::vector<std::size_t>> renumbering = {
+            {1, {0, 1}}, {2, {0, 1, 2}}, {3, {0, 1, 3, 2}}, {4, {0, 1, 2, 3}},
+            {5, {0, 1, 3, 2, 4, 5, 7, 6}}, {6, {0, 1, 2, 3, 4, 5}}, {7, {0, 1, 3, 2, 4}}
+        };
+        return renumbering.at(gmshType);
+    }
+
+    std::string fileName_;
+    bool verbose_;
+    std::vector<Element> elements_; //!< the elements of this process in insertion order
+    NodeIds vertexIds_; //!< the sorted Gmsh node ids of the vertices of this process
+    std::vector<Coordinates> vertexCoordinates_; //!< the vertex coordinates
+    std::map<NodeIds, int> boundaryFaces_; //!< the markers of the boundary faces by sorted node ids
+};
+
+} // end namespace Dumux
+
+#endif
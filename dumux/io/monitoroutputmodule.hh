@@ -0,0 +1,538 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief An output module sampling the solution in-situ at probes, along a line and in integrals
+ */
+#ifndef DUMUX_MONITOR_OUTPUT_MODULE_HH
+#define DUMUX_MONITOR_OUTPUT_MODULE_HH
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/grid/common/partitionset.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh>
+#include <dumux/common/geometry/intersectingentities.hh>
+#include <dumux/discretization/method.hh>
+#include <dumux/discretization/elementsolution.hh>
+#include <dumux/discretization/evalsolution.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief Samples the solution during the simulation and writes compact time series
+ *        instead of full VTK output that would have to be post-processed.
+ *
+ * Three kinds of reduced output are supported, each written to its own file by the first process:
+ * - point probes (name-probes.csv): the sampled quantities at given positions, one row per time step
+ * - a line sample (name-line.csv): the sampled quantities at equidistant points along a polyline,
+ *   one row per sample point and time step (with the arc length and the position)
+ * - integrals (name-integrals.csv): volume integrals (e.g. the mass in place) and boundary
+ *   integrals (e.g. the flux over the boundary), one row per time step
+ *
+ * The sampled quantities are primary variables (interpolated with evalSolution) and functions of
+ * the volume variables (constant per element for cell-centered schemes, interpolated linearly
+ * for the box scheme, i.e. like the VTK output). The probes and line samples are located once
+ * with the bounding box tree of the grid geometry (call update() if the grid changes) and are
+ * evaluated on the process owning the interior element containing them.
+ *
+ * The sampling is configured in the parameter file (group Monitor):
+ * - ProbePositions: the coordinates of all probes (dimWorld values per probe)
+ * - ProbeNames: the names of the probes (default: probe0, probe1, ...)
+ * - LinePoints: the coordinates of the corners of a polyline (dimWorld values per point)
+ * - LineSamples: the number of equidistant sample points along the polyline (default: 100)
+ * - Binary: write native doubles (after a header line with the column names) instead of text (default: false)
+ * Use different parameter groups for several monitors.
+ *
+ * \note Only cell-centered schemes and the box scheme are supported.
+ *
+ * \tparam GridVariables The grid variables
+ * \tparam SolutionVector The solution vector
+ */
+template<class GridVariables, class SolutionVector>
+class MonitorOutputModule
+{
+    using FVGridGeometry = typename GridVariables::GridGeometry;
+    using FVElementGeometry = typename FVGridGeometry::LocalView;
+    using SubControlVolumeFace = typename FVGridGeometry::SubControlVolumeFace;
+    using GridView = typename FVGridGeometry::GridView;
+    using Element = typename GridView::template Codim<0>::Entity;
+    using GlobalPosition = typename Element::Geometry::GlobalCoordinate;
+    using ElementVolumeVariables = typename GridVariables::GridVolumeVariables::LocalView;
+    using ElementFluxVariablesCache = typename GridVariables::GridFluxVariablesCache::LocalView;
+    using Scalar = typename GridVariables::Scalar;
+
+    enum { dimWorld = GridView::dimensionworld };
+
+    static constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+
+    //! a position where the quantities are sampled
+    struct Sample
+    {
+        GlobalPosition position;
+        std::size_t eIdx; //!< the element containing the position (if owned by this process)
+        bool isOwned;
+        bool isFound; //!< if the position is contained in any process's interior elements
+    };
+
+public:
+    //! export type of the volume variables for the sampled quantities
+    using VolumeVariables = typename GridVariables::VolumeVariables;
+
+    //! the function returning the flux over a boundary sub-control-volume face
+    using BoundaryFluxFunction = std::function<Scalar(const Element&, const FVElementGeometry&, const ElementVolumeVariables&,
+                                                      const ElementFluxVariablesCache&, const SubControlVolumeFace&)>;
+
+    MonitorOutputModule(const GridVariables& gridVariables,
+                        const SolutionVector& sol,
+                        const std::string& name,
+                        const std::string& paramGroup = "")
+    : gridVariables_(gridVariables)
+    , sol_(sol)
+    , name_(name)
+    , paramGroup_(paramGroup)
+    , binary_(getParamFromGroup<bool>(paramGroup, "Monitor.Binary", false))
+    {
+        // read the probes
+        if (hasParamInGroup(paramGroup, "Monitor.ProbePositions"))
+        {
+            const auto positions = readPositions_("Monitor.ProbePositions");
+            std::vector<std::string> names;
+            if (hasParamInGroup(paramGroup, "Monitor.ProbeNames"))
+                names = getParamFromGroup<std::vector<std::string>>(paramGroup, "Monitor.ProbeNames");
+            else
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                    names.push_back("probe" + std::to_string(i));
+
+            if (names.size() != positions.size())
+                DUNE_THROW(Dune::InvalidStateException, "Monitor.ProbeNames has to contain a name for each probe");
+
+            for (std::size_t i = 0; i < positions.size(); ++i)
+                addProbe(positions[i], names[i]);
+        }
+
+        // read the polyline
+        if (hasParamInGroup(paramGroup, "Monitor.LinePoints"))
+            setLine(readPositions_("Monitor.LinePoints"), getParamFromGroup<std::size_t>(paramGroup, "Monitor.LineSamples", 100));
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    //! Methods to add the sampled quantities and positions upon initialization
+    //! Do not call these methods after the first call to write()
+    //////////////////////////////////////////////////////////////////////////////////////////////
+
+    //! Sample a primary variable
+    void addPrimaryVariable(int pvIdx, const std::string& name)
+    { priVarInfo_.push_back(PriVarInfo{pvIdx, name}); }
+
+    //! Sample a scalar function of the volume variables
+    void addVolumeVariable(std::function<Scalar(const VolumeVariables&)>&& f, const std::string& name)
+    { volVarInfo_.push_back(VolVarInfo{f, name}); }
+
+    /*!
+     * \brief Integrate a function of the volume variables over the domain
+     * \param f A function returning the quantity per volume (e.g. the mass density of a phase in the pore space)
+     * \param name The name of the integral
+     */
+    void addVolumeIntegral(std::function<Scalar(const VolumeVariables&)>&& f, const std::string& name)
+    { volumeIntegralInfo_.push_back(VolVarInfo{f, name}); }
+
+    /*!
+     * \brief Sum up a flux over the boundary faces of the domain
+     * \param f A function returning the flux over a boundary sub-control-volume face
+     *          (return zero for the faces not to be considered)
+     * \param name The name of the integral
+     */
+    void addBoundaryIntegral(BoundaryFluxFunction&& f, const std::string& name)
+    { boundaryIntegralInfo_.push_back(BoundaryIntegralInfo{f, name}); }
+
+    //! Add a point probe (collective)
+    void addProbe(const GlobalPosition& position, const std::string& name)
+    {
+        probes_.push_back(locate_(position));
+        probeNames_.push_back(name);
+        warnIfNotFound_(probes_.back(), "Probe " + name);
+    }
+
+    //! Sample along a polyline at numSamples equidistant points (collective)
+    void setLine(const std::vector<GlobalPosition>& points, std::size_t numSamples)
+    {
+        if (points.size() < 2 || numSamples < 2)
+            DUNE_THROW(Dune::InvalidStateException, "A line sample needs at least two points and two samples");
+
+        // the cumulated arc length at the corners of the polyline
+        std::vector<Scalar> arcLength(1, 0.0);
+        for (std::size_t i = 1; i < points.size(); ++i)
+            arcLength.push_back(arcLength.back() + (points[i] - points[i-1]).two_norm());
+
+        line_.clear();
+        lineArcLength_.clear();
+        std::size_t segmentIdx = 0;
+        for (std::size_t i = 0; i < numSamples; ++i)
+        {
+            const Scalar s = arcLength.back()*i/(numSamples - 1);
+            while (segmentIdx + 2 < points.size() && s > arcLength[segmentIdx + 1])
+                ++segmentIdx;
+
+            const Scalar segmentLength = arcLength[segmentIdx + 1] - arcLength[segmentIdx];
+            const Scalar t = segmentLength > 0.0 ? (s - arcLength[segmentIdx])/segmentLength : 0.0;
+            auto position = points[segmentIdx];
+            position.axpy(t, points[segmentIdx + 1] - points[segmentIdx]);
+
+            line_.push_back(locate_(position));
+            lineArcLength_.push_back(s);
+            warnIfNotFound_(line_.back(), "Line sample " + std::to_string(i));
+        }
+    }
+
+    //! Locate the probes and line samples again, e.g. after the grid changed (collective)
+    void update()
+    {
+        for (auto& probe : probes_)
+            probe = locate_(probe.position);
+        for (auto& sample : line_)
+            sample = locate_(sample.position);
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    //! Accessing the sampled data
+    //////////////////////////////////////////////////////////////////////////////////////////////
+
+    //! The quantities sampled at the probes, ordered by probe and quantity (collective)
+    std::vector<double> probeValues() const
+    { return sample_(probes_); }
+
+    //! The quantities sampled along the line, ordered by sample point and quantity (collective)
+    std::vector<double> lineValues() const
+    { return sample_(line_); }
+
+    //! The volume integrals followed by the boundary integrals (collective)
+    std::vector<double> integralValues() const
+    { return integrate_(); }
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    //! Writing data
+    //////////////////////////////////////////////////////////////////////////////////////////////
+
+    //! Sample the quantities and append them to the time series (collective)
+    void write(double time)
+    {
+        DUMUX_PROFILE_REGION("monitor output");
+
+        if (!probes_.empty())
+        {
+            auto values = sample_(probes_);
+            if (comm_().rank() == 0)
+            {
+                std::vector<std::string> columns(1, "time");
+                for (const auto& probeName : probeNames_)
+                    for (const auto& quantityName : quantityNames_())
+                        columns.push_back(probeName + ":" + quantityName);
+
+                values.insert(values.begin(), time);
+                appendRows_(probesFile_, name_ + "-probes", columns, values);
+            }
+        }
+
+        if (!line_.empty())
+        {
+            const auto values = sample_(line_);
+            if (comm_().rank() == 0)
+            {
+                std::vector<std::string> columns = {"time", "arc length"};
+                for (int dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
+                    columns.push_back(std::string(1, "xyz"[dimIdx]));
+                const auto quantityNames = quantityNames_();
+                columns.insert(columns.end(), quantityNames.begin(), quantityNames.end());
+
+                // one row per sample point
+                const auto numQuantities = quantityNames.size();
+                std::vector<double> rows;
+                rows.reserve(line_.size()*columns.size());
+                for (std::size_t i = 0; i < line_.size(); ++i)
+                {
+                    rows.push_back(time);
+                    rows.push_back(lineArcLength_[i]);
+                    rows.insert(rows.end(), line_[i].position.begin(), line_[i].position.end());
+                    rows.insert(rows.end(), values.begin() + i*numQuantities, values.begin() + (i+1)*numQuantities);
+                }
+
+                appendRows_(lineFile_, name_ + "-line", columns, rows);
+            }
+        }
+
+        if (!volumeIntegralInfo_.empty() || !boundaryIntegralInfo_.empty())
+        {
+            auto values = integrate_();
+            if (comm_().rank() == 0)
+            {
+                std::vector<std::string> columns(1, "time");
+                for (const auto& info : volumeIntegralInfo_)
+                    columns.push_back(info.name);
+                for (const auto& info : boundaryIntegralInfo_)
+                    columns.push_back(info.name);
+
+                values.insert(values.begin(), time);
+                appendRows_(integralsFile_, name_ + "-integrals", columns, values);
+            }
+        }
+    }
+
+private:
+    struct PriVarInfo { int pvIdx; std::string name; };
+    struct VolVarInfo { std::function<Scalar(const VolumeVariables&)> get; std::string name; };
+    struct BoundaryIntegralInfo { BoundaryFluxFunction get; std::string name; };
+
+    const FVGridGeometry& fvGridGeometry_() const
+    { return gridVariables_.fvGridGeometry(); }
+
+    const auto& comm_() const
+    { return fvGridGeometry_().gridView().comm(); }
+
+    //! reads positions with dimWorld coordinates each from the parameter tree
+    std::vector<GlobalPosition> readPositions_(const std::string& param) const
+    {
+        const auto coordinates = getParamFromGroup<std::vector<Scalar>>(paramGroup_, param);
+        if (coordinates.size() % dimWorld != 0)
+            DUNE_THROW(Dune::InvalidStateException, "The number of coordinates in " << param << " has to be a multiple of " << int(dimWorld));
+
+        std::vector<GlobalPosition> positions(coordinates.size()/dimWorld);
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            for (int dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
+                positions[i][dimIdx] = coordinates[i*dimWorld + dimIdx];
+        return positions;
+    }
+
+    //! finds the interior element containing a position, the process with the lowest rank owns it (collective)
+    Sample locate_(const GlobalPosition& position) const
+    {
+        Sample sample{position, 0, false, false};
+        const auto& tree = fvGridGeometry_().boundingBoxTree();
+        for (const auto eIdx : intersectingEntities(position, tree))
+        {
+            if (tree.entitySet().entity(eIdx).partitionType() == Dune::InteriorEntity)
+            {
+                sample.eIdx = eIdx;
+                sample.isOwned = true;
+                break;
+            }
+        }
+
+        const int owner = comm_().min(sample.isOwned ? comm_().rank() : comm_().size());
+        sample.isOwned = owner == comm_().rank();
+        sample.isFound = owner < comm_().size();
+        return sample;
+    }
+
+    void warnIfNotFound_(const Sample& sample, const std::string& what) const
+    {
+        if (!sample.isFound && comm_().rank() == 0)
+            std::cout << "Warning: " << what << " at " << sample.position << " is outside of the domain and will be NaN" << std::endl;
+    }
+
+    //! the names of the sampled quantities
+    std::vector<std::string> quantityNames_() const
+    {
+        std::vector<std::string> names;
+        for (const auto& info : priVarInfo_)
+            names.push_back(info.name);
+        for (const auto& info : volVarInfo_)
+            names.push_back(info.name);
+        return names;
+    }
+
+    //! evaluates the quantities at the samples owned by this process and gathers them (collective)
+    std::vector<double> sample_(const std::vector<Sample>& samples) const
+    {
+        const auto numQuantities = priVarInfo_.size() + volVarInfo_.size();
+        std::vector<double> values(samples.size()*numQuantities, 0.0);
+
+        auto fvGeometry = localView(fvGridGeometry_());
+        auto elemVolVars = localView(gridVariables_.curGridVolVars());
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            if (!samples[i].isOwned)
+                continue;
+
+            const auto element = fvGridGeometry_().element(samples[i].eIdx);
+            const auto geometry = element.geometry();
+            auto value = values.begin() + i*numQuantities;
+
+            // the primary variables are interpolated with the basis functions of the discretization
+            if (!priVarInfo_.empty())
+            {
+                const auto elemSol = elementSolution(element, sol_, fvGridGeometry_());
+                const auto priVars = evalSolution(element, geometry, fvGridGeometry_(), elemSol, samples[i].position);
+                for (const auto& info : priVarInfo_)
+                    *value++ = priVars[info.pvIdx];
+            }
+
+            if (!volVarInfo_.empty())
+            {
+                fvGeometry.bindElement(element);
+                elemVolVars.bindElement(element, fvGeometry, sol_);
+                for (const auto& info : volVarInfo_)
+                    *value++ = evalVolVars_(info.get, geometry, fvGeometry, elemVolVars, samples[i].position,
+                                            std::integral_constant<bool, isBox>());
+            }
+        }
+
+        // each sample is owned by a single process
+        comm_().sum(values.data(), values.size());
+
+        for (std::size_t i = 0; i < samples.size(); ++i)
+            if (!samples[i].isFound)
+                std::fill(values.begin() + i*numQuantities, values.begin() + (i+1)*numQuantities,
+                          std::numeric_limits<double>::quiet_NaN());
+
+        return values;
+    }
+
+    //! cell-centered schemes: the volume variables are constant per element
+    template<class Function, class Geometry>
+    Scalar evalVolVars_(const Function& f, const Geometry& geometry, const FVElementGeometry& fvGeometry,
+                        const ElementVolumeVariables& elemVolVars, const GlobalPosition& position, std::false_type) const
+    {
+        for (auto&& scv : scvs(fvGeometry))
+            return f(elemVolVars[scv]);
+        return 0.0;
+    }
+
+    //! box scheme: the quantity is interpolated linearly between the element's vertices
+    template<class Function, class Geometry>
+    Scalar evalVolVars_(const Function& f, const Geometry& geometry, const FVElementGeometry& fvGeometry,
+                        const ElementVolumeVariables& elemVolVars, const GlobalPosition& position, std::true_type) const
+    {
+        const auto& localBasis = fvGridGeometry_().feCache().get(geometry.type()).localBasis();
+        std::vector<Dune::FieldVector<Scalar, 1>> shapeValues;
+        localBasis.evaluateFunction(geometry.local(position), shapeValues);
+
+        Scalar result = 0.0;
+        for (auto&& scv : scvs(fvGeometry))
+            result += shapeValues[scv.localDofIndex()][0]*f(elemVolVars[scv]);
+        return result;
+    }
+
+    //! computes the volume and boundary integrals (collective)
+    std::vector<double> integrate_() const
+    {
+        std::vector<double> values(volumeIntegralInfo_.size() + boundaryIntegralInfo_.size(), 0.0);
+        const auto boundaryOffset = volumeIntegralInfo_.size();
+
+        auto fvGeometry = localView(fvGridGeometry_());
+        auto elemVolVars = localView(gridVariables_.curGridVolVars());
+        auto elemFluxVarsCache = localView(gridVariables_.gridFluxVarsCache());
+        for (const auto& element : elements(fvGridGeometry_().gridView(), Dune::Partitions::interior))
+        {
+            // the fluxes over the boundary require the whole stencil
+            if (!boundaryIntegralInfo_.empty() && element.hasBoundaryIntersections())
+            {
+                fvGeometry.bind(element);
+                elemVolVars.bind(element, fvGeometry, sol_);
+                elemFluxVarsCache.bind(element, fvGeometry, elemVolVars);
+
+                for (auto&& scvf : scvfs(fvGeometry))
+                    if (scvf.boundary())
+                        for (std::size_t i = 0; i < boundaryIntegralInfo_.size(); ++i)
+                            values[boundaryOffset + i] += boundaryIntegralInfo_[i].get(element, fvGeometry, elemVolVars, elemFluxVarsCache, scvf);
+            }
+            else if (!volumeIntegralInfo_.empty())
+            {
+                fvGeometry.bindElement(element);
+                elemVolVars.bindElement(element, fvGeometry, sol_);
+            }
+            else
+                continue;
+
+            for (auto&& scv : scvs(fvGeometry))
+            {
+                const auto& volVars = elemVolVars[scv];
+                for (std::size_t i = 0; i < volumeIntegralInfo_.size(); ++i)
+                    values[i] += volumeIntegralInfo_[i].get(volVars)*scv.volume()*volVars.extrusionFactor();
+            }
+        }
+
+        comm_().sum(values.data(), values.size());
+        return values;
+    }
+
+    //! appends rows of values to a time series file (created with a header on the first call)
+    void appendRows_(std::ofstream& file, const std::string& baseName,
+                     const std::vector<std::string>& columns, const std::vector<double>& values)
+    {
+        if (!file.is_open())
+        {
+            const auto fileName = baseName + (binary_ ? ".bin" : ".csv");
+            file.open(fileName, binary_ ? std::ios::out | std::ios::binary : std::ios::out);
+            if (!file)
+                DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+
+            for (std::size_t i = 0; i < columns.size(); ++i)
+                file << (i > 0 ? "," : "") << columns[i];
+            file << '\n';
+            file << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+        }
+
+        if (binary_)
+            file.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(double));
+        else
+        {
+            for (std::size_t i = 0; i < values.size(); ++i)
+                file << values[i] << ((i + 1) % columns.size() == 0 ? '\n' : ',');
+        }
+
+        // keep the time series readable while the simulation is running
+        file.flush();
+    }
+
+    const GridVariables& gridVariables_;
+    const SolutionVector& sol_;
+    std::string name_;
+    std::string paramGroup_;
+    bool binary_;
+
+    std::vector<PriVarInfo> priVarInfo_;
+    std::vector<VolVarInfo> volVarInfo_;
+    std::vector<VolVarInfo> volumeIntegralInfo_;
+    std::vector<BoundaryIntegralInfo> boundaryIntegralInfo_;
+
+    std::vector<Sample> probes_;
+    std::vector<std::string> probeNames_;
+    std::vector<Sample> line_;
+    std::vector<Scalar> lineArcLength_;
+
+    std::ofstream probesFile_, lineFile_, integralsFile_;
+};
+
+} // end namespace Dumux
+
+#endif
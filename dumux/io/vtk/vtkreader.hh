@@ -24,25 +24,168 @@
 #ifndef DUMUX_IO_VTK_VTKREADER_HH
 #define DUMUX_IO_VTK_VTKREADER_HH
 
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/exceptions.hh>
+#include <dune/common/unused.hh>
 #include <dune/grid/common/capabilities.hh>
 #include <dune/grid/io/file/vtk/common.hh>
 #include <dumux/io/xml/tinyxml2.h>
 #include <dune/grid/common/gridfactory.hh>
 
 namespace Dumux {
+namespace Detail {
+
+/*!
+ * \ingroup InputOutput
+ * \brief Reads the bytes of raw appended vtk data from a stream
+ */
+class VTKRawDataReader
+{
+public:
+    explicit VTKRawDataReader(std::istream& stream)
+    : stream_(stream)
+    {}
+
+    //! read the next numBytes bytes
+    void read(char* data, std::size_t numBytes)
+    {
+        stream_.read(data, numBytes);
+        if (static_cast<std::size_t>(stream_.gcount()) != numBytes)
+            DUNE_THROW(Dune::IOError, "Unexpected end of appended raw data.");
+    }
+
+private:
+    std::istream& stream_;
+};
+
+//! Character source for base64 encoded text in memory
+struct VTKMemoryCharSource
+{
+    const char* pos;
+    const char* end;
+
+    int get()
+    { return pos != end ? static_cast<unsigned char>(*pos++) : EOF; }
+};
+
+//! Character source for base64 encoded text in a stream buffer
+struct VTKStreamCharSource
+{
+    std::streambuf& buffer;
+
+    int get()
+    { return buffer.sbumpc(); }
+};
+
+/*!
+ * \ingroup InputOutput
+ * \brief Decodes the bytes of base64 encoded vtk data on the fly
+ * \note Whitespace is skipped and padding may occur after every group of four characters,
+ *       so data headers and data encoded separately or together are both decoded correctly.
+ */
+template<class CharSource>
+class VTKBase64DataReader
+{
+public:
+    explicit VTKBase64DataReader(CharSource source)
+    : source_(source)
+    {}
+
+    //! read the next numBytes decoded bytes
+    void read(char* data, std::size_t numBytes)
+    {
+        while (numBytes > 0)
+        {
+            if (pos_ == size_)
+                decodeGroup_();
+
+            const std::size_t n = std::min(numBytes, size_ - pos_);
+            std::copy_n(buffer_ + pos_, n, data);
+            pos_ += n;
+            data += n;
+            numBytes -= n;
+        }
+    }
+
+private:
+    // decode the next four characters into up to three bytes
+    void decodeGroup_()
+    {
+        std::uint32_t bits = 0;
+        std::size_t numPadding = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            int c = source_.get();
+            while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+                c = source_.get();
+
+            if (c == EOF)
+                DUNE_THROW(Dune::IOError, "Unexpected end of base64 encoded data.");
+
+            if (c == '=')
+                ++numPadding;
+            else if (numPadding > 0)
+                DUNE_THROW(Dune::IOError, "Invalid padding in base64 encoded data.");
+
+            bits = (bits << 6) | (c == '=' ? 0 : decodeChar_(c));
+        }
+
+        if (numPadding > 2)
+            DUNE_THROW(Dune::IOError, "Invalid padding in base64 encoded data.");
+
+        buffer_[0] = static_cast<char>((bits >> 16) & 0xff);
+        buffer_[1] = static_cast<char>((bits >> 8) & 0xff);
+        buffer_[2] = static_cast<char>(bits & 0xff);
+        size_ = 3 - numPadding;
+        pos_ = 0;
+    }
+
+    static std::uint32_t decodeChar_(int c)
+    {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        DUNE_THROW(Dune::IOError, "Invalid character " << c << " in base64 encoded data.");
+    }
+
+    CharSource source_;
+    char buffer_[3];
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+};
+
+} // end namespace Detail
 
 /*!
  * \ingroup InputOutput
  * \brief A vtk file reader using tinyxml2 as xml backend
+ *
+ * Data arrays may be stored in ascii, inline base64 binary or appended (raw or base64) format,
+ * optionally compressed with zlib (requires zlib to be found), as written e.g. by Dune::VTKWriter
+ * and ParaView. For files with appended data only the xml structure in front of the appended data
+ * is loaded into memory, the data arrays are read from the file on demand. For parallel files
+ * (.pvtu, .pvtp), every process reads the piece corresponding to its rank. Sequential files
+ * can only be read by sequential programs.
  */
 class VTKReader
 {
@@ -57,15 +200,19 @@ public:
 
     /*!
      * \brief The contructor creates a tinyxml2::XMLDocument from file
+     * \note In parallel runs, only parallel files (.pvtu, .pvtp) can be read, as the data
+     *       of a sequential file would be interpreted as the data of every process.
      */
     explicit VTKReader(const std::string& fileName)
     {
-        fileName_ = Dune::MPIHelper::getCollectiveCommunication().size() > 1 ?
-                        getProcessFileName_(fileName) : fileName;
-
-        const auto eResult = doc_.LoadFile(fileName_.c_str());
-        if (eResult != tinyxml2::XML_SUCCESS)
-            DUNE_THROW(Dune::IOError, "Couldn't open XML file " << fileName_ << ".");
+        loadFile_(fileName);
+
+        // for parallel files, every process reads the piece with its rank
+        if (isParallelFile_())
+            loadFile_(getProcessFileName_(fileName));
+        else if (Dune::MPIHelper::getCollectiveCommunication().size() > 1)
+            DUNE_THROW(Dune::IOError, "Sequential vtk file " << fileName << " can't be read in parallel, "
+                                      << "use a parallel file (.pvtu, .pvtp) with one piece per process.");
     }
 
     /*!
@@ -136,36 +283,145 @@ public:
 
 private:
     /*!
-     * \brief get the vtk filename for the current processor
+     * \brief Load the xml structure of a vtk file
+     * \note If the file contains appended data, only the part in front of it is parsed
+     *       and the position of the appended data in the file is stored.
      */
-    std::string getProcessFileName_(const std::string& pvtkFileName)
+    void loadFile_(const std::string& fileName)
     {
         using namespace tinyxml2;
 
-        XMLDocument pDoc;
-        const auto eResult = pDoc.LoadFile(pvtkFileName.c_str());
-        if (eResult != XML_SUCCESS)
-            DUNE_THROW(Dune::IOError, "Couldn't open XML file " << pvtkFileName << ".");
+        fileName_ = fileName;
+        appendedDataOffset_ = -1;
+
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Couldn't open XML file " << fileName << ".");
+
+        const std::streamoff appendedDataTagPos = findAppendedDataTag_(file);
+        if (appendedDataTagPos < 0)
+        {
+            const auto eResult = doc_.LoadFile(fileName.c_str());
+            if (eResult != XML_SUCCESS)
+                DUNE_THROW(Dune::IOError, "Couldn't open XML file " << fileName << ".");
+        }
+        else
+        {
+            // the appended data starts after the first underscore following the tag
+            file.clear();
+            file.seekg(appendedDataTagPos);
+            std::string appendedDataTag;
+            std::getline(file, appendedDataTag, '_');
+            const auto tagEnd = appendedDataTag.find('>');
+            if (!file || tagEnd == std::string::npos)
+                DUNE_THROW(Dune::IOError, "Couldn't find the beginning of the appended data in " << fileName << ".");
+            appendedDataOffset_ = file.tellg();
+
+            // parse the xml structure in front of the appended data only and close the open elements
+            std::string xml(static_cast<std::size_t>(appendedDataTagPos), '\0');
+            file.seekg(0);
+            file.read(&xml[0], appendedDataTagPos);
+            xml.append(appendedDataTag, 0, tagEnd + 1);
+            xml += "</AppendedData></VTKFile>";
+
+            const auto eResult = doc_.Parse(xml.c_str(), xml.size());
+            if (eResult != XML_SUCCESS)
+                DUNE_THROW(Dune::IOError, "Couldn't parse XML file " << fileName << ".");
+
+            const XMLElement* appendedData = doc_.FirstChildElement("VTKFile")->FirstChildElement("AppendedData");
+            const char* encoding = appendedData->Attribute("encoding");
+            if (encoding == nullptr || (std::string(encoding) != "raw" && std::string(encoding) != "base64"))
+                DUNE_THROW(Dune::IOError, "Unknown encoding of the appended data in " << fileName << ".");
+            appendedDataIsBase64_ = std::string(encoding) == "base64";
+        }
+
+        const XMLElement* vtkFile = doc_.FirstChildElement("VTKFile");
+        if (vtkFile == nullptr)
+            DUNE_THROW(Dune::IOError, "Couldn't get 'VTKFile' node in " << fileName << ".");
+
+        const char* headerType = vtkFile->Attribute("header_type");
+        headerSize_ = headerType != nullptr && std::string(headerType) == "UInt64" ? 8 : 4;
+
+        const char* byteOrder = vtkFile->Attribute("byte_order");
+        const std::uint16_t one = 1;
+        const bool littleEndianMachine = *reinterpret_cast<const unsigned char*>(&one) == 1;
+        swapBytes_ = byteOrder != nullptr && (std::string(byteOrder) == "BigEndian") == littleEndianMachine;
+
+        const char* compressor = vtkFile->Attribute("compressor");
+        compressed_ = compressor != nullptr;
+        if (compressed_ && std::string(compressor) != "vtkZLibDataCompressor")
+            DUNE_THROW(Dune::NotImplemented, "Compressor " << compressor << " used in " << fileName << ".");
+    }
+
+    /*!
+     * \brief Find the position of the AppendedData tag in a file
+     * \note Returns -1 if the file doesn't contain appended data
+     */
+    static std::streamoff findAppendedDataTag_(std::istream& file)
+    {
+        const std::string tag = "<AppendedData";
+        std::vector<char> chunk(1 << 16);
+        std::string window;
+        std::streamoff windowBegin = 0;
+        while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0)
+        {
+            window.append(chunk.data(), file.gcount());
+            const auto pos = window.find(tag);
+            if (pos != std::string::npos)
+                return windowBegin + pos;
+
+            // keep the end of the chunk in case the tag is split between two chunks
+            const auto keep = std::min(window.size(), tag.size() - 1);
+            windowBegin += window.size() - keep;
+            window.erase(0, window.size() - keep);
+        }
+
+        return -1;
+    }
+
+    /*!
+     * \brief If the loaded file is a parallel vtk file (.pvtu, .pvtp)
+     */
+    bool isParallelFile_() const
+    {
+        const tinyxml2::XMLElement* vtkFile = doc_.FirstChildElement("VTKFile");
+        return vtkFile->FirstChildElement("PUnstructuredGrid") || vtkFile->FirstChildElement("PPolyData");
+    }
+
+    /*!
+     * \brief get the vtk filename for the current processor from the loaded parallel vtk file
+     */
+    std::string getProcessFileName_(const std::string& pvtkFileName) const
+    {
+        using namespace tinyxml2;
 
         // get the first piece node
-        const XMLElement* pieceNode = getPieceNode_(pDoc, pvtkFileName);
+        const XMLElement* pieceNode = getPieceNode_();
         if (pieceNode == nullptr)
             DUNE_THROW(Dune::IOError, "Couldn't get 'Piece' node in " << pvtkFileName << ".");
 
-        const auto myrank = Dune::MPIHelper::getCollectiveCommunication().rank();
-        for (int rank = 0; rank < myrank; ++rank)
-        {
-            pieceNode = pieceNode->NextSiblingElement("Piece");
-            if (pieceNode == nullptr)
-                DUNE_THROW(Dune::IOError, "Couldn't find 'Piece' node for rank "
-                                          << rank << " in " << pvtkFileName << ".");
-        }
+        const auto comm = Dune::MPIHelper::getCollectiveCommunication();
+        const XMLElement* myPieceNode = nullptr;
+        int numPieces = 0;
+        for (; pieceNode != nullptr; pieceNode = pieceNode->NextSiblingElement("Piece"), ++numPieces)
+            if (numPieces == comm.rank())
+                myPieceNode = pieceNode;
+
+        if (numPieces != comm.size())
+            DUNE_THROW(Dune::IOError, pvtkFileName << " contains " << numPieces
+                                      << " pieces but is read by " << comm.size() << " processes.");
 
-        const char *vtkFileName = pieceNode->Attribute("Source");
+        const char *vtkFileName = myPieceNode->Attribute("Source");
         if (vtkFileName == nullptr)
-            DUNE_THROW(Dune::IOError, "Couldn't get 'Source' attribute of 'Piece' node no. " << myrank << " in " << pvtkFileName);
+            DUNE_THROW(Dune::IOError, "Couldn't get 'Source' attribute of 'Piece' node no. " << comm.rank() << " in " << pvtkFileName);
+
+        // relative piece file names refer to the directory of the parallel file
+        std::string pieceFileName(vtkFileName);
+        const auto slashPos = pvtkFileName.find_last_of('/');
+        if (!pieceFileName.empty() && pieceFileName[0] != '/' && slashPos != std::string::npos)
+            pieceFileName = pvtkFileName.substr(0, slashPos + 1) + pieceFileName;
 
-        return vtkFileName;
+        return pieceFileName;
     }
 
     /*!
@@ -187,10 +443,11 @@ private:
             DUNE_THROW(Dune::IOError, "Couldn't get data array of points in " << fileName_ << ".");
 
         using Point3D = Dune::FieldVector<double, 3>;
-        std::vector<Point3D> points3D;
-        std::stringstream dataStream(pointsNode->GetText());
-        std::istream_iterator<Point3D> it(dataStream);
-        std::copy(it, std::istream_iterator<Point3D>(), std::back_inserter(points3D));
+        const auto coordinates = parseDataArray_<std::vector<double>>(pointsNode);
+        std::vector<Point3D> points3D(coordinates.size()/3);
+        for (std::size_t i = 0; i < points3D.size(); ++i)
+            for (int j = 0; j < 3; ++j)
+                points3D[i][j] = coordinates[3*i + j];
 
         // adapt point dimensions if grid dimension is smaller than 3
         auto points = adaptPointDimension_<Grid::dimensionworld>(std::move(points3D));
@@ -386,7 +643,7 @@ private:
     }
 
     /*!
-     * \brief Parses the text of a data array into a container
+     * \brief Parses a data array in ascii, binary or appended format into a container
      * \tparam Container a container type that has begin(), end(), push_back(), e.g. std::vector<double>
      * \param dataArray the data array node to be parsed
      */
@@ -394,12 +651,236 @@ private:
     Container parseDataArray_(const tinyxml2::XMLElement* dataArray) const
     {
         Container data;
-        std::stringstream dataStream(dataArray->GetText());
-        std::istream_iterator<typename Container::value_type> it(dataStream);
-        std::copy(it, std::istream_iterator<typename Container::value_type>(), std::back_inserter(data));
+        const char* format = dataArray->Attribute("format");
+        if (format == nullptr || std::string(format) == "ascii")
+            parseAsciiData_(dataArray->GetText(), data);
+
+        else if (std::string(format) == "binary")
+        {
+            const char* text = dataArray->GetText();
+            const char* textEnd = text == nullptr ? nullptr : text + std::strlen(text);
+            Detail::VTKBase64DataReader<Detail::VTKMemoryCharSource> reader({text, textEnd});
+            parseBinaryData_(reader, dataArray, data);
+        }
+
+        else if (std::string(format) == "appended")
+        {
+            std::int64_t offset = 0;
+            if (appendedDataOffset_ < 0 || dataArray->QueryInt64Attribute("offset", &offset) != tinyxml2::XML_SUCCESS)
+                DUNE_THROW(Dune::IOError, "Couldn't locate the appended data of a data array in " << fileName_ << ".");
+
+            std::ifstream file(fileName_, std::ios::binary);
+            file.seekg(appendedDataOffset_ + offset);
+            if (!file)
+                DUNE_THROW(Dune::IOError, "Couldn't read the appended data of a data array in " << fileName_ << ".");
+
+            if (appendedDataIsBase64_)
+            {
+                Detail::VTKBase64DataReader<Detail::VTKStreamCharSource> reader({*file.rdbuf()});
+                parseBinaryData_(reader, dataArray, data);
+            }
+            else
+            {
+                Detail::VTKRawDataReader reader(file);
+                parseBinaryData_(reader, dataArray, data);
+            }
+        }
+
+        else
+            DUNE_THROW(Dune::NotImplemented, "Data array format " << format << " in " << fileName_ << ".");
+
         return data;
     }
 
+    /*!
+     * \brief Parses the whitespace separated numbers of an ascii data array into a container
+     * \note The numbers are parsed in place without copying the text
+     */
+    template<class Container>
+    void parseAsciiData_(const char* text, Container& data) const
+    {
+        using Value = typename Container::value_type;
+        if (text == nullptr)
+            return;
+
+        char* end = nullptr;
+        while (true)
+        {
+            const Value value = parseAsciiValue_<Value>(text, end);
+            if (end == text)
+                break;
+
+            data.push_back(value);
+            text = end;
+        }
+    }
+
+    template<class Value, std::enable_if_t<std::is_integral<Value>::value, int> = 0>
+    static Value parseAsciiValue_(const char* text, char*& end)
+    {
+        const auto value = std::strtoll(text, &end, 10);
+
+        // integers might have been written as floating point numbers
+        if (end != text && (*end == '.' || *end == 'e' || *end == 'E'))
+            return static_cast<Value>(std::strtod(text, &end));
+
+        return static_cast<Value>(value);
+    }
+
+    template<class Value, std::enable_if_t<!std::is_integral<Value>::value, int> = 0>
+    static Value parseAsciiValue_(const char* text, char*& end)
+    { return static_cast<Value>(std::strtod(text, &end)); }
+
+    /*!
+     * \brief Parses binary data (header followed by the possibly compressed data) into a container
+     * \param reader the reader providing the (decoded) bytes
+     * \param dataArray the data array node
+     * \param data the container to be filled
+     */
+    template<class Reader, class Container>
+    void parseBinaryData_(Reader& reader, const tinyxml2::XMLElement* dataArray, Container& data) const
+    {
+        const char* typeAttribute = dataArray->Attribute("type");
+        if (typeAttribute == nullptr)
+            DUNE_THROW(Dune::IOError, "Couldn't get type attribute of a data array in " << fileName_ << ".");
+
+        const std::string type(typeAttribute);
+        if (type == "Float32") parseBinaryData_<float>(reader, data);
+        else if (type == "Float64") parseBinaryData_<double>(reader, data);
+        else if (type == "Int8") parseBinaryData_<std::int8_t>(reader, data);
+        else if (type == "UInt8") parseBinaryData_<std::uint8_t>(reader, data);
+        else if (type == "Int16") parseBinaryData_<std::int16_t>(reader, data);
+        else if (type == "UInt16") parseBinaryData_<std::uint16_t>(reader, data);
+        else if (type == "Int32") parseBinaryData_<std::int32_t>(reader, data);
+        else if (type == "UInt32") parseBinaryData_<std::uint32_t>(reader, data);
+        else if (type == "Int64") parseBinaryData_<std::int64_t>(reader, data);
+        else if (type == "UInt64") parseBinaryData_<std::uint64_t>(reader, data);
+        else
+            DUNE_THROW(Dune::NotImplemented, "Data array type " << type << " in " << fileName_ << ".");
+    }
+
+    /*!
+     * \brief Parses binary data with values of type T into a container
+     * \note Uncompressed data is converted in chunks, so the bytes are never held in memory as a whole
+     */
+    template<class T, class Reader, class Container>
+    void parseBinaryData_(Reader& reader, Container& data) const
+    {
+        if (compressed_)
+        {
+            std::vector<char> bytes;
+            readCompressedData_(reader, bytes);
+            reserve_(data, bytes.size()/sizeof(T), 0);
+            convertBinaryData_<T>(bytes.data(), bytes.size(), data);
+        }
+        else
+        {
+            std::size_t numBytes = readHeaderValue_(reader);
+            reserve_(data, numBytes/sizeof(T), 0);
+
+            constexpr std::size_t chunkSize = (std::size_t(1) << 16)*sizeof(T);
+            std::vector<char> chunk(std::min(numBytes, chunkSize));
+            while (numBytes > 0)
+            {
+                const std::size_t n = std::min(numBytes, chunkSize);
+                reader.read(chunk.data(), n);
+                convertBinaryData_<T>(chunk.data(), n, data);
+                numBytes -= n;
+            }
+        }
+    }
+
+    /*!
+     * \brief Read a value of the header in front of binary data
+     */
+    template<class Reader>
+    std::uint64_t readHeaderValue_(Reader& reader) const
+    {
+        char buffer[8] = {};
+        reader.read(buffer, headerSize_);
+        if (swapBytes_)
+            std::reverse(buffer, buffer + headerSize_);
+
+        if (headerSize_ == 8)
+        {
+            std::uint64_t value;
+            std::memcpy(&value, buffer, 8);
+            return value;
+        }
+
+        std::uint32_t value;
+        std::memcpy(&value, buffer, 4);
+        return value;
+    }
+
+    /*!
+     * \brief Read and decompress zlib compressed binary data
+     * \note The header contains the number of blocks, the (uncompressed) block size,
+     *       the size of the last block (zero if it is a full block) and the compressed block sizes.
+     */
+    template<class Reader>
+    void readCompressedData_(Reader& reader, std::vector<char>& bytes) const
+    {
+#if HAVE_ZLIB
+        const std::size_t numBlocks = readHeaderValue_(reader);
+        const std::size_t blockSize = readHeaderValue_(reader);
+        const std::size_t lastBlockSize = readHeaderValue_(reader);
+        std::vector<std::size_t> compressedBlockSizes(numBlocks);
+        for (auto& size : compressedBlockSizes)
+            size = readHeaderValue_(reader);
+
+        const std::size_t sizeOfLastBlock = lastBlockSize > 0 ? lastBlockSize : blockSize;
+        bytes.resize(numBlocks > 0 ? (numBlocks - 1)*blockSize + sizeOfLastBlock : 0);
+
+        std::vector<char> compressedBlock;
+        for (std::size_t i = 0; i < numBlocks; ++i)
+        {
+            compressedBlock.resize(compressedBlockSizes[i]);
+            reader.read(compressedBlock.data(), compressedBlock.size());
+
+            const uLongf expectedSize = i + 1 < numBlocks ? blockSize : sizeOfLastBlock;
+            uLongf size = expectedSize;
+            const int result = uncompress(reinterpret_cast<Bytef*>(bytes.data() + i*blockSize), &size,
+                                          reinterpret_cast<const Bytef*>(compressedBlock.data()), compressedBlock.size());
+            if (result != Z_OK || size != expectedSize)
+                DUNE_THROW(Dune::IOError, "Couldn't decompress block " << i << " of a data array in " << fileName_ << ".");
+        }
+#else
+        DUNE_UNUSED_PARAMETER(reader);
+        DUNE_UNUSED_PARAMETER(bytes);
+        DUNE_THROW(Dune::NotImplemented, "Reading compressed data from " << fileName_ << " requires zlib.");
+#endif
+    }
+
+    /*!
+     * \brief Convert bytes of binary data with values of type T and append them to a container
+     */
+    template<class T, class Container>
+    void convertBinaryData_(char* bytes, std::size_t numBytes, Container& data) const
+    {
+        const std::size_t numValues = numBytes/sizeof(T);
+        for (std::size_t i = 0; i < numValues; ++i)
+        {
+            char* valueBytes = bytes + i*sizeof(T);
+            if (swapBytes_)
+                std::reverse(valueBytes, valueBytes + sizeof(T));
+
+            T value;
+            std::memcpy(&value, valueBytes, sizeof(T));
+            data.push_back(static_cast<typename Container::value_type>(value));
+        }
+    }
+
+    //! reserve memory for containers supporting it
+    template<class Container>
+    static auto reserve_(Container& data, std::size_t size, int) -> decltype(data.reserve(size), void())
+    { data.reserve(size); }
+
+    template<class Container>
+    static void reserve_(Container&, std::size_t, long)
+    {}
+
+
     /*!
      * \brief Return the Dune::GeometryType for a given VTK geometry type
      * \param vtkCellType the vtk cell type
@@ -437,6 +918,11 @@ private:
 
     std::string fileName_; //!< the vtk file name
     tinyxml2::XMLDocument doc_; //!< the xml document created from file with name fileName_
+    std::streamoff appendedDataOffset_ = -1; //!< the position of the appended data in the file (-1 if there is none)
+    bool appendedDataIsBase64_ = false; //!< if the appended data is base64 encoded (or raw)
+    std::size_t headerSize_ = 4; //!< the size of the values of the headers in front of binary data
+    bool swapBytes_ = false; //!< if the byte order of the file differs from the one of this machine
+    bool compressed_ = false; //!< if binary data is compressed
 };
 
 } // end namespace Dumux
@@ -24,7 +24,14 @@
 #ifndef VTK_OUTPUT_MODULE_HH
 #define VTK_OUTPUT_MODULE_HH
 
+#include <algorithm>
+#include <array>
+#include <exception>
 #include <functional>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include <dune/common/timer.hh>
 #include <dune/common/fvector.hh>
@@ -40,6 +47,7 @@
 #include <dune/grid/common/partitionset.hh>
 
 #include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh>
 #include <dumux/common/typetraits/typetraits.hh>
 #include <dumux/discretization/method.hh>
 #include <dune/common/deprecated.hh>
@@ -61,6 +69,10 @@ namespace Dumux {
  * variables and timesteps. Certain predefined fields can be registered on
  * initialization and/or be turned on/off using the designated properties. Additionally
  * non-standardized scalar and vector fields can be added to the writer manually.
+ *
+ * If the grid volume variables are cached and no velocities are written, the registered
+ * volume variable quantities are read directly from the cache, using up to Vtk.NumThreads
+ * threads (default 1). The registered functions then have to be safe to call concurrently.
  */
 template<class GridVariables, class SolutionVector>
 class VtkOutputModule
@@ -82,6 +94,7 @@ class VtkOutputModule
 
     static constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
     static constexpr int dofCodim = isBox ? dim : 0;
+    static constexpr bool volVarsCached = GridVariables::GridVolumeVariables::cachingEnabled;
 
     struct VolVarScalarDataInfo { std::function<Scalar(const VV&)> get; std::string name; };
     struct VolVarVectorDataInfo { std::function<VolVarsVector(const VV&)> get; std::string name; };
@@ -114,6 +127,7 @@ public:
     , writer_(std::make_shared<Dune::VTKWriter<GridView>>(gridVariables.fvGridGeometry().gridView(), dm))
     , sequenceWriter_(writer_, name)
     , velocityOutput_(std::make_shared<VelocityOutputType>())
+    , numThreads_(std::max(getParamFromGroup<int>(paramGroup, "Vtk.NumThreads", 1), 1))
     {}
 
     //! the parameter group for getting parameter from the parameter tree
@@ -210,6 +224,7 @@ public:
     //! (4) Clear the writer for the next time step
     void write(double time, Dune::VTK::OutputType type = Dune::VTK::ascii)
     {
+        DUMUX_PROFILE_REGION("output");
         Dune::Timer timer;
 
         // write to file depending on data mode
@@ -258,17 +273,8 @@ private:
         //! (1) Assemble all variable fields and add to writer
         //////////////////////////////////////////////////////////////
 
-        // instantiate the velocity output
-        using VelocityVector = typename VelocityOutput::VelocityVector;
-        std::vector<VelocityVector> velocity(velocityOutput_->numFluidPhases());
-
         // process rank
         static bool addProcessRank = getParamFromGroup<bool>(paramGroup_, "Vtk.AddProcessRank");
-        std::vector<double> rank;
-
-        // volume variable data
-        std::vector<std::vector<Scalar>> volVarScalarData;
-        std::vector<std::vector<VolVarsVector>> volVarVectorData;
 
         //! Abort if no data was registered
         if (!volVarScalarDataInfo_.empty()
@@ -280,72 +286,61 @@ private:
             const auto numCells = fvGridGeometry().gridView().size(0);
             const auto numDofs = numDofs_();
 
-            // get fields for all volume variables
-            if (!volVarScalarDataInfo_.empty())
-                volVarScalarData.resize(volVarScalarDataInfo_.size(), std::vector<Scalar>(numDofs));
-            if (!volVarVectorDataInfo_.empty())
-                volVarVectorData.resize(volVarVectorDataInfo_.size(), std::vector<VolVarsVector>(numDofs));
+            // the buffers persist between writes and are only reallocated if the grid size changes
+            volVarScalarData_.resize(volVarScalarDataInfo_.size());
+            for (auto& data : volVarScalarData_)
+                data.resize(numDofs);
+            volVarVectorData_.resize(volVarVectorDataInfo_.size());
+            for (auto& data : volVarVectorData_)
+                data.resize(numDofs);
 
             if (velocityOutput_->enableOutput())
             {
-                for (int phaseIdx = 0; phaseIdx < velocityOutput_->numFluidPhases(); ++phaseIdx)
+                velocity_.resize(velocityOutput_->numFluidPhases());
+                for (auto& velocity : velocity_)
                 {
-                    if(isBox && dim == 1)
-                        velocity[phaseIdx].resize(numCells);
-                    else
-                        velocity[phaseIdx].resize(numDofs);
+                    // some velocity output policies accumulate the contributions of the elements
+                    velocity.resize(isBox && dim == 1 ? numCells : numDofs);
+                    std::fill(velocity.begin(), velocity.end(), typename VelocityOutput::VelocityVector::value_type(0.0));
                 }
             }
 
-            // maybe allocate space for the process rank
-            if (addProcessRank) rank.resize(numCells);
+            // the process rank only has to be set if the grid size changed
+            if (addProcessRank && rank_.size() != std::size_t(numCells))
+                rank_.assign(numCells, static_cast<double>(fvGridGeometry().gridView().comm().rank()));
 
-            for (const auto& element : elements(fvGridGeometry().gridView(), Dune::Partitions::interior))
-            {
-                const auto eIdxGlobal = fvGridGeometry().elementMapper().index(element);
+            // with cached volume variables, these are read directly if no velocities have to be computed
+            const bool hasVolVarData = !volVarScalarDataInfo_.empty() || !volVarVectorDataInfo_.empty();
+            if (volVarsCached && hasVolVarData && !velocityOutput_->enableOutput())
+                extractCachedVolVars_(std::integral_constant<bool, volVarsCached>(), std::integral_constant<bool, isBox>());
 
+            else if (hasVolVarData || velocityOutput_->enableOutput())
+            {
                 auto fvGeometry = localView(fvGridGeometry());
                 auto elemVolVars = localView(gridVariables_.curGridVolVars());
-
-                // If velocity output is enabled we need to bind to the whole stencil
-                // otherwise element-local data is sufficient
-                if (velocityOutput_->enableOutput())
+                for (const auto& element : elements(fvGridGeometry().gridView(), Dune::Partitions::interior))
                 {
-                    fvGeometry.bind(element);
-                    elemVolVars.bind(element, fvGeometry, sol_);
-                }
-                else
-                {
-                    fvGeometry.bindElement(element);
-                    elemVolVars.bindElement(element, fvGeometry, sol_);
-                }
-
-                if (!volVarScalarDataInfo_.empty()
-                    || !volVarVectorDataInfo_.empty())
-                {
-                    for (auto&& scv : scvs(fvGeometry))
+                    // If velocity output is enabled we need to bind to the whole stencil
+                    // otherwise element-local data is sufficient
+                    if (velocityOutput_->enableOutput())
                     {
-                        const auto dofIdxGlobal = scv.dofIndex();
-                        const auto& volVars = elemVolVars[scv];
-
-                        // get the scalar-valued data
-                        for (std::size_t i = 0; i < volVarScalarDataInfo_.size(); ++i)
-                            volVarScalarData[i][dofIdxGlobal] = volVarScalarDataInfo_[i].get(volVars);
-
-                        // get the vector-valued data
-                        for (std::size_t i = 0; i < volVarVectorDataInfo_.size(); ++i)
-                            volVarVectorData[i][dofIdxGlobal] = volVarVectorDataInfo_[i].get(volVars);
+                        fvGeometry.bind(element);
+                        elemVolVars.bind(element, fvGeometry, sol_);
+                    }
+                    else
+                    {
+                        fvGeometry.bindElement(element);
+                        elemVolVars.bindElement(element, fvGeometry, sol_);
                     }
-                }
 
-                // velocity output
-                if (velocityOutput_->enableOutput())
-                    for (int phaseIdx = 0; phaseIdx < velocityOutput_->numFluidPhases(); ++phaseIdx)
-                        velocityOutput_->calculateVelocity(velocity[phaseIdx], elemVolVars, fvGeometry, element, phaseIdx);
+                    for (auto&& scv : scvs(fvGeometry))
+                        extractVolVars_(scv.dofIndex(), elemVolVars[scv]);
 
-                //! the rank
-                if (addProcessRank)
-                    rank[eIdxGlobal] = static_cast<double>(fvGridGeometry().gridView().comm().rank());
+                    // velocity output
+                    if (velocityOutput_->enableOutput())
+                        for (int phaseIdx = 0; phaseIdx < velocityOutput_->numFluidPhases(); ++phaseIdx)
+                            velocityOutput_->calculateVelocity(velocity_[phaseIdx], elemVolVars, fvGeometry, element, phaseIdx);
+                }
             }
 
             //////////////////////////////////////////////////////////////
@@ -356,19 +351,19 @@ private:
             if (isBox)
             {
                 for (std::size_t i = 0; i < volVarScalarDataInfo_.size(); ++i)
-                    sequenceWriter_.addVertexData( Field(fvGridGeometry().gridView(), fvGridGeometry().vertexMapper(), volVarScalarData[i],
+                    sequenceWriter_.addVertexData( Field(fvGridGeometry().gridView(), fvGridGeometry().vertexMapper(), volVarScalarData_[i],
                                                          volVarScalarDataInfo_[i].name, /*numComp*/1, /*codim*/dim).get() );
                 for (std::size_t i = 0; i < volVarVectorDataInfo_.size(); ++i)
-                    sequenceWriter_.addVertexData( Field(fvGridGeometry().gridView(), fvGridGeometry().vertexMapper(), volVarVectorData[i],
+                    sequenceWriter_.addVertexData( Field(fvGridGeometry().gridView(), fvGridGeometry().vertexMapper(), volVarVectorData_[i],
                                                          volVarVectorDataInfo_[i].name, /*numComp*/dimWorld, /*codim*/dim).get() );
             }
             else
             {
                 for (std::size_t i = 0; i < volVarScalarDataInfo_.size(); ++i)
-                    sequenceWriter_.addCellData( Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), volVarScalarData[i],
+                    sequenceWriter_.addCellData( Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), volVarScalarData_[i],
                                                        volVarScalarDataInfo_[i].name, /*numComp*/1, /*codim*/0).get() );
                 for (std::size_t i = 0; i < volVarVectorDataInfo_.size(); ++i)
-                    sequenceWriter_.addCellData( Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), volVarVectorData[i],
+                    sequenceWriter_.addCellData( Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), volVarVectorData_[i],
                                                        volVarVectorDataInfo_[i].name, /*numComp*/dimWorld, /*codim*/0).get() );
             }
 
@@ -378,7 +373,7 @@ private:
                 if (isBox && dim > 1)
                 {
                     for (int phaseIdx = 0; phaseIdx < velocityOutput_->numFluidPhases(); ++phaseIdx)
-                        sequenceWriter_.addVertexData( Field(fvGridGeometry().gridView(), fvGridGeometry().vertexMapper(), velocity[phaseIdx],
+                        sequenceWriter_.addVertexData( Field(fvGridGeometry().gridView(), fvGridGeometry().vertexMapper(), velocity_[phaseIdx],
                                                              "velocity_" + velocityOutput_->phaseName(phaseIdx) + " (m/s)",
                                                              /*numComp*/dimWorld, /*codim*/dim).get() );
                 }
@@ -386,7 +381,7 @@ private:
                 else
                 {
                     for (int phaseIdx = 0; phaseIdx < velocityOutput_->numFluidPhases(); ++phaseIdx)
-                        sequenceWriter_.addCellData( Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), velocity[phaseIdx],
+                        sequenceWriter_.addCellData( Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), velocity_[phaseIdx],
                                                            "velocity_" + velocityOutput_->phaseName(phaseIdx) + " (m/s)",
                                                            /*numComp*/dimWorld, /*codim*/0).get() );
                 }
@@ -394,7 +389,7 @@ private:
 
             // the process rank
             if (addProcessRank)
-                sequenceWriter_.addCellData(Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), rank, "process rank", 1, 0).get());
+                sequenceWriter_.addCellData(Field(fvGridGeometry().gridView(), fvGridGeometry().elementMapper(), rank_, "process rank", 1, 0).get());
 
             // also register additional (non-standardized) user fields if any
             for (auto&& field : fields_)
@@ -591,6 +586,84 @@ private:
         writer_->clear();
     }
 
+    //! Stores the registered quantities of the volume variables of a dof in the output buffers
+    void extractVolVars_(std::size_t dofIdxGlobal, const VolumeVariables& volVars)
+    {
+        // get the scalar-valued data
+        for (std::size_t i = 0; i < volVarScalarDataInfo_.size(); ++i)
+            volVarScalarData_[i][dofIdxGlobal] = volVarScalarDataInfo_[i].get(volVars);
+
+        // get the vector-valued data
+        for (std::size_t i = 0; i < volVarVectorDataInfo_.size(); ++i)
+            volVarVectorData_[i][dofIdxGlobal] = volVarVectorDataInfo_[i].get(volVars);
+    }
+
+    //! Reads the registered quantities directly from the cached volume variables (cell-centered schemes)
+    void extractCachedVolVars_(std::true_type /*cached*/, std::false_type /*isBox*/)
+    {
+        const auto& gridVolVars = gridVariables_.curGridVolVars();
+        runInParallel_(numDofs_(), [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t eIdx = begin; eIdx < end; ++eIdx)
+                extractVolVars_(eIdx, gridVolVars.volVars(eIdx));
+        });
+    }
+
+    //! Reads the registered quantities directly from the cached volume variables (box scheme)
+    void extractCachedVolVars_(std::true_type /*cached*/, std::true_type /*isBox*/)
+    {
+        // the volume variables are stored per element, use those of one interior element per vertex
+        static constexpr auto unassigned = std::numeric_limits<std::size_t>::max();
+        cachedVolVarsIndices_.assign(numDofs_(), {{unassigned, 0}});
+        for (const auto& element : elements(fvGridGeometry().gridView(), Dune::Partitions::interior))
+        {
+            const auto eIdx = fvGridGeometry().elementMapper().index(element);
+            for (unsigned int localIdx = 0; localIdx < element.subEntities(dim); ++localIdx)
+                cachedVolVarsIndices_[fvGridGeometry().vertexMapper().subIndex(element, localIdx, dim)] = {{eIdx, localIdx}};
+        }
+
+        const auto& gridVolVars = gridVariables_.curGridVolVars();
+        runInParallel_(numDofs_(), [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t vIdx = begin; vIdx < end; ++vIdx)
+                if (cachedVolVarsIndices_[vIdx][0] != unassigned)
+                    extractVolVars_(vIdx, gridVolVars.volVars(cachedVolVarsIndices_[vIdx][0], cachedVolVarsIndices_[vIdx][1]));
+        });
+    }
+
+    //! Without cached volume variables, these have to be computed element-wise
+    template<class IsBox>
+    void extractCachedVolVars_(std::false_type /*cached*/, IsBox)
+    {}
+
+    //! Calls f(begin, end) for consecutive ranges of [0, size) on up to Vtk.NumThreads threads
+    template<class Function>
+    void runInParallel_(std::size_t size, const Function& f) const
+    {
+        const std::size_t numThreads = std::max<std::size_t>(1, std::min<std::size_t>(numThreads_, size/minRangeSize_));
+        if (numThreads == 1)
+            return f(0, size);
+
+        // exceptions are passed on to the calling thread
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> exceptions(numThreads);
+        for (std::size_t threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+        {
+            threads.emplace_back([&, threadIdx]()
+            {
+                try { f(threadIdx*size/numThreads, (threadIdx + 1)*size/numThreads); }
+                catch (...) { exceptions[threadIdx] = std::current_exception(); }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        for (const auto& exception : exceptions)
+            if (exception)
+                std::rethrow_exception(exception);
+    }
+
     //! Deduces the number of components of the value type of a vector of values
     template<class Vector, typename std::enable_if_t<IsIndexable<decltype(std::declval<Vector>()[0])>::value, int> = 0>
     std::size_t getNumberOfComponents_(const Vector& v) { return v[0].size(); }
@@ -618,6 +691,16 @@ private:
 
     std::vector<Field> fields_; //!< Registered scalar and vector fields
     std::shared_ptr<VelocityOutput> velocityOutput_; //!< The velocity output policy
+
+    // output buffers persisting between writes (conforming output)
+    std::vector<std::vector<Scalar>> volVarScalarData_;
+    std::vector<std::vector<VolVarsVector>> volVarVectorData_;
+    std::vector<typename VelocityOutput::VelocityVector> velocity_;
+    std::vector<double> rank_;
+    std::vector<std::array<std::size_t, 2>> cachedVolVarsIndices_; //!< element and local index of the cached volume variables of each vertex (box)
+
+    std::size_t numThreads_; //!< The maximum number of threads for the extraction of the volume variables
+    static constexpr std::size_t minRangeSize_ = 1000; //!< The minimum number of dofs per thread
 };
 
 } // end namespace Dumux
@@ -0,0 +1,565 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief A writer for time series of unstructured meshes and fields
+ *        into a single HDF5 file described by an XDMF file.
+ */
+#ifndef DUMUX_IO_HDF5_XDMF_WRITER_HH
+#define DUMUX_IO_HDF5_XDMF_WRITER_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if HAVE_HDF5
+#include <hdf5.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief Writes a time series of fields on an unstructured mesh into a single
+ *        HDF5 file (name.h5) and an XDMF file (name.xmf) describing its content,
+ *        which can be opened e.g. with ParaView or VisIt.
+ *
+ * The mesh is written once and only written again if it is changed with setMesh().
+ * For each time step, the registered fields are appended to the HDF5 file and a
+ * grid referencing the mesh and the fields is appended to the XDMF file. In parallel,
+ * each process passes the mesh part and the field values of its cells and points.
+ * If HDF5 was built with MPI support, all processes write collectively into the file.
+ * Otherwise, the processes write their chunks of the data sets one after another.
+ *
+ * Optionally, the data sets are stored in chunks compressed with deflate (zlib).
+ *
+ * \tparam Communication The collective communication type (e.g. of the grid view)
+ */
+template<class Communication>
+class Hdf5XdmfWriter
+{
+public:
+    //! Cell types (as numbered by XDMF)
+    enum CellType : int
+    {
+        polyvertex = 1, polyline = 2, triangle = 4, quadrilateral = 5,
+        tetrahedron = 6, pyramid = 7, wedge = 8, hexahedron = 9
+    };
+
+    /*!
+     * \brief Constructor, creates the HDF5 file (collective)
+     * \param name The base name of the output files
+     * \param comm The collective communication object
+     * \param compressionLevel The deflate compression level (0 = no compression, 1-9)
+     */
+    Hdf5XdmfWriter(const std::string& name, const Communication& comm, int compressionLevel = 0)
+    : name_(name)
+    , comm_(comm)
+    , compressionLevel_(compressionLevel)
+    {
+#if HAVE_HDF5
+        if (compressionLevel_ < 0 || compressionLevel_ > 9)
+            DUNE_THROW(Dune::InvalidStateException, "Invalid compression level " << compressionLevel_ << " (use 0-9)");
+
+        // the file is created empty and kept open if all processes write at once
+        openFile_(H5F_ACC_TRUNC, /*keepOpen=*/!serializedWrite_());
+#else
+        DUNE_THROW(Dune::NotImplemented, "XDMF output requires HDF5");
+#endif
+    }
+
+    ~Hdf5XdmfWriter()
+    {
+#if HAVE_HDF5
+        if (file_ >= 0)
+            H5Fclose(file_);
+#endif
+    }
+
+    Hdf5XdmfWriter(const Hdf5XdmfWriter&) = delete;
+    Hdf5XdmfWriter& operator=(const Hdf5XdmfWriter&) = delete;
+
+    /*!
+     * \brief Sets the mesh part of this process (written with the next time step)
+     * \param points The point coordinates (three per point)
+     * \param cellTypes The XDMF cell type of each cell
+     * \param connectivity The point indices of the cells (local to this process, in VTK ordering)
+     */
+    void setMesh(std::vector<double>&& points,
+                 const std::vector<int>& cellTypes,
+                 const std::vector<std::int64_t>& connectivity)
+    {
+        if (points.size() % 3 != 0)
+            DUNE_THROW(Dune::InvalidStateException, "Expected three coordinates per point");
+
+        // the global offsets of the points and cells of this process
+        numPoints_ = points.size()/3;
+        numCells_ = cellTypes.size();
+        globalNumPoints_ = exclusiveScan_(numPoints_, pointOffset_);
+        globalNumCells_ = exclusiveScan_(numCells_, cellOffset_);
+
+        // the mixed topology stores the cell type and (for poly cells) the number of points before the point indices
+        topology_.clear();
+        topology_.reserve(connectivity.size() + 2*cellTypes.size());
+        std::size_t pos = 0;
+        for (const auto type : cellTypes)
+        {
+            const auto numCellPoints = numCellPoints_(type);
+            topology_.push_back(type);
+            if (type == polyvertex || type == polyline)
+                topology_.push_back(numCellPoints);
+
+            if (pos + numCellPoints > connectivity.size())
+                DUNE_THROW(Dune::InvalidStateException, "Connectivity does not match the cell types");
+
+            for (std::size_t i = 0; i < numCellPoints; ++i)
+                topology_.push_back(connectivity[pos++] + pointOffset_);
+        }
+
+        globalTopologySize_ = exclusiveScan_(topology_.size(), topologyOffset_);
+        points_ = std::move(points);
+        meshChanged_ = true;
+    }
+
+    //! Adds a field with values at the points for the next time step
+    void addPointData(const std::string& name, std::vector<double>&& values, std::size_t numComponents = 1)
+    {
+        if (values.size() != numPoints_*numComponents)
+            DUNE_THROW(Dune::InvalidStateException, "Size mismatch of point data " << name);
+        fields_.push_back(FieldData{name, std::move(values), numComponents, /*isCellData=*/false});
+    }
+
+    //! Adds a field with values on the cells for the next time step
+    void addCellData(const std::string& name, std::vector<double>&& values, std::size_t numComponents = 1)
+    {
+        if (values.size() != numCells_*numComponents)
+            DUNE_THROW(Dune::InvalidStateException, "Size mismatch of cell data " << name);
+        fields_.push_back(FieldData{name, std::move(values), numComponents, /*isCellData=*/true});
+    }
+
+    /*!
+     * \brief Writes the mesh (if changed) and the added fields of a time step (collective)
+     * \note The added fields are removed afterwards
+     */
+    void write(double time)
+    {
+#if HAVE_HDF5
+        if (!meshWritten_ && !meshChanged_)
+            DUNE_THROW(Dune::InvalidStateException, "Set the mesh before writing");
+
+        std::vector<Dataset> datasets;
+        if (meshChanged_)
+        {
+            meshPath_ = "/Mesh_" + std::to_string(meshIdx_++);
+            datasets.push_back(Dataset{meshPath_ + "/Geometry", globalNumPoints_, 3, pointOffset_, numPoints_,
+                                       H5T_NATIVE_DOUBLE, points_.data()});
+            datasets.push_back(Dataset{meshPath_ + "/Topology", globalTopologySize_, 1, topologyOffset_, topology_.size(),
+                                       H5T_NATIVE_INT64, topology_.data()});
+        }
+
+        const std::string stepPath = "/Step_" + std::to_string(stepIdx_);
+        for (const auto& field : fields_)
+        {
+            const auto globalNumEntities = field.isCellData ? globalNumCells_ : globalNumPoints_;
+            const auto offset = field.isCellData ? cellOffset_ : pointOffset_;
+            const auto numEntities = field.isCellData ? numCells_ : numPoints_;
+            datasets.push_back(Dataset{stepPath + "/" + datasetName_(field.name), globalNumEntities, field.numComponents,
+                                       offset, numEntities, H5T_NATIVE_DOUBLE, field.values.data()});
+        }
+
+        writeDatasets_(datasets);
+
+        if (comm_.rank() == 0)
+            appendXdmfStep_(time, stepPath);
+
+        // the mesh data is only needed again if it changes
+        if (meshChanged_)
+        {
+            points_.clear(); points_.shrink_to_fit();
+            topology_.clear(); topology_.shrink_to_fit();
+            meshChanged_ = false;
+            meshWritten_ = true;
+        }
+
+        fields_.clear();
+        ++stepIdx_;
+#endif
+    }
+
+    //! The name of the HDF5 file
+    std::string hdf5FileName() const
+    { return name_ + ".h5"; }
+
+    //! The name of the XDMF file
+    std::string xdmfFileName() const
+    { return name_ + ".xmf"; }
+
+private:
+    struct FieldData
+    {
+        std::string name;
+        std::vector<double> values;
+        std::size_t numComponents;
+        bool isCellData;
+    };
+
+    //! the number of points of a cell type
+    static std::size_t numCellPoints_(int type)
+    {
+        switch (type)
+        {
+            case polyvertex: return 1;
+            case polyline: return 2;
+            case triangle: return 3;
+            case quadrilateral: return 4;
+            case tetrahedron: return 4;
+            case pyramid: return 5;
+            case wedge: return 6;
+            case hexahedron: return 8;
+            default: DUNE_THROW(Dune::NotImplemented, "XDMF cell type " << type);
+        }
+    }
+
+    //! computes the offset of this process and returns the global size
+    std::size_t exclusiveScan_(std::size_t localSize, std::size_t& offset) const
+    {
+        std::vector<std::size_t> sizes(comm_.size());
+        comm_.allgather(&localSize, 1, sizes.data());
+        offset = std::accumulate(sizes.begin(), sizes.begin() + comm_.rank(), std::size_t(0));
+        return std::accumulate(sizes.begin(), sizes.end(), std::size_t(0));
+    }
+
+    //! data set names must not contain slashes
+    static std::string datasetName_(std::string name)
+    {
+        std::replace(name.begin(), name.end(), '/', '_');
+        return name;
+    }
+
+    //! escapes the characters with special meaning in XML
+    static std::string escapeXml_(const std::string& text)
+    {
+        std::string escaped;
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                case '&': escaped += "&amp;"; break;
+                case '<': escaped += "&lt;"; break;
+                case '>': escaped += "&gt;"; break;
+                case '"': escaped += "&quot;"; break;
+                default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    //! the HDF5 file name as referenced from the XDMF file (same directory)
+    std::string relativeHdf5FileName_() const
+    {
+        const auto fileName = hdf5FileName();
+        const auto pos = fileName.find_last_of('/');
+        return pos == std::string::npos ? fileName : fileName.substr(pos+1);
+    }
+
+    //! appends the grid of a time step to the XDMF file (only on rank 0)
+    void appendXdmfStep_(double time, const std::string& stepPath)
+    {
+        static const std::string tail = "    </Grid>\n  </Domain>\n</Xdmf>\n";
+
+        std::fstream file;
+        if (stepIdx_ == 0)
+        {
+            file.open(xdmfFileName(), std::ios::out | std::ios::trunc);
+            file << "<?xml version=\"1.0\" ?>\n"
+                 << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n"
+                 << "<Xdmf Version=\"3.0\">\n"
+                 << "  <Domain>\n"
+                 << "    <Grid Name=\"TimeSeries\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+        }
+        else
+        {
+            // overwrite the tail of the file
+            file.open(xdmfFileName(), std::ios::in | std::ios::out);
+            file.seekp(xdmfTailPos_);
+        }
+
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not write " << xdmfFileName());
+
+        const auto h5 = relativeHdf5FileName_();
+        auto dataItem = [&h5] (const std::string& dimensions, const char* type, const std::string& path)
+        {
+            return "          <DataItem Dimensions=\"" + dimensions + "\" NumberType=\"" + type
+                   + "\" Precision=\"8\" Format=\"HDF\">" + escapeXml_(h5 + ":" + path) + "</DataItem>\n";
+        };
+
+        std::ostringstream grid;
+        grid << std::setprecision(17);
+        grid << "      <Grid Name=\"Step_" << stepIdx_ << "\" GridType=\"Uniform\">\n"
+             << "        <Time Value=\"" << time << "\" />\n"
+             << "        <Topology TopologyType=\"Mixed\" NumberOfElements=\"" << globalNumCells_ << "\">\n"
+             << dataItem(std::to_string(globalTopologySize_), "Int", meshPath_ + "/Topology")
+             << "        </Topology>\n"
+             << "        <Geometry GeometryType=\"XYZ\">\n"
+             << dataItem(std::to_string(globalNumPoints_) + " 3", "Float", meshPath_ + "/Geometry")
+             << "        </Geometry>\n";
+
+        for (const auto& field : fields_)
+        {
+            const auto n = field.numComponents;
+            const char* attributeType = n == 1 ? "Scalar" : n == 3 ? "Vector" : n == 6 ? "Tensor6" : n == 9 ? "Tensor" : "Matrix";
+            const auto numEntities = field.isCellData ? globalNumCells_ : globalNumPoints_;
+            const auto dimensions = std::to_string(numEntities) + (n > 1 ? " " + std::to_string(n) : "");
+            grid << "        <Attribute Name=\"" << escapeXml_(field.name) << "\" AttributeType=\"" << attributeType
+                 << "\" Center=\"" << (field.isCellData ? "Cell" : "Node") << "\">\n"
+                 << dataItem(dimensions, "Float", stepPath + "/" + datasetName_(field.name))
+                 << "        </Attribute>\n";
+        }
+
+        grid << "      </Grid>\n";
+
+        file << grid.str();
+        xdmfTailPos_ = file.tellp();
+        file << tail;
+    }
+
+#if HAVE_HDF5
+    //! a (part of a) data set to be written by this process
+    struct Dataset
+    {
+        std::string path;
+        std::size_t globalRows;
+        std::size_t numComponents;
+        std::size_t offset;
+        std::size_t localRows;
+        hid_t memType;
+        const void* data;
+    };
+
+    //! if true, the processes write their data one after another
+    bool serializedWrite_() const
+    {
+#if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+        return false;
+#else
+        return comm_.size() > 1;
+#endif
+    }
+
+    //! opens or creates the HDF5 file
+    void openFile_(unsigned int flags, bool keepOpen)
+    {
+        if (file_ >= 0)
+            return;
+
+        // without parallel HDF5, the file is created by the first process only
+        if (serializedWrite_() && flags == H5F_ACC_TRUNC)
+        {
+            if (comm_.rank() == 0)
+                createFile_(H5P_DEFAULT);
+            comm_.barrier();
+        }
+        else
+        {
+            const hid_t accessList = H5Pcreate(H5P_FILE_ACCESS);
+#if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+            if (comm_.size() > 1)
+                H5Pset_fapl_mpio(accessList, mpiCommunicator_(comm_), MPI_INFO_NULL);
+#endif
+            if (flags == H5F_ACC_TRUNC)
+                createFile_(accessList);
+            else
+                file_ = H5Fopen(hdf5FileName().c_str(), flags, accessList);
+            H5Pclose(accessList);
+        }
+
+        if (!keepOpen && file_ >= 0)
+        {
+            H5Fclose(file_);
+            file_ = -1;
+        }
+    }
+
+    void createFile_(hid_t accessList)
+    {
+        file_ = H5Fcreate(hdf5FileName().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, accessList);
+        if (file_ < 0)
+            DUNE_THROW(Dune::IOError, "Could not create " << hdf5FileName());
+    }
+
+    //! creates the data sets (collective in parallel HDF5)
+    std::vector<hid_t> createDatasets_(const std::vector<Dataset>& datasets) const
+    {
+        // groups of the data set paths are created on the fly
+        const hid_t linkList = H5Pcreate(H5P_LINK_CREATE);
+        H5Pset_create_intermediate_group(linkList, 1);
+
+        std::vector<hid_t> ids;
+        for (const auto& dataset : datasets)
+        {
+            const int rank = dataset.numComponents > 1 ? 2 : 1;
+            const hsize_t dims[2] = {dataset.globalRows, dataset.numComponents};
+            const hid_t space = H5Screate_simple(rank, dims, nullptr);
+
+            // maybe store the data in compressed chunks
+            const hid_t createList = H5Pcreate(H5P_DATASET_CREATE);
+            if (compressionLevel_ > 0 && dataset.globalRows > 0)
+            {
+                const hsize_t chunk[2] = {std::min(hsize_t(dataset.globalRows), hsize_t(chunkRows)), dataset.numComponents};
+                H5Pset_chunk(createList, rank, chunk);
+                H5Pset_deflate(createList, compressionLevel_);
+            }
+
+            const hid_t fileType = dataset.memType == H5T_NATIVE_INT64 ? H5T_STD_I64LE : H5T_IEEE_F64LE;
+            const hid_t id = H5Dcreate2(file_, dataset.path.c_str(), fileType, space, linkList, createList, H5P_DEFAULT);
+            if (id < 0)
+                DUNE_THROW(Dune::IOError, "Could not create data set " << dataset.path << " in " << hdf5FileName());
+
+            ids.push_back(id);
+            H5Pclose(createList);
+            H5Sclose(space);
+        }
+
+        H5Pclose(linkList);
+        return ids;
+    }
+
+    //! writes the part of this process into a data set
+    void writeDataset_(hid_t id, const Dataset& dataset) const
+    {
+        const int rank = dataset.numComponents > 1 ? 2 : 1;
+        const hsize_t offset[2] = {dataset.offset, 0};
+        const hsize_t count[2] = {dataset.localRows, dataset.numComponents};
+
+        const hid_t fileSpace = H5Dget_space(id);
+        const hid_t memSpace = H5Screate_simple(rank, count, nullptr);
+        if (dataset.localRows > 0)
+            H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+        else
+        {
+            H5Sselect_none(fileSpace);
+            H5Sselect_none(memSpace);
+        }
+
+        const hid_t transferList = H5Pcreate(H5P_DATASET_XFER);
+#if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+        if (comm_.size() > 1)
+            H5Pset_dxpl_mpio(transferList, H5FD_MPIO_COLLECTIVE);
+#endif
+        const auto status = H5Dwrite(id, dataset.memType, memSpace, fileSpace, transferList, dataset.data);
+        H5Pclose(transferList);
+        H5Sclose(memSpace);
+        H5Sclose(fileSpace);
+
+        if (status < 0)
+            DUNE_THROW(Dune::IOError, "Could not write data set " << dataset.path << " in " << hdf5FileName());
+    }
+
+    //! writes the data sets of a time step (collective)
+    void writeDatasets_(const std::vector<Dataset>& datasets)
+    {
+        if (!serializedWrite_())
+        {
+            auto ids = createDatasets_(datasets);
+            for (std::size_t i = 0; i < datasets.size(); ++i)
+            {
+                writeDataset_(ids[i], datasets[i]);
+                H5Dclose(ids[i]);
+            }
+
+            // keep the file readable after each time step
+            H5Fflush(file_, H5F_SCOPE_GLOBAL);
+            return;
+        }
+
+        // the first process creates the data sets, then the processes write their chunks in turn
+        if (comm_.rank() == 0)
+        {
+            openFile_(H5F_ACC_RDWR, /*keepOpen=*/true);
+            for (auto id : createDatasets_(datasets))
+                H5Dclose(id);
+            H5Fclose(file_);
+            file_ = -1;
+        }
+        comm_.barrier();
+
+        for (int rank = 0; rank < comm_.size(); ++rank)
+        {
+            if (rank == comm_.rank())
+            {
+                openFile_(H5F_ACC_RDWR, /*keepOpen=*/true);
+                for (const auto& dataset : datasets)
+                {
+                    const hid_t id = H5Dopen2(file_, dataset.path.c_str(), H5P_DEFAULT);
+                    writeDataset_(id, dataset);
+                    H5Dclose(id);
+                }
+                H5Fclose(file_);
+                file_ = -1;
+            }
+            comm_.barrier();
+        }
+    }
+
+#if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+    //! the MPI communicator of a collective communication object
+    template<class C>
+    static MPI_Comm mpiCommunicator_(const C& comm)
+    { return comm; }
+#endif
+
+    //! the maximum number of rows of a compressed chunk
+    static constexpr hsize_t chunkRows = 65536;
+
+    hid_t file_ = -1;
+#endif
+
+    std::string name_;
+    Communication comm_;
+    int compressionLevel_;
+
+    // the mesh part of this process
+    std::vector<double> points_;
+    std::vector<std::int64_t> topology_;
+    std::size_t numPoints_ = 0, numCells_ = 0;
+    std::size_t pointOffset_ = 0, cellOffset_ = 0, topologyOffset_ = 0;
+    std::size_t globalNumPoints_ = 0, globalNumCells_ = 0, globalTopologySize_ = 0;
+    bool meshChanged_ = false;
+    bool meshWritten_ = false;
+    std::string meshPath_;
+    int meshIdx_ = 0;
+
+    // the fields of the next time step
+    std::vector<FieldData> fields_;
+    int stepIdx_ = 0;
+    std::streampos xdmfTailPos_ = 0;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,334 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief An output module writing dumux simulation data to a single HDF5 file with an XDMF descriptor
+ */
+#ifndef DUMUX_XDMF_OUTPUT_MODULE_HH
+#define DUMUX_XDMF_OUTPUT_MODULE_HH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/timer.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/io/file/vtk/common.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/profiler.hh>
+#include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/xdmf/hdf5xdmfwriter.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief An output module writing dumux simulation data as a time series into a single
+ *        HDF5 file (name.h5) with an XDMF descriptor (name.xmf) instead of one VTK file per
+ *        process and time step.
+ *
+ * Fields are registered exactly as for the VtkOutputModule (addVolumeVariable, addField,
+ * addVelocityOutput). The mesh is written once (and again after updateMesh() or a change
+ * of the grid size), for each call to write() only the fields are appended. The data sets
+ * can be compressed with the parameter Xdmf.CompressionLevel (0-9, default 0).
+ *
+ * \note Only conforming output is supported. In parallel, each process writes the vertices
+ *       of its interior elements, i.e. vertices on process borders appear more than once.
+ *
+ * \tparam GridVariables The grid variables
+ * \tparam SolutionVector The solution vector
+ */
+template<class GridVariables, class SolutionVector>
+class XdmfOutputModule
+: public VtkOutputModule<GridVariables, SolutionVector>
+{
+    using ParentType = VtkOutputModule<GridVariables, SolutionVector>;
+    using FVGridGeometry = typename GridVariables::GridGeometry;
+    using GridView = typename FVGridGeometry::GridView;
+    using Scalar = typename GridVariables::Scalar;
+    using Communication = std::decay_t<decltype(std::declval<GridView>().comm())>;
+    using Writer = Hdf5XdmfWriter<Communication>;
+
+    enum {
+        dim = GridView::dimension,
+        dimWorld = GridView::dimensionworld
+    };
+
+    static constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+
+public:
+    XdmfOutputModule(const GridVariables& gridVariables,
+                     const SolutionVector& sol,
+                     const std::string& name,
+                     const std::string& paramGroup = "",
+                     bool verbose = true)
+    : ParentType(gridVariables, sol, name, paramGroup, Dune::VTK::conforming, verbose)
+    , writer_(std::make_unique<Writer>(name, gridVariables.fvGridGeometry().gridView().comm(),
+                                       getParamFromGroup<int>(paramGroup, "Xdmf.CompressionLevel", 0)))
+    , addProcessRank_(getParamFromGroup<bool>(paramGroup, "Vtk.AddProcessRank"))
+    {}
+
+    //! Write the mesh again with the next time step, e.g. after grid adaption
+    void updateMesh()
+    { meshUpToDate_ = false; }
+
+    //! Write the data for this time step (collective)
+    void write(double time)
+    {
+        DUMUX_PROFILE_REGION("output");
+        Dune::Timer timer;
+
+        const auto& gridView = this->fvGridGeometry().gridView();
+        if (!meshUpToDate_ || numVertices_ != std::size_t(gridView.size(dim)) || numElements_ != std::size_t(gridView.size(0)))
+            setMesh_();
+
+        addVolVarData_();
+        addFields_();
+        writer_->write(time);
+
+        timer.stop();
+        if (this->verbose())
+            std::cout << "Writing output for problem \"" << this->name() << "\" to "
+                      << writer_->xdmfFileName() << ". Took " << timer.elapsed() << " seconds." << std::endl;
+    }
+
+private:
+    //! the interior elements and their vertices in output ordering
+    void setMesh_()
+    {
+        const auto& gridView = this->fvGridGeometry().gridView();
+        const auto& vertexMapper = this->fvGridGeometry().vertexMapper();
+        const auto& elementMapper = this->fvGridGeometry().elementMapper();
+
+        numVertices_ = gridView.size(dim);
+        numElements_ = gridView.size(0);
+        vertexToPoint_.assign(vertexMapper.size(), -1);
+        pointToVertex_.clear();
+        cellToElement_.clear();
+
+        std::vector<double> points;
+        std::vector<int> cellTypes;
+        std::vector<std::int64_t> connectivity;
+        for (const auto& element : elements(gridView, Dune::Partitions::interior))
+        {
+            const auto type = element.type();
+            cellToElement_.push_back(elementMapper.index(element));
+            cellTypes.push_back(cellType_(type));
+
+            const auto geometry = element.geometry();
+            for (int i = 0; i < geometry.corners(); ++i)
+            {
+                // the corners in VTK ordering
+                const int localIdx = Dune::VTK::renumber(type, i);
+                const auto vIdx = vertexMapper.subIndex(element, localIdx, dim);
+                if (vertexToPoint_[vIdx] < 0)
+                {
+                    vertexToPoint_[vIdx] = pointToVertex_.size();
+                    pointToVertex_.push_back(vIdx);
+
+                    const auto corner = geometry.corner(localIdx);
+                    for (int dimIdx = 0; dimIdx < 3; ++dimIdx)
+                        points.push_back(dimIdx < dimWorld ? corner[dimIdx] : 0.0);
+                }
+
+                connectivity.push_back(vertexToPoint_[vIdx]);
+            }
+        }
+
+        writer_->setMesh(std::move(points), cellTypes, connectivity);
+        meshUpToDate_ = true;
+    }
+
+    //! the XDMF cell type of a geometry type
+    static int cellType_(const Dune::GeometryType& type)
+    {
+        if (type.isVertex()) return Writer::polyvertex;
+        else if (type.isLine()) return Writer::polyline;
+        else if (type.isTriangle()) return Writer::triangle;
+        else if (type.isQuadrilateral()) return Writer::quadrilateral;
+        else if (type.isTetrahedron()) return Writer::tetrahedron;
+        else if (type.isPyramid()) return Writer::pyramid;
+        else if (type.isPrism()) return Writer::wedge;
+        else if (type.isHexahedron()) return Writer::hexahedron;
+        else DUNE_THROW(Dune::NotImplemented, "XDMF output for geometry type " << type);
+    }
+
+    //! gathers values indexed by vertex or element index in output ordering
+    template<class Values>
+    std::vector<double> gather_(const Values& values, bool isCellData, std::size_t numComponents) const
+    {
+        const auto& entities = isCellData ? cellToElement_ : pointToVertex_;
+        std::vector<double> result(entities.size()*numComponents, 0.0);
+        for (std::size_t i = 0; i < entities.size(); ++i)
+            for (std::size_t compIdx = 0; compIdx < numComponents; ++compIdx)
+                result[i*numComponents + compIdx] = component_(values[entities[i]], compIdx);
+        return result;
+    }
+
+    //! the component of a scalar or vector (vectors are padded with zeros to three components)
+    static double component_(Scalar value, std::size_t compIdx)
+    { return value; }
+
+    template<class Vector>
+    static double component_(const Vector& value, std::size_t compIdx)
+    { return compIdx < value.size() ? value[compIdx] : 0.0; }
+
+    //! the number of components of vectors in the output
+    static constexpr std::size_t numVectorComponents_()
+    { return dimWorld > 1 ? 3 : 1; }
+
+    //! evaluates the volume variables, the velocities and the process rank
+    void addVolVarData_()
+    {
+        const auto& scalarInfo = this->volVarScalarDataInfo();
+        const auto& vectorInfo = this->volVarVectorDataInfo();
+        const auto& velocityOutput = this->velocityOutput();
+
+        if (scalarInfo.empty() && vectorInfo.empty() && !velocityOutput.enableOutput() && !addProcessRank_)
+            return;
+
+        const auto& fvGridGeometry = this->fvGridGeometry();
+        const auto numDofs = isBox ? fvGridGeometry.vertexMapper().size() : fvGridGeometry.elementMapper().size();
+
+        using VolVarsVector = Dune::FieldVector<Scalar, dimWorld>;
+        std::vector<std::vector<Scalar>> scalarData(scalarInfo.size(), std::vector<Scalar>(numDofs));
+        std::vector<std::vector<VolVarsVector>> vectorData(vectorInfo.size(), std::vector<VolVarsVector>(numDofs));
+
+        // velocities are cell data except for the box scheme in more than one dimension
+        constexpr bool velocityAtVertices = isBox && dim > 1;
+        using VelocityVector = typename ParentType::VelocityOutput::VelocityVector;
+        std::vector<VelocityVector> velocity(velocityOutput.numFluidPhases());
+        for (auto& v : velocity)
+            v.resize(velocityAtVertices ? numDofs : fvGridGeometry.gridView().size(0));
+
+        auto fvGeometry = localView(fvGridGeometry);
+        auto elemVolVars = localView(this->gridVariables().curGridVolVars());
+        for (const auto& element : elements(fvGridGeometry.gridView(), Dune::Partitions::interior))
+        {
+            // the velocity requires the whole stencil, the volume variables only element-local data
+            if (velocityOutput.enableOutput())
+            {
+                fvGeometry.bind(element);
+                elemVolVars.bind(element, fvGeometry, this->sol());
+            }
+            else
+            {
+                fvGeometry.bindElement(element);
+                elemVolVars.bindElement(element, fvGeometry, this->sol());
+            }
+
+            for (auto&& scv : scvs(fvGeometry))
+            {
+                const auto dofIdxGlobal = scv.dofIndex();
+                const auto& volVars = elemVolVars[scv];
+                for (std::size_t i = 0; i < scalarInfo.size(); ++i)
+                    scalarData[i][dofIdxGlobal] = scalarInfo[i].get(volVars);
+                for (std::size_t i = 0; i < vectorInfo.size(); ++i)
+                    vectorData[i][dofIdxGlobal] = vectorInfo[i].get(volVars);
+            }
+
+            if (velocityOutput.enableOutput())
+                for (int phaseIdx = 0; phaseIdx < velocityOutput.numFluidPhases(); ++phaseIdx)
+                    velocityOutput.calculateVelocity(velocity[phaseIdx], elemVolVars, fvGeometry, element, phaseIdx);
+        }
+
+        for (std::size_t i = 0; i < scalarInfo.size(); ++i)
+            addData_(scalarInfo[i].name, gather_(scalarData[i], !isBox, 1), 1, !isBox);
+        for (std::size_t i = 0; i < vectorInfo.size(); ++i)
+            addData_(vectorInfo[i].name, gather_(vectorData[i], !isBox, numVectorComponents_()), numVectorComponents_(), !isBox);
+
+        if (velocityOutput.enableOutput())
+            for (int phaseIdx = 0; phaseIdx < velocityOutput.numFluidPhases(); ++phaseIdx)
+                addData_("velocity_" + velocityOutput.phaseName(phaseIdx) + " (m/s)",
+                         gather_(velocity[phaseIdx], !velocityAtVertices, numVectorComponents_()),
+                         numVectorComponents_(), !velocityAtVertices);
+
+        if (addProcessRank_)
+            addData_("process rank", std::vector<double>(cellToElement_.size(), fvGridGeometry.gridView().comm().rank()), 1, true);
+    }
+
+    //! evaluates the user fields at the cells or at the element corners
+    void addFields_()
+    {
+        const auto& gridView = this->fvGridGeometry().gridView();
+        const auto& vertexMapper = this->fvGridGeometry().vertexMapper();
+
+        for (const auto& field : this->fields())
+        {
+            const bool isCellData = field.codim() == 0;
+            if (!isCellData && field.codim() != dim)
+                DUNE_THROW(Dune::RangeError, "Cannot add wrongly sized field " << field.name());
+
+            const std::size_t numComponents = field.ncomps();
+            const auto numEntities = isCellData ? cellToElement_.size() : pointToVertex_.size();
+            std::vector<double> values(numEntities*numComponents);
+            std::size_t cellIdx = 0;
+            for (const auto& element : elements(gridView, Dune::Partitions::interior))
+            {
+                const auto& refElement = Dune::ReferenceElements<typename GridView::ctype, dim>::general(element.type());
+                if (isCellData)
+                {
+                    // the cells are numbered in the order of the interior elements
+                    const auto& center = refElement.position(0, 0);
+                    for (std::size_t compIdx = 0; compIdx < numComponents; ++compIdx)
+                        values[cellIdx*numComponents + compIdx] = field.evaluate(int(compIdx), element, center);
+                    ++cellIdx;
+                }
+                else
+                {
+                    for (int i = 0; i < refElement.size(dim); ++i)
+                    {
+                        const auto pointIdx = vertexToPoint_[vertexMapper.subIndex(element, i, dim)];
+                        for (std::size_t compIdx = 0; compIdx < numComponents; ++compIdx)
+                            values[pointIdx*numComponents + compIdx] = field.evaluate(int(compIdx), element, refElement.position(i, dim));
+                    }
+                }
+            }
+
+            addData_(field.name(), std::move(values), numComponents, isCellData);
+        }
+    }
+
+    void addData_(const std::string& name, std::vector<double>&& values, std::size_t numComponents, bool isCellData)
+    {
+        if (isCellData)
+            writer_->addCellData(name, std::move(values), numComponents);
+        else
+            writer_->addPointData(name, std::move(values), numComponents);
+    }
+
+    std::unique_ptr<Writer> writer_;
+    bool addProcessRank_;
+    bool meshUpToDate_ = false;
+    std::size_t numVertices_ = 0, numElements_ = 0;
+
+    // the maps between the grid entities and the points and cells of the output
+    std::vector<std::int64_t> vertexToPoint_;
+    std::vector<std::size_t> pointToVertex_;
+    std::vector<std::size_t> cellToElement_;
+};
+
+} // end namespace Dumux
+
+#endif
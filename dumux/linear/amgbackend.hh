@@ -35,6 +35,7 @@
 #include <dune/istl/paamg/pinfo.hh>
 #include <dune/istl/solvers.hh>
 
+#include <dumux/common/profiler.hh>
 #include <dumux/linear/solver.hh>
 #include <dumux/linear/amgparallelhelpers.hh>
 
@@ -147,15 +148,36 @@ public:
         smootherArgs.iterations = 1;
         smootherArgs.relaxationFactor = 1;
 
-        AMGType amg(*fop, criterion, smootherArgs, *comm);
-        Dune::BiCGSTABSolver<VType> solver(*fop, *sp, amg, this->residReduction(), this->maxIter(),
+        std::unique_ptr<AMGType> amg;
+        {
+            DUMUX_PROFILE_REGION("preconditioner setup");
+            amg = std::make_unique<AMGType>(*fop, criterion, smootherArgs, *comm);
+        }
+
+        Dune::BiCGSTABSolver<VType> solver(*fop, *sp, *amg, this->residReduction(), this->maxIter(),
                                            rank == 0 ? this->verbosity() : 0);
 
-        solver.apply(x, b, result_);
+        {
+            DUMUX_PROFILE_REGION("iterations");
+            solver.apply(x, b, result_);
+        }
         firstCall_ = false;
         return result_.converged;
     }
 
+    /*!
+     * \brief Update the parallel index information after the grid was changed
+     *
+     * Has to be called after grid adaptation or load balancing in parallel runs
+     * to recompute the markers for ghost and owned degrees of freedom.
+     */
+    void updateAfterGridAdaption()
+    {
+        firstCall_ = true;
+        if (phelper_)
+            phelper_->initGhostsAndOwners();
+    }
+
     /*!
      * \brief The name of the solver
      */
@@ -383,9 +383,9 @@ public:
     //
     void initGhostsAndOwners()
     {
-        owner_.resize(mapper_.size(),
+        owner_.assign(mapper_.size(),
                       gridView_.comm().rank());
-        isGhost_.resize(mapper_.size(),0.0);
+        isGhost_.assign(mapper_.size(),0.0);
         // find out about ghosts
         GhostGatherScatter ggs(owner_, mapper_);
 
@@ -0,0 +1,485 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Linear
+ * \brief Field-split (block) preconditioners and solvers for Dune::MultiTypeBlockMatrix systems
+ */
+#ifndef DUMUX_LINEAR_FIELDSPLIT_SOLVER_HH
+#define DUMUX_LINEAR_FIELDSPLIT_SOLVER_HH
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/indices.hh>
+#include <dune/common/version.hh>
+#include <dune/istl/matrixindexset.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+#include <dune/istl/umfpack.hh>
+#include <dune/istl/paamg/amg.hh>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/typetraits/utility.hh>
+#include <dumux/linear/solver.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Linear
+ * \brief The ways to combine the sub-solvers of a field-split preconditioner
+ */
+enum class FieldSplitType
+{
+    additive,       //!< block Jacobi: all blocks are solved independently
+    multiplicative, //!< block Gauss-Seidel: the lower coupling blocks are taken into account
+    schur           //!< block LDU factorization with an approximate Schur complement (two blocks only)
+};
+
+namespace Detail {
+
+/*!
+ * \ingroup Linear
+ * \brief AMG for a sub block of a field-split preconditioner (owns the linear operator)
+ * \note The aggregation is set up for the dimension of the grid the block is discretized on
+ */
+template<class M, class X, class Y>
+class FieldSplitAMG : public Dune::Preconditioner<X, Y>
+{
+    using LinearOperator = Dune::MatrixAdapter<M, X, Y>;
+    using Smoother = Dune::SeqSSOR<M, X, Y>;
+    using SmootherArgs = typename Dune::Amg::SmootherTraits<Smoother>::Arguments;
+    using Criterion = Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<M, Dune::Amg::FirstDiagonal>>;
+    using AMG = Dune::Amg::AMG<LinearOperator, X, Smoother>;
+
+public:
+    FieldSplitAMG(const M& m, int dimension, int verbosity)
+    : op_(m)
+    {
+        Dune::Amg::Parameters params(15, 2000, 1.2, 1.6, Dune::Amg::atOnceAccu);
+        params.setDefaultValuesIsotropic(dimension);
+        params.setDebugLevel(verbosity);
+        Criterion criterion(params);
+
+        SmootherArgs smootherArgs;
+        smootherArgs.iterations = 1;
+        smootherArgs.relaxationFactor = 1;
+
+        amg_ = std::make_unique<AMG>(op_, criterion, smootherArgs);
+    }
+
+    void pre (X& v, Y& d) final
+    { amg_->pre(v, d); }
+
+    void apply (X& v, const Y& d) final
+    { amg_->apply(v, d); }
+
+    void post (X& v) final
+    { amg_->post(v); }
+
+    Dune::SolverCategory::Category category() const final
+    { return Dune::SolverCategory::sequential; }
+
+private:
+    LinearOperator op_;
+    std::unique_ptr<AMG> amg_;
+};
+
+#if HAVE_UMFPACK
+/*!
+ * \ingroup Linear
+ * \brief Direct solver (UMFPack) for a sub block of a field-split preconditioner
+ */
+template<class M, class X, class Y>
+class FieldSplitDirect : public Dune::Preconditioner<X, Y>
+{
+public:
+    FieldSplitDirect(const M& m, int verbosity)
+    : solver_(m, verbosity > 0)
+    {}
+
+    void pre (X& v, Y& d) final {}
+
+    void apply (X& v, const Y& d) final
+    {
+        Y dTmp(d);
+        Dune::InverseOperatorResult result;
+        solver_.apply(v, dTmp, result);
+    }
+
+    void post (X&) final {}
+
+    Dune::SolverCategory::Category category() const final
+    { return Dune::SolverCategory::sequential; }
+
+private:
+    Dune::UMFPack<M> solver_;
+};
+#endif // HAVE_UMFPACK
+
+/*!
+ * \ingroup Linear
+ * \brief Create the sub-solver for a block of a field-split preconditioner
+ * \param m The matrix block
+ * \param type The sub-solver type (amg, ilu or direct)
+ * \param dimension The dimension of the grid of the block (amg)
+ * \param relaxation The relaxation factor (ilu)
+ * \param verbosity The verbosity level
+ */
+template<class M, class X, class Y>
+std::shared_ptr<Dune::Preconditioner<X, Y>> makeFieldSplitSubSolver(const M& m, const std::string& type, int dimension,
+                                                                    double relaxation, int verbosity)
+{
+    if (type == "amg")
+        return std::make_shared<FieldSplitAMG<M, X, Y>>(m, dimension, verbosity);
+    else if (type == "ilu")
+    {
+#if DUNE_VERSION_NEWER(DUNE_ISTL,2,6)
+        return std::make_shared<Dune::SeqILU<M, X, Y>>(m, relaxation);
+#else
+        return std::make_shared<Dune::SeqILU0<M, X, Y>>(m, relaxation);
+#endif
+    }
+    else if (type == "direct")
+    {
+#if HAVE_UMFPACK
+        return std::make_shared<FieldSplitDirect<M, X, Y>>(m, verbosity);
+#else
+        DUNE_THROW(Dune::NotImplemented, "Direct field-split sub-solvers require UMFPack");
+#endif
+    }
+
+    DUNE_THROW(ParameterException, "Unknown field-split sub-solver type " << type << ". Use amg, ilu or direct.");
+}
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Linear
+ * \brief A field-split preconditioner for systems with N blocks
+ *
+ * Each diagonal block is approximately inverted by its own sub-solver (AMG, ILU0 or a direct solver).
+ * The sub-solvers are combined additively (block Jacobi), multiplicatively (block Gauss-Seidel)
+ * or, for two blocks, by a block LDU factorization using the approximate Schur complement
+ * \f$ S = D - C \, \mathrm{diag}(A)^{-1} B \f$ of the system
+ * | A  B |
+ * | C  D |
+ *
+ * \tparam M The Dune::MultiTypeBlockMatrix type
+ * \tparam X The domain vector type
+ * \tparam Y The range vector type
+ */
+template<class M, class X, class Y>
+class FieldSplitPreconditioner : public Dune::Preconditioner<X, Y>
+{
+    static constexpr std::size_t numBlocks = M::size();
+    using LastIdx = Dune::index_constant<numBlocks-1>;
+
+    template<std::size_t i>
+    using DiagBlockType = std::decay_t<decltype(std::declval<M>()[Dune::index_constant<i>{}][Dune::index_constant<i>{}])>;
+
+    template<std::size_t i>
+    using VecBlockType = std::decay_t<decltype(std::declval<X>()[Dune::index_constant<i>{}])>;
+
+    template<std::size_t i>
+    using SubSolver = std::shared_ptr<Dune::Preconditioner<VecBlockType<i>, VecBlockType<i>>>;
+
+    using SubSolverTuple = typename makeFromIndexedType<std::tuple, SubSolver, std::make_index_sequence<numBlocks>>::type;
+
+public:
+    //! \brief The matrix type the preconditioner is for.
+    using matrix_type = typename std::decay_t<M>;
+    //! \brief The domain type of the preconditioner.
+    using domain_type = X;
+    //! \brief The range type of the preconditioner.
+    using range_type = Y;
+    //! \brief The field type of the preconditioner.
+    using field_type = typename X::field_type;
+
+    /*!
+     * \brief Constructor
+     * \param m The (multi type block) matrix to operate on
+     * \param type How the sub-solvers are combined
+     * \param subSolverTypes The sub-solver type (amg, ilu or direct) for each block
+     * \param dimensions The dimension of the grid of each block (used to set up the amg sub-solvers)
+     * \param relaxation The relaxation factor for the ilu sub-solvers
+     * \param verbosity The verbosity level
+     */
+    FieldSplitPreconditioner(const M& m, FieldSplitType type,
+                             const std::array<std::string, numBlocks>& subSolverTypes,
+                             const std::array<int, numBlocks>& dimensions,
+                             double relaxation = 1.0, int verbosity = 0)
+    : m_(m)
+    , type_(type)
+    {
+        if (type_ == FieldSplitType::schur && numBlocks != 2)
+            DUNE_THROW(Dune::NotImplemented, "The Schur complement field split is only implemented for two blocks");
+
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(subSolvers_)), [&](const auto i)
+        {
+            // for the Schur variant, the last sub-solver acts on the Schur complement (see below)
+            if (type_ == FieldSplitType::schur && i == numBlocks-1)
+                return;
+
+            using MatrixBlock = DiagBlockType<decltype(i)::value>;
+            using VectorBlock = VecBlockType<decltype(i)::value>;
+            std::get<decltype(i)::value>(subSolvers_)
+                = Detail::makeFieldSplitSubSolver<MatrixBlock, VectorBlock, VectorBlock>(m_[i][i], subSolverTypes[i], dimensions[i],
+                                                                                         relaxation, verbosity);
+        });
+
+        if (type_ == FieldSplitType::schur)
+        {
+            using namespace Dune::Indices;
+            computeApproximateSchurComplement_(m_[_0][_0], m_[_0][LastIdx{}], m_[LastIdx{}][_0], m_[LastIdx{}][LastIdx{}]);
+
+            using VectorBlock = VecBlockType<numBlocks-1>;
+            std::get<numBlocks-1>(subSolvers_)
+                = Detail::makeFieldSplitSubSolver<DiagBlockType<numBlocks-1>, VectorBlock, VectorBlock>(schurComplement_, subSolverTypes[numBlocks-1],
+                                                                                                         dimensions[numBlocks-1], relaxation, verbosity);
+        }
+    }
+
+    void pre (X& v, Y& d) final
+    {
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(subSolvers_)), [&](const auto i)
+        {
+            std::get<decltype(i)::value>(subSolvers_)->pre(v[i], d[i]);
+        });
+    }
+
+    void apply (X& v, const Y& d) final
+    {
+        if (type_ == FieldSplitType::additive)
+            applyAdditive_(v, d);
+        else if (type_ == FieldSplitType::multiplicative)
+            applyMultiplicative_(v, d);
+        else
+            applySchur_(v, d);
+    }
+
+    void post (X& v) final
+    {
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(subSolvers_)), [&](const auto i)
+        {
+            std::get<decltype(i)::value>(subSolvers_)->post(v[i]);
+        });
+    }
+
+    //! Category of the preconditioner (see SolverCategory::Category)
+    Dune::SolverCategory::Category category() const final
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    //! v_i = P_i^-1 d_i
+    void applyAdditive_(X& v, const Y& d)
+    {
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(subSolvers_)), [&](const auto i)
+        {
+            v[i] = 0.0;
+            std::get<decltype(i)::value>(subSolvers_)->apply(v[i], d[i]);
+        });
+    }
+
+    //! v_i = P_i^-1 (d_i - sum_{j<i} A_ij v_j)
+    void applyMultiplicative_(X& v, const Y& d)
+    {
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(subSolvers_)), [&](const auto i)
+        {
+            auto r = d[i];
+            forEach(integralRange(Dune::Hybrid::size(subSolvers_)), [&](const auto j)
+            {
+                if (j < i)
+                    m_[i][j].mmv(v[j], r);
+            });
+
+            v[i] = 0.0;
+            std::get<decltype(i)::value>(subSolvers_)->apply(v[i], r);
+        });
+    }
+
+    //! block LDU solve with the approximate Schur complement
+    void applySchur_(X& v, const Y& d)
+    {
+        using namespace Dune::Indices;
+        auto& solverA = *std::get<0>(subSolvers_);
+        auto& solverS = *std::get<numBlocks-1>(subSolvers_);
+
+        // v_0 = A^-1 d_0
+        v[_0] = 0.0;
+        solverA.apply(v[_0], d[_0]);
+
+        // v_1 = S^-1 (d_1 - C v_0)
+        auto r1 = d[LastIdx{}];
+        m_[LastIdx{}][_0].mmv(v[_0], r1);
+        v[LastIdx{}] = 0.0;
+        solverS.apply(v[LastIdx{}], r1);
+
+        // v_0 = A^-1 (d_0 - B v_1)
+        auto r0 = d[_0];
+        m_[_0][LastIdx{}].mmv(v[LastIdx{}], r0);
+        v[_0] = 0.0;
+        solverA.apply(v[_0], r0);
+    }
+
+    //! assemble S = D - C diag(A)^-1 B
+    template<class MA, class MB, class MC, class MD>
+    void computeApproximateSchurComplement_(const MA& a, const MB& b, const MC& c, const MD& d)
+    {
+        // the inverse of the diagonal of A
+        std::vector<typename MA::block_type> invDiagA(a.N());
+        for (std::size_t i = 0; i < a.N(); ++i)
+        {
+            invDiagA[i] = a[i][i];
+            invDiagA[i].invert();
+        }
+
+        // the occupation pattern of S is the union of the patterns of D and C*B
+        Dune::MatrixIndexSet pattern(d.N(), d.M());
+        pattern.import(d);
+        for (auto cRow = c.begin(); cRow != c.end(); ++cRow)
+            for (auto cCol = cRow->begin(); cCol != cRow->end(); ++cCol)
+                for (auto bCol = b[cCol.index()].begin(); bCol != b[cCol.index()].end(); ++bCol)
+                    pattern.add(cRow.index(), bCol.index());
+
+        schurComplement_.setBuildMode(MD::random);
+        pattern.exportIdx(schurComplement_);
+        schurComplement_ = 0.0;
+
+        for (auto dRow = d.begin(); dRow != d.end(); ++dRow)
+            for (auto dCol = dRow->begin(); dCol != dRow->end(); ++dCol)
+                schurComplement_[dRow.index()][dCol.index()] = *dCol;
+
+        for (auto cRow = c.begin(); cRow != c.end(); ++cRow)
+        {
+            for (auto cCol = cRow->begin(); cCol != cRow->end(); ++cCol)
+            {
+                auto cInvA = *cCol;
+                cInvA.rightmultiply(invDiagA[cCol.index()]);
+                for (auto bCol = b[cCol.index()].begin(); bCol != b[cCol.index()].end(); ++bCol)
+                    schurComplement_[cRow.index()][bCol.index()] -= cInvA.rightmultiplyany(*bCol);
+            }
+        }
+    }
+
+    const M& m_;
+    FieldSplitType type_;
+    SubSolverTuple subSolvers_;
+    DiagBlockType<numBlocks-1> schurComplement_;
+};
+
+/*!
+ * \ingroup Linear
+ * \brief A BiCGSTAB solver preconditioned by a field-split preconditioner
+ * \note expects a system as a multi-type block-matrix with an arbitrary number of blocks
+ * \note Reads the following parameters from the parameter tree
+ *       - LinearSolver.FieldSplit.Type additive, multiplicative (default) or schur
+ *       - LinearSolver.FieldSplit.SubSolverTypes amg, ilu (default) or direct, either
+ *         one entry for all blocks or one entry per block
+ *       - LinearSolver.FieldSplit.AmgDimensions the dimension of the grid of each block, used to set
+ *         up the aggregation of the amg sub-solvers, either one entry for all blocks or one entry
+ *         per block (default: 3)
+ */
+class FieldSplitBiCGSTABSolver : public LinearSolver
+{
+public:
+    FieldSplitBiCGSTABSolver(const std::string& paramGroup = "")
+    : LinearSolver(paramGroup)
+    {
+        const auto type = getParamFromGroup<std::string>(paramGroup, "LinearSolver.FieldSplit.Type", "multiplicative");
+        if (type == "additive")
+            type_ = FieldSplitType::additive;
+        else if (type == "multiplicative")
+            type_ = FieldSplitType::multiplicative;
+        else if (type == "schur")
+            type_ = FieldSplitType::schur;
+        else
+            DUNE_THROW(ParameterException, "Unknown field split type " << type << ". Use additive, multiplicative or schur.");
+
+        subSolverTypes_ = getParamFromGroup<std::vector<std::string>>(paramGroup, "LinearSolver.FieldSplit.SubSolverTypes",
+                                                                      std::vector<std::string>{"ilu"});
+        dimensions_ = getParamFromGroup<std::vector<int>>(paramGroup, "LinearSolver.FieldSplit.AmgDimensions",
+                                                          std::vector<int>{3});
+    }
+
+    template<int precondBlockLevel = 2, class Matrix, class Vector>
+    bool solve(const Matrix& m, Vector& x, const Vector& b)
+    {
+        const auto subSolverTypes = valuePerBlock_<Matrix::size()>(subSolverTypes_, "LinearSolver.FieldSplit.SubSolverTypes");
+        const auto dimensions = valuePerBlock_<Matrix::size()>(dimensions_, "LinearSolver.FieldSplit.AmgDimensions");
+
+        FieldSplitPreconditioner<Matrix, Vector, Vector> preconditioner(m, type_, subSolverTypes, dimensions,
+                                                                        this->relaxation(), this->verbosity());
+        Dune::MatrixAdapter<Matrix, Vector, Vector> op(m);
+        Dune::BiCGSTABSolver<Vector> solver(op, preconditioner, this->residReduction(),
+                                            this->maxIter(), this->verbosity());
+        auto bTmp(b);
+        solver.apply(x, bTmp, result_);
+
+        return result_.converged;
+    }
+
+    const Dune::InverseOperatorResult& result() const
+    {
+      return result_;
+    }
+
+    std::string name() const
+    { return "field-split preconditioned BiCGSTAB solver"; }
+
+private:
+    //! expand a parameter with one entry for all blocks or one entry per block
+    template<std::size_t numBlocks, class T>
+    std::array<T, numBlocks> valuePerBlock_(const std::vector<T>& values, const std::string& param) const
+    {
+        std::array<T, numBlocks> valuePerBlock;
+        if (values.size() == 1)
+            valuePerBlock.fill(values[0]);
+        else if (values.size() == numBlocks)
+            std::copy(values.begin(), values.end(), valuePerBlock.begin());
+        else
+            DUNE_THROW(ParameterException, param << " needs one entry or one entry per block (" << numBlocks << ")");
+        return valuePerBlock;
+    }
+
+    FieldSplitType type_;
+    std::vector<std::string> subSolverTypes_;
+    std::vector<int> dimensions_;
+    Dune::InverseOperatorResult result_;
+};
+
+} // end namespace Dumux
+
+#endif
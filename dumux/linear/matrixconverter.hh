@@ -24,6 +24,9 @@
 #ifndef DUMUX_MATRIX_CONVERTER
 #define DUMUX_MATRIX_CONVERTER
 
+#include <cassert>
+#include <vector>
+
 #include <dune/common/indices.hh>
 #include <dune/common/hybridutilities.hh>
 #include <dune/istl/bvector.hh>
@@ -39,6 +42,9 @@ namespace Dumux {
  * \brief A helper classe that converts a Dune::MultiTypeBlockMatrix into a plain Dune::BCRSMatrix
  * TODO: allow block sizes for BCRSMatrix other than 1x1 ?
  *
+ * Besides the static conversion function, objects of this class can be used to convert
+ * a matrix repeatedly (e.g. in every Newton iteration). The converted matrix and its
+ * occupation pattern are then stored and only the values are copied in subsequent conversions.
  */
 template <class MultiTypeBlockMatrix, class Scalar=double>
 class MatrixConverter
@@ -48,6 +54,9 @@ class MatrixConverter
 
 public:
 
+    MatrixConverter()
+    { M_.setBuildMode(BCRSMatrix::random); }
+
     /*!
      * \brief Converts the matrix to a type the IterativeSolverBackend can handle
      *
@@ -68,6 +77,39 @@ public:
         return M;
     }
 
+    /*!
+     * \brief Converts the matrix reusing the occupation pattern of the previous conversion
+     *
+     * The occupation pattern is recomputed if the size, the number of non-zero entries
+     * or the column indices of the matrix have changed (e.g. after grid adaption or
+     * changes of the coupling stencils) or after a call to reset().
+     *
+     * \param A The original multitype blockmatrix
+     * \return A reference to the converted matrix which is valid until the next call
+     */
+    const BCRSMatrix& convert(const MultiTypeBlockMatrix &A)
+    {
+        const auto numRows = getNumRows_(A);
+        const bool patternChanged = !patternIsSet_ || numRows != M_.N() || getNumNonZeros_(A) != M_.nonzeroes();
+
+        // copying the values fails if the column indices changed without changing the number of non-zeros
+        if (patternChanged || !copyValues_(M_, A))
+        {
+            M_.setSize(numRows, numRows);
+            setOccupationPattern_(M_, A);
+            patternIsSet_ = true;
+            copyValues_(M_, A);
+        }
+
+        return M_;
+    }
+
+    /*!
+     * \brief Enforce recomputing the occupation pattern in the next conversion
+     */
+    void reset()
+    { patternIsSet_ = false; }
+
 private:
 
     /*!
@@ -119,28 +161,56 @@ private:
     }
 
     /*!
-     * \brief Sets the occupation pattern (i.e. indices) for the converted matrix
+     * \brief Copies the values of the original matrix into the converted matrix
+     *
+     * The sub matrices are traversed from left to right, so the entries of each row of the
+     * converted matrix are visited in ascending column order. We therefore keep an iterator
+     * for each row instead of searching for the column index of each entry.
      *
      * \param M The converted matrix
-     * \param A The original subMatrix of the multitype blockmatrix
+     * \param A The original multitype blockmatrix
+     * \return false if the occupation pattern of M does not match the one of A
+     *         (the values of M are then incomplete)
      */
-    static void copyValues_(BCRSMatrix& M, const MultiTypeBlockMatrix& A)
+    static bool copyValues_(BCRSMatrix& M, const MultiTypeBlockMatrix& A)
     {
         // get number of rows
         const auto numRows = M.N();
 
+        // the current position in each row of the converted matrix
+        std::vector<typename BCRSMatrix::ColIterator> rowPosition, rowEnd;
+        rowPosition.reserve(numRows);
+        rowEnd.reserve(numRows);
+        for (auto row = M.begin(); row != M.end(); ++row)
+        {
+            rowPosition.push_back(row->begin());
+            rowEnd.push_back(row->end());
+        }
+
         // lambda function to copy the values
-        auto copyValues = [&M](const auto& subMatrix, const std::size_t startRow, const std::size_t startCol)
+        bool patternMatches = true;
+        auto copyValues = [&rowPosition, &rowEnd, &patternMatches](const auto& subMatrix, const std::size_t startRow, const std::size_t startCol)
         {
             using BlockType = typename std::decay_t<decltype(subMatrix)>::block_type;
             const auto blockSizeI = BlockType::rows;
             const auto blockSizeJ = BlockType::cols;
-            for (auto row = subMatrix.begin(); row != subMatrix.end(); ++row)
-                for (auto col = row->begin(); col != row->end(); ++col)
+            for (auto row = subMatrix.begin(); row != subMatrix.end() && patternMatches; ++row)
+                for (auto col = row->begin(); col != row->end() && patternMatches; ++col)
                     for (std::size_t i = 0; i < blockSizeI; ++i)
-                        for (std::size_t j = 0; j < blockSizeJ; ++j)
-                            M[startRow + row.index()*blockSizeI + i][startCol + col.index()*blockSizeJ + j] = subMatrix[row.index()][col.index()][i][j];
-
+                    {
+                        const auto rowIdx = startRow + row.index()*blockSizeI + i;
+                        auto& position = rowPosition[rowIdx];
+                        for (std::size_t j = 0; j < blockSizeJ; ++j, ++position)
+                        {
+                            if (position == rowEnd[rowIdx] || position.index() != startCol + col.index()*blockSizeJ + j)
+                            {
+                                patternMatches = false;
+                                return;
+                            }
+
+                            *position = (*col)[i][j];
+                        }
+                    }
         };
 
         std::size_t rowIndex = 0;
@@ -160,6 +230,28 @@ private:
                     rowIndex += SubBlockType::rows * subMatrix.N();
             });
         });
+
+        return patternMatches;
+    }
+
+    /*!
+     * \brief Calculates the number of non-zero entries of the converted matrix
+     *
+     * \param A The original multitype blockmatrix
+     */
+    static std::size_t getNumNonZeros_(const MultiTypeBlockMatrix& A)
+    {
+        std::size_t numNonZeros = 0;
+        Dune::Hybrid::forEach(A, [&numNonZeros](const auto& rowOfMultiTypeMatrix)
+        {
+            Dune::Hybrid::forEach(rowOfMultiTypeMatrix, [&numNonZeros](const auto& subMatrix)
+            {
+                using SubBlockType = typename std::decay_t<decltype(subMatrix)>::block_type;
+                numNonZeros += SubBlockType::rows * SubBlockType::cols * subMatrix.nonzeroes();
+            });
+        });
+
+        return numNonZeros;
     }
 
     /*!
@@ -181,6 +273,8 @@ private:
         return numRows;
     }
 
+    BCRSMatrix M_;
+    bool patternIsSet_ = false;
 };
 
 /*!
@@ -202,10 +296,23 @@ public:
      */
     static auto multiTypeToBlockVector(const MultiTypeBlockVector& b)
     {
-        const auto size = getSize_(b);
-
         BlockVector bTmp;
-        bTmp.resize(size);
+        multiTypeToBlockVector(b, bTmp);
+        return bTmp;
+    }
+
+    /*!
+     * \brief Copies a Dune::MultiTypeBlockVector into a plain 1x1 Dune::BlockVector
+     *        (the target vector is only reallocated if its size doesn't match)
+     *
+     * \param b The original multitype blockvector
+     * \param bTmp The plain blockvector where the values are copied to
+     */
+    static void multiTypeToBlockVector(const MultiTypeBlockVector& b, BlockVector& bTmp)
+    {
+        const auto size = getSize_(b);
+        if (bTmp.size() != size)
+            bTmp.resize(size);
 
         std::size_t startIndex = 0;
         Dune::Hybrid::forEach(b, [&bTmp, &startIndex](const auto& subVector)
@@ -218,8 +325,6 @@ public:
 
             startIndex += numEq*subVector.size();
         });
-
-        return bTmp;
     }
 
     /*!
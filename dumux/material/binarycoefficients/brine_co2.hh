@@ -24,6 +24,8 @@
 #ifndef DUMUX_BINARY_COEFF_BRINE_CO2_HH
 #define DUMUX_BINARY_COEFF_BRINE_CO2_HH
 
+#include <string>
+
 #include <dumux/common/parameters.hh>
 #include <dumux/material/components/brine.hh>
 #include <dumux/material/components/h2o.hh>
@@ -44,7 +46,36 @@ class Brine_CO2 {
     static const int lPhaseIdx = 0; // index of the liquid phase
     static const int gPhaseIdx = 1; // index of the gas phase
 
+    //! the runtime parameters of the binary coefficients
+    struct Params
+    {
+        explicit Params(const std::string& paramGroup)
+        : gasDiffCoeff(ParameterHandle<Scalar>::optional(paramGroup, "BinaryCoefficients.GasDiffCoeff"))
+        , liquidDiffCoeff(paramGroup, "BinaryCoefficients.LiquidDiffCoeff", 2e-9)
+        {}
+
+        // in case one might set these user-specific as e.g. in dumux-lecture/mm/convectivemixing
+        ParameterHandle<Scalar> gasDiffCoeff;
+        ParameterHandle<Scalar> liquidDiffCoeff;
+    };
+
+    //! the parameters (resolved in the global group on first use if init() has not been called)
+    static Params& params_()
+    {
+        static Params params("");
+        return params;
+    }
+
 public:
+    /*!
+     * \brief Resolve the runtime parameters of the binary coefficients
+     * \param paramGroup The parameter group in which to look for the parameters first
+     * \note This is called by the init() function of the brine-CO2 fluid system and
+     *       must not be called concurrently with the evaluation of the coefficients.
+     */
+    static void init(const std::string& paramGroup = "")
+    { params_() = Params(paramGroup); }
+
     /*!
      * \brief Binary diffusion coefficient \f$\mathrm{[m^2/s]}\f$ of water in the CO2 phase.
      *
@@ -54,17 +85,18 @@ public:
      */
     static Scalar gasDiffCoeff(Scalar temperature, Scalar pressure)
     {
-        if(!hasParam("BinaryCoefficients.GasDiffCoeff")) //in case one might set that user-specific as e.g. in dumux-lecture/mm/convectivemixing
-        {
-            //Diffusion coefficient of water in the CO2 phase
-            Scalar const PI=3.141593;
-            Scalar const k = 1.3806504e-23; // Boltzmann constant
-            Scalar const c = 4; // slip parameter, can vary between 4 (slip condition) and 6 (stick condition)
-            Scalar const R_h = 1.72e-10; // hydrodynamic radius of the solute
-            Scalar mu = CO2::gasViscosity(temperature, pressure); // CO2 viscosity
-            Scalar D = k / (c * PI * R_h) * (temperature / mu);
-            return D;
-        } else return getParam<Scalar>("BinaryCoefficients.GasDiffCoeff");
+        const auto& userGasDiffCoeff = params_().gasDiffCoeff;
+        if (userGasDiffCoeff.hasValue())
+            return userGasDiffCoeff.value();
+
+        //Diffusion coefficient of water in the CO2 phase
+        Scalar const PI=3.141593;
+        Scalar const k = 1.3806504e-23; // Boltzmann constant
+        Scalar const c = 4; // slip parameter, can vary between 4 (slip condition) and 6 (stick condition)
+        Scalar const R_h = 1.72e-10; // hydrodynamic radius of the solute
+        Scalar mu = CO2::gasViscosity(temperature, pressure); // CO2 viscosity
+        Scalar D = k / (c * PI * R_h) * (temperature / mu);
+        return D;
     }
 
     /*!
@@ -76,10 +108,7 @@ public:
     static Scalar liquidDiffCoeff(Scalar temperature, Scalar pressure)
     {
         //Diffusion coefficient of CO2 in the brine phase
-        if(!hasParam("BinaryCoefficients.LiquidDiffCoeff")) //in case one might set that user-specific as e.g. in dumux-lecture/mm/convectivemixing
-        {
-            return 2e-9;
-        } else return getParam<Scalar>("BinaryCoefficients.LiquidDiffCoeff");
+        return params_().liquidDiffCoeff.value();
     }
 
     /*!
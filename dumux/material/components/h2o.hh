@@ -189,14 +189,15 @@ public:
         if (pressure > pv) {
             // the pressure is too high, in this case we use the slope
             // of the enthalpy at the vapor pressure to regularize
+            const auto g = Region2::gibbsFreeEnergy(temperature, pv);
             Scalar dh_dp =
                 Rs*temperature*
                 Region2::tau(temperature)*
                 Region2::dPi_dp(pv)*
-                Region2::ddGamma_dTaudPi(temperature, pv);
+                g.ddGamma_dTaudPi;
 
             return
-                enthalpyRegion2_(temperature, pv) +
+                enthalpyRegion2_(temperature, g) +
                 (pressure - pv)*dh_dp;
         }
 
@@ -224,14 +225,15 @@ public:
         if (pressure < pv) {
             // the pressure is too low, in this case we use the slope
             // of the enthalpy at the vapor pressure to regularize
+            const auto g = Region1::gibbsFreeEnergy(temperature, pv);
             Scalar dh_dp =
                 Rs * temperature*
                 Region1::tau(temperature)*
                 Region1::dPi_dp(pv)*
-                Region1::ddGamma_dTaudPi(temperature, pv);
+                g.ddGamma_dTaudPi;
 
             return
-                enthalpyRegion1_(temperature, pv) +
+                enthalpyRegion1_(temperature, g) +
                 (pressure - pv)*dh_dp;
         }
 
@@ -815,102 +817,217 @@ public:
         return Common::thermalConductivityIAPWS(temperature, rho);
     }
 
+    /*!
+     * \brief The thermodynamic properties of a phase of pure water at a given temperature and pressure
+     */
+    struct PhaseProperties
+    {
+        Scalar density; //!< the density \f$\mathrm{[kg/m^3]}\f$
+        Scalar enthalpy; //!< the specific enthalpy \f$\mathrm{[J/kg]}\f$
+        Scalar internalEnergy; //!< the specific internal energy \f$\mathrm{[J/kg]}\f$
+        Scalar heatCapacity; //!< the specific isobaric heat capacity \f$\mathrm{[J/(kg*K)]}\f$
+        Scalar viscosity; //!< the dynamic viscosity \f$\mathrm{[Pa*s]}\f$
+    };
+
+    /*!
+     * \brief All thermodynamic properties of liquid water at once.
+     *
+     * The Gibbs free energy of region 1 and its derivatives are evaluated only once
+     * for all properties, whereas the individual functions (liquidDensity(),
+     * liquidEnthalpy(), ...) evaluate them per property. The result is identical
+     * to the one of the individual functions.
+     *
+     * \param temperature temperature of component in \f$\mathrm{[K]}\f$
+     * \param pressure pressure of component in \f$\mathrm{[Pa]}\f$
+     */
+    static PhaseProperties liquidProperties(Scalar temperature, Scalar pressure)
+    {
+        Region1::checkValidityRange(temperature, pressure, "Liquid properties");
+
+        // the regularized states are rare, use the individual functions for them
+        const Scalar pv = vaporPressure(temperature);
+        if (pressure < pv)
+        {
+            const Scalar rho = liquidDensity(temperature, pressure);
+            return {rho,
+                    liquidEnthalpy(temperature, pressure),
+                    liquidInternalEnergy(temperature, pressure),
+                    liquidHeatCapacity(temperature, pressure),
+                    Common::viscosity(temperature, rho)};
+        }
+
+        const auto g = Region1::gibbsFreeEnergy(temperature, pressure);
+        const Scalar rho = 1.0/volumeRegion1_(temperature, pressure, g);
+        return {rho,
+                enthalpyRegion1_(temperature, g),
+                internalEnergyRegion1_(temperature, pressure, g),
+                heatCap_p_Region1_(temperature, g),
+                Common::viscosity(temperature, rho)};
+    }
+
+    /*!
+     * \brief All thermodynamic properties of steam at once.
+     *
+     * The Gibbs free energy of region 2 and its derivatives are evaluated only once
+     * for all properties, whereas the individual functions (gasDensity(),
+     * gasEnthalpy(), ...) evaluate them per property. The result is identical
+     * to the one of the individual functions.
+     *
+     * \param temperature temperature of component in \f$\mathrm{[K]}\f$
+     * \param pressure pressure of component in \f$\mathrm{[Pa]}\f$
+     */
+    static PhaseProperties gasProperties(Scalar temperature, Scalar pressure)
+    {
+        Region2::checkValidityRange(temperature, pressure, "Gas properties");
+
+        // the regularized states are rare, use the individual functions for them
+        if (pressure < triplePressure() - 100 || pressure > vaporPressure(temperature))
+        {
+            const Scalar rho = gasDensity(temperature, pressure);
+            return {rho,
+                    gasEnthalpy(temperature, pressure),
+                    gasInternalEnergy(temperature, pressure),
+                    gasHeatCapacity(temperature, pressure),
+                    Common::viscosity(temperature, rho)};
+        }
+
+        const auto g = Region2::gibbsFreeEnergy(temperature, pressure);
+        const Scalar rho = 1.0/volumeRegion2_(temperature, pressure, g);
+        return {rho,
+                enthalpyRegion2_(temperature, g),
+                internalEnergyRegion2_(temperature, pressure, g),
+                heatCap_p_Region2_(temperature, g),
+                Common::viscosity(temperature, rho)};
+    }
+
 private:
+    using GibbsFreeEnergy = IAPWS::GibbsFreeEnergyDerivatives<Scalar>;
+
     // the unregularized specific enthalpy for liquid water
-    static constexpr Scalar enthalpyRegion1_(Scalar temperature, Scalar pressure)
+    static Scalar enthalpyRegion1_(Scalar temperature, Scalar pressure)
+    { return enthalpyRegion1_(temperature, Region1::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar enthalpyRegion1_(Scalar temperature, const GibbsFreeEnergy& g)
     {
         return
             Region1::tau(temperature) *
-            Region1::dGamma_dTau(temperature, pressure) *
+            g.dGamma_dTau *
             Rs*temperature;
     }
 
     // the unregularized specific isobaric heat capacity
-    static constexpr Scalar heatCap_p_Region1_(Scalar temperature, Scalar pressure)
+    static Scalar heatCap_p_Region1_(Scalar temperature, Scalar pressure)
+    { return heatCap_p_Region1_(temperature, Region1::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar heatCap_p_Region1_(Scalar temperature, const GibbsFreeEnergy& g)
     {
         return
             - Region1::tau(temperature) * Region1::tau(temperature) *
-            Region1::ddGamma_ddTau(temperature, pressure) *
+            g.ddGamma_ddTau *
             Rs;
     }
 
     // the unregularized specific isochoric heat capacity
     static Scalar heatCap_v_Region1_(Scalar temperature, Scalar pressure)
+    { return heatCap_v_Region1_(temperature, Region1::gibbsFreeEnergy(temperature, pressure)); }
+
+    static Scalar heatCap_v_Region1_(Scalar temperature, const GibbsFreeEnergy& g)
     {
         Scalar tau = Region1::tau(temperature);
-        Scalar num = Region1::dGamma_dPi(temperature, pressure) - tau * Region1::ddGamma_dTaudPi(temperature, pressure);
-        Scalar diff = num * num / Region1::ddGamma_ddPi(temperature, pressure);
+        Scalar num = g.dGamma_dPi - tau * g.ddGamma_dTaudPi;
+        Scalar diff = num * num / g.ddGamma_ddPi;
 
         return
             - tau * tau *
-            Region1::ddGamma_ddTau(temperature, pressure) * Rs +
+            g.ddGamma_ddTau * Rs +
             diff;
     }
 
     // the unregularized specific internal energy for liquid water
-    static constexpr Scalar internalEnergyRegion1_(Scalar temperature, Scalar pressure)
+    static Scalar internalEnergyRegion1_(Scalar temperature, Scalar pressure)
+    { return internalEnergyRegion1_(temperature, pressure, Region1::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar internalEnergyRegion1_(Scalar temperature, Scalar pressure, const GibbsFreeEnergy& g)
     {
         return
             Rs * temperature *
-            ( Region1::tau(temperature)*Region1::dGamma_dTau(temperature, pressure) -
-              Region1::pi(pressure)*Region1::dGamma_dPi(temperature, pressure));
+            ( Region1::tau(temperature)*g.dGamma_dTau -
+              Region1::pi(pressure)*g.dGamma_dPi);
     }
 
     // the unregularized specific volume for liquid water
-    static constexpr Scalar volumeRegion1_(Scalar temperature, Scalar pressure)
+    static Scalar volumeRegion1_(Scalar temperature, Scalar pressure)
+    { return volumeRegion1_(temperature, pressure, Region1::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar volumeRegion1_(Scalar temperature, Scalar pressure, const GibbsFreeEnergy& g)
     {
         return
             Region1::pi(pressure)*
-            Region1::dGamma_dPi(temperature, pressure) *
+            g.dGamma_dPi *
             Rs * temperature / pressure;
     }
 
     // the unregularized specific enthalpy for steam
-    static constexpr Scalar enthalpyRegion2_(Scalar temperature, Scalar pressure)
+    static Scalar enthalpyRegion2_(Scalar temperature, Scalar pressure)
+    { return enthalpyRegion2_(temperature, Region2::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar enthalpyRegion2_(Scalar temperature, const GibbsFreeEnergy& g)
     {
         return
             Region2::tau(temperature) *
-            Region2::dGamma_dTau(temperature, pressure) *
+            g.dGamma_dTau *
             Rs*temperature;
     }
 
     // the unregularized specific internal energy for steam
-    static constexpr Scalar internalEnergyRegion2_(Scalar temperature, Scalar pressure)
+    static Scalar internalEnergyRegion2_(Scalar temperature, Scalar pressure)
+    { return internalEnergyRegion2_(temperature, pressure, Region2::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar internalEnergyRegion2_(Scalar temperature, Scalar pressure, const GibbsFreeEnergy& g)
     {
         return
             Rs * temperature *
-            ( Region2::tau(temperature)*Region2::dGamma_dTau(temperature, pressure) -
-              Region2::pi(pressure)*Region2::dGamma_dPi(temperature, pressure));
+            ( Region2::tau(temperature)*g.dGamma_dTau -
+              Region2::pi(pressure)*g.dGamma_dPi);
     }
 
     // the unregularized specific isobaric heat capacity
-    static constexpr Scalar heatCap_p_Region2_(Scalar temperature, Scalar pressure)
+    static Scalar heatCap_p_Region2_(Scalar temperature, Scalar pressure)
+    { return heatCap_p_Region2_(temperature, Region2::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar heatCap_p_Region2_(Scalar temperature, const GibbsFreeEnergy& g)
     {
         return
             - Region2::tau(temperature) * Region2::tau(temperature) *
-            Region2::ddGamma_ddTau(temperature, pressure) *
+            g.ddGamma_ddTau *
             Rs;
     }
 
     // the unregularized specific isochoric heat capacity
     static Scalar heatCap_v_Region2_(Scalar temperature, Scalar pressure)
+    { return heatCap_v_Region2_(temperature, pressure, Region2::gibbsFreeEnergy(temperature, pressure)); }
+
+    static Scalar heatCap_v_Region2_(Scalar temperature, Scalar pressure, const GibbsFreeEnergy& g)
     {
         Scalar tau = Region2::tau(temperature);
         Scalar pi = Region2::pi(pressure);
-        Scalar num = 1 + pi * Region2::dGamma_dPi(temperature, pressure) + tau * pi * Region2::ddGamma_dTaudPi(temperature, pressure);
-        Scalar diff = num * num / (1 - pi * pi * Region2::ddGamma_ddPi(temperature, pressure));
+        Scalar num = 1 + pi * g.dGamma_dPi + tau * pi * g.ddGamma_dTaudPi;
+        Scalar diff = num * num / (1 - pi * pi * g.ddGamma_ddPi);
         return
             - tau * tau *
-            Region2::ddGamma_ddTau(temperature, pressure) * Rs
+            g.ddGamma_ddTau * Rs
             - diff;
     }
 
     // the unregularized specific volume for steam
-    static constexpr Scalar volumeRegion2_(Scalar temperature, Scalar pressure)
+    static Scalar volumeRegion2_(Scalar temperature, Scalar pressure)
+    { return volumeRegion2_(temperature, pressure, Region2::gibbsFreeEnergy(temperature, pressure)); }
+
+    static constexpr Scalar volumeRegion2_(Scalar temperature, Scalar pressure, const GibbsFreeEnergy& g)
     {
         return
             Region2::pi(pressure)*
-            Region2::dGamma_dPi(temperature, pressure) *
+            g.dGamma_dPi *
             Rs * temperature / pressure;
     }
 }; // end class
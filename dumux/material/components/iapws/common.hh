@@ -38,6 +38,25 @@
 namespace Dumux {
 namespace IAPWS {
 
+/*!
+ * \ingroup IAPWS
+ * \brief The dimensionless Gibbs free energy of an IAPWS '97 region and its partial
+ *        derivatives to the reduced temperature \f$\tau\f$ and the reduced pressure \f$\pi\f$,
+ *        evaluated together in a single pass over the coefficients of the region.
+ *
+ * \tparam Scalar The type used for scalar values
+ */
+template <class Scalar>
+struct GibbsFreeEnergyDerivatives
+{
+    Scalar gamma; //!< \f$\gamma\f$
+    Scalar dGamma_dTau; //!< \f$\partial\gamma/\partial\tau\f$
+    Scalar dGamma_dPi; //!< \f$\partial\gamma/\partial\pi\f$
+    Scalar ddGamma_dTaudPi; //!< \f$\partial^2\gamma/\partial\tau\partial\pi\f$
+    Scalar ddGamma_ddPi; //!< \f$\partial^2\gamma/\partial\pi^2\f$
+    Scalar ddGamma_ddTau; //!< \f$\partial^2\gamma/\partial\tau^2\f$
+};
+
 /*!
  * \ingroup IAPWS
  * \brief Implements relations which are common for all regions of the IAPWS '97
@@ -29,9 +29,11 @@
 #ifndef DUMUX_IAPWS_REGION1_HH
 #define DUMUX_IAPWS_REGION1_HH
 
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <dumux/common/exceptions.hh>
+#include <dumux/material/components/iapws/common.hh>
 
 namespace Dumux {
 namespace IAPWS {
@@ -285,7 +287,62 @@ public:
         return result;
     }
 
+    /*!
+     * \brief The Gibbs free energy and all its partial derivatives up to second order
+     *        for IAPWS region 1 (i.e. liquid) (dimensionless).
+     *
+     * All quantities are evaluated in a single pass over the coefficients. The integer
+     * powers of the reduced pressure and temperature terms are built incrementally in
+     * tables instead of calling std::pow for every coefficient and derivative.
+     *
+     * \param temperature temperature of component in \f$\mathrm{[K]}\f$
+     * \param pressure pressure of component in \f$\mathrm{[Pa]}\f$
+     */
+    static GibbsFreeEnergyDerivatives<Scalar> gibbsFreeEnergy(Scalar temperature, Scalar pressure)
+    {
+        const Scalar a = 7.1 - pi(pressure);
+        const Scalar b = tau(temperature) - 1.222;
+        const Scalar invA = 1.0/a;
+        const Scalar invB = 1.0/b;
+
+        // a^I for I in [0, 32]
+        std::array<Scalar, maxI + 1> powA;
+        powA[0] = 1.0;
+        for (int k = 1; k <= maxI; ++k)
+            powA[k] = powA[k-1]*a;
+
+        // b^J for J in [minJ, maxJ], stored at J - minJ
+        std::array<Scalar, maxJ - minJ + 1> powB;
+        powB[-minJ] = 1.0;
+        for (int k = 1; k <= maxJ; ++k)
+            powB[k - minJ] = powB[k - 1 - minJ]*b;
+        for (int k = 1; k <= -minJ; ++k)
+            powB[-k - minJ] = powB[-k + 1 - minJ]*invB;
+
+        GibbsFreeEnergyDerivatives<Scalar> result{0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        for (int i = 0; i < 34; ++i)
+        {
+            const int I_i = I(i);
+            const int J_i = J(i);
+            const Scalar term = n(i)*powA[I_i]*powB[J_i - minJ];
+
+            result.gamma += term;
+            result.dGamma_dTau += term*J_i*invB;
+            result.dGamma_dPi -= term*I_i*invA;
+            result.ddGamma_dTaudPi -= term*I_i*J_i*invA*invB;
+            result.ddGamma_ddPi += term*I_i*(I_i - 1)*invA*invA;
+            result.ddGamma_ddTau += term*J_i*(J_i - 1)*invB*invB;
+        }
+
+        return result;
+    }
+
 private:
+    // the range of the exponents of the coefficients
+    static constexpr int maxI = 32;
+    static constexpr int minJ = -41;
+    static constexpr int maxJ = 17;
+
     static Scalar n(int i)
     {
         constexpr Scalar n[34] = {
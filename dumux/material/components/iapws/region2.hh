@@ -30,9 +30,11 @@
 #ifndef DUMUX_IAPWS_REGION2_HH
 #define DUMUX_IAPWS_REGION2_HH
 
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <dumux/common/exceptions.hh>
+#include <dumux/material/components/iapws/common.hh>
 
 namespace Dumux {
 namespace IAPWS {
@@ -130,25 +132,7 @@ public:
      * http://www.iapws.org/relguide/IF97-Rev.pdf
      */
     static Scalar gamma(Scalar temperature, Scalar pressure)
-    {
-        Scalar tau = tau(temperature);   /* reduced temperature */
-        Scalar pi = pi(pressure);    /* reduced pressure */
-
-        Scalar result;
-
-        // ideal gas part
-        using std::pow;
-        result = ln(pi);
-        for (int i = 0; i < 9; ++i)
-            result += n_g(i)*pow(tau, J_g(i));
-
-        // residual part
-        for (int i = 0; i < 43; ++i)
-            result += n_r(i)*
-                      pow(pi, I_r(i))*
-                      pow(tau - 0.5, J_r(i));
-        return result;
-    }
+    { return gibbsFreeEnergy(temperature, pressure).gamma; }
 
     /*!
      * \brief The partial derivative of the Gibbs free energy to the
@@ -325,7 +309,80 @@ public:
         return result;
     }
 
+    /*!
+     * \brief The Gibbs free energy and all its partial derivatives up to second order
+     *        for IAPWS region 2 (i.e. sub-critical steam) (dimensionless).
+     *
+     * All quantities are evaluated in a single pass over the coefficients. The integer
+     * powers of the reduced pressure and temperature terms are built incrementally in
+     * tables instead of calling std::pow for every coefficient and derivative.
+     *
+     * \param temperature temperature of component in \f$\mathrm{[K]}\f$
+     * \param pressure pressure of component in \f$\mathrm{[Pa]}\f$
+     */
+    static GibbsFreeEnergyDerivatives<Scalar> gibbsFreeEnergy(Scalar temperature, Scalar pressure)
+    {
+        const Scalar tau_ = tau(temperature);   /* reduced temperature */
+        const Scalar pi_ = pi(pressure);    /* reduced pressure */
+        const Scalar c = tau_ - 0.5;
+        const Scalar invTau = 1.0/tau_;
+        const Scalar invPi = 1.0/pi_;
+        const Scalar invC = 1.0/c;
+
+        // ideal gas part, tau^J for J in [minJ_g, maxJ_g]
+        std::array<Scalar, maxJ_g - minJ_g + 1> powTau;
+        powTau[-minJ_g] = 1.0;
+        for (int k = 1; k <= maxJ_g; ++k)
+            powTau[k - minJ_g] = powTau[k - 1 - minJ_g]*tau_;
+        for (int k = 1; k <= -minJ_g; ++k)
+            powTau[-k - minJ_g] = powTau[-k + 1 - minJ_g]*invTau;
+
+        using std::log;
+        GibbsFreeEnergyDerivatives<Scalar> result{log(pi_), 0.0, invPi, 0.0, -invPi*invPi, 0.0};
+        for (int i = 0; i < 9; ++i)
+        {
+            const int J_i = static_cast<int>(J_g(i));
+            const Scalar term = n_g(i)*powTau[J_i - minJ_g];
+            result.gamma += term;
+            result.dGamma_dTau += term*J_i*invTau;
+            result.ddGamma_ddTau += term*J_i*(J_i - 1)*invTau*invTau;
+        }
+
+        // residual part, pi^I for I in [0, maxI_r] and (tau - 0.5)^J for J in [0, maxJ_r]
+        std::array<Scalar, maxI_r + 1> powPi;
+        powPi[0] = 1.0;
+        for (int k = 1; k <= maxI_r; ++k)
+            powPi[k] = powPi[k-1]*pi_;
+
+        std::array<Scalar, maxJ_r + 1> powC;
+        powC[0] = 1.0;
+        for (int k = 1; k <= maxJ_r; ++k)
+            powC[k] = powC[k-1]*c;
+
+        for (int i = 0; i < 43; ++i)
+        {
+            const int I_i = static_cast<int>(I_r(i));
+            const int J_i = static_cast<int>(J_r(i));
+            const Scalar term = n_r(i)*powPi[I_i]*powC[J_i];
+
+            result.gamma += term;
+            result.dGamma_dTau += term*J_i*invC;
+            result.dGamma_dPi += term*I_i*invPi;
+            result.ddGamma_dTaudPi += term*I_i*J_i*invPi*invC;
+            result.ddGamma_ddPi += term*I_i*(I_i - 1)*invPi*invPi;
+            result.ddGamma_ddTau += term*J_i*(J_i - 1)*invC*invC;
+        }
+
+        return result;
+    }
+
 private:
+    // the range of the exponents of the coefficients
+    static constexpr int minJ_g = -5;
+    static constexpr int maxJ_g = 3;
+    static constexpr int maxI_r = 24;
+    static constexpr int maxJ_r = 58;
+
     static Scalar n_g(int i)
     {
         constexpr const Scalar n[9] = {
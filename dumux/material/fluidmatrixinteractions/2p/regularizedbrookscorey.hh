@@ -263,6 +263,24 @@ public:
         return BrooksCorey::krw(params, swe);
     }
 
+    /*!
+     * \brief   The derivative of the regularized relative permeability
+     *          for the wetting phase w.r.t. the effective wetting phase saturation.
+     *
+     *  regularized part:
+     *    - below \f$\mathrm{\overline{S}_w =0}\f$ and above \f$\mathrm{\overline{S}_w =1}\f$: the slope is zero
+     *
+     *  For not-regularized part:
+        \copydetails BrooksCorey::dkrw_dswe()
+     */
+    static Scalar dkrw_dswe(const Params &params, Scalar swe)
+    {
+        if (swe <= 0.0 || swe >= 1.0)
+            return 0.0;
+
+        return BrooksCorey::dkrw_dswe(params, swe);
+    }
+
     /*!
      * \brief   Regularized version of the  relative permeability
      *          for the non-wetting phase of
@@ -286,6 +304,23 @@ public:
 
         return BrooksCorey::krn(params, swe);
     }
+
+    /*!
+     * \brief   The derivative of the regularized relative permeability
+     *          for the non-wetting phase w.r.t. the effective wetting phase saturation.
+     *
+     *  regularized part:
+     *    - below \f$\mathrm{\overline{S}_w =0}\f$ and above \f$\mathrm{\overline{S}_w =1}\f$: the slope is zero
+     *
+     * \copydetails BrooksCorey::dkrn_dswe()
+     */
+    static Scalar dkrn_dswe(const Params &params, Scalar swe)
+    {
+        if (swe <= 0.0 || swe >= 1.0)
+            return 0.0;
+
+        return BrooksCorey::dkrn_dswe(params, swe);
+    }
 };
 } // end namespace Dumux
 
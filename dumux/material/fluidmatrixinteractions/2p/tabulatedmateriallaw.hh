@@ -0,0 +1,178 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Fluidmatrixinteractions
+ * \brief An adapter evaluating two-phase material laws for effective
+ *        saturations from precomputed interpolation tables.
+ */
+#ifndef DUMUX_TABULATED_MATERIAL_LAW_HH
+#define DUMUX_TABULATED_MATERIAL_LAW_HH
+
+#include "tabulatedmateriallawparams.hh"
+
+namespace Dumux {
+
+/*!
+ * \ingroup Fluidmatrixinteractions
+ * \brief An adapter evaluating two-phase material laws for effective
+ *        saturations from precomputed interpolation tables.
+ *
+ * Evaluating regularized laws like RegularizedVanGenuchten or RegularizedBrooksCorey
+ * involves several calls to pow (and the construction of splines in the regularized
+ * ranges), which may dominate the cost of the volume variables update, in particular
+ * the inversion \f$S_w(p_c)\f$ in the Richards model. This adapter tabulates
+ * \f$p_c\f$, \f$k_{rw}\f$ and \f$k_{rn}\f$ and their derivatives once per parameter set
+ * on equidistant effective saturations in [0, 1] and evaluates monotone piecewise cubic
+ * interpolants instead (see TabulatedMaterialLawTable). The inverse \f$S_w(p_c)\f$ is
+ * the exact inverse of the interpolated capillary pressure. Outside of the tabulated
+ * range the tabulated law is evaluated directly, such that its end point
+ * regularization is preserved exactly.
+ *
+ * Like the tabulated law, it is defined for effective saturations and is usually
+ * wrapped by the EffToAbsLaw:
+ * \code
+ * using EffectiveLaw = TabulatedMaterialLaw<RegularizedVanGenuchten<Scalar>>;
+ * using MaterialLaw = EffToAbsLaw<EffectiveLaw>;
+ * \endcode
+ *
+ * \tparam EffLawT The material law for effective saturations to be tabulated
+ * \tparam ParamsT The parameters, containing the parameters of the tabulated law and the tables
+ */
+template<class EffLawT, class ParamsT = TabulatedMaterialLawParams<EffLawT>>
+class TabulatedMaterialLaw
+{
+    using EffLaw = EffLawT;
+
+public:
+    using Params = ParamsT;
+    using Scalar = typename EffLaw::Scalar;
+
+    /*!
+     * \brief The capillary pressure-saturation curve
+     * \param params The parameters
+     * \param swe The effective saturation of the wetting phase
+     */
+    static Scalar pc(const Params& params, Scalar swe)
+    {
+        if (swe < 0.0 || swe > 1.0)
+            return EffLaw::pc(params, swe);
+        return params.table().eval(Table::pcIdx, swe);
+    }
+
+    /*!
+     * \brief The saturation-capillary pressure curve, the inverse of pc()
+     * \param params The parameters
+     * \param pc The capillary pressure
+     */
+    static Scalar sw(const Params& params, Scalar pc)
+    {
+        const auto& table = params.table();
+        if (pc > table.frontValue(Table::pcIdx) || pc < table.backValue(Table::pcIdx))
+            return EffLaw::sw(params, pc);
+        return table.inversePc(pc);
+    }
+
+    /*!
+     * \brief The capillary pressure at the maximum effective wetting saturation
+     * \param params The parameters
+     */
+    static Scalar endPointPc(const Params& params)
+    { return EffLaw::endPointPc(params); }
+
+    /*!
+     * \brief The derivative of the capillary pressure w.r.t. the effective saturation
+     * \param params The parameters
+     * \param swe The effective saturation of the wetting phase
+     */
+    static Scalar dpc_dswe(const Params& params, Scalar swe)
+    {
+        if (swe < 0.0 || swe > 1.0)
+            return EffLaw::dpc_dswe(params, swe);
+        return params.table().evalDerivative(Table::pcIdx, swe);
+    }
+
+    /*!
+     * \brief The derivative of the effective saturation w.r.t. the capillary pressure
+     * \param params The parameters
+     * \param pc The capillary pressure
+     */
+    static Scalar dswe_dpc(const Params& params, Scalar pc)
+    {
+        const auto& table = params.table();
+        if (pc > table.frontValue(Table::pcIdx) || pc < table.backValue(Table::pcIdx))
+            return EffLaw::dswe_dpc(params, pc);
+        return 1.0/table.evalDerivative(Table::pcIdx, table.inversePc(pc));
+    }
+
+    /*!
+     * \brief The relative permeability of the wetting phase
+     * \param params The parameters
+     * \param swe The effective saturation of the wetting phase
+     */
+    static Scalar krw(const Params& params, Scalar swe)
+    {
+        if (swe < 0.0 || swe > 1.0)
+            return EffLaw::krw(params, swe);
+        return params.table().eval(Table::krwIdx, swe);
+    }
+
+    /*!
+     * \brief The derivative of the relative permeability of the wetting phase w.r.t. the effective saturation
+     * \param params The parameters
+     * \param swe The effective saturation of the wetting phase
+     */
+    static Scalar dkrw_dswe(const Params& params, Scalar swe)
+    {
+        if (swe < 0.0 || swe > 1.0)
+            return EffLaw::dkrw_dswe(params, swe);
+        return params.table().evalDerivative(Table::krwIdx, swe);
+    }
+
+    /*!
+     * \brief The relative permeability of the non-wetting phase
+     * \param params The parameters
+     * \param swe The effective saturation of the wetting phase
+     */
+    static Scalar krn(const Params& params, Scalar swe)
+    {
+        if (swe < 0.0 || swe > 1.0)
+            return EffLaw::krn(params, swe);
+        return params.table().eval(Table::krnIdx, swe);
+    }
+
+    /*!
+     * \brief The derivative of the relative permeability of the non-wetting phase w.r.t. the effective saturation
+     * \param params The parameters
+     * \param swe The effective saturation of the wetting phase
+     */
+    static Scalar dkrn_dswe(const Params& params, Scalar swe)
+    {
+        if (swe < 0.0 || swe > 1.0)
+            return EffLaw::dkrn_dswe(params, swe);
+        return params.table().evalDerivative(Table::krnIdx, swe);
+    }
+
+private:
+    using Table = typename Params::Table;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,362 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Fluidmatrixinteractions
+ * \brief Parameters of the tabulated adapter for two-phase material laws
+ *        and the tables of the monotone piecewise cubic interpolants.
+ */
+#ifndef DUMUX_TABULATED_MATERIAL_LAW_PARAMS_HH
+#define DUMUX_TABULATED_MATERIAL_LAW_PARAMS_HH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dumux/material/spatialparams/materiallawparamsstorage.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Fluidmatrixinteractions
+ * \brief Monotone piecewise cubic Hermite interpolants of the capillary pressure
+ *        and the relative permeabilities on equidistant effective saturations in [0, 1].
+ *
+ * The node slopes are the derivatives of the tabulated material law, limited after
+ * Fritsch & Carlson (1980) such that each interpolant is monotone wherever the tabulated
+ * curve is monotone. Derivatives are evaluated as derivatives of the interpolants,
+ * i.e. they are consistent with the interpolated values.
+ */
+template<class ScalarT>
+class TabulatedMaterialLawTable
+{
+public:
+    using Scalar = ScalarT;
+
+    //! the tabulated curves
+    enum Curve { pcIdx = 0, krwIdx = 1, krnIdx = 2, numCurves = 3 };
+
+    /*!
+     * \brief Sample the curves
+     *
+     * \param numIntervals The number of equidistant saturation intervals
+     * \param curve A function (curveIdx, swe) returning the value of the curve
+     * \param derivative A function (curveIdx, swe) returning the derivative of the curve
+     */
+    template<class CurveFunction, class DerivativeFunction>
+    TabulatedMaterialLawTable(std::size_t numIntervals,
+                              const CurveFunction& curve,
+                              const DerivativeFunction& derivative)
+    : numIntervals_(std::max<std::size_t>(numIntervals, 1))
+    , h_(1.0/numIntervals_)
+    {
+        for (int curveIdx = 0; curveIdx < numCurves; ++curveIdx)
+        {
+            auto& values = values_[curveIdx];
+            auto& slopes = slopes_[curveIdx];
+            values.resize(numIntervals_ + 1);
+            slopes.resize(numIntervals_ + 1);
+            for (std::size_t i = 0; i <= numIntervals_; ++i)
+            {
+                // the last node is exactly at swe = 1
+                const Scalar swe = i == numIntervals_ ? 1.0 : i*h_;
+                values[i] = curve(curveIdx, swe);
+                slopes[i] = derivative(curveIdx, swe);
+            }
+
+            makeMonotone_(values, slopes);
+        }
+    }
+
+    //! The number of equidistant saturation intervals
+    std::size_t numIntervals() const
+    { return numIntervals_; }
+
+    //! The interpolated curve for an effective saturation in [0, 1]
+    Scalar eval(Curve curveIdx, Scalar swe) const
+    {
+        std::size_t i; Scalar t;
+        locate_(swe, i, t);
+        return evalSegment_(curveIdx, i, t);
+    }
+
+    //! The derivative of the interpolated curve for an effective saturation in [0, 1]
+    Scalar evalDerivative(Curve curveIdx, Scalar swe) const
+    {
+        std::size_t i; Scalar t;
+        locate_(swe, i, t);
+        return evalSegmentDerivative_(curveIdx, i, t);
+    }
+
+    //! The value of a curve at the node with effective saturation 0.0
+    Scalar frontValue(Curve curveIdx) const
+    { return values_[curveIdx].front(); }
+
+    //! The value of a curve at the node with effective saturation 1.0
+    Scalar backValue(Curve curveIdx) const
+    { return values_[curveIdx].back(); }
+
+    /*!
+     * \brief The effective saturation at which the interpolated capillary pressure equals pc
+     *
+     * \note Only call this for capillary pressures in [backValue(pcIdx), frontValue(pcIdx)],
+     *       i.e. within the range of the tabulated (monotonically decreasing) curve.
+     */
+    Scalar inversePc(Scalar pc) const
+    {
+        const auto& values = values_[pcIdx];
+
+        // the first node with a capillary pressure smaller than pc ends the segment
+        const auto it = std::upper_bound(values.begin(), values.end(), pc, std::greater<Scalar>());
+        const std::size_t i = std::min<std::size_t>(std::max<std::ptrdiff_t>(it - values.begin(), 1) - 1, numIntervals_ - 1);
+
+        // the interpolant is monotone on the segment, invert it by safeguarded Newton iterations
+        Scalar tLow = 0.0, tHigh = 1.0;
+        const Scalar deltaPc = values[i+1] - values[i];
+        Scalar t = deltaPc != 0.0 ? std::min(std::max((pc - values[i])/deltaPc, Scalar(0.0)), Scalar(1.0)) : 0.5;
+        using std::abs;
+        for (int iter = 0; iter < 50; ++iter)
+        {
+            const Scalar f = evalSegment_(pcIdx, i, t) - pc;
+            if (f == 0.0)
+                break;
+
+            // decreasing curve: the root lies at larger t if f > 0
+            if (f > 0.0)
+                tLow = t;
+            else
+                tHigh = t;
+
+            const Scalar df = evalSegmentDerivative_(pcIdx, i, t)*h_;
+            Scalar tNew = df != 0.0 ? t - f/df : 0.5*(tLow + tHigh);
+            if (!(tNew > tLow && tNew < tHigh))
+                tNew = 0.5*(tLow + tHigh);
+
+            const bool converged = abs(tNew - t) < 1e-14;
+            t = tNew;
+            if (converged)
+                break;
+        }
+
+        return (i + t)*h_;
+    }
+
+private:
+    // the segment index and the local coordinate in [0, 1] of an effective saturation
+    void locate_(Scalar swe, std::size_t& i, Scalar& t) const
+    {
+        const Scalar x = swe*numIntervals_;
+        i = std::min(static_cast<std::size_t>(std::max(x, Scalar(0.0))), numIntervals_ - 1);
+        t = x - i;
+    }
+
+    // cubic Hermite interpolation on segment i
+    Scalar evalSegment_(int curveIdx, std::size_t i, Scalar t) const
+    {
+        const auto& y = values_[curveIdx];
+        const auto& m = slopes_[curveIdx];
+        const Scalar t2 = t*t;
+        const Scalar t3 = t2*t;
+        return (2*t3 - 3*t2 + 1)*y[i] + (t3 - 2*t2 + t)*h_*m[i]
+               + (-2*t3 + 3*t2)*y[i+1] + (t3 - t2)*h_*m[i+1];
+    }
+
+    // derivative w.r.t. the saturation of the cubic Hermite interpolation on segment i
+    Scalar evalSegmentDerivative_(int curveIdx, std::size_t i, Scalar t) const
+    {
+        const auto& y = values_[curveIdx];
+        const auto& m = slopes_[curveIdx];
+        const Scalar t2 = t*t;
+        return ((6*t2 - 6*t)*(y[i] - y[i+1]))/h_
+               + (3*t2 - 4*t + 1)*m[i] + (3*t2 - 2*t)*m[i+1];
+    }
+
+    // limit the slopes such that the interpolant is monotone on each segment (Fritsch & Carlson)
+    void makeMonotone_(const std::vector<Scalar>& values, std::vector<Scalar>& slopes) const
+    {
+        using std::isfinite; using std::sqrt;
+
+        // infinite slopes (e.g. of relative permeabilities at the end points) are replaced by secants
+        for (std::size_t i = 0; i <= numIntervals_; ++i)
+            if (!isfinite(slopes[i]))
+                slopes[i] = i < numIntervals_ ? (values[i+1] - values[i])/h_ : (values[i] - values[i-1])/h_;
+
+        for (std::size_t i = 0; i < numIntervals_; ++i)
+        {
+            const Scalar delta = (values[i+1] - values[i])/h_;
+            if (delta == 0.0)
+            {
+                slopes[i] = slopes[i+1] = 0.0;
+                continue;
+            }
+
+            // slopes of the wrong sign would cause overshoots
+            Scalar alpha = slopes[i]/delta;
+            Scalar beta = slopes[i+1]/delta;
+            if (alpha < 0.0) { slopes[i] = 0.0; alpha = 0.0; }
+            if (beta < 0.0) { slopes[i+1] = 0.0; beta = 0.0; }
+
+            const Scalar norm2 = alpha*alpha + beta*beta;
+            if (norm2 > 9.0)
+            {
+                const Scalar tau = 3.0/sqrt(norm2);
+                slopes[i] = tau*alpha*delta;
+                slopes[i+1] = tau*beta*delta;
+            }
+        }
+    }
+
+    std::size_t numIntervals_;
+    Scalar h_;
+    std::array<std::vector<Scalar>, numCurves> values_;
+    std::array<std::vector<Scalar>, numCurves> slopes_;
+};
+
+/*!
+ * \ingroup Fluidmatrixinteractions
+ * \brief The parameters of the tabulated adapter for two-phase material laws.
+ *
+ * Extends the parameters of the tabulated law by the interpolation tables. The tables
+ * are created on the first evaluation, so the parameters of the tabulated law have to be
+ * set before and must not be changed afterwards (or resetTable() has to be called).
+ * Tables are shared between all parameter objects comparing equal to each other,
+ * e.g. between all copies of the parameters of a material zone. They are found by the
+ * hash of the parameters in a registry guarded by a mutex, which only keeps weak references,
+ * i.e. a table is freed with the last parameter object using it.
+ *
+ * \note The lazy creation of the table of a single parameter object is not thread-safe.
+ *       Call table() once for each parameter object (e.g. by storing the parameters in a
+ *       MaterialLawParamsStorage) before evaluating the material law concurrently.
+ */
+template<class EffLawT>
+class TabulatedMaterialLawParams : public EffLawT::Params
+{
+    using EffLaw = EffLawT;
+    using EffLawParams = typename EffLaw::Params;
+
+public:
+    using Scalar = typename EffLawParams::Scalar;
+    using Table = TabulatedMaterialLawTable<Scalar>;
+
+    //! Set the number of equidistant saturation intervals of the tables (default: 1000)
+    void setNumIntervals(std::size_t numIntervals)
+    {
+        numIntervals_ = numIntervals;
+        resetTable();
+    }
+
+    //! The number of equidistant saturation intervals of the tables
+    std::size_t numIntervals() const
+    { return numIntervals_; }
+
+    //! Discard the tables, e.g. after changing the parameters of the tabulated law
+    void resetTable()
+    { table_.reset(); }
+
+    //! The interpolation tables (created on the first call)
+    const Table& table() const
+    {
+        if (!table_)
+            table_ = findOrCreateTable_();
+        return *table_;
+    }
+
+    //! The hash of the parameters of the tabulated law (equal parameters have equal hashes)
+    std::size_t hash() const
+    { return MaterialLawParamsHash<EffLawParams>()(*this); }
+
+private:
+    //! an entry of the table registry
+    struct TableEntry
+    {
+        EffLawParams params;
+        std::size_t numIntervals;
+        std::weak_ptr<const Table> table;
+    };
+
+    //! the tables in use, found by the hash of the parameters
+    struct TableRegistry
+    {
+        std::mutex mutex;
+        std::unordered_multimap<std::size_t, TableEntry> tables;
+    };
+
+    // reuse the tables of parameter sets comparing equal to this one
+    std::shared_ptr<const Table> findOrCreateTable_() const
+    {
+        const EffLawParams& params = *this;
+        const auto key = hash();
+
+        auto& registry = registry_();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const auto range = registry.tables.equal_range(key);
+        for (auto it = range.first; it != range.second;)
+        {
+            // remove the entries of tables that are no longer used
+            const auto table = it->second.table.lock();
+            if (!table)
+            {
+                it = registry.tables.erase(it);
+                continue;
+            }
+
+            if (it->second.numIntervals == numIntervals_ && it->second.params == params)
+                return table;
+            ++it;
+        }
+
+        auto curve = [&](int curveIdx, Scalar swe)
+        {
+            return curveIdx == Table::pcIdx ? EffLaw::pc(params, swe)
+                   : curveIdx == Table::krwIdx ? EffLaw::krw(params, swe)
+                   : EffLaw::krn(params, swe);
+        };
+
+        auto derivative = [&](int curveIdx, Scalar swe)
+        {
+            return curveIdx == Table::pcIdx ? EffLaw::dpc_dswe(params, swe)
+                   : curveIdx == Table::krwIdx ? EffLaw::dkrw_dswe(params, swe)
+                   : EffLaw::dkrn_dswe(params, swe);
+        };
+
+        auto table = std::make_shared<const Table>(numIntervals_, curve, derivative);
+        registry.tables.emplace(key, TableEntry{params, numIntervals_, table});
+        return table;
+    }
+
+    static TableRegistry& registry_()
+    {
+        static TableRegistry registry;
+        return registry;
+    }
+
+    std::size_t numIntervals_ = 1000;
+    mutable std::shared_ptr<const Table> table_;
+};
+
+} // end namespace Dumux
+
+#endif
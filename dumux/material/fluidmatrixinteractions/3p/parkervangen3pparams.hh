@@ -29,6 +29,7 @@
 #define PARKERVANGEN_PARAMS_3P_HH
 
 #include <dune/common/fvector.hh>
+#include <dune/common/float_cmp.hh>
 #include <iostream>
 
 namespace Dumux {
@@ -63,6 +64,25 @@ public:
         setRhoBulk(rhoBulk);
     }
 
+    /*!
+     * \brief Equality comparison with another set of params
+     */
+    template<class OtherParams>
+    bool operator== (const OtherParams& otherParams) const
+    {
+        return Dune::FloatCmp::eq(vgAlpha_, otherParams.vgAlpha(), /*eps*/1e-6*vgAlpha_)
+               && Dune::FloatCmp::eq(vgn_, otherParams.vgn(), /*eps*/1e-6*vgn_)
+               && Dune::FloatCmp::eq(swr_, otherParams.swr(), /*eps*/1e-6*swr_)
+               && Dune::FloatCmp::eq(snr_, otherParams.snr(), /*eps*/1e-6*snr_)
+               && Dune::FloatCmp::eq(sgr_, otherParams.sgr(), /*eps*/1e-6*sgr_)
+               && krRegardsSnr_ == otherParams.krRegardsSnr()
+               && Dune::FloatCmp::eq(KdNAPL_, otherParams.KdNAPL(), /*eps*/1e-6*KdNAPL_)
+               && Dune::FloatCmp::eq(rhoBulk_, otherParams.rhoBulk(), /*eps*/1e-6*rhoBulk_)
+               && Dune::FloatCmp::eq(betaNw_, otherParams.betaNw(), /*eps*/1e-6*betaNw_)
+               && Dune::FloatCmp::eq(betaGn_, otherParams.betaGn(), /*eps*/1e-6*betaGn_)
+               && Dune::FloatCmp::eq(betaGw_, otherParams.betaGw(), /*eps*/1e-6*betaGw_);
+    }
+
     /*!
      * \brief Return the \f$\mathrm{\alpha}\f$ shape parameter of van Genuchten's
      *        curve.
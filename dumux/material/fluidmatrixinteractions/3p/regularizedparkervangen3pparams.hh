@@ -60,6 +60,18 @@ public:
         pcHighS_ = 99e-2;
     }
 
+    /*!
+     * \brief Equality comparison with another set of params
+     */
+    template<class OtherParams>
+    bool operator== (const OtherParams& otherParams) const
+    {
+        return Dune::FloatCmp::eq(pcLowS_, otherParams.pcLowS(), /*eps*/1e-6*pcLowS_)
+               && Dune::FloatCmp::eq(pcHighS_, otherParams.pcHighS(), /*eps*/1e-6*pcHighS_)
+               && constRegularization_ == otherParams.constRegularization()
+               && ParkerVanGen3PParams::operator==(otherParams);
+    }
+
     /*!
      * \brief Threshold saturation below which the capillary pressure
      *        is regularized.
@@ -25,6 +25,10 @@
 #ifndef MP_LINEAR_MATERIAL_PARAMS_HH
 #define MP_LINEAR_MATERIAL_PARAMS_HH
 
+#include <cmath>
+
+#include <dune/common/float_cmp.hh>
+
 namespace Dumux {
 
 /*!
@@ -47,6 +51,20 @@ public:
         }
     }
 
+    /*!
+     * \brief Equality comparison with another set of params
+     */
+    template<class OtherParams>
+    bool operator== (const OtherParams& otherParams) const
+    {
+        using std::abs;
+        for (int i = 0; i < numPhases; ++i)
+            if (!Dune::FloatCmp::eq(pcMinSat_[i], otherParams.pcMinSat(i), /*eps*/1e-6*abs(pcMinSat_[i]))
+                || !Dune::FloatCmp::eq(pcMaxSat_[i], otherParams.pcMaxSat(i), /*eps*/1e-6*abs(pcMaxSat_[i])))
+                return false;
+        return true;
+    }
+
     /*!
      * \brief Return the threshold saturation at which the relative
      *        permeability starts to get regularized.
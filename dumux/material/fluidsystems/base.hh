@@ -24,6 +24,8 @@
 #ifndef DUMUX_BASE_FLUID_SYSTEM_HH
 #define DUMUX_BASE_FLUID_SYSTEM_HH
 
+#include <cassert>
+#include <cstddef>
 #include <string>
 
 #include <dune/common/exceptions.hh>
@@ -448,6 +450,114 @@ public:
     {
         return Implementation::heatCapacity(fluidState, phaseIdx);
     }
+
+    /*!
+     * \name Batched evaluation
+     *
+     * Evaluate a property of a fluid phase for a range of fluid states (e.g. the
+     * fluid states of all cells of a grid) at once. The fluid states and the values
+     * have to provide size() and operator[], and the values have to be of the same size
+     * as the fluid states. The default implementations loop over the fluid states
+     * reusing a single parameter cache. Fluid systems can hide them with implementations
+     * evaluating the states in a vectorizable way.
+     */
+    // \{
+
+    /*!
+     * \brief Calculate the densities \f$\mathrm{[kg/m^3]}\f$ of a fluid phase for a range of fluid states
+     * \param fluidStates The fluid states
+     * \param phaseIdx Index of the fluid phase
+     * \param values The densities
+     */
+    template <class FluidStates, class Values>
+    static void density(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        evaluateBatch_(fluidStates, phaseIdx, values, [](const auto& fs, const auto& paramCache, int phaseIdx)
+                       { return Implementation::density(fs, paramCache, phaseIdx); });
+    }
+
+    /*!
+     * \brief Calculate the molar densities \f$\mathrm{[mol/m^3]}\f$ of a fluid phase for a range of fluid states
+     * \param fluidStates The fluid states
+     * \param phaseIdx Index of the fluid phase
+     * \param values The molar densities
+     */
+    template <class FluidStates, class Values>
+    static void molarDensity(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        evaluateBatch_(fluidStates, phaseIdx, values, [](const auto& fs, const auto& paramCache, int phaseIdx)
+                       { return Implementation::molarDensity(fs, paramCache, phaseIdx); });
+    }
+
+    /*!
+     * \brief Calculate the dynamic viscosities \f$\mathrm{[Pa*s]}\f$ of a fluid phase for a range of fluid states
+     * \param fluidStates The fluid states
+     * \param phaseIdx Index of the fluid phase
+     * \param values The viscosities
+     */
+    template <class FluidStates, class Values>
+    static void viscosity(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        evaluateBatch_(fluidStates, phaseIdx, values, [](const auto& fs, const auto& paramCache, int phaseIdx)
+                       { return Implementation::viscosity(fs, paramCache, phaseIdx); });
+    }
+
+    /*!
+     * \brief Calculate the specific enthalpies \f$\mathrm{[J/kg]}\f$ of a fluid phase for a range of fluid states
+     * \param fluidStates The fluid states
+     * \param phaseIdx Index of the fluid phase
+     * \param values The specific enthalpies
+     */
+    template <class FluidStates, class Values>
+    static void enthalpy(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        evaluateBatch_(fluidStates, phaseIdx, values, [](const auto& fs, const auto& paramCache, int phaseIdx)
+                       { return Implementation::enthalpy(fs, paramCache, phaseIdx); });
+    }
+
+    /*!
+     * \brief Calculate the thermal conductivities \f$\mathrm{[W/(m K)]}\f$ of a fluid phase for a range of fluid states
+     * \param fluidStates The fluid states
+     * \param phaseIdx Index of the fluid phase
+     * \param values The thermal conductivities
+     */
+    template <class FluidStates, class Values>
+    static void thermalConductivity(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        evaluateBatch_(fluidStates, phaseIdx, values, [](const auto& fs, const auto& paramCache, int phaseIdx)
+                       { return Implementation::thermalConductivity(fs, paramCache, phaseIdx); });
+    }
+
+    /*!
+     * \brief Calculate the specific isobaric heat capacities \f$\mathrm{[J/(kg*K)]}\f$ of a fluid phase
+     *        for a range of fluid states
+     * \param fluidStates The fluid states
+     * \param phaseIdx Index of the fluid phase
+     * \param values The heat capacities
+     */
+    template <class FluidStates, class Values>
+    static void heatCapacity(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        evaluateBatch_(fluidStates, phaseIdx, values, [](const auto& fs, const auto& paramCache, int phaseIdx)
+                       { return Implementation::heatCapacity(fs, paramCache, phaseIdx); });
+    }
+
+    // \}
+
+private:
+    //! Evaluate a property for all fluid states reusing one parameter cache of the implementation
+    template <class FluidStates, class Values, class Evaluate>
+    static void evaluateBatch_(const FluidStates &fluidStates, int phaseIdx, Values &values, Evaluate&& evaluate)
+    {
+        assert(values.size() == fluidStates.size());
+
+        typename Implementation::ParameterCache paramCache;
+        for (std::size_t i = 0; i < fluidStates.size(); ++i)
+        {
+            paramCache.updatePhase(fluidStates[i], phaseIdx);
+            values[i] = evaluate(fluidStates[i], paramCache, phaseIdx);
+        }
+    }
 };
 
 } // end namespace FluidSystems
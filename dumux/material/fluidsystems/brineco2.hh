@@ -24,6 +24,8 @@
 #ifndef DUMUX_BRINE_CO2_FLUID_SYSTEM_HH
 #define DUMUX_BRINE_CO2_FLUID_SYSTEM_HH
 
+#include <array>
+#include <string>
 #include <type_traits>
 
 #include <dune/common/exceptions.hh>
@@ -32,6 +34,7 @@
 #include <dumux/material/idealgas.hh>
 #include <dumux/material/fluidsystems/base.hh>
 #include <dumux/material/fluidsystems/brine.hh>
+#include <dumux/material/fluidsystems/phasestateparametercache.hh>
 #include <dumux/material/fluidstates/adapter.hh>
 
 #include <dumux/material/components/brine.hh>
@@ -145,8 +148,20 @@ class BrineCO2
     //! if the implementation considers NaCl as a real compoent, it gets the index 2
     static constexpr int NaClIdx = 2;
 
+    //! The quantities stored in the parameter cache. They only depend on
+    //! the temperature, the pressure and the salinity of a phase.
+    enum CachedQuantity
+    {
+        liquidCO2MoleFractionIdx, gasH2OMoleFractionIdx, //!< the equilibrium composition
+        pureWaterDensityIdx, brineDensityIdx, co2DensityIdx,
+        viscosityIdx, brineEnthalpyIdx, h2oEnthalpyIdx, co2EnthalpyIdx,
+        diffusionCoefficientIdx,
+        numCachedQuantities
+    };
+
 public:
-    using ParameterCache = NullParameterCache;
+    //! The parameter cache storing the temperature and pressure dependent quantities of the phases
+    using ParameterCache = PhaseStateParameterCache<Scalar, /*numPhases=*/2, numCachedQuantities>;
 
     using H2O = H2OType;
     using Brine = BrineType;
@@ -325,15 +340,16 @@ public:
      ****************************************/
 
     // Initializing with salinity and default tables
-    static void init()
+    static void init(const std::string& paramGroup = "")
     {
         init(/*startTemp=*/273.15, /*endTemp=*/623.15, /*tempSteps=*/100,
-             /*startPressure=*/1e4, /*endPressure=*/40e6, /*pressureSteps=*/200);
+             /*startPressure=*/1e4, /*endPressure=*/40e6, /*pressureSteps=*/200, paramGroup);
     }
 
     // Initializing with custom tables
     static void init(Scalar startTemp, Scalar endTemp, int tempSteps,
-                     Scalar startPressure, Scalar endPressure, int pressureSteps)
+                     Scalar startPressure, Scalar endPressure, int pressureSteps,
+                     const std::string& paramGroup = "")
     {
         std::cout << "The Brine-CO2 fluid system was configured with the following policy:\n";
         std::cout << " - use constant salinity: " << std::boolalpha << Policy::useConstantSalinity() << "\n";
@@ -341,6 +357,9 @@ public:
 
         if (H2O::isTabulated)
             H2O::init(startTemp, endTemp, tempSteps, startPressure, endPressure, pressureSteps);
+
+        // resolve the runtime parameters of the binary coefficients
+        Brine_CO2::init(paramGroup);
     }
 
     using Base::density;
@@ -354,16 +373,32 @@ public:
      */
     template <class FluidState>
     static Scalar density(const FluidState& fluidState, int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return density(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief Given a phase's composition, temperature, pressure, and
+     *        the partial pressures of all components, return its
+     *        density \f$\mathrm{[kg/m^3]}\f$.
+     *
+     * \param fluidState The fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the phase
+     */
+    template <class FluidState>
+    static Scalar density(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
     {
         Scalar T = fluidState.temperature(phaseIdx);
         if (phaseIdx == liquidPhaseIdx)
-            return liquidDensityMixture_(fluidState);
+            return liquidDensityMixture_(fluidState, paramCache);
 
         else if (phaseIdx == gasPhaseIdx)
         {
             if (Policy::useCO2GasDensityAsGasMixtureDensity())
                 // use the CO2 gas density only and neglect compositional effects
-                return CO2::gasDensity(fluidState.temperature(phaseIdx), fluidState.pressure(phaseIdx));
+                return co2GasDensity_(fluidState, paramCache);
             else
             {
                 // assume ideal mixture: steam and CO2 don't "see" each other
@@ -388,14 +423,29 @@ public:
      */
     template <class FluidState>
     static Scalar molarDensity(const FluidState& fluidState, int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return molarDensity(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief The molar density \f$\rho_{mol,\alpha}\f$
+     *   of a fluid phase \f$\alpha\f$ in \f$\mathrm{[mol/m^3]}\f$
+     *
+     * \param fluidState The fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the phase
+     */
+    template <class FluidState>
+    static Scalar molarDensity(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
     {
         Scalar T = fluidState.temperature(phaseIdx);
         if (phaseIdx == liquidPhaseIdx)
-            return density(fluidState, phaseIdx)/fluidState.averageMolarMass(phaseIdx);
+            return density(fluidState, paramCache, phaseIdx)/fluidState.averageMolarMass(phaseIdx);
         else if (phaseIdx == gasPhaseIdx)
         {
             if (Policy::useCO2GasDensityAsGasMixtureDensity())
-                return CO2::gasMolarDensity(fluidState.temperature(phaseIdx), fluidState.pressure(phaseIdx));
+                return co2GasDensity_(fluidState, paramCache)/CO2::molarMass();
             else
             {
                 // assume ideal mixture: steam and CO2 don't "see" each other
@@ -420,16 +470,34 @@ public:
      */
     template <class FluidState>
     static Scalar viscosity(const FluidState& fluidState, int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return viscosity(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief Calculate the dynamic viscosity of a fluid phase \f$\mathrm{[Pa*s]}\f$
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     */
+    template <class FluidState>
+    static Scalar viscosity(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
     {
         Scalar T = fluidState.temperature(phaseIdx);
         Scalar p = fluidState.pressure(phaseIdx);
 
+        bindState_(fluidState, paramCache, phaseIdx);
         if (phaseIdx == liquidPhaseIdx)
-            return useConstantSalinity ? ConstantSalinityBrine::liquidViscosity(T, p)
-                                       : VariableSalinityBrine::viscosity( BrineAdapter<FluidState>(fluidState),
-                                                                           VariableSalinityBrine::liquidPhaseIdx );
+            return paramCache.get(phaseIdx, viscosityIdx, [&]
+            {
+                return useConstantSalinity ? ConstantSalinityBrine::liquidViscosity(T, p)
+                                           : VariableSalinityBrine::viscosity( BrineAdapter<FluidState>(fluidState),
+                                                                               VariableSalinityBrine::liquidPhaseIdx );
+            });
         else if (phaseIdx == gasPhaseIdx)
-            return CO2::gasViscosity(T, p);
+            return paramCache.get(phaseIdx, viscosityIdx, [&]{ return CO2::gasViscosity(T, p); });
 
         DUNE_THROW(Dune::InvalidStateException, "Invalid phase index.");
     }
@@ -465,6 +533,25 @@ public:
     static Scalar fugacityCoefficient(const FluidState& fluidState,
                                       int phaseIdx,
                                       int compIdx)
+    {
+        ParameterCache paramCache;
+        return fugacityCoefficient(fluidState, paramCache, phaseIdx, compIdx);
+    }
+
+    /*!
+     * \brief Returns the fugacity coefficient \f$\mathrm{[-]}\f$ of a component in a
+     *        phase.
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     * \param compIdx The index of the component
+     */
+    template <class FluidState>
+    static Scalar fugacityCoefficient(const FluidState& fluidState,
+                                      const ParameterCache& paramCache,
+                                      int phaseIdx,
+                                      int compIdx)
     {
         assert(0 <= compIdx && compIdx < numComponents);
 
@@ -484,11 +571,11 @@ public:
             assert(pl > 0 && pg > 0);
 
             // calulate the equilibrium composition for given T & p
+            const auto x = equilibriumMoleFractions_(fluidState, paramCache, liquidPhaseIdx);
             Scalar xlH2O, xgH2O;
             Scalar xlCO2, xgCO2;
-            const Scalar salinity = useConstantSalinity ? ConstantSalinityBrine::salinity()
-                                                        : fluidState.massFraction(liquidPhaseIdx, NaClIdx);
-            Brine_CO2::calculateMoleFractions(T, pl, salinity, /*knownGasPhaseIdx=*/-1, xlCO2, xgH2O);
+            xlCO2 = x[0];
+            xgH2O = x[1];
 
             // normalize the phase compositions
             using std::min;
@@ -526,24 +613,16 @@ public:
                                           const ParameterCache& paramCache,
                                           int phaseIdx)
     {
-        Scalar T = fluidState.temperature(phaseIdx);
-        Scalar p = fluidState.pressure(phaseIdx);
-
-        assert(T > 0);
-        assert(p > 0);
-
-        Scalar xgH2O;
-        Scalar xlCO2;
+        assert(fluidState.temperature(phaseIdx) > 0);
+        assert(fluidState.pressure(phaseIdx) > 0);
 
         // calulate the equilibrium composition for given T & p
-        const Scalar salinity = useConstantSalinity ? ConstantSalinityBrine::salinity()
-                                                    : fluidState.massFraction(liquidPhaseIdx, NaClIdx);
-        Brine_CO2::calculateMoleFractions(T, p, salinity, /*knowgasPhaseIdx=*/-1, xlCO2, xgH2O);
+        const auto x = equilibriumMoleFractions_(fluidState, paramCache, phaseIdx);
 
         if (phaseIdx == gasPhaseIdx)
-            return xgH2O;
+            return x[1];
         else if (phaseIdx == liquidPhaseIdx)
-            return xlCO2;
+            return x[0];
 
         DUNE_THROW(Dune::InvalidStateException, "Invalid phase index.");
     }
@@ -579,6 +658,11 @@ public:
     static Scalar diffusionCoefficient(const FluidState& fluidState, int phaseIdx, int compIdx)
     { DUNE_THROW(Dune::NotImplemented, "Diffusion coefficients"); }
 
+    //! \copydoc diffusionCoefficient(const FluidState&, int, int)
+    template <class FluidState>
+    static Scalar diffusionCoefficient(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx, int compIdx)
+    { return diffusionCoefficient(fluidState, phaseIdx, compIdx); }
+
     using Base::binaryDiffusionCoefficient;
     /*!
      * \brief Given the phase compositions, return the binary
@@ -593,6 +677,26 @@ public:
                                              int phaseIdx,
                                              int compIIdx,
                                              int compJIdx)
+    {
+        ParameterCache paramCache;
+        return binaryDiffusionCoefficient(fluidState, paramCache, phaseIdx, compIIdx, compJIdx);
+    }
+
+    /*!
+     * \brief Given the phase compositions, return the binary
+     *        diffusion coefficient \f$\mathrm{[m^2/s]}\f$ of two components in a phase.
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     * \param compIIdx Index of the component i
+     * \param compJIdx Index of the component j
+     */
+    template <class FluidState>
+    static Scalar binaryDiffusionCoefficient(const FluidState& fluidState,
+                                             const ParameterCache& paramCache,
+                                             int phaseIdx,
+                                             int compIIdx,
+                                             int compJIdx)
     {
         assert(0 <= compIIdx && compIIdx < numComponents);
         assert(0 <= compJIdx && compJIdx < numComponents);
@@ -608,7 +712,10 @@ public:
         if (phaseIdx == liquidPhaseIdx)
         {
             if (compIIdx == BrineOrH2OIdx && compJIdx == CO2Idx)
-                return Brine_CO2::liquidDiffCoeff(T, p);
+            {
+                bindState_(fluidState, paramCache, phaseIdx);
+                return paramCache.get(phaseIdx, diffusionCoefficientIdx, [&]{ return Brine_CO2::liquidDiffCoeff(T, p); });
+            }
             if (!useConstantSalinity && compIIdx == BrineOrH2OIdx && compJIdx == NaClIdx)
                 return VariableSalinityBrine::binaryDiffusionCoefficient( BrineAdapter<FluidState>(fluidState),
                                                                           VariableSalinityBrine::liquidPhaseIdx,
@@ -621,7 +728,10 @@ public:
         else if (phaseIdx == gasPhaseIdx)
         {
             if (compIIdx == BrineOrH2OIdx && compJIdx == CO2Idx)
-                return Brine_CO2::gasDiffCoeff(T, p);
+            {
+                bindState_(fluidState, paramCache, phaseIdx);
+                return paramCache.get(phaseIdx, diffusionCoefficientIdx, [&]{ return Brine_CO2::gasDiffCoeff(T, p); });
+            }
 
             // NaCl is expected to never be present in the gas phase. we need to
             // return a diffusion coefficient that does not case numerical problems.
@@ -645,16 +755,34 @@ public:
      */
     template <class FluidState>
     static Scalar enthalpy(const FluidState& fluidState, int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return enthalpy(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief Given the phase composition, return the specific
+     *        phase enthalpy \f$\mathrm{[J/kg]}\f$.
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     */
+    template <class FluidState>
+    static Scalar enthalpy(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
     {
         Scalar T = fluidState.temperature(phaseIdx);
         Scalar p = fluidState.pressure(phaseIdx);
 
+        bindState_(fluidState, paramCache, phaseIdx);
         if (phaseIdx == liquidPhaseIdx)
         {
             // Convert J/kg to kJ/kg
-            const Scalar h_ls1 = useConstantSalinity ? ConstantSalinityBrine::liquidEnthalpy(T, p)/1e3
-                                                     : VariableSalinityBrine::enthalpy( BrineAdapter<FluidState>(fluidState),
-                                                                                        VariableSalinityBrine::liquidPhaseIdx )/1e3;
+            const Scalar h_ls1 = paramCache.get(phaseIdx, brineEnthalpyIdx, [&]
+            {
+                return useConstantSalinity ? ConstantSalinityBrine::liquidEnthalpy(T, p)
+                                           : VariableSalinityBrine::enthalpy( BrineAdapter<FluidState>(fluidState),
+                                                                              VariableSalinityBrine::liquidPhaseIdx );
+            })/1e3;
 
             // mass fraction of CO2 in Brine
             const Scalar X_CO2_w = fluidState.massFraction(liquidPhaseIdx, CO2Idx);
@@ -664,8 +792,8 @@ public:
             const Scalar delta_hCO2 = (-57.4375 + T * 0.1325) * 1000/44;
 
             // enthalpy contribution of water and CO2 (kJ/kg)
-            const Scalar hw = H2O::liquidEnthalpy(T, p)/1e3;
-            const Scalar hg = CO2::liquidEnthalpy(T, p)/1e3 + delta_hCO2;
+            const Scalar hw = paramCache.get(phaseIdx, h2oEnthalpyIdx, [&]{ return H2O::liquidEnthalpy(T, p); })/1e3;
+            const Scalar hg = paramCache.get(phaseIdx, co2EnthalpyIdx, [&]{ return CO2::liquidEnthalpy(T, p); })/1e3 + delta_hCO2;
 
             // Enthalpy of brine with dissolved CO2 (kJ/kg)
             return (h_ls1 - X_CO2_w*hw + hg*X_CO2_w)*1e3;
@@ -674,8 +802,10 @@ public:
         {
             Scalar result = 0;
             // we assume NaCl to not enter the gas phase, only consider H2O and CO2
-            result += H2O::gasEnthalpy(T, p)*fluidState.massFraction(gasPhaseIdx, BrineOrH2OIdx);
-            result += CO2::gasEnthalpy(T, p) *fluidState.massFraction(gasPhaseIdx, CO2Idx);
+            result += paramCache.get(phaseIdx, h2oEnthalpyIdx, [&]{ return H2O::gasEnthalpy(T, p); })
+                      *fluidState.massFraction(gasPhaseIdx, BrineOrH2OIdx);
+            result += paramCache.get(phaseIdx, co2EnthalpyIdx, [&]{ return CO2::gasEnthalpy(T, p); })
+                      *fluidState.massFraction(gasPhaseIdx, CO2Idx);
             Valgrind::CheckDefined(result);
             return result;
         }
@@ -707,6 +837,11 @@ public:
         DUNE_THROW(Dune::InvalidStateException, "Invalid phase index.");
     }
 
+    //! \copydoc thermalConductivity(const FluidState&, int)
+    template <class FluidState>
+    static Scalar thermalConductivity(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
+    { return thermalConductivity(fluidState, phaseIdx); }
+
     using Base::heatCapacity;
     /*!
      * \copybrief Base::heatCapacity
@@ -734,16 +869,65 @@ public:
         DUNE_THROW(Dune::InvalidStateException, "Invalid phase index.");
     }
 
+    //! \copydoc heatCapacity(const FluidState&, int)
+    template <class FluidState>
+    static Scalar heatCapacity(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
+    { return heatCapacity(fluidState, phaseIdx); }
+
 private:
+    //! The salinity of the liquid phase
+    template<class FluidState>
+    static Scalar salinity_(const FluidState& fluidState)
+    {
+        return useConstantSalinity ? ConstantSalinityBrine::salinity()
+                                   : fluidState.massFraction(liquidPhaseIdx, NaClIdx);
+    }
+
+    //! Set the state of a phase in the parameter cache
+    template<class FluidState>
+    static void bindState_(const FluidState& fluidState, const ParameterCache& paramCache, int phaseIdx)
+    {
+        paramCache.bindState(phaseIdx, fluidState.temperature(phaseIdx),
+                             fluidState.pressure(phaseIdx), salinity_(fluidState));
+    }
+
+    /*!
+     * \brief The equilibrium mole fractions of CO2 in the liquid phase and of H2O in the
+     *        gas phase at the temperature and pressure of the given phase
+     */
+    template<class FluidState>
+    static std::array<Scalar, 2> equilibriumMoleFractions_(const FluidState& fluidState,
+                                                           const ParameterCache& paramCache,
+                                                           int phaseIdx)
+    {
+        bindState_(fluidState, paramCache, phaseIdx);
+        return paramCache.get(phaseIdx, {{liquidCO2MoleFractionIdx, gasH2OMoleFractionIdx}}, [&]
+        {
+            std::array<Scalar, 2> x;
+            Brine_CO2::calculateMoleFractions(fluidState.temperature(phaseIdx), fluidState.pressure(phaseIdx),
+                                              salinity_(fluidState), /*knownGasPhaseIdx=*/-1, x[0], x[1]);
+            return x;
+        });
+    }
+
+    //! The density of pure CO2 at the temperature and pressure of the gas phase
+    template<class FluidState>
+    static Scalar co2GasDensity_(const FluidState& fluidState, const ParameterCache& paramCache)
+    {
+        bindState_(fluidState, paramCache, gasPhaseIdx);
+        return paramCache.get(gasPhaseIdx, co2DensityIdx, [&]
+        { return CO2::gasDensity(fluidState.temperature(gasPhaseIdx), fluidState.pressure(gasPhaseIdx)); });
+    }
 
     /*!
      * \brief Liquid-phase density calculation of a mixture of brine and CO2 accounting for compositional effects.
      *
      * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
      * \return liquidDensity the liquid-phase density
      */
     template<class FluidState>
-    static Scalar liquidDensityMixture_(const FluidState& fluidState)
+    static Scalar liquidDensityMixture_(const FluidState& fluidState, const ParameterCache& paramCache)
     {
         const auto T = fluidState.temperature(liquidPhaseIdx);
         const auto p = fluidState.pressure(liquidPhaseIdx);
@@ -760,7 +944,8 @@ private:
                                          "defined below 250MPa (p = " << p << ")");
 
         // density of pure water
-        Scalar rho_pure = H2O::liquidDensity(T, p);
+        bindState_(fluidState, paramCache, liquidPhaseIdx);
+        const Scalar rho_pure = paramCache.get(liquidPhaseIdx, pureWaterDensityIdx, [&]{ return H2O::liquidDensity(T, p); });
 
         // density of water with dissolved CO2 (neglect NaCl)
         Scalar rho_lCO2;
@@ -777,7 +962,7 @@ private:
             xlBrine /= sumx;
             xlCO2 /= sumx;
 
-            rho_lCO2 = liquidDensityWaterCO2_(T, p, xlBrine, xlCO2);
+            rho_lCO2 = liquidDensityWaterCO2_(T, rho_pure, xlBrine, xlCO2);
         }
         else
         {
@@ -787,13 +972,16 @@ private:
             const auto sumMoleFrac = xlH2O + xlCO2;
             xlH2O = xlH2O/sumMoleFrac;
             xlCO2 = xlCO2/sumMoleFrac;
-            rho_lCO2 = liquidDensityWaterCO2_(T, p, xlH2O, xlCO2);
+            rho_lCO2 = liquidDensityWaterCO2_(T, rho_pure, xlH2O, xlCO2);
         }
 
         // density of brine (water with nacl)
-        Scalar rho_brine = useConstantSalinity ? ConstantSalinityBrine::liquidDensity(T, p)
-                                               : VariableSalinityBrine::density( BrineAdapter<FluidState>(fluidState),
-                                                                                 VariableSalinityBrine::liquidPhaseIdx );
+        const Scalar rho_brine = paramCache.get(liquidPhaseIdx, brineDensityIdx, [&]
+        {
+            return useConstantSalinity ? ConstantSalinityBrine::liquidDensity(T, p)
+                                       : VariableSalinityBrine::density( BrineAdapter<FluidState>(fluidState),
+                                                                         VariableSalinityBrine::liquidPhaseIdx );
+        });
 
         // contribution of co2 to the density
         Scalar contribCO2 = rho_lCO2 - rho_pure;
@@ -809,13 +997,13 @@ private:
      * \note this is used by liquidDensityMixture_
      *
      * \param temperature The temperature
-     * \param pl the liquid-phase pressure
+     * \param rho_pure the density of pure water at the liquid-phase temperature and pressure
      * \param xlH2O the liquid-phase H2O mole fraction
      * \param xlCO2 the liquid-phase CO2 mole fraction
      * \return the density of a mixture of CO2 in pure water
      */
     static Scalar liquidDensityWaterCO2_(Scalar temperature,
-                                         Scalar pl,
+                                         Scalar rho_pure,
                                          Scalar xlH2O,
                                          Scalar xlCO2)
     {
@@ -823,7 +1011,6 @@ private:
         const Scalar M_H2O = H2O::molarMass();
 
         const Scalar tempC = temperature - 273.15;        /* tempC : temperature in °C */
-        const Scalar rho_pure = H2O::liquidDensity(temperature, pl);
 
         // xlH2O is available, but in case of a pure gas phase
         // the value of M_T for the virtual liquid phase can become very large
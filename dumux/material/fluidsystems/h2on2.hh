@@ -25,7 +25,9 @@
 #define DUMUX_H2O_N2_FLUID_SYSTEM_HH
 
 #include <cassert>
+#include <cstddef>
 #include <iomanip>
+#include <vector>
 
 #include <dumux/common/valgrind.hh>
 #include <dumux/common/exceptions.hh>
@@ -40,6 +42,7 @@
 #include <dumux/io/name.hh>
 
 #include "base.hh"
+#include "phasestateparametercache.hh"
 
 namespace Dumux {
 namespace FluidSystems {
@@ -75,6 +78,16 @@ class H2ON2
     using TabulatedH2O = Components::TabulatedComponent<Dumux::Components::H2O<Scalar> >;
     using SimpleN2 = Dumux::Components::N2<Scalar>;
 
+    //! The quantities stored in the parameter cache. They only depend on
+    //! the temperature and the pressure of a phase.
+    enum CachedQuantity
+    {
+        h2oDensityIdx, h2oMolarDensityIdx, h2oViscosityIdx, n2ViscosityIdx,
+        h2oEnthalpyIdx, n2EnthalpyIdx, vaporPressureIdx, henryIdx,
+        diffusionCoefficientIdx,
+        numCachedQuantities
+    };
+
 public:
     using H2O = TabulatedH2O; //!< The components for pure water
     using N2 = SimpleN2; //!< The components for pure nitrogen
@@ -94,6 +107,9 @@ public:
     static constexpr int liquidCompIdx = H2OIdx; //!< index of the liquid component
     static constexpr int gasCompIdx = N2Idx; //!< index of the gas component
 
+    //! The parameter cache storing the temperature and pressure dependent quantities of the phases
+    using ParameterCache = PhaseStateParameterCache<Scalar, numPhases, numCachedQuantities>;
+
     /****************************************
      * Fluid phase related static parameters
      ****************************************/
@@ -371,6 +387,24 @@ public:
     template <class FluidState>
     static Scalar density(const FluidState &fluidState,
                           int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return density(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief Given a phase's composition, temperature, pressure, and
+     *        the partial pressures of all components, return its
+     *        density \f$\mathrm{[kg/m^3]}\f$.
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     */
+    template <class FluidState>
+    static Scalar density(const FluidState &fluidState,
+                          const ParameterCache &paramCache,
+                          int phaseIdx)
     {
         assert(0 <= phaseIdx  && phaseIdx < numPhases);
 
@@ -379,15 +413,16 @@ public:
 
         // liquid phase
         if (phaseIdx == liquidPhaseIdx) {
+            paramCache.bindState(phaseIdx, T, p);
             if (Policy::useH2ODensityAsLiquidMixtureDensity())
                 // assume pure water
-                return H2O::liquidDensity(T, p);
+                return paramCache.get(phaseIdx, h2oDensityIdx, [&]{ return H2O::liquidDensity(T, p); });
             else
             {
                 // See: Eq. (7) in Class et al. (2002a)
                 // This assumes each gas molecule displaces exactly one
                 // molecule in the liquid.
-                return H2O::liquidMolarDensity(T, p)
+                return paramCache.get(phaseIdx, h2oMolarDensityIdx, [&]{ return H2O::liquidMolarDensity(T, p); })
                        * (H2O::molarMass()*fluidState.moleFraction(liquidPhaseIdx, H2OIdx)
                           + N2::molarMass()*fluidState.moleFraction(liquidPhaseIdx, N2Idx));
             }
@@ -408,6 +443,36 @@ public:
         return (rho_gH2O + rho_gN2);
     }
 
+    /*!
+     * \brief Calculate the densities \f$\mathrm{[kg/m^3]}\f$ of a fluid phase for a range of fluid states
+     *
+     * If the gas phase is assumed to be an ideal gas, the states are gathered into
+     * contiguous arrays and the densities are evaluated in a vectorizable loop.
+     *
+     * \param fluidStates The fluid states
+     * \param phaseIdx The index of the fluid phase to consider
+     * \param values The densities (of the same size as the fluid states)
+     */
+    template <class FluidStates, class Values>
+    static void density(const FluidStates &fluidStates, int phaseIdx, Values &values)
+    {
+        if (phaseIdx == gasPhaseIdx && Policy::useIdealGasDensity())
+        {
+            const auto n = fluidStates.size();
+            std::vector<Scalar> averageMolarMass(n), temperature(n), pressure(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                averageMolarMass[i] = fluidStates[i].averageMolarMass(gasPhaseIdx);
+                temperature[i] = fluidStates[i].temperature(gasPhaseIdx);
+                pressure[i] = fluidStates[i].pressure(gasPhaseIdx);
+            }
+
+            IdealGas::density(averageMolarMass, temperature, pressure, values);
+        }
+        else
+            Base::density(fluidStates, phaseIdx, values);
+    }
+
     using Base::molarDensity;
     /*!
      * \brief The molar density \f$\rho_{mol,\alpha}\f$
@@ -423,6 +488,21 @@ public:
      */
     template <class FluidState>
     static Scalar molarDensity(const FluidState &fluidState, int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return molarDensity(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief The molar density \f$\rho_{mol,\alpha}\f$
+     *   of a fluid phase \f$\alpha\f$ in \f$\mathrm{[mol/m^3]}\f$
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     */
+    template <class FluidState>
+    static Scalar molarDensity(const FluidState &fluidState, const ParameterCache &paramCache, int phaseIdx)
     {
         assert(0 <= phaseIdx  && phaseIdx < numPhases);
 
@@ -434,7 +514,8 @@ public:
         {
             // assume pure water or that each gas molecule displaces exactly one
             // molecule in the liquid.
-            return H2O::liquidMolarDensity(T, p);
+            paramCache.bindState(phaseIdx, T, p);
+            return paramCache.get(phaseIdx, h2oMolarDensityIdx, [&]{ return H2O::liquidMolarDensity(T, p); });
         }
 
         // gas phase
@@ -467,31 +548,49 @@ public:
     template <class FluidState>
     static Scalar viscosity(const FluidState &fluidState,
                             int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return viscosity(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief Calculate the dynamic viscosity of a fluid phase \f$\mathrm{[Pa*s]}\f$
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     */
+    template <class FluidState>
+    static Scalar viscosity(const FluidState &fluidState,
+                            const ParameterCache &paramCache,
+                            int phaseIdx)
     {
         assert(0 <= phaseIdx  && phaseIdx < numPhases);
 
         Scalar T = fluidState.temperature(phaseIdx);
         Scalar p = fluidState.pressure(phaseIdx);
+        paramCache.bindState(phaseIdx, T, p);
 
         // liquid phase
         if (phaseIdx == liquidPhaseIdx) {
             // assume pure water for the liquid phase
-            return H2O::liquidViscosity(T, p);
+            return paramCache.get(phaseIdx, h2oViscosityIdx, [&]{ return H2O::liquidViscosity(T, p); });
         }
 
         // gas phase
+        const Scalar muN2 = paramCache.get(phaseIdx, n2ViscosityIdx, [&]{ return N2::gasViscosity(T, p); });
         if (Policy::useN2ViscosityAsGasMixtureViscosity())
         {
             // assume pure nitrogen for the gas phase
-            return N2::gasViscosity(T, p);
+            return muN2;
         }
         else
         {
             // Wilke method (Reid et al.):
             Scalar muResult = 0;
             const Scalar mu[numComponents] = {
-                H2O::gasViscosity(T, H2O::vaporPressure(T)),
-                N2::gasViscosity(T, p)
+                paramCache.get(phaseIdx, h2oViscosityIdx, [&]{ return H2O::gasViscosity(T, vaporPressure_(paramCache, phaseIdx, T)); }),
+                muN2
             };
 
             Scalar sumx = 0.0;
@@ -549,6 +648,25 @@ public:
     static Scalar fugacityCoefficient(const FluidState &fluidState,
                                       int phaseIdx,
                                       int compIdx)
+    {
+        ParameterCache paramCache;
+        return fugacityCoefficient(fluidState, paramCache, phaseIdx, compIdx);
+    }
+
+    /*!
+     * \brief Calculate the fugacity coefficient \f$\mathrm{[-]}\f$ of an individual
+     *        component in a fluid phase
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     * \param compIdx The index of the component to consider
+     */
+    template <class FluidState>
+    static Scalar fugacityCoefficient(const FluidState &fluidState,
+                                      const ParameterCache &paramCache,
+                                      int phaseIdx,
+                                      int compIdx)
     {
         assert(0 <= phaseIdx  && phaseIdx < numPhases);
         assert(0 <= compIdx  && compIdx < numComponents);
@@ -558,9 +676,10 @@ public:
 
         // liquid phase
         if (phaseIdx == liquidPhaseIdx) {
+            paramCache.bindState(phaseIdx, T, p);
             if (compIdx == H2OIdx)
-                return H2O::vaporPressure(T)/p;
-            return BinaryCoeff::H2O_N2::henry(T)/p;
+                return vaporPressure_(paramCache, phaseIdx, T)/p;
+            return paramCache.get(phaseIdx, henryIdx, [&]{ return BinaryCoeff::H2O_N2::henry(T); })/p;
         }
 
         // for the gas phase, assume an ideal gas when it comes to
@@ -600,6 +719,14 @@ public:
         DUNE_THROW(Dune::NotImplemented, "Diffusion coefficients");
     }
 
+    //! \copydoc diffusionCoefficient(const FluidState&, int, int)
+    template <class FluidState>
+    static Scalar diffusionCoefficient(const FluidState &fluidState,
+                                       const ParameterCache &paramCache,
+                                       int phaseIdx,
+                                       int compIdx)
+    { return diffusionCoefficient(fluidState, phaseIdx, compIdx); }
+
     using Base::binaryDiffusionCoefficient;
     /*!
      * \brief Given a phase's composition, temperature and pressure,
@@ -616,7 +743,28 @@ public:
                                              int phaseIdx,
                                              int compIIdx,
                                              int compJIdx)
+    {
+        ParameterCache paramCache;
+        return binaryDiffusionCoefficient(fluidState, paramCache, phaseIdx, compIIdx, compJIdx);
+    }
 
+    /*!
+     * \brief Given a phase's composition, temperature and pressure,
+     *        return the binary diffusion coefficient \f$\mathrm{[m^2/s]}\f$ for components
+     *        \f$i\f$ and \f$j\f$ in this phase.
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     * \param compIIdx The index of the first component to consider
+     * \param compJIdx The index of the second component to consider
+     */
+    template <class FluidState>
+    static Scalar binaryDiffusionCoefficient(const FluidState &fluidState,
+                                             const ParameterCache &paramCache,
+                                             int phaseIdx,
+                                             int compIIdx,
+                                             int compJIdx)
     {
         static Scalar undefined(1e10);
         Valgrind::SetUndefined(undefined);
@@ -641,17 +789,20 @@ public:
 
         Scalar T = fluidState.temperature(phaseIdx);
         Scalar p = fluidState.pressure(phaseIdx);
+        paramCache.bindState(phaseIdx, T, p);
 
         // liquid phase
         if (phaseIdx == liquidPhaseIdx) {
             if (compIIdx == H2OIdx && compJIdx == N2Idx)
-                return BinaryCoeff::H2O_N2::liquidDiffCoeff(T, p);
+                return paramCache.get(phaseIdx, diffusionCoefficientIdx,
+                                      [&]{ return BinaryCoeff::H2O_N2::liquidDiffCoeff(T, p); });
             return undefined;
         }
 
         // gas phase
         if (compIIdx == H2OIdx && compJIdx == N2Idx)
-            return BinaryCoeff::H2O_N2::gasDiffCoeff(T, p);
+            return paramCache.get(phaseIdx, diffusionCoefficientIdx,
+                                  [&]{ return BinaryCoeff::H2O_N2::gasDiffCoeff(T, p); });
         return undefined;
     }
 
@@ -671,15 +822,33 @@ public:
     template <class FluidState>
     static Scalar enthalpy(const FluidState &fluidState,
                            int phaseIdx)
+    {
+        ParameterCache paramCache;
+        return enthalpy(fluidState, paramCache, phaseIdx);
+    }
+
+    /*!
+     * \brief Given a phase's composition, temperature, pressure and
+     *        density, calculate its specific enthalpy \f$\mathrm{[J/kg]}\f$.
+     *
+     * \param fluidState An arbitrary fluid state
+     * \param paramCache The parameter cache
+     * \param phaseIdx The index of the fluid phase to consider
+     */
+    template <class FluidState>
+    static Scalar enthalpy(const FluidState &fluidState,
+                           const ParameterCache &paramCache,
+                           int phaseIdx)
     {
         Scalar T = fluidState.temperature(phaseIdx);
         Scalar p = fluidState.pressure(phaseIdx);
         Valgrind::CheckDefined(T);
         Valgrind::CheckDefined(p);
+        paramCache.bindState(phaseIdx, T, p);
 
         // liquid phase
         if (phaseIdx == liquidPhaseIdx) {
-            return H2O::liquidEnthalpy(T, p);
+            return paramCache.get(phaseIdx, h2oEnthalpyIdx, [&]{ return H2O::liquidEnthalpy(T, p); });
         }
         // gas phase
         else {
@@ -688,10 +857,10 @@ public:
             // "partial specific enthalpies" of the components.
             Scalar hH2O =
                 fluidState.massFraction(gasPhaseIdx, H2OIdx)
-                * H2O::gasEnthalpy(T, p);
+                * paramCache.get(phaseIdx, h2oEnthalpyIdx, [&]{ return H2O::gasEnthalpy(T, p); });
             Scalar hN2 =
                 fluidState.massFraction(gasPhaseIdx, N2Idx)
-                * N2::gasEnthalpy(T, p);
+                * paramCache.get(phaseIdx, n2EnthalpyIdx, [&]{ return N2::gasEnthalpy(T, p); });
             return hH2O + hN2;
         }
     }
@@ -772,6 +941,13 @@ public:
         }
     }
 
+    //! \copydoc thermalConductivity(const FluidState&, const int)
+    template <class FluidState>
+    static Scalar thermalConductivity(const FluidState &fluidState,
+                                      const ParameterCache &paramCache,
+                                      const int phaseIdx)
+    { return thermalConductivity(fluidState, phaseIdx); }
+
     using Base::heatCapacity;
     /*!
      * \brief Specific isobaric heat capacity of a fluid phase.
@@ -819,6 +995,18 @@ public:
         return c_pH2O*fluidState.massFraction(gasPhaseIdx, H2OIdx)
                + c_pN2*fluidState.massFraction(gasPhaseIdx, N2Idx);
     }
+
+    //! \copydoc heatCapacity(const FluidState&, int)
+    template <class FluidState>
+    static Scalar heatCapacity(const FluidState &fluidState,
+                               const ParameterCache &paramCache,
+                               int phaseIdx)
+    { return heatCapacity(fluidState, phaseIdx); }
+
+private:
+    //! The vapor pressure of water at the temperature of the phase bound to the parameter cache
+    static Scalar vaporPressure_(const ParameterCache &paramCache, int phaseIdx, Scalar T)
+    { return paramCache.get(phaseIdx, vaporPressureIdx, [&]{ return H2O::vaporPressure(T); }); }
 };
 
 } // end namespace FluidSystems
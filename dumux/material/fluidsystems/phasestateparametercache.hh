@@ -0,0 +1,139 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Fluidsystems
+ * \brief @copybrief Dumux::PhaseStateParameterCache
+ */
+#ifndef DUMUX_PHASE_STATE_PARAMETER_CACHE_HH
+#define DUMUX_PHASE_STATE_PARAMETER_CACHE_HH
+
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <limits>
+
+#include "parametercachebase.hh"
+
+namespace Dumux {
+
+/*!
+ * \ingroup Fluidsystems
+ * \brief A parameter cache for fluid systems whose expensive quantities only depend on
+ *        the temperature and the pressure of a phase (and optionally one further parameter,
+ *        e.g. the salinity).
+ *
+ * The fluid system binds the state of a phase before requesting a quantity. A quantity
+ * is evaluated on first request and the stored value is returned for all subsequent
+ * requests until the state of the phase changes. Thus, the cache stays valid if the
+ * fluid system is called without prior update of the cache, and the quantities shared
+ * by several property functions (e.g. density, viscosity and enthalpy) are only
+ * evaluated once per fluid state update.
+ *
+ * \tparam Scalar The type used for scalar values
+ * \tparam numPhases The number of fluid phases
+ * \tparam numQuantities The number of cached quantities per phase
+ */
+template <class Scalar, int numPhases, int numQuantities>
+class PhaseStateParameterCache
+: public ParameterCacheBase<PhaseStateParameterCache<Scalar, numPhases, numQuantities>>
+{
+    struct PhaseState
+    {
+        Scalar temperature = std::numeric_limits<Scalar>::quiet_NaN();
+        Scalar pressure = std::numeric_limits<Scalar>::quiet_NaN();
+        Scalar parameter = std::numeric_limits<Scalar>::quiet_NaN();
+        std::array<Scalar, numQuantities> values;
+        std::bitset<numQuantities> isCached;
+    };
+
+public:
+    /*!
+     * \brief Set the state of a phase the quantities are requested for.
+     *        The cached quantities of the phase are discarded if the state changed.
+     *
+     * \param phaseIdx The index of the fluid phase
+     * \param temperature The temperature of the phase
+     * \param pressure The pressure of the phase
+     * \param parameter A further parameter the cached quantities depend on
+     */
+    void bindState(int phaseIdx, Scalar temperature, Scalar pressure, Scalar parameter = 0.0) const
+    {
+        assert(0 <= phaseIdx && phaseIdx < numPhases);
+        auto& state = states_[phaseIdx];
+        if (temperature != state.temperature || pressure != state.pressure || parameter != state.parameter)
+        {
+            state.temperature = temperature;
+            state.pressure = pressure;
+            state.parameter = parameter;
+            state.isCached.reset();
+        }
+    }
+
+    /*!
+     * \brief Return a quantity of the bound phase state, evaluating it on first request
+     *
+     * \param phaseIdx The index of the fluid phase
+     * \param quantityIdx The index of the quantity
+     * \param evaluate A callable returning the quantity
+     */
+    template<class Evaluate>
+    Scalar get(int phaseIdx, int quantityIdx, Evaluate&& evaluate) const
+    {
+        auto& state = states_[phaseIdx];
+        if (!state.isCached[quantityIdx])
+        {
+            state.values[quantityIdx] = evaluate();
+            state.isCached.set(quantityIdx);
+        }
+
+        return state.values[quantityIdx];
+    }
+
+    /*!
+     * \brief Return two quantities of the bound phase state that are evaluated together
+     *
+     * \param phaseIdx The index of the fluid phase
+     * \param quantityIndices The indices of the two quantities
+     * \param evaluate A callable returning both quantities as std::array<Scalar, 2>
+     */
+    template<class Evaluate>
+    std::array<Scalar, 2> get(int phaseIdx, const std::array<int, 2>& quantityIndices, Evaluate&& evaluate) const
+    {
+        auto& state = states_[phaseIdx];
+        if (!state.isCached[quantityIndices[0]] || !state.isCached[quantityIndices[1]])
+        {
+            const std::array<Scalar, 2> values = evaluate();
+            for (int i = 0; i < 2; ++i)
+            {
+                state.values[quantityIndices[i]] = values[i];
+                state.isCached.set(quantityIndices[i]);
+            }
+        }
+
+        return {{ state.values[quantityIndices[0]], state.values[quantityIndices[1]] }};
+    }
+
+private:
+    mutable std::array<PhaseState, numPhases> states_;
+};
+
+} // end namespace Dumux
+
+#endif
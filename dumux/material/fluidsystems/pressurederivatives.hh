@@ -0,0 +1,107 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Fluidsystems
+ * \brief Pressure derivatives of the density and viscosity of a fluid phase
+ *        as needed for analytic Jacobians of compressible flow models.
+ */
+#ifndef DUMUX_FLUIDSYSTEMS_PRESSURE_DERIVATIVES_HH
+#define DUMUX_FLUIDSYSTEMS_PRESSURE_DERIVATIVES_HH
+
+#include <dumux/common/numericdifferentiation.hh>
+
+namespace Dumux {
+namespace Detail {
+
+//! Forward difference of a phase property w.r.t. the phase pressure at constant temperature and composition
+template<class FluidSystem, class FluidState, class Property>
+typename FluidSystem::Scalar phasePropertyPressureDerivative(const FluidState& fluidState,
+                                                             int phaseIdx,
+                                                             typename FluidSystem::Scalar value,
+                                                             const Property& property)
+{
+    using Scalar = typename FluidSystem::Scalar;
+
+    // the fluid systems evaluate the phase properties in double precision,
+    // a smaller step would be dominated by their round-off errors
+    const Scalar p = fluidState.pressure(phaseIdx);
+    const Scalar eps = NumericDifferentiation::epsilon(p, Scalar(1e-8));
+
+    FluidState deflectedFluidState(fluidState);
+    typename FluidSystem::ParameterCache paramCache;
+    auto evalProperty = [&](Scalar pressure)
+    {
+        deflectedFluidState.setPressure(phaseIdx, pressure);
+        paramCache.updatePhase(deflectedFluidState, phaseIdx);
+        return property(deflectedFluidState, paramCache);
+    };
+
+    Scalar derivative = 0.0;
+    NumericDifferentiation::partialDerivative(evalProperty, p, derivative, value, eps);
+    return derivative;
+}
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Fluidsystems
+ * \brief The derivative of the density of a fluid phase w.r.t. its pressure
+ *
+ * Returns zero without evaluating the fluid system for incompressible phases.
+ * Otherwise the density is evaluated once more at a deflected pressure, which is
+ * much cheaper than deflecting the primary variables and updating the volume variables.
+ *
+ * \param fluidState A fluid state with the current density of the phase
+ * \param phaseIdx The index of the fluid phase
+ */
+template<class FluidSystem, class FluidState>
+typename FluidSystem::Scalar densityPressureDerivative(const FluidState& fluidState, int phaseIdx)
+{
+    if (!FluidSystem::isCompressible(phaseIdx))
+        return 0.0;
+
+    return Detail::phasePropertyPressureDerivative<FluidSystem>(fluidState, phaseIdx, fluidState.density(phaseIdx),
+                                                                [phaseIdx](const auto& fs, auto& paramCache)
+                                                                { return FluidSystem::density(fs, paramCache, phaseIdx); });
+}
+
+/*!
+ * \ingroup Fluidsystems
+ * \brief The derivative of the viscosity of a fluid phase w.r.t. its pressure
+ *
+ * Returns zero without evaluating the fluid system for phases with a constant viscosity.
+ *
+ * \param fluidState A fluid state with the current viscosity of the phase
+ * \param phaseIdx The index of the fluid phase
+ */
+template<class FluidSystem, class FluidState>
+typename FluidSystem::Scalar viscosityPressureDerivative(const FluidState& fluidState, int phaseIdx)
+{
+    if (FluidSystem::viscosityIsConstant(phaseIdx))
+        return 0.0;
+
+    return Detail::phasePropertyPressureDerivative<FluidSystem>(fluidState, phaseIdx, fluidState.viscosity(phaseIdx),
+                                                                [phaseIdx](const auto& fs, auto& paramCache)
+                                                                { return FluidSystem::viscosity(fs, paramCache, phaseIdx); });
+}
+
+} // end namespace Dumux
+
+#endif
@@ -24,6 +24,7 @@
 #ifndef DUMUX_SPE5_FLUID_SYSTEM_HH
 #define DUMUX_SPE5_FLUID_SYSTEM_HH
 
+#include "base.hh"
 #include "spe5parametercache.hh"
 
 #include <dumux/common/spline.hh>
@@ -54,8 +55,10 @@ namespace FluidSystems {
  */
 template <class Scalar>
 class Spe5
+: public Base<Scalar, Spe5<Scalar> >
 {
     using ThisType = FluidSystems::Spe5<Scalar>;
+    using Base = Dumux::FluidSystems::Base<Scalar, ThisType>;
 
     using PengRobinsonMixture = Dumux::PengRobinsonMixture<Scalar, ThisType>;
     using PengRobinson = Dumux::PengRobinson<Scalar>;
@@ -373,6 +376,7 @@ public:
                            /*bMin=*/minB, /*bMax=*/maxB, /*nb=*/200);
     }
 
+    using Base::density;
     /*!
      * \brief Calculate the density \f$\mathrm{[kg/m^3]}\f$ of a fluid phase
      *
@@ -391,6 +395,7 @@ public:
         return fluidState.averageMolarMass(phaseIdx)/paramCache.molarVolume(phaseIdx);
     }
 
+    using Base::molarDensity;
     /*!
      * \brief The molar density \f$\rho_{mol,\alpha}\f$
      *   of a fluid phase \f$\alpha\f$ in \f$\mathrm{[mol/m^3]}\f$
@@ -406,6 +411,7 @@ public:
         return 1.0/paramCache.molarVolume(phaseIdx);
     }
 
+    using Base::viscosity;
     /*!
      * \brief Calculate the dynamic viscosity of a fluid phase \f$\mathrm{[Pa*s]}\f$
      * \param fs An arbitrary fluid state
@@ -435,6 +441,7 @@ public:
         }
     }
 
+    using Base::fugacityCoefficient;
     /*!
      * \brief Calculate the fugacity coefficient \f$\mathrm{[-]}\f$ of an individual
      *        component in a fluid phase
@@ -472,6 +479,7 @@ public:
     }
 
 
+    using Base::diffusionCoefficient;
     /*!
      * \brief Calculate the binary molecular diffusion coefficient for
      *        a component in a fluid phase \f$\mathrm{[mol^2 * s / (kg*m^3)]}\f$
@@ -502,6 +510,7 @@ public:
                                        int compIdx)
     { DUNE_THROW(Dune::NotImplemented, "Diffusion coefficients"); }
 
+    using Base::binaryDiffusionCoefficient;
     /*!
      * \brief Given a phase's composition, temperature and pressure,
      *        return the binary diffusion coefficient \f$\mathrm{[m^2/s]}\f$ for components
@@ -521,6 +530,7 @@ public:
                                              int compJIdx)
     { DUNE_THROW(Dune::NotImplemented, "Binary diffusion coefficients"); }
 
+    using Base::enthalpy;
     /*!
      * \brief Given a phase's composition, temperature and pressure,
      *        calculate its specific enthalpy \f$\mathrm{[J/kg]}\f$.
@@ -534,6 +544,7 @@ public:
                            int phaseIdx)
     { DUNE_THROW(Dune::NotImplemented, "Enthalpies"); }
 
+    using Base::thermalConductivity;
     /*!
      * \brief Given a phase's composition, temperature and pressure,
      *        calculate its thermal conductivity \f$\mathrm{[W/(m K)]}\f$.
@@ -547,6 +558,7 @@ public:
                                       int phaseIdx)
     { DUNE_THROW(Dune::NotImplemented, "Thermal conductivities"); }
 
+    using Base::heatCapacity;
     /*!
      * \brief Given a phase's composition, temperature and pressure,
      *        calculate its heat capacity \f$\mathrm{[J/(kg K)]}\f$.
@@ -24,6 +24,8 @@
 #ifndef DUMUX_IDEAL_GAS_HH
 #define DUMUX_IDEAL_GAS_HH
 
+#include <cstddef>
+
 #include <dumux/material/constants.hh>
 
 namespace Dumux {
@@ -70,6 +72,48 @@ public:
     static constexpr Scalar molarDensity(Scalar temperature,
                                          Scalar pressure)
     { return pressure/(R*temperature); }
+
+    /*!
+     * \brief The densities of the gas in \f$\mathrm{[kg/m^3]}\f$ for ranges of
+     *        average molar masses, temperatures and pressures.
+     *
+     * The loop has no branches and can be vectorized by the compiler.
+     *
+     * \param avgMolarMass The average molar masses of the gas
+     * \param temperature The temperatures of the gas
+     * \param pressure The pressures of the gas
+     * \param values The densities (of the same size as the arguments)
+     */
+    template<class MolarMasses, class Temperatures, class Pressures, class Values>
+    static void density(const MolarMasses& avgMolarMass,
+                        const Temperatures& temperature,
+                        const Pressures& pressure,
+                        Values& values)
+    {
+        const auto n = values.size();
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = pressure[i]*avgMolarMass[i]/(R*temperature[i]);
+    }
+
+    /*!
+     * \brief The molar densities of the gas \f$\mathrm{[mol/m^3]}\f$ for ranges of
+     *        temperatures and pressures.
+     *
+     * The loop has no branches and can be vectorized by the compiler.
+     *
+     * \param temperature The temperatures of the gas
+     * \param pressure The pressures of the gas
+     * \param values The molar densities (of the same size as the arguments)
+     */
+    template<class Temperatures, class Pressures, class Values>
+    static void molarDensity(const Temperatures& temperature,
+                             const Pressures& pressure,
+                             Values& values)
+    {
+        const auto n = values.size();
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = pressure[i]/(R*temperature[i]);
+    }
 };
 } // end namespace
 
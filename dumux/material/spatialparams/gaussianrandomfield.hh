@@ -0,0 +1,275 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup SpatialParameters
+ * \brief Generation of Gaussian random fields with the spectral (randomization) method
+ */
+#ifndef DUMUX_GAUSSIAN_RANDOM_FIELD_HH
+#define DUMUX_GAUSSIAN_RANDOM_FIELD_HH
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/io/file/vtk.hh>
+
+#include <dumux/common/parameters.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief The covariance models available for Gaussian random fields
+ */
+enum class CovarianceModel
+{
+    //! \f$ C(\mathbf{h}) = \sigma^2 \exp(-|\mathbf{h}/\lambda|^2) \f$ (gstat's Gau model)
+    gaussian,
+    //! \f$ C(\mathbf{h}) = \sigma^2 \exp(-|\mathbf{h}/\lambda|) \f$ (gstat's Exp model)
+    exponential
+};
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief Creates stationary Gaussian random fields in-process, e.g. as a replacement
+ *        for the external gstat tool used by GstatRandomField.
+ *
+ * The field is a superposition of random Fourier modes (spectral or randomization method)
+ * \f[
+ *    f(\mathbf{x}) = \mu + \sigma \sqrt{\frac{2}{N}} \sum_{i=1}^N \cos(\mathbf{k}_i \cdot \mathbf{x} + \varphi_i),
+ * \f]
+ * where the wave vectors \f$ \mathbf{k}_i \f$ are sampled from the spectral density of the
+ * covariance model and the phases \f$ \varphi_i \f$ are uniformly distributed. The field
+ * converges to a Gaussian field with the given covariance for an increasing number of modes.
+ * The anisotropic correlation lengths \f$ \lambda \f$ are aligned with the coordinate axes.
+ *
+ * As the modes only depend on the seed, the field can be evaluated at arbitrary
+ * positions without any grid structure or communication: all processes of a
+ * distributed grid generate values consistent with the serial field.
+ *
+ * The following runtime parameters are read from the given parameter group (default "RandomField"):
+ * Mean, Variance, CorrelationLength (one value or one per direction),
+ * Covariance (Gaussian or Exponential, default Gaussian), NumModes (default 1000) and Seed (default 0).
+ */
+template<class GridView, class Scalar>
+class GaussianRandomField
+{
+    enum { dimWorld = GridView::dimensionworld };
+
+    using DataVector = std::vector<Scalar>;
+    using Element = typename GridView::Traits::template Codim<0>::Entity;
+    using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
+    using GlobalPosition = Dune::FieldVector<Scalar, dimWorld>;
+
+public:
+    // Add field types if you want to implement e.g. tensor permeabilities.
+    enum FieldType { scalar, log10 };
+
+    /*!
+     * \brief Constructor
+     *
+     * \param gridView the used gridView
+     * \param elementMapper Maps elements of the given grid view
+     * \param paramGroup The parameter group in which to look for the runtime parameters
+     */
+    GaussianRandomField(const GridView& gridView,
+                        const ElementMapper& elementMapper,
+                        const std::string& paramGroup = "RandomField")
+    : gridView_(gridView)
+    , elementMapper_(elementMapper)
+    , data_(gridView.size(0))
+    , fieldType_(FieldType::scalar)
+    {
+        const auto covariance = getParamFromGroup<std::string>(paramGroup, "Covariance", "Gaussian");
+        if (covariance == "Gaussian")
+            covarianceModel_ = CovarianceModel::gaussian;
+        else if (covariance == "Exponential")
+            covarianceModel_ = CovarianceModel::exponential;
+        else
+            DUNE_THROW(Dune::InvalidStateException, "Unknown covariance model " << covariance);
+
+        mean_ = getParamFromGroup<Scalar>(paramGroup, "Mean");
+        variance_ = getParamFromGroup<Scalar>(paramGroup, "Variance");
+
+        const auto correlationLength = getParamFromGroup<std::vector<Scalar>>(paramGroup, "CorrelationLength");
+        if (correlationLength.size() == 1)
+            correlationLength_ = correlationLength[0];
+        else if (correlationLength.size() == dimWorld)
+            std::copy(correlationLength.begin(), correlationLength.end(), correlationLength_.begin());
+        else
+            DUNE_THROW(Dune::InvalidStateException, "Specify one correlation length or one per direction");
+
+        numModes_ = getParamFromGroup<std::size_t>(paramGroup, "NumModes", 1000);
+        seed_ = getParamFromGroup<unsigned int>(paramGroup, "Seed", 0);
+    }
+
+    //! Set the covariance model
+    void setCovarianceModel(CovarianceModel covarianceModel)
+    { covarianceModel_ = covarianceModel; }
+
+    //! Set the mean value and the variance of the field
+    void setMoments(Scalar mean, Scalar variance)
+    {
+        mean_ = mean;
+        variance_ = variance;
+    }
+
+    //! Set the correlation length in each direction
+    void setCorrelationLength(const GlobalPosition& correlationLength)
+    { correlationLength_ = correlationLength; }
+
+    //! Set the number of Fourier modes and the seed of the random number generator
+    void setModes(std::size_t numModes, unsigned int seed)
+    {
+        numModes_ = numModes;
+        seed_ = seed;
+    }
+
+    /*!
+     * \brief Creates a new field with random values at the element centers
+     *
+     * \param fieldType Create the field itself (scalar) or the logarithm of the field (log10)
+     */
+    void create(FieldType fieldType = FieldType::scalar)
+    {
+        fieldType_ = fieldType;
+        createModes_();
+
+        for (const auto& element : elements(gridView_))
+            data_[elementMapper_.index(element)] = value(element.geometry().center());
+
+        // post processing
+        using std::pow;
+        if (fieldType_ == FieldType::log10)
+            std::for_each(data_.begin(), data_.end(), [](Scalar& s){ s = pow(10.0, s); });
+    }
+
+    /*!
+     * \brief The value of the Gaussian field at an arbitrary position
+     * \note Call create() first. The log10 post processing is not applied.
+     */
+    Scalar value(const GlobalPosition& globalPos) const
+    {
+        Scalar sum = 0.0;
+        for (std::size_t i = 0; i < numModes_; ++i)
+        {
+            Scalar phase = phases_[i];
+            for (int dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
+                phase += waveVectors_[i*dimWorld + dimIdx]*globalPos[dimIdx];
+
+            using std::cos;
+            sum += cos(phase);
+        }
+
+        using std::sqrt;
+        return mean_ + sqrt(2.0*variance_/numModes_)*sum;
+    }
+
+    //! \brief Return an entry of the data vector
+    Scalar data(const Element& e) const
+    {
+        return data_[elementMapper_.index(e)];
+    }
+
+    //! \brief Return the data vector for analysis or external vtk output
+    const DataVector& data() const
+    {
+        return data_;
+    }
+
+    //! \brief Write the data to a vtk file
+    void writeVtk(const std::string& vtkName,
+                  const std::string& dataName = "data") const
+    {
+        Dune::VTKWriter<GridView> vtkwriter(gridView_);
+        vtkwriter.addCellData(data_, dataName);
+
+        DataVector logPerm;
+        if (fieldType_ == FieldType::log10)
+        {
+            logPerm = data_;
+            using std::log10;
+            std::for_each(logPerm.begin(), logPerm.end(), [](Scalar& s){ s = log10(s); });
+            vtkwriter.addCellData(logPerm, "log10 of " + dataName);
+        }
+        vtkwriter.write(vtkName, Dune::VTK::OutputType::ascii);
+    }
+
+private:
+    /*!
+     * \brief Sample the wave vectors from the spectral density of the covariance model
+     *
+     * The Gaussian covariance has a Gaussian spectral density with standard deviation
+     * \f$ \sqrt{2}/\lambda \f$, the exponential covariance has a multivariate Cauchy
+     * spectral density with scale \f$ 1/\lambda \f$.
+     * The standard library distributions are not guaranteed to produce the same sequence
+     * on every platform, so the samples are computed from the raw engine output.
+     */
+    void createModes_()
+    {
+        std::mt19937 generator(seed_);
+        const auto uniform = [&generator]()
+        { return (Scalar(generator()) + 0.5)/(Scalar(std::mt19937::max()) + 1.0); };
+
+        // Box-Muller transform (the draws are sequenced to be reproducible across compilers)
+        const auto normal = [&uniform]()
+        {
+            using std::sqrt; using std::log; using std::cos;
+            const auto u1 = uniform();
+            const auto u2 = uniform();
+            return sqrt(-2.0*log(u1))*cos(2.0*M_PI*u2);
+        };
+
+        waveVectors_.resize(numModes_*dimWorld);
+        phases_.resize(numModes_);
+        for (std::size_t i = 0; i < numModes_; ++i)
+        {
+            using std::sqrt; using std::abs;
+            const Scalar scale = covarianceModel_ == CovarianceModel::gaussian ? sqrt(2.0) : 1.0/abs(normal());
+            for (int dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
+                waveVectors_[i*dimWorld + dimIdx] = scale*normal()/correlationLength_[dimIdx];
+            phases_[i] = 2.0*M_PI*uniform();
+        }
+    }
+
+    const GridView gridView_;
+    const ElementMapper& elementMapper_;
+    DataVector data_;
+    FieldType fieldType_;
+
+    CovarianceModel covarianceModel_;
+    Scalar mean_;
+    Scalar variance_;
+    GlobalPosition correlationLength_;
+    std::size_t numModes_;
+    unsigned int seed_;
+
+    std::vector<Scalar> waveVectors_;
+    std::vector<Scalar> phases_;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -43,6 +43,9 @@ namespace Dumux {
  * directory or donwload, unpack and install the tarball from the gstat-website.
  * Then rerun cmake (in the second case set GSTAT_ROOT in your input file to the
  * path where gstat is installed).
+ *
+ * \note GaussianRandomField generates Gaussian fields in-process without
+ *       external tools, also on distributed grids.
  */
 template<class GridView, class Scalar>
 class GstatRandomField
@@ -0,0 +1,250 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup SpatialParameters
+ * \brief Compact storage of element-wise material law parameters
+ */
+#ifndef DUMUX_MATERIAL_LAW_PARAMS_STORAGE_HH
+#define DUMUX_MATERIAL_LAW_PARAMS_STORAGE_HH
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+#include <dune/common/exceptions.hh>
+
+namespace Dumux {
+
+#ifndef DOXYGEN
+namespace Detail {
+// precompute the tables of tabulated material laws (see TabulatedMaterialLawParams)
+template<class Params>
+auto prepareMaterialLawParams(const Params& params, int)
+-> decltype(params.table(), void())
+{ params.table(); }
+
+// nothing to precompute for other parameter sets
+template<class Params>
+void prepareMaterialLawParams(const Params&, long)
+{}
+
+// FNV-1a hash of the object representation
+template<class Params>
+std::size_t hashMaterialLawParams(const Params& params, std::true_type)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&params);
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < sizeof(Params); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+// parameter sets that are not trivially copyable all share one bucket
+template<class Params>
+std::size_t hashMaterialLawParams(const Params&, std::false_type)
+{ return 0; }
+
+// parameter sets providing their own hash (e.g. TabulatedMaterialLawParams)
+template<class Params>
+auto hashMaterialLawParams(const Params& params, int)
+-> decltype(std::size_t(params.hash()))
+{ return params.hash(); }
+
+// all other parameter sets are hashed depending on their type
+template<class Params>
+std::size_t hashMaterialLawParams(const Params& params, long)
+{ return hashMaterialLawParams(params, std::is_trivially_copyable<Params>()); }
+} // end namespace Detail
+#endif
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief The default hash of material law parameters used by the MaterialLawParamsStorage
+ *
+ * Parameter sets with a hash() member function are hashed with it. Trivially copyable parameter
+ * sets (e.g. the parameters of the van Genuchten or Brooks-Corey laws) are hashed by their object
+ * representation, i.e. parameter sets with identical values share a hash. All other parameter
+ * sets get the same hash, which makes interning linear in the number of unique sets. Pass a
+ * specialized hash functor to the storage for those.
+ */
+template<class MaterialLawParams>
+struct MaterialLawParamsHash
+{
+    std::size_t operator()(const MaterialLawParams& params) const
+    { return Detail::hashMaterialLawParams(params, 0); }
+};
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief Stores element-wise material law parameters with a compact index per element.
+ *
+ * Identical parameter sets are stored only once: inserting a parameter set that compares
+ * equal to an already stored one with the same hash returns the index of the stored set.
+ * Stored sets are looked up by their hash and then compared with the parameters'
+ * operator== (which compares up to a small relative tolerance). Each element only
+ * stores the index of its parameter set. Quantities derived from the parameters
+ * (e.g. the tables of TabulatedMaterialLawParams) are computed once per unique set
+ * when it is inserted.
+ *
+ * The spatial parameters can return the parameters of an element by reference, e.g.
+ * \code
+ * template<class ElementSolution>
+ * const MaterialLawParams& materialLawParams(const Element& element,
+ *                                            const SubControlVolume& scv,
+ *                                            const ElementSolution& elemSol) const
+ * { return materialParams_[scv.elementIndex()]; }
+ * \endcode
+ *
+ * \note Parameter sets that compare equal within the tolerance but differ in their hash
+ *       (e.g. values differing in the last digits) are stored separately. This only costs
+ *       memory. For continuous random fields, classify the field values into a finite number
+ *       of classes before creating the parameters.
+ * \note References to stored parameter sets stay valid when new sets are inserted.
+ *
+ * \tparam MaterialLawParamsT the type of the material law parameters
+ * \tparam IndexT the unsigned integer type of the per-element indices
+ * \tparam EqualT the comparison functor used for interning
+ * \tparam HashT the hash functor used to find equal parameter sets
+ */
+template<class MaterialLawParamsT,
+         class IndexT = std::uint32_t,
+         class EqualT = std::equal_to<MaterialLawParamsT>,
+         class HashT = MaterialLawParamsHash<MaterialLawParamsT>>
+class MaterialLawParamsStorage
+{
+    static_assert(std::is_unsigned<IndexT>::value, "The index type has to be an unsigned integer type");
+
+public:
+    using MaterialLawParams = MaterialLawParamsT;
+    using IndexType = IndexT;
+
+    //! the index of elements without parameters
+    static constexpr IndexType invalidIndex = std::numeric_limits<IndexType>::max();
+
+    //! Default constructor
+    MaterialLawParamsStorage() = default;
+
+    //! Constructor for a given number of elements
+    explicit MaterialLawParamsStorage(std::size_t numElements,
+                                      const EqualT& equal = EqualT(),
+                                      const HashT& hash = HashT())
+    : indices_(numElements, invalidIndex)
+    , equal_(equal)
+    , hash_(hash)
+    {}
+
+    //! Resize the element indices (new elements have no parameters)
+    void resize(std::size_t numElements)
+    { indices_.resize(numElements, invalidIndex); }
+
+    /*!
+     * \brief Insert a parameter set and return its index
+     * \note If an equal parameter set is already stored, its index is returned.
+     */
+    IndexType insert(const MaterialLawParams& params)
+    {
+        // consecutive insertions are often equal, e.g. for elements of the same layer
+        if (lastIndex_ < uniqueParams_.size() && equal_(uniqueParams_[lastIndex_], params))
+            return lastIndex_;
+
+        const auto hash = hash_(params);
+        const auto candidates = buckets_.equal_range(hash);
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            if (equal_(uniqueParams_[it->second], params))
+            {
+                lastIndex_ = it->second;
+                return lastIndex_;
+            }
+        }
+
+        if (uniqueParams_.size() >= invalidIndex)
+            DUNE_THROW(Dune::RangeError, "Number of unique material law parameter sets exceeds the index type");
+
+        uniqueParams_.push_back(params);
+        Detail::prepareMaterialLawParams(uniqueParams_.back(), 0);
+        lastIndex_ = static_cast<IndexType>(uniqueParams_.size() - 1);
+        buckets_.emplace(hash, lastIndex_);
+        return lastIndex_;
+    }
+
+    //! Set the parameters of an element (equal parameter sets are stored only once)
+    void setParams(std::size_t eIdx, const MaterialLawParams& params)
+    { indices_[eIdx] = insert(params); }
+
+    //! Set the index of the parameter set of an element (as returned by insert())
+    void setIndex(std::size_t eIdx, IndexType paramsIdx)
+    {
+        if (paramsIdx >= uniqueParams_.size())
+            DUNE_THROW(Dune::RangeError, "Invalid material law parameter index " << paramsIdx);
+        indices_[eIdx] = paramsIdx;
+    }
+
+    //! The index of the parameter set of an element
+    IndexType index(std::size_t eIdx) const
+    { return indices_[eIdx]; }
+
+    //! The parameters of an element
+    const MaterialLawParams& operator[] (std::size_t eIdx) const
+    { return uniqueParams_[indices_[eIdx]]; }
+
+    //! The parameter set with the given index
+    const MaterialLawParams& uniqueParams(IndexType paramsIdx) const
+    { return uniqueParams_[paramsIdx]; }
+
+    //! The number of unique parameter sets
+    std::size_t numUniqueParams() const
+    { return uniqueParams_.size(); }
+
+    //! The number of elements
+    std::size_t size() const
+    { return indices_.size(); }
+
+    //! Remove all parameter sets and element indices
+    void clear()
+    {
+        uniqueParams_.clear();
+        buckets_.clear();
+        indices_.clear();
+        lastIndex_ = invalidIndex;
+    }
+
+private:
+    std::deque<MaterialLawParams> uniqueParams_;
+    std::unordered_multimap<std::size_t, IndexType> buckets_; //!< the indices of the unique sets by hash
+    std::vector<IndexType> indices_;
+    IndexType lastIndex_ = invalidIndex;
+    EqualT equal_;
+    HashT hash_;
+};
+
+template<class MaterialLawParams, class IndexType, class Equal, class Hash>
+constexpr IndexType MaterialLawParamsStorage<MaterialLawParams, IndexType, Equal, Hash>::invalidIndex;
+
+} // end namespace Dumux
+
+#endif
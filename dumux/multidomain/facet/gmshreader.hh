@@ -23,13 +23,22 @@
 #define DUMUX_FACETCOUPLING_GMSH_READER_HH
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
+#include <functional>
 #include <iostream>
-#include <sstream>
-#include <typeinfo>
+#include <limits>
+#include <string>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
+#include <dune/common/exceptions.hh>
+#include <dune/common/hybridutilities.hh>
 #include <dune/common/timer.hh>
 #include <dune/common/version.hh>
 #include <dune/common/fvector.hh>
@@ -38,6 +47,216 @@
 #include <dumux/common/indextraits.hh>
 
 namespace Dumux {
+namespace Detail {
+
+/*!
+ * \ingroup FacetCoupling
+ * \brief Reads the numbers stored in the sections of ASCII or binary gmsh files.
+ *        In ASCII mode, numbers are read token by token across line breaks.
+ *        In binary mode, the byte order and the size of the size_t values
+ *        (msh format 4) are set from the header of the file.
+ */
+class GmshDataStream
+{
+public:
+    explicit GmshDataStream(std::istream& stream)
+    : stream_(stream)
+    {}
+
+    //! Sets the format of the data to be read
+    void setFormat(bool binary, bool swapBytes = false, std::size_t sizeTSize = sizeof(std::uint64_t))
+    {
+        if (binary && sizeTSize != sizeof(std::uint32_t) && sizeTSize != sizeof(std::uint64_t))
+            DUNE_THROW(Dune::IOError, "Unsupported data size " << sizeTSize << " in .msh file");
+
+        binary_ = binary;
+        swapBytes_ = swapBytes;
+        sizeTSize_ = sizeTSize;
+    }
+
+    //! Returns true if the data is stored in binary format
+    bool binary() const
+    { return binary_; }
+
+    //! Reads the next line (ignoring any unread data on the current line)
+    bool getLine(std::string& line)
+    {
+        pos_ = line_.size();
+        return static_cast<bool>(std::getline(stream_, line));
+    }
+
+    //! Reads a number given as text on a separate line (section headers of msh format 2)
+    std::size_t readSizeLine()
+    {
+        std::string line;
+        if (!getLine(line))
+            DUNE_THROW(Dune::IOError, "Unexpected end of .msh file");
+
+        char* end;
+        const auto value = std::strtoull(line.c_str(), &end, 10);
+        if (end == line.c_str())
+            DUNE_THROW(Dune::IOError, "Could not convert '" << line << "' to a number");
+        return value;
+    }
+
+    //! Reads a value stored as "int" in the file
+    int readInt()
+    {
+        if (binary_)
+            return readBinary_<std::int32_t>();
+
+        const char* begin = nextToken_();
+        char* end;
+        const long value = std::strtol(begin, &end, 10);
+        advance_(begin, end);
+        return static_cast<int>(value);
+    }
+
+    //! Reads a non-negative value stored as "size_t" in the file
+    std::size_t readSize()
+    {
+        if (binary_)
+            return sizeTSize_ == sizeof(std::uint64_t) ? readBinary_<std::uint64_t>()
+                                                       : readBinary_<std::uint32_t>();
+
+        const char* begin = nextToken_();
+        char* end;
+        const auto value = std::strtoull(begin, &end, 10);
+        advance_(begin, end);
+        return value;
+    }
+
+    //! Reads a value stored as "double" in the file
+    double readDouble()
+    {
+        if (binary_)
+            return readBinary_<double>();
+
+        const char* begin = nextToken_();
+        char* end;
+        const double value = std::strtod(begin, &end);
+        advance_(begin, end);
+        return value;
+    }
+
+    //! Reads n values stored as "int" in the file
+    void readInts(int* data, std::size_t n)
+    {
+        if (binary_)
+            readBinaryArray_(reinterpret_cast<std::int32_t*>(data), n);
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                data[i] = readInt();
+    }
+
+    //! Reads n values stored as "size_t" in the file
+    void readSizes(std::size_t* data, std::size_t n)
+    {
+        if (binary_ && sizeTSize_ == sizeof(std::size_t))
+            readBinaryArray_(data, n);
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                data[i] = readSize();
+    }
+
+    //! Reads n values stored as "double" in the file
+    void readDoubles(double* data, std::size_t n)
+    {
+        if (binary_)
+            readBinaryArray_(data, n);
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                data[i] = readDouble();
+    }
+
+    /*!
+     * \brief Discards the rest of the current section and makes
+     *        sure that the data is followed by the end tag of the section.
+     */
+    void finishSection(const std::string& section)
+    {
+        const std::string endTag = "$End" + section;
+        std::string line;
+        while (getLine(line))
+        {
+            const auto first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos)
+                continue;
+            if (line.compare(first, endTag.size(), endTag) != 0)
+                DUNE_THROW(Dune::IOError, "Found more data than stated in section $" << section << " of the .msh file");
+            return;
+        }
+
+        DUNE_THROW(Dune::IOError, "Missing " << endTag << " in .msh file");
+    }
+
+    //! Skips a section that is not needed
+    void skipSection(const std::string& section)
+    {
+        const std::string endTag = "$End" + section;
+        std::string line;
+        while (getLine(line))
+            if (line.compare(0, endTag.size(), endTag) == 0)
+                return;
+
+        DUNE_THROW(Dune::IOError, "Missing " << endTag << " in .msh file");
+    }
+
+private:
+    //! returns a pointer to the beginning of the next token
+    const char* nextToken_()
+    {
+        while (true)
+        {
+            while (pos_ < line_.size() && std::isspace(static_cast<unsigned char>(line_[pos_])))
+                ++pos_;
+            if (pos_ < line_.size())
+                return line_.c_str() + pos_;
+
+            if (!std::getline(stream_, line_))
+                DUNE_THROW(Dune::IOError, "Unexpected end of .msh file");
+            pos_ = 0;
+        }
+    }
+
+    //! moves the position to the end of a converted token
+    void advance_(const char* begin, const char* end)
+    {
+        if (end == begin)
+            DUNE_THROW(Dune::IOError, "Could not convert '" << line_.substr(pos_, line_.find_first_of(" \t\r", pos_) - pos_) << "' to a number");
+        pos_ += end - begin;
+    }
+
+    template<class T>
+    T readBinary_()
+    {
+        T value;
+        readBinaryArray_(&value, 1);
+        return value;
+    }
+
+    template<class T>
+    void readBinaryArray_(T* data, std::size_t n)
+    {
+        char* bytes = reinterpret_cast<char*>(data);
+        stream_.read(bytes, n*sizeof(T));
+        if (!stream_)
+            DUNE_THROW(Dune::IOError, "Unexpected end of binary data in .msh file");
+
+        if (swapBytes_)
+            for (std::size_t i = 0; i < n; ++i)
+                std::reverse(bytes + i*sizeof(T), bytes + (i+1)*sizeof(T));
+    }
+
+    std::istream& stream_;
+    std::string line_;
+    std::size_t pos_ = 0;
+    bool binary_ = false;
+    bool swapBytes_ = false;
+    std::size_t sizeTSize_ = sizeof(std::uint64_t);
+};
+
+} // end namespace Detail
 
 /*!
  * \ingroup FacetCoupling
@@ -53,6 +272,13 @@ namespace Dumux {
  *       then be interpreted as boundary segments. Use respective physical entity
  *       indexing in your grid file in that case.
  *
+ * \note Supported are the msh file formats 2 and 4.1, both in ASCII and binary mode.
+ *       The file is read in a single pass, and the vertices, elements and boundary
+ *       segments can be inserted directly into the grid factories of the hierarchy
+ *       (see the overload of read() taking the grid factories). Lower-dimensional
+ *       entities have to appear in the file before the entities they are embedded in,
+ *       which is the case for files written by gmsh.
+ *
  * \tparam BulkGrid The type of the highest-dimensional grid in the hierachy
  * \tparam numGrids The number of grids to be considered in the hierarchy
  */
@@ -78,6 +304,24 @@ class FacetCouplingGmshReader
         VertexIndexSet cornerIndices;
     };
 
+    // functions passing the read entities to the grids of the hierarchy
+    using VertexInserter = std::function<void(const GlobalPosition&)>;
+    using ElementInserter = std::function<void(const Dune::GeometryType&, const VertexIndexSet&)>;
+    using SegmentInserter = std::function<void(const VertexIndexSet&)>;
+
+    // the corners of the elements of a lower-dimensional grid and
+    // the elements connected to its vertices (in compressed row storage)
+    struct EmbeddedElements
+    {
+        std::vector<GridIndexType> corners;
+        std::vector<std::size_t> cornerOffsets = std::vector<std::size_t>(1, 0);
+        std::vector<std::size_t> vertexOffsets;
+        std::vector<GridIndexType> vertexElements;
+        std::size_t numIndexedElements = 0;
+    };
+
+    static constexpr GridIndexType unassigned = std::numeric_limits<GridIndexType>::max();
+
 public:
     //! Reads the data from a given mesh file
     //! Use this routine if you don't specify boundary segments in the grid file
@@ -86,193 +330,63 @@ public:
         read(fileName, 0, verbose);
     }
 
-    //! Reads the data from a given mesh file
+    //! Reads the data from a given mesh file and stores the elements and boundary segments
     void read(const std::string& fileName, std::size_t boundarySegThresh, bool verbose = false)
     {
-        Dune::Timer watch;
-        if (verbose) std::cout << "Opening " << fileName << std::endl;
-        std::ifstream gridFile(fileName);
-        if (gridFile.fail())
-            DUNE_THROW(Dune::InvalidStateException, "Could not open the given .msh file. Make sure it exists");
-
-        // read file until we get to the list of nodes
-        std::string line;
-        std::getline(gridFile, line);
-        while (line.find("$Nodes") == std::string::npos)
-            std::getline(gridFile, line);
-
-        // read all vertices
-        std::getline(gridFile, line);
-        const auto numVertices = convertString<std::size_t>(line);
-        bulkGridvertices_.resize(numVertices);
-
-        std::getline(gridFile, line);
-        std::size_t vertexCount = 0;
-        while (line.find("$EndNodes")  == std::string::npos)
+        for (int id = 0; id < numGrids; ++id)
         {
-            // drop first entry in line (vertex index) and read coordinates
-            std::istringstream stream(line);
-            std::string buf; stream >> buf;
-            GlobalPosition v;
-            for (auto& coord : v)
-            {
-                stream >> coord;
-                if (stream.fail()) DUNE_THROW(Dune::IOError, "Could not read vertex coordinate");
-            }
-
-            // insert vertex into container and move to next line
-            bulkGridvertices_[vertexCount++] = v;
-            std::getline(gridFile, line);
+            insertVertex_[id] = [] (const GlobalPosition&) {};
+            insertElement_[id] = [this, id] (const Dune::GeometryType& gt, const VertexIndexSet& corners)
+                                 { elementData_[id].emplace_back(ElementData({gt, corners})); };
+            insertBoundarySegment_[id] = [this, id] (const VertexIndexSet& corners)
+                                         { boundarySegments_[id].push_back(corners); };
         }
 
-        // we should always find as many vertices as the mesh file states
-        if (vertexCount != numVertices)
-            DUNE_THROW(Dune::InvalidStateException, "Couldn't find as many vertices as stated in the .msh file");
-
-        // read file until we get to the list of elements
-        while(line.find("$Elements") == std::string::npos)
-            std::getline(gridFile, line);
-
-        // read elements
-        std::getline(gridFile, line);
-        const auto numElements = convertString<std::size_t>(line);
-
-        // keep track of number of elements
-        std::array<std::size_t, numGrids> elementCount;
-        std::fill(elementCount.begin(), elementCount.end(), 0);
-
-        // for low dim grids, construct maps that map bulk grid vertex
-        // indices to lowDim vertex indices. -1 indicates non-initialized status
-        std::size_t elemCount = 0;
-        std::array<std::size_t, numGrids-1> lowDimVertexCount;
-        std::array<std::vector<GridIndexType>, numGrids-1> lowDimVertexMap;
-        std::array<std::vector<bool>, numGrids-1> idxIsAssigned;
-        std::fill(lowDimVertexCount.begin(), lowDimVertexCount.end(), 0);
-        std::fill(lowDimVertexMap.begin(), lowDimVertexMap.end(), std::vector<GridIndexType>(vertexCount));
-        std::fill(idxIsAssigned.begin(), idxIsAssigned.end(), std::vector<bool>(vertexCount, false));
-        std::getline(gridFile, line);
-        while (line.find("$EndElements") == std::string::npos)
-        {
-            // pass all indices into vector
-            std::istringstream stream(line);
-            std::string buf;
-            std::vector<std::size_t> lineData;
-            while (stream >> buf) lineData.push_back(convertString<std::size_t>(buf));
-            assert(lineData.size() >= 4 && "Grid format erroneous or unsupported");
-
-            // obtain geometry type
-            const auto gt = obtainGeometryType( lineData[1] );
-            const std::size_t physicalIndex = lineData[3];
-            const auto geoDim = gt.dim();
-            const bool isBoundarySeg = geoDim != bulkDim && physicalIndex < boundarySegThresh;
-            if (geoDim >= minGridDim-1)
-            {
-                // insert boundary segment
-                if ((isBoundarySeg || geoDim == minGridDim-1))
-                {
-                    const unsigned int higherGridIdx = bulkDim-geoDim-1;
-                    const unsigned int idxInLowDimGrids = higherGridIdx-1;
-
-                    VertexIndexSet corners;
-                    auto it = lineData.begin()+2+lineData[2]+1;
-                    for (; it != lineData.end(); ++it)
-                    {
-                        *it -= 1; // gmsh indices start from 1
-                        if (geoDim+1 < bulkDim) // modify and obtain from next level grid vertex map
-                        {
-                            // insert map if vertex is not inserted yet
-                            if (!idxIsAssigned[idxInLowDimGrids][*it])
-                            {
-                                lowDimVertexMap[idxInLowDimGrids][*it] = lowDimVertexCount[idxInLowDimGrids]++;
-                                idxIsAssigned[idxInLowDimGrids][*it] = true;
-                                lowDimGridVertexIndices_[idxInLowDimGrids].push_back(*it);
-                            }
-                            corners.push_back(lowDimVertexMap[idxInLowDimGrids][*it]);
-                        }
-                        else // next level grid is bulk grid
-                            corners.push_back(*it);
-                    }
-
-                    // marker = physical entity index
-                    boundaryMarkerMaps_[higherGridIdx].push_back(physicalIndex);
-                    boundarySegments_[higherGridIdx].push_back(corners);
-                }
-
-                // insert element
-                else
-                {
-                    const unsigned int gridIdx = bulkDim-geoDim;
-                    const unsigned int idxInLowDimGrids = gridIdx-1;
-
-                    VertexIndexSet corners;
-                    auto it = lineData.begin()+2+lineData[2]+1;
-                    for (; it != lineData.end(); ++it)
-                    {
-                        *it -= 1; // gmsh indices start from 1
-                        if (geoDim < bulkDim) // lower-dimensional element
-                        {
-                            // insert map, if vertex is not inserted yet
-                            if (!idxIsAssigned[idxInLowDimGrids][*it])
-                            {
-                                lowDimVertexMap[idxInLowDimGrids][*it] = lowDimVertexCount[idxInLowDimGrids]++;
-                                idxIsAssigned[idxInLowDimGrids][*it] = true;
-                                lowDimGridVertexIndices_[idxInLowDimGrids].push_back(*it);
-                            }
-                            corners.push_back(lowDimVertexMap[idxInLowDimGrids][*it]);
-                        }
-                        else // bulk element
-                            corners.push_back(*it);
-                    }
-
-                    // add data to embedments/embeddings
-                    if (geoDim > minGridDim)
-                    {
-                        const auto gridElemCount = elementData_[gridIdx].size();
-                        const auto& embeddedVIndices = lowDimGridVertexIndices_[gridIdx];
-                        const auto& idxIsAssignedMap = idxIsAssigned[gridIdx];
-                        if (geoDim == bulkDim)
-                            addEmbeddings(corners, gridIdx, gridElemCount, embeddedVIndices, idxIsAssignedMap);
-                        else
-                        {
-                            VertexIndexSet cornerBulkIndices(corners.size());
-                            for (unsigned int i = 0; i < corners.size(); ++i)
-                                cornerBulkIndices[i] = lowDimGridVertexIndices_[idxInLowDimGrids][corners[i]];
-                            addEmbeddings(cornerBulkIndices, gridIdx, gridElemCount, embeddedVIndices, idxIsAssignedMap);
-                        }
-                    }
-
-                    // ensure dune-specific corner ordering
-                    reorder(gt, corners);
-
-                    // insert element data to grid's container
-                    elementMarkerMaps_[gridIdx].push_back(physicalIndex);
-                    elementData_[gridIdx].emplace_back(ElementData({gt, corners}));
-                }
-            }
-
-            // get next line
-            std::getline(gridFile, line);
-            elemCount++;
-        }
+        readFile(fileName, boundarySegThresh, verbose);
+    }
 
-        // make sure we read all elements
-        if (elemCount != numElements)
-            DUNE_THROW(Dune::InvalidStateException, "Didn't read as many elements as stated in the .msh file");
+    /*!
+     * \brief Reads the data from a given mesh file and inserts the vertices,
+     *        elements and (optionally) boundary segments directly into the grid
+     *        factories of the hierarchy. The elements and boundary segments are
+     *        not stored in this reader, and the bulk grid vertices are released
+     *        after reading.
+     *
+     * \param fileName The name of the .msh file
+     * \param gridFactories A tuple of (smart) pointers to the grid factories of the hierarchy
+     * \param boundarySegThresh Entities with smaller physical index are boundary segments
+     * \param insertBoundarySegments Whether to insert boundary segments into the factories
+     * \param verbose Whether to print information on the read grids
+     */
+    template<class GridFactoryPtrs>
+    void read(const std::string& fileName,
+              GridFactoryPtrs& gridFactories,
+              std::size_t boundarySegThresh,
+              bool insertBoundarySegments,
+              bool verbose = false)
+    {
+        static_assert(std::tuple_size<GridFactoryPtrs>::value == numGrids, "Provide one grid factory per grid");
 
-        if (verbose)
+        using namespace Dune::Hybrid;
+        forEach(integralRange(Dune::Hybrid::size(gridFactories)), [&](const auto id)
         {
-            std::cout << "Finished reading gmsh file" << std::endl;
-            for (std::size_t id = 0; id < numGrids; ++id)
-            {
-                std::cout << elementData_[id].size() << " "
-                          << bulkDim-id << "-dimensional elements comprising of ";
-                if (id == 0) std::cout << vertexCount;
-                else std::cout << lowDimVertexCount[id-1];
-                std::cout << " vertices";
-                if (id < numGrids-1) std::cout << "," << std::endl;
-            }
-            std::cout << " have been read in " << watch.elapsed() << " seconds." << std::endl;
-        }
+            auto factory = &(*std::get<id>(gridFactories));
+            insertVertex_[id] = [factory] (const GlobalPosition& v) { factory->insertVertex(v); };
+            insertElement_[id] = [factory] (const Dune::GeometryType& gt, const VertexIndexSet& corners)
+                                 { factory->insertElement(gt, corners); };
+
+            if (insertBoundarySegments)
+                insertBoundarySegment_[id] = [factory] (const VertexIndexSet& corners)
+                                             { factory->insertBoundarySegment(corners); };
+            else
+                insertBoundarySegment_[id] = [] (const VertexIndexSet&) {};
+        });
+
+        readFile(fileName, boundarySegThresh, verbose);
+
+        // the coordinates have been passed to the factories
+        bulkGridvertices_.clear();
+        bulkGridvertices_.shrink_to_fit();
     }
 
     //! Returns the bulk grid vertices
@@ -330,16 +444,420 @@ public:
     }
 
 private:
-    //! converts a value contained in a string
-    template<class T>
-    T convertString(const std::string& string) const
+    //! reads the file and passes the entities to the inserters
+    void readFile(const std::string& fileName, std::size_t boundarySegThresh, bool verbose)
     {
-        T value;
-        std::istringstream stream(string);
-        stream >> value;
-        if (stream.fail())
-            DUNE_THROW(Dune::InvalidStateException, "Couldn't convert string: " << string << "to type: " << typeid(T).name());
-        return value;
+        Dune::Timer watch;
+        if (verbose) std::cout << "Opening " << fileName << std::endl;
+        std::ifstream gridFile(fileName, std::ios::binary);
+        if (gridFile.fail())
+            DUNE_THROW(Dune::InvalidStateException, "Could not open the given .msh file. Make sure it exists");
+
+        boundarySegThresh_ = boundarySegThresh;
+        std::fill(elementCount_.begin(), elementCount_.end(), 0);
+
+        // read the file section by section until we read the elements
+        Detail::GmshDataStream stream(gridFile);
+        double version = 2.0;
+        bool readElements = false;
+        std::string line;
+        while (!readElements && stream.getLine(line))
+        {
+            if (line.compare(0, 11, "$MeshFormat") == 0)
+                version = readMeshFormat(stream);
+            else if (line.compare(0, 9, "$Entities") == 0)
+                readEntities(stream);
+            else if (line.compare(0, 6, "$Nodes") == 0)
+            {
+                if (version < 3.0) readNodesV2(stream);
+                else readNodesV4(stream);
+            }
+            else if (line.compare(0, 9, "$Elements") == 0)
+            {
+                if (version < 3.0) readElementsV2(stream);
+                else readElementsV4(stream);
+                readElements = true;
+            }
+            else if (line.compare(0, 20, "$PartitionedEntities") == 0)
+                DUNE_THROW(Dune::NotImplemented, "FacetCoupling gmsh reader for partitioned .msh files");
+            else if (line.size() > 1 && line[0] == '$')
+                stream.skipSection(line.substr(1, line.find_first_of(" \t\r") - 1));
+        }
+
+        if (!readElements)
+            DUNE_THROW(Dune::InvalidStateException, "Could not find the elements in the .msh file");
+
+        // release the data only needed during reading
+        for (auto& map : lowDimVertexMap_) { map.clear(); map.shrink_to_fit(); }
+        for (auto& elements : embeddedElements_) elements = EmbeddedElements();
+        for (auto& map : entityPhysicalTags_) map.clear();
+        nodeTagToIndex_.clear();
+        nodeTagToIndex_.shrink_to_fit();
+
+        if (verbose)
+        {
+            std::cout << "Finished reading gmsh file" << std::endl;
+            for (std::size_t id = 0; id < numGrids; ++id)
+            {
+                std::cout << elementCount_[id] << " "
+                          << bulkDim-id << "-dimensional elements comprising of ";
+                if (id == 0) std::cout << bulkGridvertices_.size();
+                else std::cout << lowDimGridVertexIndices_[id-1].size();
+                std::cout << " vertices";
+                if (id < numGrids-1) std::cout << "," << std::endl;
+            }
+            std::cout << " have been read in " << watch.elapsed() << " seconds." << std::endl;
+        }
+    }
+
+    //! reads the mesh format section and returns the file format version
+    double readMeshFormat(Detail::GmshDataStream& stream)
+    {
+        std::string line;
+        stream.getLine(line);
+        char* end;
+        const double version = std::strtod(line.c_str(), &end);
+        const long fileType = std::strtol(end, &end, 10);
+        const long dataSize = std::strtol(end, &end, 10);
+
+        if (version >= 3.0 && version < 4.1)
+            DUNE_THROW(Dune::NotImplemented, "FacetCoupling gmsh reader for msh file format version " << version << " (use 2 or 4.1)");
+        if (version < 2.0 || version >= 5.0)
+            DUNE_THROW(Dune::IOError, "Unsupported msh file format version " << version);
+
+        bool swapBytes = false;
+        if (fileType == 1)
+        {
+            // the integer one is written in binary to detect the byte order
+            std::int32_t one;
+            stream.setFormat(true);
+            stream.readInts(&one, 1);
+            if (one != 1)
+            {
+                std::reverse(reinterpret_cast<char*>(&one), reinterpret_cast<char*>(&one) + sizeof(one));
+                if (one != 1)
+                    DUNE_THROW(Dune::IOError, "Could not determine the byte order of the binary .msh file");
+                swapBytes = true;
+            }
+        }
+
+        stream.setFormat(fileType == 1, swapBytes, dataSize);
+        stream.finishSection("MeshFormat");
+        return version;
+    }
+
+    //! reads the physical tags of the geometrical entities (msh format 4)
+    void readEntities(Detail::GmshDataStream& stream)
+    {
+        std::array<std::size_t, 4> numEntities;
+        stream.readSizes(numEntities.data(), 4);
+
+        for (int dim = 0; dim < 4; ++dim)
+        {
+            for (std::size_t i = 0; i < numEntities[dim]; ++i)
+            {
+                const int tag = stream.readInt();
+
+                // points store their coordinates, all others their bounding box
+                std::array<double, 6> coordinates;
+                stream.readDoubles(coordinates.data(), dim == 0 ? 3 : 6);
+
+                // we use the first physical tag of an entity
+                const auto numPhysicalTags = stream.readSize();
+                int physicalTag = 0;
+                for (std::size_t j = 0; j < numPhysicalTags; ++j)
+                {
+                    const int t = stream.readInt();
+                    if (j == 0) physicalTag = t;
+                }
+                entityPhysicalTags_[dim][tag] = physicalTag;
+
+                if (dim > 0)
+                {
+                    const auto numBoundingEntities = stream.readSize();
+                    for (std::size_t j = 0; j < numBoundingEntities; ++j)
+                        stream.readInt();
+                }
+            }
+        }
+
+        stream.finishSection("Entities");
+    }
+
+    //! reads the nodes (msh format 2)
+    void readNodesV2(Detail::GmshDataStream& stream)
+    {
+        const auto numVertices = stream.readSizeLine();
+        bulkGridvertices_.reserve(numVertices);
+
+        std::array<double, 3> coordinates;
+        for (std::size_t i = 0; i < numVertices; ++i)
+        {
+            const auto tag = stream.readInt();
+            stream.readDoubles(coordinates.data(), 3);
+            insertBulkVertex(tag, coordinates);
+        }
+
+        stream.finishSection("Nodes");
+        initLowDimVertexMaps();
+    }
+
+    //! reads the nodes (msh format 4.1)
+    void readNodesV4(Detail::GmshDataStream& stream)
+    {
+        std::array<std::size_t, 4> header; // numBlocks, numNodes, minTag, maxTag
+        stream.readSizes(header.data(), 4);
+        bulkGridvertices_.reserve(header[1]);
+
+        std::vector<std::size_t> tags;
+        std::array<double, 6> coordinates;
+        for (std::size_t block = 0; block < header[0]; ++block)
+        {
+            const int entityDim = stream.readInt();
+            stream.readInt(); // entity tag
+            const bool parametric = stream.readInt() != 0;
+            const auto numNodesInBlock = stream.readSize();
+
+            // all tags of the block precede the coordinates
+            tags.resize(numNodesInBlock);
+            stream.readSizes(tags.data(), numNodesInBlock);
+            for (const auto tag : tags)
+            {
+                stream.readDoubles(coordinates.data(), parametric ? 3 + entityDim : 3);
+                insertBulkVertex(tag, coordinates);
+            }
+        }
+
+        if (bulkGridvertices_.size() != header[1])
+            DUNE_THROW(Dune::InvalidStateException, "Couldn't find as many vertices as stated in the .msh file");
+
+        stream.finishSection("Nodes");
+        initLowDimVertexMaps();
+    }
+
+    //! reads the elements (msh format 2)
+    void readElementsV2(Detail::GmshDataStream& stream)
+    {
+        const auto numElements = stream.readSizeLine();
+
+        std::vector<int> data;
+        if (!stream.binary())
+        {
+            std::array<int, 3> header; // number, type, number of tags
+            for (std::size_t i = 0; i < numElements; ++i)
+            {
+                stream.readInts(header.data(), 3);
+                const auto numNodes = obtainNumNodes(header[1]);
+                data.resize(header[2] + numNodes);
+                stream.readInts(data.data(), data.size());
+                processElement(header[1], header[2] > 0 ? data[0] : 0, data.data() + header[2], numNodes);
+            }
+        }
+        else
+        {
+            // elements are stored in blocks of elements with the same type and number of tags
+            std::size_t elemCount = 0;
+            std::array<int, 3> header; // type, number of elements in block, number of tags
+            while (elemCount < numElements)
+            {
+                stream.readInts(header.data(), 3);
+                const auto numNodes = obtainNumNodes(header[0]);
+                const std::size_t recordSize = 1 + header[2] + numNodes;
+
+                // read the block in chunks to limit the memory usage
+                for (std::size_t i = 0; i < std::size_t(header[1]); i += chunkSize)
+                {
+                    const auto n = std::min(std::size_t(chunkSize), header[1] - i);
+                    data.resize(n*recordSize);
+                    stream.readInts(data.data(), data.size());
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        const int* record = data.data() + j*recordSize;
+                        processElement(header[0], header[2] > 0 ? record[1] : 0, record + 1 + header[2], numNodes);
+                    }
+                }
+
+                elemCount += header[1];
+            }
+
+            if (elemCount != numElements)
+                DUNE_THROW(Dune::InvalidStateException, "Didn't read as many elements as stated in the .msh file");
+        }
+
+        stream.finishSection("Elements");
+    }
+
+    //! reads the elements (msh format 4.1)
+    void readElementsV4(Detail::GmshDataStream& stream)
+    {
+        std::array<std::size_t, 4> header; // numBlocks, numElements, minTag, maxTag
+        stream.readSizes(header.data(), 4);
+
+        std::size_t elemCount = 0;
+        std::vector<std::size_t> data;
+        for (std::size_t block = 0; block < header[0]; ++block)
+        {
+            const int entityDim = stream.readInt();
+            const int entityTag = stream.readInt();
+            const int type = stream.readInt();
+            const auto numElementsInBlock = stream.readSize();
+            const auto numNodes = obtainNumNodes(type);
+
+            if (entityDim < 0 || entityDim > 3)
+                DUNE_THROW(Dune::IOError, "Invalid entity dimension " << entityDim << " in .msh file");
+            const auto& physicalTags = entityPhysicalTags_[entityDim];
+            const auto it = physicalTags.find(entityTag);
+            const int physicalIndex = it != physicalTags.end() ? it->second : 0;
+
+            // read the block in chunks to limit the memory usage
+            const std::size_t recordSize = 1 + numNodes;
+            for (std::size_t i = 0; i < numElementsInBlock; i += chunkSize)
+            {
+                const auto n = std::min(std::size_t(chunkSize), numElementsInBlock - i);
+                data.resize(n*recordSize);
+                stream.readSizes(data.data(), data.size());
+                for (std::size_t j = 0; j < n; ++j)
+                    processElement(type, physicalIndex, data.data() + j*recordSize + 1, numNodes);
+            }
+
+            elemCount += numElementsInBlock;
+        }
+
+        if (elemCount != header[1])
+            DUNE_THROW(Dune::InvalidStateException, "Didn't read as many elements as stated in the .msh file");
+
+        stream.finishSection("Elements");
+    }
+
+    //! stores a vertex of the bulk grid and inserts it into the bulk grid
+    template<class Coordinates>
+    void insertBulkVertex(std::size_t tag, const Coordinates& coordinates)
+    {
+        const std::size_t index = bulkGridvertices_.size();
+
+        // only store a map if the tags are not the consecutive indices starting from one
+        if (!nodeTagToIndex_.empty() || tag != index+1)
+        {
+            if (nodeTagToIndex_.empty())
+            {
+                nodeTagToIndex_.resize(index+1);
+                for (std::size_t i = 0; i < index; ++i)
+                    nodeTagToIndex_[i+1] = i;
+            }
+
+            if (tag >= nodeTagToIndex_.size())
+                nodeTagToIndex_.resize(tag+1, GridIndexType(unassigned));
+            nodeTagToIndex_[tag] = index;
+        }
+
+        GlobalPosition v;
+        for (int i = 0; i < bulkDimWorld; ++i)
+            v[i] = coordinates[i];
+
+        bulkGridvertices_.push_back(v);
+        insertVertex_[0](v);
+    }
+
+    //! returns the bulk grid vertex index for a node tag
+    GridIndexType vertexIndex(std::size_t tag) const
+    {
+        const auto index = nodeTagToIndex_.empty() ? tag-1
+                           : tag < nodeTagToIndex_.size() ? nodeTagToIndex_[tag] : GridIndexType(unassigned);
+        if (tag == 0 || index >= bulkGridvertices_.size())
+            DUNE_THROW(Dune::IOError, "Element refers to unknown node " << tag);
+        return index;
+    }
+
+    //! initializes the maps from bulk grid vertices to lower-dimensional grid vertices
+    void initLowDimVertexMaps()
+    {
+        for (auto& map : lowDimVertexMap_)
+            map.assign(bulkGridvertices_.size(), GridIndexType(unassigned));
+    }
+
+    //! returns the index of a bulk grid vertex in a lower-dimensional grid (inserts it if necessary)
+    GridIndexType lowDimVertexIndex(unsigned int gridIdx, GridIndexType bulkVertexIdx)
+    {
+        auto& index = lowDimVertexMap_[gridIdx-1][bulkVertexIdx];
+        if (index == unassigned)
+        {
+            auto& vertexIndices = lowDimGridVertexIndices_[gridIdx-1];
+            index = vertexIndices.size();
+            vertexIndices.push_back(bulkVertexIdx);
+            insertVertex_[gridIdx](bulkGridvertices_[bulkVertexIdx]);
+        }
+
+        return index;
+    }
+
+    //! passes an element read from the file to the corresponding grid or boundary segments
+    template<class NodeTag>
+    void processElement(int gmshElemType, int physicalIndex, const NodeTag* nodeTags, std::size_t numNodes)
+    {
+        // obtain geometry type
+        const auto gt = obtainGeometryType( gmshElemType );
+        const int geoDim = gt.dim();
+        if (geoDim < minGridDim-1)
+            return;
+
+        const bool isBoundarySeg = geoDim != bulkDim && std::size_t(physicalIndex) < boundarySegThresh_;
+
+        // insert boundary segment
+        if ((isBoundarySeg || geoDim == minGridDim-1))
+        {
+            const unsigned int higherGridIdx = bulkDim-geoDim-1;
+
+            corners_.resize(numNodes);
+            for (std::size_t i = 0; i < numNodes; ++i)
+            {
+                const auto vIdx = vertexIndex(nodeTags[i]);
+                if (geoDim+1 < bulkDim) // obtain from next level grid vertex map
+                    corners_[i] = lowDimVertexIndex(higherGridIdx, vIdx);
+                else // next level grid is bulk grid
+                    corners_[i] = vIdx;
+            }
+
+            // marker = physical entity index
+            boundaryMarkerMaps_[higherGridIdx].push_back(physicalIndex);
+            insertBoundarySegment_[higherGridIdx](corners_);
+        }
+
+        // insert element
+        else
+        {
+            const unsigned int gridIdx = bulkDim-geoDim;
+
+            corners_.resize(numNodes);
+            bulkCorners_.resize(numNodes);
+            for (std::size_t i = 0; i < numNodes; ++i)
+            {
+                bulkCorners_[i] = vertexIndex(nodeTags[i]);
+                if (geoDim < bulkDim) // lower-dimensional element
+                    corners_[i] = lowDimVertexIndex(gridIdx, bulkCorners_[i]);
+                else // bulk element
+                    corners_[i] = bulkCorners_[i];
+            }
+
+            // add data to embedments/embeddings
+            if (geoDim > minGridDim)
+                addEmbeddings(bulkCorners_, gridIdx, elementCount_[gridIdx]);
+
+            // store the corners of elements that are embedded in higher-dimensional ones
+            if (gridIdx > 0)
+            {
+                auto& embeddedElements = embeddedElements_[gridIdx-1];
+                embeddedElements.corners.insert(embeddedElements.corners.end(), corners_.begin(), corners_.end());
+                embeddedElements.cornerOffsets.push_back(embeddedElements.corners.size());
+            }
+
+            // ensure dune-specific corner ordering
+            reorder(gt, corners_);
+
+            // insert element into the grid
+            elementMarkerMaps_[gridIdx].push_back(physicalIndex);
+            insertElement_[gridIdx](gt, corners_);
+            elementCount_[gridIdx]++;
+        }
     }
 
     //! obtain Dune::GeometryType from a given gmsh element type
@@ -359,6 +877,22 @@ private:
         }
     }
 
+    //! the number of nodes of a given gmsh element type
+    std::size_t obtainNumNodes(int gmshElemType) const
+    {
+        switch (gmshElemType)
+        {
+            case 15: return 1;
+            case 1:  return 2;
+            case 2:  return 3;
+            case 3:  return 4;
+            case 4:  return 4;
+            case 5:  return 8;
+            default:
+                DUNE_THROW(Dune::NotImplemented, "FacetCoupling gmsh reader for gmsh element type " << gmshElemType);
+        }
+    }
+
     //! reorders in a dune way a set of given element corners in gmsh ordering
     void reorder(const Dune::GeometryType gt, VertexIndexSet& cornerIndices) const
     {
@@ -372,42 +906,73 @@ private:
         }
     }
 
+    //! updates the elements connected to the vertices of an embedded grid
+    void updateVertexElements(EmbeddedElements& elements, std::size_t numVertices)
+    {
+        const std::size_t numElements = elements.cornerOffsets.size()-1;
+        if (elements.numIndexedElements == numElements && elements.vertexOffsets.size() == numVertices+1)
+            return;
+
+        elements.vertexOffsets.assign(numVertices+1, 0);
+        for (const auto vIdx : elements.corners)
+            elements.vertexOffsets[vIdx+1]++;
+        for (std::size_t vIdx = 0; vIdx < numVertices; ++vIdx)
+            elements.vertexOffsets[vIdx+1] += elements.vertexOffsets[vIdx];
+
+        auto position = elements.vertexOffsets;
+        elements.vertexElements.resize(elements.corners.size());
+        for (std::size_t eIdx = 0; eIdx < numElements; ++eIdx)
+            for (std::size_t i = elements.cornerOffsets[eIdx]; i < elements.cornerOffsets[eIdx+1]; ++i)
+                elements.vertexElements[position[elements.corners[i]]++] = eIdx;
+
+        elements.numIndexedElements = numElements;
+    }
+
     //! adds embeddings/embedments to the map for a given element
     void addEmbeddings(const VertexIndexSet& corners,
                        unsigned int gridIdx,
-                       std::size_t curElemIdx,
-                       const std::vector<GridIndexType>& lowDimVIndices,
-                       const std::vector<bool>& idxIsAssigned)
+                       std::size_t curElemIdx)
     {
         const unsigned int embeddedGridIdx = gridIdx+1;
+        const auto& lowDimVIndices = lowDimGridVertexIndices_[gridIdx];
+        const auto& lowDimVertexMap = lowDimVertexMap_[gridIdx];
+        auto& embeddedElements = embeddedElements_[gridIdx];
+        updateVertexElements(embeddedElements, lowDimVIndices.size());
 
-        // check for embedments only if a vertex is
-        // already contained in the lower-dimensional grid
+        // candidates are the lower-dimensional elements connected to the corners
+        candidates_.clear();
         for (auto cIdx : corners)
         {
-            if (idxIsAssigned[cIdx]) // vertex is part of the lower-dimensional grid
-            {
-                for (std::size_t i = 0; i < elementData_[embeddedGridIdx].size(); ++i)
-                {
-                    const auto& e = elementData_[embeddedGridIdx][i];
-
-                    // if all corners are contained within this element, it is embedded
-                    auto vertIsContained = [&lowDimVIndices, &corners] (auto eCornerIdx)
-                                           { return std::find(corners.begin(),
-                                                              corners.end(),
-                                                              lowDimVIndices[eCornerIdx]) != corners.end(); };
-                    if ( std::all_of(e.cornerIndices.begin(), e.cornerIndices.end(), vertIsContained) )
-                    {
-                        embeddedEntityMaps_[gridIdx][curElemIdx].push_back(i);
-                        adjoinedEntityMaps_[embeddedGridIdx][i].push_back(curElemIdx);
-                    }
-                }
+            const auto lowDimVIdx = lowDimVertexMap[cIdx];
+            if (lowDimVIdx != unassigned) // vertex is part of the lower-dimensional grid
+                candidates_.insert(candidates_.end(),
+                                   embeddedElements.vertexElements.begin() + embeddedElements.vertexOffsets[lowDimVIdx],
+                                   embeddedElements.vertexElements.begin() + embeddedElements.vertexOffsets[lowDimVIdx+1]);
+        }
 
-                return;
+        std::sort(candidates_.begin(), candidates_.end());
+        candidates_.erase(std::unique(candidates_.begin(), candidates_.end()), candidates_.end());
+
+        for (const auto i : candidates_)
+        {
+            // if all corners are contained within this element, it is embedded
+            auto vertIsContained = [&lowDimVIndices, &corners] (auto eCornerIdx)
+                                   { return std::find(corners.begin(),
+                                                      corners.end(),
+                                                      lowDimVIndices[eCornerIdx]) != corners.end(); };
+            const auto begin = embeddedElements.corners.begin() + embeddedElements.cornerOffsets[i];
+            const auto end = embeddedElements.corners.begin() + embeddedElements.cornerOffsets[i+1];
+            if ( std::all_of(begin, end, vertIsContained) )
+            {
+                embeddedEntityMaps_[gridIdx][curElemIdx].push_back(i);
+                adjoinedEntityMaps_[embeddedGridIdx][i].push_back(curElemIdx);
             }
         }
     }
 
+    //! number of elements read at once from binary files
+    static constexpr std::size_t chunkSize = 4096;
+
     //! data on grid entities
     std::vector<GlobalPosition> bulkGridvertices_;
     std::array<VertexIndexSet, numGrids-1> lowDimGridVertexIndices_;
@@ -421,6 +986,22 @@ private:
     //! data on domain and boundary markers
     std::array< std::vector<int>, numGrids > elementMarkerMaps_;
     std::array< std::vector<int>, numGrids > boundaryMarkerMaps_;
+
+    //! the functions passing the read entities to the grids
+    std::array<VertexInserter, numGrids> insertVertex_;
+    std::array<ElementInserter, numGrids> insertElement_;
+    std::array<SegmentInserter, numGrids> insertBoundarySegment_;
+
+    //! data only needed while reading the file
+    std::size_t boundarySegThresh_ = 0;
+    std::array<std::size_t, numGrids> elementCount_;
+    std::vector<GridIndexType> nodeTagToIndex_;
+    std::array<std::vector<GridIndexType>, numGrids-1> lowDimVertexMap_;
+    std::array<EmbeddedElements, numGrids-1> embeddedElements_;
+    std::array<std::unordered_map<int, int>, 4> entityPhysicalTags_;
+    VertexIndexSet corners_;
+    VertexIndexSet bulkCorners_;
+    std::vector<GridIndexType> candidates_;
 };
 
 } // end namespace Dumux
@@ -343,8 +343,15 @@ public:
         {
             const auto thresh = getParamFromGroup<std::size_t>(paramGroup, "Grid.GmshPhysicalEntityThreshold", 0);
             FacetCouplingGmshReader<Grid<bulkGridId>, numGrids> gmshReader;
-            gmshReader.read(fileName, (boundarySegments ? thresh : 0), verbose);
-            passDataFromReader(gmshReader, domainMarkers, boundarySegments);
+
+            // the reader inserts the entities directly into the grid factories
+            GridFactoryPtrTuple gridFactories;
+            using namespace Dune::Hybrid;
+            forEach(integralRange(Dune::Hybrid::size(gridFactories)), [&](const auto id)
+            { std::get<id>(gridFactories) = std::make_shared<GridFactory<id>>(); });
+
+            gmshReader.read(fileName, gridFactories, (boundarySegments ? thresh : 0), boundarySegments, verbose);
+            passDataFromReader(gmshReader, gridFactories, domainMarkers, boundarySegments);
         }
         else
             DUNE_THROW(Dune::NotImplemented, "Reader for grid files of type ." + ext);
@@ -374,33 +381,14 @@ private:
             DUNE_THROW(Dune::IOError, "Please provide an extension for your grid file ('"<< fileName << "')!");
     }
 
-    //! Creates the grids using the data in a mesh file reader
-    template<typename MeshFileReader>
-    void passDataFromReader(MeshFileReader& reader, bool domainMarkers, bool boundarySegments)
+    //! Creates the grids from the factories filled by a mesh file reader
+    template<typename MeshFileReader, typename GridFactoryPtrs>
+    void passDataFromReader(MeshFileReader& reader, GridFactoryPtrs& gridFactories, bool domainMarkers, bool boundarySegments)
     {
-        const auto& bulkGridVertices = reader.bulkGridVertices();
         using namespace Dune::Hybrid;
         forEach(integralRange(Dune::Hybrid::size(gridPtrTuple_)), [&](const auto id)
         {
-            using GridFactory = Dune::GridFactory<Grid<id>>;
-            auto factoryPtr = std::make_shared<GridFactory>();
-
-            // insert grid vertices
-            if (id == 0)
-                for (const auto& v : bulkGridVertices)
-                    factoryPtr->insertVertex(v);
-            else
-                for (const auto idx : reader.lowDimVertexIndices(id))
-                    factoryPtr->insertVertex(bulkGridVertices[idx]);
-
-            // insert elements
-            for (const auto& e : reader.elementData(id))
-                factoryPtr->insertElement(e.gt, e.cornerIndices);
-
-            // insert boundary segments
-            if (boundarySegments)
-                for (const auto& segment : reader.boundarySegmentData(id))
-                    factoryPtr->insertBoundarySegment(segment);
+            auto factoryPtr = std::get<id>(gridFactories);
 
             // make grid
             auto gridPtr = std::shared_ptr<Grid<id>>(factoryPtr->createGrid());
@@ -438,6 +426,11 @@ private:
     using GridPtrTuple = typename makeFromIndexedType<std::tuple, GridPtr, Indices>::type;
     GridPtrTuple gridPtrTuple_;
 
+    //! tuple to store the grid factories filled by the readers
+    template<std::size_t id> using GridFactory = Dune::GridFactory<Grid<id>>;
+    template<std::size_t id> using GridFactoryPtr = std::shared_ptr< GridFactory<id> >;
+    using GridFactoryPtrTuple = typename makeFromIndexedType<std::tuple, GridFactoryPtr, Indices>::type;
+
     //! grid data, i.e. parameters and markers
     bool enableEntityMarkers_;
     std::shared_ptr<GridData> gridDataPtr_;
@@ -191,6 +191,32 @@ public:
         });
     }
 
+    /*!
+     * \brief Assembles the diagonal Jacobian block and the residual of a single
+     *        sub-domain for the current solution. The coupling blocks are not assembled
+     *        and the other sub-domains are left untouched (used by sequential solvers).
+     */
+    template<std::size_t i>
+    void assembleJacobianAndResidual(Dune::index_constant<i> domainId, const SolutionVector& curSol)
+    {
+        checkAssemblerState_();
+        if (!jacobian_)
+            resetJacobian_();
+        if (!residual_)
+            resetResidual_();
+
+        auto& jacBlock = (*jacobian_)[domainId][domainId];
+        auto& subRes = (*residual_)[domainId];
+        jacBlock = 0.0;
+        subRes = 0.0;
+
+        assemble_(domainId, [&](const auto& element)
+        {
+            SubDomainAssembler<i> subDomainAssembler(*this, element, curSol, *couplingManager_);
+            subDomainAssembler.assembleJacobianDiagonalBlockAndResidual(jacBlock, subRes, gridVariablesTuple_);
+        });
+    }
+
     //! compute the residuals using the internal residual
     void assembleResidual(const SolutionVector& curSol)
     {
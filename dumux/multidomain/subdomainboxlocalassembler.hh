@@ -132,27 +132,26 @@ public:
                 this->assembleJacobianCoupling(i, jacRow, residual, gridVariables);
         });
 
-        // lambda for the incorporation of Dirichlet Bcs
-        auto applyDirichlet = [&] (const auto& scvI,
-                                   const auto& dirichletValues,
-                                   const auto eqIdx,
-                                   const auto pvIdx)
-        {
-            res[scvI.dofIndex()][eqIdx] = this->curElemVolVars()[scvI].priVars()[pvIdx] - dirichletValues[pvIdx];
+        // incorporate Dirichlet BCs
+        incorporateDirichletBCs_(jacRow[domainId], res);
+    }
 
-            // in explicit schemes we only have entries on the diagonal
-            // and thus don't have to do anything with off-diagonal entries
-            if (implicit)
-            {
-                for (const auto& scvJ : scvs(this->fvGeometry()))
-                    jacRow[domainId][scvI.dofIndex()][scvJ.dofIndex()][eqIdx] = 0.0;
-            }
+    /*!
+     * \brief Computes the derivatives with respect to the given element and adds them
+     *        to the diagonal block of the global matrix only, i.e. the coupling blocks are
+     *        not assembled. The element residual is written into the right hand side.
+     */
+    template<class JacobianMatrixDiagBlock, class GridVariablesTuple>
+    void assembleJacobianDiagonalBlockAndResidual(JacobianMatrixDiagBlock& A, SubSolutionVector& res, GridVariablesTuple& gridVariables)
+    {
+        this->asImp_().bindLocalViews();
+        this->elemBcTypes().update(problem(), this->element(), this->fvGeometry());
 
-            jacRow[domainId][scvI.dofIndex()][scvI.dofIndex()][eqIdx][pvIdx] = 1.0;
-        };
+        const auto residual = this->asImp_().assembleJacobianAndResidualImpl(A, *std::get<domainId>(gridVariables));
+        for (const auto& scv : scvs(this->fvGeometry()))
+            res[scv.dofIndex()] += residual[scv.localDofIndex()];
 
-        // incorporate Dirichlet BCs
-        this->asImp_().evalDirichletBoundaries(applyDirichlet);
+        incorporateDirichletBCs_(A, res);
     }
 
     /*!
@@ -302,6 +301,32 @@ public:
     { return couplingManager_; }
 
 private:
+    //! overwrite the residual and the diagonal block rows of Dirichlet dofs
+    template<class JacobianMatrixDiagBlock>
+    void incorporateDirichletBCs_(JacobianMatrixDiagBlock& A, SubSolutionVector& res)
+    {
+        // lambda for the incorporation of Dirichlet Bcs
+        auto applyDirichlet = [&] (const auto& scvI,
+                                   const auto& dirichletValues,
+                                   const auto eqIdx,
+                                   const auto pvIdx)
+        {
+            res[scvI.dofIndex()][eqIdx] = this->curElemVolVars()[scvI].priVars()[pvIdx] - dirichletValues[pvIdx];
+
+            // in explicit schemes we only have entries on the diagonal
+            // and thus don't have to do anything with off-diagonal entries
+            if (implicit)
+            {
+                for (const auto& scvJ : scvs(this->fvGeometry()))
+                    A[scvI.dofIndex()][scvJ.dofIndex()][eqIdx] = 0.0;
+            }
+
+            A[scvI.dofIndex()][scvI.dofIndex()][eqIdx][pvIdx] = 1.0;
+        };
+
+        this->asImp_().evalDirichletBoundaries(applyDirichlet);
+    }
+
     CouplingManager& couplingManager_; //!< the coupling manager
 };
 
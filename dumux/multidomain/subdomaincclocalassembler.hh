@@ -129,6 +129,19 @@ public:
         });
     }
 
+    /*!
+     * \brief Computes the derivatives with respect to the given element and adds them
+     *        to the diagonal block of the global matrix only, i.e. the coupling blocks are
+     *        not assembled. The element residual is written into the right hand side.
+     */
+    template<class JacobianMatrixDiagBlock, class GridVariablesTuple>
+    void assembleJacobianDiagonalBlockAndResidual(JacobianMatrixDiagBlock& A, SubSolutionVector& res, GridVariablesTuple& gridVariables)
+    {
+        this->asImp_().bindLocalViews();
+        const auto globalI = this->fvGeometry().fvGridGeometry().elementMapper().index(this->element());
+        res[globalI] = this->asImp_().assembleJacobianAndResidualImplInverse(A, *std::get<domainId>(gridVariables));
+    }
+
     /*!
      * \brief Assemble the entries in a coupling block of the jacobian.
      *        There is no coupling block between a domain and itself.
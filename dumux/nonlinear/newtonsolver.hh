@@ -41,6 +41,7 @@
 
 #include <dumux/common/parameters.hh>
 #include <dumux/common/exceptions.hh>
+#include <dumux/common/profiler.hh>
 #include <dumux/common/typetraits/vector.hh>
 #include <dumux/common/typetraits/isvalid.hh>
 #include <dumux/linear/linearsolveracceptsmultitypematrix.hh>
@@ -726,6 +727,8 @@ private:
      */
     bool solve_(SolutionVector& uCurrentIter, std::shared_ptr<ConvergenceWriter> convWriter = nullptr)
     {
+        DUMUX_PROFILE_REGION("newton");
+
         // the given solution is the initial guess
         SolutionVector uLastIter(uCurrentIter);
         SolutionVector deltaU(uCurrentIter);
@@ -791,11 +794,14 @@ private:
 
                 // solve the resulting linear equation system
                 solveTimer.start();
+                {
+                    DUMUX_PROFILE_REGION("linear solve");
 
-                // set the delta vector to zero before solving the linear system!
-                deltaU = 0;
+                    // set the delta vector to zero before solving the linear system!
+                    deltaU = 0;
 
-                solveLinearSystem(deltaU);
+                    solveLinearSystem(deltaU);
+                }
                 solveTimer.stop();
 
                 ///////////////
@@ -808,9 +814,13 @@ private:
                 }
 
                 updateTimer.start();
-                // update the current solution (i.e. uOld) with the delta
-                // (i.e. u). The result is stored in u
-                newtonUpdate(uCurrentIter, uLastIter, deltaU);
+                {
+                    DUMUX_PROFILE_REGION("update");
+
+                    // update the current solution (i.e. uOld) with the delta
+                    // (i.e. u). The result is stored in u
+                    newtonUpdate(uCurrentIter, uLastIter, deltaU);
+                }
                 updateTimer.stop();
 
                 // tell the solver that we're done with this iteration
@@ -1058,27 +1068,30 @@ private:
         assert(checkMatrix_(A) && "Sub blocks of MultiType matrix have wrong sizes!");
 
         // create the bcrs matrix the IterativeSolver backend can handle
-        const auto M = MatrixConverter<JacobianMatrix>::multiTypeToBCRSMatrix(A);
+        // (the occupation pattern is computed once and reused as long as it doesn't change)
+        if (!matrixConverter_)
+            matrixConverter_ = std::make_unique<MatrixConverter<JacobianMatrix, Scalar>>();
+        const auto& M = matrixConverter_->convert(A);
 
         // get the new matrix sizes
         const std::size_t numRows = M.N();
         assert(numRows == M.M());
 
         // create the vector the IterativeSolver backend can handle
-        const auto bTmp = VectorConverter<SolutionVector>::multiTypeToBlockVector(b);
-        assert(bTmp.size() == numRows);
+        VectorConverter<SolutionVector, Scalar>::multiTypeToBlockVector(b, bTmp_);
+        assert(bTmp_.size() == numRows);
 
         // create a blockvector to which the linear solver writes the solution
-        using VectorBlock = typename Dune::FieldVector<Scalar, 1>;
-        using BlockVector = typename Dune::BlockVector<VectorBlock>;
-        BlockVector y(numRows);
+        if (y_.size() != numRows)
+            y_.resize(numRows);
+        y_ = 0.0;
 
         // solve
-        const bool converged = ls.solve(M, y, bTmp);
+        const bool converged = ls.solve(M, y_, bTmp_);
 
         // copy back the result y into x
         if(converged)
-            VectorConverter<SolutionVector>::retrieveValues(x, y);
+            VectorConverter<SolutionVector, Scalar>::retrieveValues(x, y_);
 
         return converged;
     }
@@ -1243,6 +1256,11 @@ private:
     std::unique_ptr<PrimaryVariableSwitch> priVarSwitch_;
     //! if we switched primary variables in the last iteration
     bool priVarsSwitchedInLastIteration_ = false;
+
+    //! converter and vectors for linear solvers that cannot handle MultiType matrices (kept to reuse the memory)
+    std::unique_ptr<MatrixConverter<JacobianMatrix, Scalar>> matrixConverter_;
+    Dune::BlockVector<Dune::FieldVector<Scalar, 1>> bTmp_;
+    Dune::BlockVector<Dune::FieldVector<Scalar, 1>> y_;
 };
 
 } // end namespace Dumux
@@ -2021,6 +2021,16 @@ void FvMpfaL3dInteractionVolumeContainer<TypeTag>::storeInteractionVolumeInfo()
 
         InteractionVolume& interactionVolume = interactionVolumes_[vIdxGlobal];
 
+#if HAVE_MPI
+        // interaction volumes are only needed around vertices of interior elements,
+        // volumes cut by the process boundary can not be completed anyway
+        if (vertex.partitionType() != Dune::InteriorEntity && vertex.partitionType() != Dune::BorderEntity)
+        {
+            interactionVolume.reset();
+            continue;
+        }
+#endif
+
         if (interactionVolume.getElementNumber() == 8)
         {
             storeInnerInteractionVolume(interactionVolume, vertex);
@@ -1615,6 +1615,16 @@ void FvMpfaL3dInteractionVolumeContainerAdaptive<TypeTag>::storeInteractionVolum
 
         InteractionVolume& interactionVolume = asImp_().interactionVolumes_[vIdxGlobal];
 
+#if HAVE_MPI
+        // interaction volumes are only needed around vertices of interior elements,
+        // volumes cut by the process boundary can not be completed anyway
+        if (vertex.partitionType() != Dune::InteriorEntity && vertex.partitionType() != Dune::BorderEntity)
+        {
+            interactionVolume.reset();
+            continue;
+        }
+#endif
+
         if (interactionVolume.getElementNumber() == 8)
         {
             asImp_().storeInnerInteractionVolume(interactionVolume, vertex);
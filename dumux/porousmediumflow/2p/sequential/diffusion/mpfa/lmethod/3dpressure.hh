@@ -29,6 +29,7 @@
 // dumux environment
 #include <dumux/porousmediumflow/2p/sequential/diffusion/properties.hh>
 #include <dumux/porousmediumflow/sequential/cellcentered/pressure.hh>
+#include <dumux/linear/vectorexchange.hh>
 #include "3dinteractionvolumecontainer.hh"
 #include "3dtransmissibilitycalculator.hh"
 
@@ -98,6 +99,7 @@ class FvMpfaL3dPressure2p: public FVPressure<TypeTag>
     using SolutionTypes = typename GET_PROP(TypeTag, SolutionTypes);
     using PrimaryVariables = typename SolutionTypes::PrimaryVariables;
     using ScalarSolutionType = typename SolutionTypes::ScalarSolution;
+    using ElementMapper = typename SolutionTypes::ElementMapper;
 
     enum
         {
@@ -311,6 +313,9 @@ public:
             }
         }
 
+        if (problem_.gridView().comm().size() > 1)
+            maxError_ = problem_.gridView().comm().max(maxError_);
+
         asImp_().assemble();
 
         this->solve();
@@ -446,6 +451,48 @@ public:
         }
     }
 
+    /*!
+     * \brief Solves the global system of equations
+     *
+     * In parallel, the pressure of overlap and ghost cells is afterwards
+     * exchanged with the processes owning these cells.
+     */
+    void solve()
+    {
+        ParentType::solve();
+
+#if HAVE_MPI
+        if (problem_.gridView().comm().size() > 1)
+        {
+            using DataHandle = VectorExchange<ElementMapper, ScalarSolutionType>;
+            DataHandle dataHandle(problem_.variables().elementMapper(), this->pressure());
+            problem_.gridView().template communicate<DataHandle>(dataHandle,
+                                                                 Dune::InteriorBorder_All_Interface,
+                                                                 Dune::ForwardCommunication);
+        }
+#endif
+    }
+
+    /*!
+     * \brief Exchanges the cell data of overlap and ghost cells
+     *
+     * Copies the <tt>CellData</tt> (including the flux data) of all interior cells
+     * to the processes on which these cells are overlap or ghost cells.
+     */
+    void communicateCellData()
+    {
+#if HAVE_MPI
+        if (problem_.gridView().comm().size() > 1)
+        {
+            using DataHandle = VectorExchange<ElementMapper, std::vector<CellData> >;
+            DataHandle dataHandle(problem_.variables().elementMapper(), problem_.variables().cellDataGlobal());
+            problem_.gridView().template communicate<DataHandle>(dataHandle,
+                                                                 Dune::InteriorBorder_All_Interface,
+                                                                 Dune::ForwardCommunication);
+        }
+#endif
+    }
+
     //! Returns the global container of the stored interaction volumes
     InteractionVolumeContainer& interactionVolumes()
     {
@@ -561,6 +608,7 @@ void FvMpfaL3dPressure2p<TypeTag>::initializeMatrixRowSize()
         int eIdxGlobalI = problem_.variables().index(element);
 
         std::set<int> neighborIndices;
+        neighborIndices.insert(eIdxGlobalI);
 
         int numVertices = element.geometry().corners();
 
@@ -632,6 +680,12 @@ void FvMpfaL3dPressure2p<TypeTag>::assemble()
     // run through all vertices
     for (const auto& vertex : vertices(problem_.gridView()))
     {
+#if HAVE_MPI
+        if (vertex.partitionType() != Dune::InteriorEntity && vertex.partitionType() != Dune::BorderEntity)
+        {
+            continue;
+        }
+#endif
         int vIdxGlobal = problem_.variables().index(vertex);
 
         InteractionVolume& interactionVolume = interactionVolumes_.interactionVolume(vIdxGlobal);
@@ -650,6 +704,24 @@ void FvMpfaL3dPressure2p<TypeTag>::assemble()
 
     } // end vertex iterator
 
+    // only do more if we have more than one process
+    if (problem_.gridView().comm().size() > 1)
+    {
+        // set ghost and overlap element entries
+        for (const auto& element : elements(problem_.gridView()))
+        {
+            if (element.partitionType() == Dune::InteriorEntity)
+                continue;
+
+            // get the global index of the cell
+            int eIdxGlobalI = problem_.variables().index(element);
+
+            this->A_[eIdxGlobalI] = 0.0;
+            this->A_[eIdxGlobalI][eIdxGlobalI] = 1.0;
+            this->f_[eIdxGlobalI] = this->pressure()[eIdxGlobalI];
+        }
+    }
+
     return;
 }
 
@@ -290,6 +290,7 @@ void FvMpfaL3dPressure2pAdaptive<TypeTag>::initializeMatrixRowSize()
         int levelI = element.level();
 
         std::set<int> neighborIndices;
+        neighborIndices.insert(globalIdxI);
 
         int numVertices = element.geometry().corners();
 
@@ -449,6 +450,24 @@ void FvMpfaL3dPressure2pAdaptive<TypeTag>::assemble()
 
     } // end vertex iterator
 
+    // only do more if we have more than one process
+    if (problem_.gridView().comm().size() > 1)
+    {
+        // set ghost and overlap element entries
+        for (const auto& element : elements(problem_.gridView()))
+        {
+            if (element.partitionType() == Dune::InteriorEntity)
+                continue;
+
+            // get the global index of the cell
+            int eIdxGlobalI = problem_.variables().index(element);
+
+            this->A_[eIdxGlobalI] = 0.0;
+            this->A_[eIdxGlobalI][eIdxGlobalI] = 1.0;
+            this->f_[eIdxGlobalI] = this->pressure()[eIdxGlobalI];
+        }
+    }
+
     return;
 }
 
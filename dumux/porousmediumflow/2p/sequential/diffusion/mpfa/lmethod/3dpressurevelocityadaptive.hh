@@ -218,6 +218,12 @@ void FvMpfaL3dPressureVelocity2pAdaptive<TypeTag>::calculateVelocity()
     // run through all vertices
     for (const auto& vertex : vertices(problem_.gridView()))
     {
+#if HAVE_MPI
+        if (vertex.partitionType() != Dune::InteriorEntity && vertex.partitionType() != Dune::BorderEntity)
+        {
+            continue;
+        }
+#endif
         int vIdxGlobal = problem_.variables().index(vertex);
 
         InteractionVolume& interactionVolume = this->interactionVolumes_.interactionVolume(vIdxGlobal);
@@ -291,6 +297,9 @@ void FvMpfaL3dPressureVelocity2pAdaptive<TypeTag>::calculateVelocity()
 
     } // end vertex iterator
 
+    // velocities of overlap and ghost cells are calculated on the owning process
+    this->communicateCellData();
+
     return;
 }
 
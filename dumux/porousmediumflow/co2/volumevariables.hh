@@ -121,11 +121,11 @@ public:
     void update(const ElemSol& elemSol, const Problem& problem, const Element& element, const Scv& scv)
     {
         ParentType::update(elemSol, problem, element, scv);
-        completeFluidState(elemSol, problem, element, scv, fluidState_, solidState_);
 
-        // Second instance of a parameter cache. Could be avoided if
-        // diffusion coefficients also became part of the fluid state.
+        // the parameter cache is shared with the fluid state computation such that
+        // quantities already evaluated there are reused for the diffusion coefficients
         typename FluidSystem::ParameterCache paramCache;
+        completeFluidState(elemSol, problem, element, scv, fluidState_, solidState_, paramCache);
         paramCache.updateAll(fluidState_);
 
         using MaterialLaw = typename Problem::SpatialParams::MaterialLaw;
@@ -169,6 +169,30 @@ public:
                             const Scv& scv,
                             FluidState& fluidState,
                             SolidState& solidState)
+    {
+        typename FluidSystem::ParameterCache paramCache;
+        completeFluidState(elemSol, problem, element, scv, fluidState, solidState, paramCache);
+    }
+
+    /*!
+     * \brief Completes the fluid state using the given parameter cache.
+     *
+     * \param elemSol A vector containing all primary variables connected to the element
+     * \param problem The object specifying the problem which ought to be simulated
+     * \param element An element which contains part of the control volume
+     * \param scv The sub-control volume
+     * \param fluidState A container with the current (physical) state of the fluid
+     * \param solidState A container with the current (physical) state of the solid
+     * \param paramCache The fluid system's parameter cache
+     */
+    template<class ElemSol, class Problem, class Element, class Scv>
+    void completeFluidState(const ElemSol& elemSol,
+                            const Problem& problem,
+                            const Element& element,
+                            const Scv& scv,
+                            FluidState& fluidState,
+                            SolidState& solidState,
+                            typename FluidSystem::ParameterCache& paramCache)
     {
         EnergyVolVars::updateTemperature(elemSol, problem, element, scv, fluidState, solidState);
 
@@ -223,7 +247,6 @@ public:
         }
 
         // calculate the phase compositions
-        typename FluidSystem::ParameterCache paramCache;
         // both phases are present
         if (phasePresence == bothPhases)
         {
@@ -300,7 +323,7 @@ public:
             paramCache.updateComposition(fluidState, phaseIdx);
             const Scalar rho = FluidSystem::density(fluidState, paramCache, phaseIdx);
             fluidState.setDensity(phaseIdx, rho);
-            const Scalar rhoMolar = FluidSystem::molarDensity(fluidState, phaseIdx);
+            const Scalar rhoMolar = FluidSystem::molarDensity(fluidState, paramCache, phaseIdx);
             fluidState.setMolarDensity(phaseIdx, rhoMolar);
             const Scalar mu = FluidSystem::viscosity(fluidState, paramCache, phaseIdx);
             fluidState.setViscosity(phaseIdx,mu);
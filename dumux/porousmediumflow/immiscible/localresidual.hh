@@ -25,7 +25,18 @@
 #ifndef DUMUX_IMMISCIBLE_LOCAL_RESIDUAL_HH
 #define DUMUX_IMMISCIBLE_LOCAL_RESIDUAL_HH
 
+#include <array>
+#include <cmath>
+
 #include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/timeloop.hh>
+
+#include <dumux/discretization/method.hh>
+#include <dumux/discretization/elementsolution.hh>
+
+#include <dumux/material/fluidsystems/pressurederivatives.hh>
+#include <dumux/porousmediumflow/2p/formulation.hh>
 
 namespace Dumux {
 
@@ -51,13 +62,20 @@ class ImmiscibleLocalResidual : public GetPropType<TypeTag, Properties::BaseLoca
     using GridView = GetPropType<TypeTag, Properties::GridView>;
     using Element = typename GridView::template Codim<0>::Entity;
     using EnergyLocalResidual = GetPropType<TypeTag, Properties::EnergyLocalResidual>;
+    using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
+    using TimeLoop = TimeLoopBase<Scalar>;
 
     using ModelTraits = GetPropType<TypeTag, Properties::ModelTraits>;
     static constexpr int numPhases = ModelTraits::numFluidPhases();
     static constexpr int conti0EqIdx = ModelTraits::Indices::conti0EqIdx; //!< first index for the mass balance
 
 public:
-    using ParentType::ParentType;
+    //! The constructor reads the upwind weight from the problem's parameter group
+    ImmiscibleLocalResidual(const Problem* problem,
+                            const TimeLoop* timeLoop = nullptr)
+    : ParentType(problem, timeLoop)
+    , upwindWeight_(getParamFromGroup<Scalar>(problem->paramGroup(), "Flux.UpwindWeight"))
+    {}
 
     /*!
      * \brief Evaluatex the rate of change of all conservation
@@ -134,6 +152,396 @@ public:
 
         return flux;
     }
+
+    /*!
+     * \name Interfaces for analytic Jacobian computation
+     *
+     * The derivatives are available for the isothermal two-phase model in both the
+     * p0-s1 and the p1-s0 formulation. They account for the saturation dependence of the
+     * capillary pressure and the relative permeabilities (through the material law) and
+     * for the pressure dependence of the densities and viscosities (through the fluid
+     * system, see densityPressureDerivative()). The dependence of the gravitational term
+     * on the densities is neglected.
+     */
+    // \{
+
+    /*!
+     * \brief Adds the storage derivatives of the phase mass balances
+     *
+     * \param partialDerivatives The partial derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curVolVars The current volume variables
+     * \param scv The sub control volume
+     *
+     * \note The material law parameters are evaluated with an empty element solution,
+     *       i.e. they must not depend on the solution.
+     */
+    template<class PartialDerivativeMatrix>
+    void addStorageDerivatives(PartialDerivativeMatrix& partialDerivatives,
+                               const Problem& problem,
+                               const Element& element,
+                               const FVElementGeometry& fvGeometry,
+                               const VolumeVariables& curVolVars,
+                               const SubControlVolume& scv) const
+    {
+        const auto derivatives = phaseDerivatives_(problem, element, scv, curVolVars, EmptyElementSolution{});
+        const auto poreVolume = scv.volume()*curVolVars.porosity()*curVolVars.extrusionFactor();
+        const auto dt = this->timeLoop().timeStepSize();
+
+        // d(phi*rho*S)/dx = phi*(drho/dx*S + rho*dS/dx)
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+            for (int pvIdx = 0; pvIdx < numPhases; ++pvIdx)
+                partialDerivatives[conti0EqIdx+phaseIdx][pvIdx]
+                    += poreVolume/dt*(derivatives.dDensity[phaseIdx][pvIdx]*curVolVars.saturation(phaseIdx)
+                                      + curVolVars.density(phaseIdx)*derivatives.dSaturation[phaseIdx][pvIdx]);
+    }
+
+    /*!
+     * \brief Adds the source derivatives, which are forwarded to the problem.
+     *
+     * \param partialDerivatives The partial derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curVolVars The current volume variables
+     * \param scv The sub control volume
+     */
+    template<class PartialDerivativeMatrix>
+    void addSourceDerivatives(PartialDerivativeMatrix& partialDerivatives,
+                              const Problem& problem,
+                              const Element& element,
+                              const FVElementGeometry& fvGeometry,
+                              const VolumeVariables& curVolVars,
+                              const SubControlVolume& scv) const
+    {
+        problem.addSourceDerivatives(partialDerivatives, element, fvGeometry, curVolVars, scv);
+    }
+
+    /*!
+     * \brief Adds the flux derivatives of the phase mass balances for cell-centered FVM using TPFA
+     *
+     * \param derivativeMatrices The partial derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class PartialDerivativeMatrices, class T = TypeTag>
+    std::enable_if_t<GetPropType<T, Properties::FVGridGeometry>::discMethod == DiscretizationMethod::cctpfa, void>
+    addFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                       const Problem& problem,
+                       const Element& element,
+                       const FVElementGeometry& fvGeometry,
+                       const ElementVolumeVariables& curElemVolVars,
+                       const ElementFluxVariablesCache& elemFluxVarsCache,
+                       const SubControlVolumeFace& scvf) const
+    {
+        using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+
+        // get references to the two participating vol vars and their derivatives
+        const auto insideScvIdx = scvf.insideScvIdx();
+        const auto outsideScvIdx = scvf.outsideScvIdx();
+        const auto outsideElement = fvGeometry.fvGridGeometry().element(outsideScvIdx);
+        const auto& insideScv = fvGeometry.scv(insideScvIdx);
+        const auto& outsideScv = fvGeometry.scv(outsideScvIdx);
+        const auto& insideVolVars = curElemVolVars[insideScvIdx];
+        const auto& outsideVolVars = curElemVolVars[outsideScvIdx];
+        const auto insideDerivatives = phaseDerivatives_(problem, element, insideScv, insideVolVars,
+                                                         elementSolution<FVElementGeometry>(insideVolVars.priVars()));
+        const auto outsideDerivatives = phaseDerivatives_(problem, outsideElement, outsideScv, outsideVolVars,
+                                                          elementSolution<FVElementGeometry>(outsideVolVars.priVars()));
+
+        // get references to the two participating derivative matrices
+        auto& dI_dI = derivativeMatrices[insideScvIdx];
+        auto& dI_dJ = derivativeMatrices[outsideScvIdx];
+
+        const auto tij = elemFluxVarsCache[scvf].advectionTij();
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+        {
+            // evaluate the current Darcy flux and resulting upwind weights
+            const auto flux = AdvectionType::flux(problem, element, fvGeometry, curElemVolVars, scvf, phaseIdx, elemFluxVarsCache);
+            const auto insideWeight = std::signbit(flux) ? (1.0 - upwindWeight_) : upwindWeight_;
+            const auto outsideWeight = 1.0 - insideWeight;
+            const auto tij_up = tij*(upwindTerm_(insideVolVars, phaseIdx)*insideWeight
+                                     + upwindTerm_(outsideVolVars, phaseIdx)*outsideWeight);
+
+            // Darcy flux and upwinded term contributions
+            const auto eqIdx = conti0EqIdx + phaseIdx;
+            for (int pvIdx = 0; pvIdx < numPhases; ++pvIdx)
+            {
+                dI_dI[eqIdx][pvIdx] += tij_up*insideDerivatives.dPressure[phaseIdx][pvIdx]
+                                       + flux*insideDerivatives.dUpwindTerm[phaseIdx][pvIdx]*insideWeight;
+                dI_dJ[eqIdx][pvIdx] += -tij_up*outsideDerivatives.dPressure[phaseIdx][pvIdx]
+                                       + flux*outsideDerivatives.dUpwindTerm[phaseIdx][pvIdx]*outsideWeight;
+            }
+        }
+    }
+
+    /*!
+     * \brief Adds the flux derivatives of the phase mass balances for the box method
+     *
+     * \param A The Jacobian Matrix
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class JacobianMatrix, class T = TypeTag>
+    std::enable_if_t<GetPropType<T, Properties::FVGridGeometry>::discMethod == DiscretizationMethod::box, void>
+    addFluxDerivatives(JacobianMatrix& A,
+                       const Problem& problem,
+                       const Element& element,
+                       const FVElementGeometry& fvGeometry,
+                       const ElementVolumeVariables& curElemVolVars,
+                       const ElementFluxVariablesCache& elemFluxVarsCache,
+                       const SubControlVolumeFace& scvf) const
+    {
+        using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+
+        // get references to the two participating vol vars and their derivatives
+        const auto insideScvIdx = scvf.insideScvIdx();
+        const auto outsideScvIdx = scvf.outsideScvIdx();
+        const auto& insideScv = fvGeometry.scv(insideScvIdx);
+        const auto& outsideScv = fvGeometry.scv(outsideScvIdx);
+        const auto& insideVolVars = curElemVolVars[insideScv];
+        const auto& outsideVolVars = curElemVolVars[outsideScv];
+
+        const auto elemSol = elementSolution(element, curElemVolVars, fvGeometry);
+        const auto insideDerivatives = phaseDerivatives_(problem, element, insideScv, insideVolVars, elemSol);
+        const auto outsideDerivatives = phaseDerivatives_(problem, element, outsideScv, outsideVolVars, elemSol);
+
+        // let the Law for the advective fluxes calculate the transmissibilities
+        const auto ti = AdvectionType::calculateTransmissibilities(problem,
+                                                                   element,
+                                                                   fvGeometry,
+                                                                   curElemVolVars,
+                                                                   scvf,
+                                                                   elemFluxVarsCache[scvf]);
+
+        // get the rows of the jacobian matrix for the inside/outside scv
+        auto& dI_dJ_inside = A[insideScv.dofIndex()];
+        auto& dI_dJ_outside = A[outsideScv.dofIndex()];
+
+        // evaluate the current Darcy fluxes, the upwind weights and the upwinded terms
+        std::array<Scalar, numPhases> flux, insideWeight, outsideWeight, up;
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+        {
+            flux[phaseIdx] = AdvectionType::flux(problem, element, fvGeometry, curElemVolVars, scvf, phaseIdx, elemFluxVarsCache);
+            insideWeight[phaseIdx] = std::signbit(flux[phaseIdx]) ? (1.0 - upwindWeight_) : upwindWeight_;
+            outsideWeight[phaseIdx] = 1.0 - insideWeight[phaseIdx];
+            up[phaseIdx] = upwindTerm_(insideVolVars, phaseIdx)*insideWeight[phaseIdx]
+                           + upwindTerm_(outsideVolVars, phaseIdx)*outsideWeight[phaseIdx];
+        }
+
+        // add the partial derivatives w.r.t all scvs in the element
+        for (const auto& scvJ : scvs(fvGeometry))
+        {
+            const auto globalJ = scvJ.dofIndex();
+            const auto localJ = scvJ.indexInElement();
+
+            // the phase pressures of all scvs enter the Darcy flux,
+            // the upwinded terms only depend on the inside/outside scv
+            const auto dPressureJ = localJ == insideScvIdx ? insideDerivatives.dPressure
+                                    : localJ == outsideScvIdx ? outsideDerivatives.dPressure
+                                    : phasePressureDerivatives_(problem, element, scvJ, curElemVolVars[scvJ], elemSol);
+
+            for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+            {
+                const auto eqIdx = conti0EqIdx + phaseIdx;
+                const auto tj_up = ti[localJ]*up[phaseIdx];
+                for (int pvIdx = 0; pvIdx < numPhases; ++pvIdx)
+                {
+                    auto dFlux_dxJ = tj_up*dPressureJ[phaseIdx][pvIdx];
+                    if (localJ == insideScvIdx)
+                        dFlux_dxJ += flux[phaseIdx]*insideDerivatives.dUpwindTerm[phaseIdx][pvIdx]*insideWeight[phaseIdx];
+                    else if (localJ == outsideScvIdx)
+                        dFlux_dxJ += flux[phaseIdx]*outsideDerivatives.dUpwindTerm[phaseIdx][pvIdx]*outsideWeight[phaseIdx];
+
+                    dI_dJ_inside[globalJ][eqIdx][pvIdx] += dFlux_dxJ;
+                    dI_dJ_outside[globalJ][eqIdx][pvIdx] -= dFlux_dxJ;
+                }
+            }
+        }
+    }
+
+    /*!
+     * \brief Adds the cell-centered Dirichlet flux derivatives of the phase mass balances
+     *
+     * \param derivativeMatrices The matrices containing the derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class PartialDerivativeMatrices>
+    void addCCDirichletFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                                       const Problem& problem,
+                                       const Element& element,
+                                       const FVElementGeometry& fvGeometry,
+                                       const ElementVolumeVariables& curElemVolVars,
+                                       const ElementFluxVariablesCache& elemFluxVarsCache,
+                                       const SubControlVolumeFace& scvf) const
+    {
+        using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+
+        // the boundary values are fixed, only the inside primary variables contribute
+        const auto insideScvIdx = scvf.insideScvIdx();
+        const auto& insideScv = fvGeometry.scv(insideScvIdx);
+        const auto& insideVolVars = curElemVolVars[insideScvIdx];
+        const auto& outsideVolVars = curElemVolVars[scvf.outsideScvIdx()];
+        const auto insideDerivatives = phaseDerivatives_(problem, element, insideScv, insideVolVars,
+                                                         elementSolution<FVElementGeometry>(insideVolVars.priVars()));
+
+        auto& dI_dI = derivativeMatrices[insideScvIdx];
+        const auto tij = elemFluxVarsCache[scvf].advectionTij();
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+        {
+            const auto flux = AdvectionType::flux(problem, element, fvGeometry, curElemVolVars, scvf, phaseIdx, elemFluxVarsCache);
+            const auto insideWeight = std::signbit(flux) ? (1.0 - upwindWeight_) : upwindWeight_;
+            const auto outsideWeight = 1.0 - insideWeight;
+            const auto tij_up = tij*(upwindTerm_(insideVolVars, phaseIdx)*insideWeight
+                                     + upwindTerm_(outsideVolVars, phaseIdx)*outsideWeight);
+
+            const auto eqIdx = conti0EqIdx + phaseIdx;
+            for (int pvIdx = 0; pvIdx < numPhases; ++pvIdx)
+                dI_dI[eqIdx][pvIdx] += tij_up*insideDerivatives.dPressure[phaseIdx][pvIdx]
+                                       + flux*insideDerivatives.dUpwindTerm[phaseIdx][pvIdx]*insideWeight;
+        }
+    }
+
+    /*!
+     * \brief Adds Robin flux derivatives by forwarding to the problem
+     * \note Problems with solution-dependent Neumann fluxes have to implement
+     *       addRobinFluxDerivatives, the default assumes solution-independent fluxes
+     *
+     * \param derivativeMatrices The matrices containing the derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class PartialDerivativeMatrices>
+    void addRobinFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                                 const Problem& problem,
+                                 const Element& element,
+                                 const FVElementGeometry& fvGeometry,
+                                 const ElementVolumeVariables& curElemVolVars,
+                                 const ElementFluxVariablesCache& elemFluxVarsCache,
+                                 const SubControlVolumeFace& scvf) const
+    { problem.addRobinFluxDerivatives(derivativeMatrices, element, fvGeometry, curElemVolVars, elemFluxVarsCache, scvf); }
+
+    // \}
+
+private:
+    //! derivatives of a phase quantity w.r.t. the primary variables of a scv (phaseIdx, pvIdx)
+    using PhaseMatrix = std::array<std::array<Scalar, numPhases>, numPhases>;
+
+    //! the derivatives of the phase quantities of a scv w.r.t. its primary variables
+    struct PhaseDerivatives
+    {
+        PhaseMatrix dPressure;
+        PhaseMatrix dSaturation;
+        PhaseMatrix dDensity;
+        PhaseMatrix dUpwindTerm;
+    };
+
+    //! The upwinded term of the phase flux
+    static Scalar upwindTerm_(const VolumeVariables& volVars, int phaseIdx)
+    { return volVars.density(phaseIdx)*volVars.mobility(phaseIdx); }
+
+    //! The derivatives of the phase pressures w.r.t. the primary variables
+    template<class ElementSolution>
+    static PhaseMatrix phasePressureDerivatives_(const Problem& problem,
+                                                 const Element& element,
+                                                 const SubControlVolume& scv,
+                                                 const VolumeVariables& volVars,
+                                                 const ElementSolution& elemSol)
+    {
+        static_assert(numPhases == 2,
+                      "immiscible/localresidual.hh: Analytic differentiation is only implemented for two-phase models!");
+        static_assert(!ModelTraits::enableEnergyBalance(),
+                      "immiscible/localresidual.hh: Analytic differentiation is only implemented for isothermal models!");
+
+        using MaterialLaw = typename Problem::SpatialParams::MaterialLaw;
+        using Indices = typename ModelTraits::Indices;
+        const auto& materialParams = problem.spatialParams().materialLawParams(element, scv, elemSol);
+        const int wPhaseIdx = problem.spatialParams().template wettingPhase<FluidSystem>(element, scv, elemSol);
+
+        // the phase whose pressure is a primary variable, the saturation is the one of the other phase
+        const int pPhaseIdx = ModelTraits::priVarFormulation() == TwoPFormulation::p0s1 ? 0 : 1;
+        const Scalar dSw_dS = pPhaseIdx == wPhaseIdx ? -1.0 : 1.0;
+        const Scalar dpc_dS = MaterialLaw::dpc_dsw(materialParams, volVars.saturation(wPhaseIdx))*dSw_dS;
+
+        PhaseMatrix dPressure;
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+        {
+            dPressure[phaseIdx][Indices::pressureIdx] = 1.0;
+            // p_n = p_w + p_c
+            dPressure[phaseIdx][Indices::saturationIdx] = phaseIdx == pPhaseIdx ? Scalar(0.0)
+                                                          : phaseIdx == wPhaseIdx ? -dpc_dS : dpc_dS;
+        }
+
+        return dPressure;
+    }
+
+    //! The derivatives of the phase pressures, saturations, densities and upwinded terms w.r.t. the primary variables
+    template<class ElementSolution>
+    static PhaseDerivatives phaseDerivatives_(const Problem& problem,
+                                              const Element& element,
+                                              const SubControlVolume& scv,
+                                              const VolumeVariables& volVars,
+                                              const ElementSolution& elemSol)
+    {
+        using MaterialLaw = typename Problem::SpatialParams::MaterialLaw;
+        using Indices = typename ModelTraits::Indices;
+        const auto& materialParams = problem.spatialParams().materialLawParams(element, scv, elemSol);
+        const int wPhaseIdx = problem.spatialParams().template wettingPhase<FluidSystem>(element, scv, elemSol);
+        const int pPhaseIdx = ModelTraits::priVarFormulation() == TwoPFormulation::p0s1 ? 0 : 1;
+        const Scalar dSw_dS = pPhaseIdx == wPhaseIdx ? -1.0 : 1.0;
+
+        const auto sw = volVars.saturation(wPhaseIdx);
+        const Scalar dkrw_dS = MaterialLaw::dkrw_dsw(materialParams, sw)*dSw_dS;
+        const Scalar dkrn_dS = MaterialLaw::dkrn_dsw(materialParams, sw)*dSw_dS;
+
+        PhaseDerivatives derivatives;
+        derivatives.dPressure = phasePressureDerivatives_(problem, element, scv, volVars, elemSol);
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+        {
+            const auto& fluidState = volVars.fluidState();
+            const auto rho = volVars.density(phaseIdx);
+            const auto mu = volVars.viscosity(phaseIdx);
+            const auto mobility = volVars.mobility(phaseIdx);
+            const auto drho_dp = densityPressureDerivative<FluidSystem>(fluidState, phaseIdx);
+            const auto dmu_dp = viscosityPressureDerivative<FluidSystem>(fluidState, phaseIdx);
+
+            derivatives.dSaturation[phaseIdx][Indices::pressureIdx] = 0.0;
+            derivatives.dSaturation[phaseIdx][Indices::saturationIdx] = phaseIdx == pPhaseIdx ? -1.0 : 1.0;
+
+            for (int pvIdx = 0; pvIdx < numPhases; ++pvIdx)
+            {
+                const auto dp = derivatives.dPressure[phaseIdx][pvIdx];
+                const auto dkr = pvIdx == Indices::saturationIdx ? (phaseIdx == wPhaseIdx ? dkrw_dS : dkrn_dS) : Scalar(0.0);
+
+                // d(rho*k_r/mu)/dx = drho/dx*k_r/mu + rho*(dk_r/dx - k_r/mu*dmu/dx)/mu
+                derivatives.dDensity[phaseIdx][pvIdx] = drho_dp*dp;
+                derivatives.dUpwindTerm[phaseIdx][pvIdx] = drho_dp*dp*mobility + rho*(dkr - mobility*dmu_dp*dp)/mu;
+            }
+        }
+
+        return derivatives;
+    }
+
+    Scalar upwindWeight_; //!< the upwind weight read once from Flux.UpwindWeight
 };
 
 } // end namespace Dumux
@@ -26,7 +26,16 @@
 #ifndef DUMUX_RICHARDS_LOCAL_RESIDUAL_HH
 #define DUMUX_RICHARDS_LOCAL_RESIDUAL_HH
 
+#include <cmath>
+
 #include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/timeloop.hh>
+
+#include <dumux/discretization/method.hh>
+#include <dumux/discretization/elementsolution.hh>
+
+#include <dumux/material/fluidsystems/pressurederivatives.hh>
 
 namespace Dumux {
 
@@ -55,9 +64,12 @@ class RichardsLocalResidual : public GetPropType<TypeTag, Properties::BaseLocalR
     using Element = typename GridView::template Codim<0>::Entity;
     using EnergyLocalResidual = GetPropType<TypeTag, Properties::EnergyLocalResidual>;
     using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
-    using Indices = typename GetPropType<TypeTag, Properties::ModelTraits>::Indices;
+    using TimeLoop = TimeLoopBase<Scalar>;
+    using ModelTraits = GetPropType<TypeTag, Properties::ModelTraits>;
+    using Indices = typename ModelTraits::Indices;
     // first index for the mass balance
     enum { conti0EqIdx = Indices::conti0EqIdx };
+    enum { pressureIdx = Indices::pressureIdx };
 
     // phase indices
     enum {
@@ -69,7 +81,12 @@ class RichardsLocalResidual : public GetPropType<TypeTag, Properties::BaseLocalR
     static constexpr bool enableWaterDiffusionInAir
         = getPropValue<TypeTag, Properties::EnableWaterDiffusionInAir>();
 public:
-    using ParentType::ParentType;
+    //! The constructor reads the upwind weight from the problem's parameter group
+    RichardsLocalResidual(const Problem* problem,
+                          const TimeLoop* timeLoop = nullptr)
+    : ParentType(problem, timeLoop)
+    , upwindWeight_(getParamFromGroup<Scalar>(problem->paramGroup(), "Flux.UpwindWeight"))
+    {}
 
     /*!
      * \brief Evaluates the rate of change of all conservation
@@ -150,12 +167,339 @@ public:
         return flux;
     }
 
+    /*!
+     * \name Interfaces for analytic Jacobian computation
+     *
+     * The derivatives are available for the isothermal Richards model without water
+     * diffusion in air. They account for the pressure dependence of the saturation and
+     * the relative permeability (through the material law) and of the water density and
+     * viscosity (through the fluid system, see densityPressureDerivative()).
+     * The dependence of the gravitational term on the density is neglected.
+     */
+    // \{
+
+    /*!
+     * \brief Adds the storage derivative of the water mass balance w.r.t. \f$p_w\f$
+     *
+     * \param partialDerivatives The partial derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curVolVars The current volume variables
+     * \param scv The sub control volume
+     *
+     * \note The material law parameters are evaluated with an empty element solution,
+     *       i.e. they must not depend on the solution.
+     */
+    template<class PartialDerivativeMatrix>
+    void addStorageDerivatives(PartialDerivativeMatrix& partialDerivatives,
+                               const Problem& problem,
+                               const Element& element,
+                               const FVElementGeometry& fvGeometry,
+                               const VolumeVariables& curVolVars,
+                               const SubControlVolume& scv) const
+    {
+        static_assert(!enableWaterDiffusionInAir,
+                      "richards/localresidual.hh: Analytic differentiation is not implemented for water diffusion in air!");
+        static_assert(!ModelTraits::enableEnergyBalance(),
+                      "richards/localresidual.hh: Analytic differentiation is only implemented for the isothermal model!");
+
+        const auto& materialParams = problem.spatialParams().materialLawParams(element, scv, EmptyElementSolution{});
+        const auto poreVolume = scv.volume()*curVolVars.porosity()*curVolVars.extrusionFactor();
+        const auto dt = this->timeLoop().timeStepSize();
+
+        // d(phi*rho*S_w)/dp_w = phi*(drho/dp_w*S_w + rho*dS_w/dp_w)
+        const auto drho_dpw = densityPressureDerivative<FluidSystem>(curVolVars.fluidState(), liquidPhaseIdx);
+        const auto dsw_dpw = dSaturation_dPressure_(problem, curVolVars, materialParams);
+        partialDerivatives[conti0EqIdx][pressureIdx] += poreVolume/dt*(drho_dpw*curVolVars.saturation(liquidPhaseIdx)
+                                                                       + curVolVars.density(liquidPhaseIdx)*dsw_dpw);
+    }
+
+    /*!
+     * \brief Adds the source derivatives, which are forwarded to the problem.
+     *
+     * \param partialDerivatives The partial derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curVolVars The current volume variables
+     * \param scv The sub control volume
+     */
+    template<class PartialDerivativeMatrix>
+    void addSourceDerivatives(PartialDerivativeMatrix& partialDerivatives,
+                              const Problem& problem,
+                              const Element& element,
+                              const FVElementGeometry& fvGeometry,
+                              const VolumeVariables& curVolVars,
+                              const SubControlVolume& scv) const
+    {
+        problem.addSourceDerivatives(partialDerivatives, element, fvGeometry, curVolVars, scv);
+    }
+
+    /*!
+     * \brief Adds the flux derivatives w.r.t. \f$p_w\f$ for cell-centered FVM using TPFA
+     *
+     * \param derivativeMatrices The partial derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class PartialDerivativeMatrices, class T = TypeTag>
+    std::enable_if_t<GetPropType<T, Properties::FVGridGeometry>::discMethod == DiscretizationMethod::cctpfa, void>
+    addFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                       const Problem& problem,
+                       const Element& element,
+                       const FVElementGeometry& fvGeometry,
+                       const ElementVolumeVariables& curElemVolVars,
+                       const ElementFluxVariablesCache& elemFluxVarsCache,
+                       const SubControlVolumeFace& scvf) const
+    {
+        static_assert(!enableWaterDiffusionInAir,
+                      "richards/localresidual.hh: Analytic differentiation is not implemented for water diffusion in air!");
+        static_assert(!ModelTraits::enableEnergyBalance(),
+                      "richards/localresidual.hh: Analytic differentiation is only implemented for the isothermal model!");
+
+        using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+
+        // evaluate the current Darcy flux and resulting upwind weights
+        const auto flux = AdvectionType::flux(problem, element, fvGeometry, curElemVolVars, scvf, liquidPhaseIdx, elemFluxVarsCache);
+        const auto insideWeight = std::signbit(flux) ? (1.0 - upwindWeight_) : upwindWeight_;
+        const auto outsideWeight = 1.0 - insideWeight;
+
+        // get references to the two participating vol vars & parameters
+        const auto insideScvIdx = scvf.insideScvIdx();
+        const auto outsideScvIdx = scvf.outsideScvIdx();
+        const auto outsideElement = fvGeometry.fvGridGeometry().element(outsideScvIdx);
+        const auto& insideScv = fvGeometry.scv(insideScvIdx);
+        const auto& outsideScv = fvGeometry.scv(outsideScvIdx);
+        const auto& insideVolVars = curElemVolVars[insideScvIdx];
+        const auto& outsideVolVars = curElemVolVars[outsideScvIdx];
+        const auto& insideMaterialParams = problem.spatialParams().materialLawParams(element,
+                                                                                     insideScv,
+                                                                                     elementSolution<FVElementGeometry>(insideVolVars.priVars()));
+        const auto& outsideMaterialParams = problem.spatialParams().materialLawParams(outsideElement,
+                                                                                      outsideScv,
+                                                                                      elementSolution<FVElementGeometry>(outsideVolVars.priVars()));
+
+        // get references to the two participating derivative matrices
+        auto& dI_dI = derivativeMatrices[insideScvIdx];
+        auto& dI_dJ = derivativeMatrices[outsideScvIdx];
+
+        // the upwinded term and its derivatives w.r.t. the inside and outside pressure
+        const auto up = upwindTerm_(insideVolVars)*insideWeight + upwindTerm_(outsideVolVars)*outsideWeight;
+        const auto dUp_dpw_inside = dUpwindTerm_dPressure_(problem, insideVolVars, insideMaterialParams);
+        const auto dUp_dpw_outside = dUpwindTerm_dPressure_(problem, outsideVolVars, outsideMaterialParams);
+
+        const auto tij = elemFluxVarsCache[scvf].advectionTij();
+        const auto tij_up = tij*up;
+
+        // partial derivative of the water flux w.r.t. p_w
+        dI_dI[conti0EqIdx][pressureIdx] += tij_up + flux*dUp_dpw_inside*insideWeight;
+        dI_dJ[conti0EqIdx][pressureIdx] += -tij_up + flux*dUp_dpw_outside*outsideWeight;
+    }
+
+    /*!
+     * \brief Adds the flux derivatives w.r.t. \f$p_w\f$ for the box method
+     *
+     * \param A The Jacobian Matrix
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class JacobianMatrix, class T = TypeTag>
+    std::enable_if_t<GetPropType<T, Properties::FVGridGeometry>::discMethod == DiscretizationMethod::box, void>
+    addFluxDerivatives(JacobianMatrix& A,
+                       const Problem& problem,
+                       const Element& element,
+                       const FVElementGeometry& fvGeometry,
+                       const ElementVolumeVariables& curElemVolVars,
+                       const ElementFluxVariablesCache& elemFluxVarsCache,
+                       const SubControlVolumeFace& scvf) const
+    {
+        static_assert(!enableWaterDiffusionInAir,
+                      "richards/localresidual.hh: Analytic differentiation is not implemented for water diffusion in air!");
+        static_assert(!ModelTraits::enableEnergyBalance(),
+                      "richards/localresidual.hh: Analytic differentiation is only implemented for the isothermal model!");
+
+        using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+
+        // evaluate the current Darcy flux and resulting upwind weights
+        const auto flux = AdvectionType::flux(problem, element, fvGeometry, curElemVolVars, scvf, liquidPhaseIdx, elemFluxVarsCache);
+        const auto insideWeight = std::signbit(flux) ? (1.0 - upwindWeight_) : upwindWeight_;
+        const auto outsideWeight = 1.0 - insideWeight;
+
+        // get references to the two participating vol vars & parameters
+        const auto insideScvIdx = scvf.insideScvIdx();
+        const auto outsideScvIdx = scvf.outsideScvIdx();
+        const auto& insideScv = fvGeometry.scv(insideScvIdx);
+        const auto& outsideScv = fvGeometry.scv(outsideScvIdx);
+        const auto& insideVolVars = curElemVolVars[insideScv];
+        const auto& outsideVolVars = curElemVolVars[outsideScv];
+
+        const auto elemSol = elementSolution(element, curElemVolVars, fvGeometry);
+
+        const auto& insideMaterialParams = problem.spatialParams().materialLawParams(element, insideScv, elemSol);
+        const auto& outsideMaterialParams = problem.spatialParams().materialLawParams(element, outsideScv, elemSol);
+
+        // let the Law for the advective fluxes calculate the transmissibilities
+        const auto ti = AdvectionType::calculateTransmissibilities(problem,
+                                                                   element,
+                                                                   fvGeometry,
+                                                                   curElemVolVars,
+                                                                   scvf,
+                                                                   elemFluxVarsCache[scvf]);
+
+        // get the rows of the jacobian matrix for the inside/outside scv
+        auto& dI_dJ_inside = A[insideScv.dofIndex()];
+        auto& dI_dJ_outside = A[outsideScv.dofIndex()];
+
+        // the upwinded term
+        const auto up = upwindTerm_(insideVolVars)*insideWeight + upwindTerm_(outsideVolVars)*outsideWeight;
+
+        // add the partial derivatives w.r.t all scvs in the element
+        for (const auto& scvJ : scvs(fvGeometry))
+        {
+            const auto globalJ = scvJ.dofIndex();
+            const auto localJ = scvJ.indexInElement();
+
+            // partial derivative of the water flux w.r.t. p_w (Darcy flux contribution)
+            auto dFlux_dpwJ = ti[localJ]*up;
+
+            // the upwinded term only depends on the inside/outside pressure
+            if (localJ == insideScvIdx)
+                dFlux_dpwJ += flux*dUpwindTerm_dPressure_(problem, insideVolVars, insideMaterialParams)*insideWeight;
+            else if (localJ == outsideScvIdx)
+                dFlux_dpwJ += flux*dUpwindTerm_dPressure_(problem, outsideVolVars, outsideMaterialParams)*outsideWeight;
+
+            dI_dJ_inside[globalJ][conti0EqIdx][pressureIdx] += dFlux_dpwJ;
+            dI_dJ_outside[globalJ][conti0EqIdx][pressureIdx] -= dFlux_dpwJ;
+        }
+    }
+
+    /*!
+     * \brief Adds the cell-centered Dirichlet flux derivatives w.r.t. \f$p_w\f$
+     *
+     * \param derivativeMatrices The matrices containing the derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class PartialDerivativeMatrices>
+    void addCCDirichletFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                                       const Problem& problem,
+                                       const Element& element,
+                                       const FVElementGeometry& fvGeometry,
+                                       const ElementVolumeVariables& curElemVolVars,
+                                       const ElementFluxVariablesCache& elemFluxVarsCache,
+                                       const SubControlVolumeFace& scvf) const
+    {
+        using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+
+        // evaluate the current Darcy flux and resulting upwind weights
+        const auto flux = AdvectionType::flux(problem, element, fvGeometry, curElemVolVars, scvf, liquidPhaseIdx, elemFluxVarsCache);
+        const auto insideWeight = std::signbit(flux) ? (1.0 - upwindWeight_) : upwindWeight_;
+        const auto outsideWeight = 1.0 - insideWeight;
+
+        // get references to the two participating vol vars & parameters
+        const auto insideScvIdx = scvf.insideScvIdx();
+        const auto& insideScv = fvGeometry.scv(insideScvIdx);
+        const auto& insideVolVars = curElemVolVars[insideScvIdx];
+        const auto& outsideVolVars = curElemVolVars[scvf.outsideScvIdx()];
+        const auto& insideMaterialParams = problem.spatialParams().materialLawParams(element,
+                                                                                     insideScv,
+                                                                                     elementSolution<FVElementGeometry>(insideVolVars.priVars()));
+
+        // the boundary values are fixed, only the inside pressure contributes
+        const auto up = upwindTerm_(insideVolVars)*insideWeight + upwindTerm_(outsideVolVars)*outsideWeight;
+        const auto tij = elemFluxVarsCache[scvf].advectionTij();
+        derivativeMatrices[insideScvIdx][conti0EqIdx][pressureIdx]
+            += tij*up + flux*dUpwindTerm_dPressure_(problem, insideVolVars, insideMaterialParams)*insideWeight;
+    }
+
+    /*!
+     * \brief Adds Robin flux derivatives by forwarding to the problem
+     * \note Problems with solution-dependent Neumann fluxes have to implement
+     *       addRobinFluxDerivatives, the default assumes solution-independent fluxes
+     *
+     * \param derivativeMatrices The matrices containing the derivatives
+     * \param problem The problem
+     * \param element The element
+     * \param fvGeometry The finite volume element geometry
+     * \param curElemVolVars The current element volume variables
+     * \param elemFluxVarsCache The element flux variables cache
+     * \param scvf The sub control volume face
+     */
+    template<class PartialDerivativeMatrices>
+    void addRobinFluxDerivatives(PartialDerivativeMatrices& derivativeMatrices,
+                                 const Problem& problem,
+                                 const Element& element,
+                                 const FVElementGeometry& fvGeometry,
+                                 const ElementVolumeVariables& curElemVolVars,
+                                 const ElementFluxVariablesCache& elemFluxVarsCache,
+                                 const SubControlVolumeFace& scvf) const
+    { problem.addRobinFluxDerivatives(derivativeMatrices, element, fvGeometry, curElemVolVars, elemFluxVarsCache, scvf); }
+
+    // \}
+
 private:
+    //! The upwinded term of the water flux
+    static Scalar upwindTerm_(const VolumeVariables& volVars)
+    { return volVars.density(liquidPhaseIdx)*volVars.mobility(liquidPhaseIdx); }
+
+    //! The derivative of the water saturation w.r.t. p_w
+    template<class MaterialLawParams>
+    static Scalar dSaturation_dPressure_(const Problem& problem,
+                                        const VolumeVariables& volVars,
+                                        const MaterialLawParams& materialParams)
+    {
+        using MaterialLaw = typename Problem::SpatialParams::MaterialLaw;
+
+        // the saturation is constant where the capillary pressure is cut off at the entry pressure
+        const Scalar pc = problem.nonWettingReferencePressure() - volVars.pressure(liquidPhaseIdx);
+        if (pc <= MaterialLaw::endPointPc(materialParams))
+            return 0.0;
+
+        // dS_w/dp_w = dS_w/dp_c * dp_c/dp_w with p_c = p_ref - p_w
+        return -1.0*MaterialLaw::dsw_dpc(materialParams, pc);
+    }
+
+    //! The derivative of the upwinded term rho*k_r/mu w.r.t. p_w
+    template<class MaterialLawParams>
+    static Scalar dUpwindTerm_dPressure_(const Problem& problem,
+                                         const VolumeVariables& volVars,
+                                         const MaterialLawParams& materialParams)
+    {
+        using MaterialLaw = typename Problem::SpatialParams::MaterialLaw;
+
+        const auto& fluidState = volVars.fluidState();
+        const auto rho = volVars.density(liquidPhaseIdx);
+        const auto mu = volVars.viscosity(liquidPhaseIdx);
+        const auto mobility = volVars.mobility(liquidPhaseIdx);
+
+        const auto dkr_dpw = MaterialLaw::dkrw_dsw(materialParams, volVars.saturation(liquidPhaseIdx))
+                             *dSaturation_dPressure_(problem, volVars, materialParams);
+        const auto drho_dpw = densityPressureDerivative<FluidSystem>(fluidState, liquidPhaseIdx);
+        const auto dmu_dpw = viscosityPressureDerivative<FluidSystem>(fluidState, liquidPhaseIdx);
+
+        return drho_dpw*mobility + rho*(dkr_dpw - mobility*dmu_dpw)/mu;
+    }
+
     Implementation *asImp_()
     { return static_cast<Implementation *> (this); }
 
     const Implementation *asImp_() const
     { return static_cast<const Implementation *> (this); }
+
+    Scalar upwindWeight_; //!< the upwind weight read once from Flux.UpwindWeight
 };
 
 } // end namespace Dumux
@@ -20,6 +20,9 @@
 #ifndef DUMUX_FVMPFAL3DINTERACTIONVOLUME_HH
 #define DUMUX_FVMPFAL3DINTERACTIONVOLUME_HH
 
+#include <array>
+#include <bitset>
+
 #include "properties.hh"
 
 /**
@@ -166,30 +169,30 @@ public:
     , facePos_(DimVector(0.0))
     , edgePos_((DimVector(0.0)))
     , faceArea_(0.0)
-    , faceType_(fluxFacesTotalNum, inside)
     , indexOnElement_(IndexVector(0.0))
-    , elements_(subVolumeTotalNum)
     , centerVertexPos_(0)
     , elementNum_(0)
-    {}
+    {
+        faceType_.fill(inside);
+    }
 
     //! Reset the interaction volume (deletes stored data)
     void reset()
     {
-        elements_.clear();
-        elements_.resize(subVolumeTotalNum);
+        elements_.fill(ElementSeed());
+        hasElement_.reset();
         centerVertexPos_ = 0;
         indexOnElement_ = IndexVector(0.0);
-        faceType_.clear();
-        faceType_.resize(fluxFacesTotalNum, inside);
+        faceType_.fill(inside);
         faceArea_ = 0.0;
         facePos_ = DimVector(0.0);
         edgePos_ = DimVector(0.0);
         normal_ = FieldVectorVector(DimVector(0.0));
         elementNum_ = 0;
-        boundaryTypes_.clear();
-        neumannValues_.clear();
-        dirichletValues_.clear();
+        // release the boundary storage, it is only allocated for boundary volumes
+        BCTypeVector().swap(boundaryTypes_);
+        BCVector().swap(neumannValues_);
+        BCVector().swap(dirichletValues_);
     }
 
     //! Store position of the central vertex
@@ -202,6 +205,8 @@ public:
     }
     //! Store a dune element as a sub volume element
     /*!
+     *  If an element is already stored for the sub volume it is replaced.
+     *
      *  \param element The element
      *  \param subVolumeIdx The local element index in the interaction volume
      */
@@ -209,13 +214,10 @@ public:
     {
         if (!hasSubVolumeElement(subVolumeIdx))
         {
-            elements_[subVolumeIdx].push_back(element.seed());
+            hasElement_.set(subVolumeIdx);
             elementNum_++;
         }
-        else
-        {
-            elements_[subVolumeIdx].insert(elements_[subVolumeIdx].begin(), element.seed());
-        }
+        elements_[subVolumeIdx] = element.seed();
     }
 
     //! Store the position of a flux face
@@ -380,7 +382,7 @@ public:
     Element getSubVolumeElement(int subVolumeIdx)
     {
         if (hasSubVolumeElement(subVolumeIdx))
-            return grid_->entity(elements_[subVolumeIdx][0]);
+            return grid_->entity(elements_[subVolumeIdx]);
         else
         {
             std::cout<<"Problems when calling getSubVolumeElement("<<subVolumeIdx<<")\n";
@@ -397,7 +399,7 @@ public:
      */
     bool hasSubVolumeElement(int subVolumeIdx)
     {
-        return (elements_[subVolumeIdx].size() > 0);
+        return hasElement_[subVolumeIdx];
     }
 
     //! The boundary types
@@ -578,12 +580,12 @@ public:
         std::cout<<" center position: "<<centerVertexPos_<<"\n";
         for (int i = 0; i < subVolumeTotalNum; i++)
         {
-            if (elements_[i].size() > 0)
+            if (hasElement_[i])
             {
             std::cout<<"element "<<i<<":\n";
-            std::cout<<"element level: "<<grid_->entity(elements_[i][0]).level()<<"\n";
-            std::cout<<"element position: "<<grid_->entity(elements_[i][0]).geometry().center()<<"\n";
-            std::cout<<"element volume: "<<grid_->entity(elements_[i][0]).geometry().volume()<<"\n";
+            std::cout<<"element level: "<<grid_->entity(elements_[i]).level()<<"\n";
+            std::cout<<"element position: "<<grid_->entity(elements_[i]).geometry().center()<<"\n";
+            std::cout<<"element volume: "<<grid_->entity(elements_[i]).geometry().volume()<<"\n";
             std::cout<<"face indices on element: "<<indexOnElement_[i]<<"\n";
             std::cout<<"face normals on element: "<<normal_[i]<<"\n";
             std::cout<<"face areas on element: ";
@@ -692,9 +694,10 @@ private:
     Dune::FieldVector<DimVector, fluxEdgesTotalNum> edgePos_;
     Dune::FieldVector<Scalar, fluxFacesTotalNum> faceArea_;
     BCTypeVector boundaryTypes_;
-    std::vector<int> faceType_;
+    std::array<int, fluxFacesTotalNum> faceType_;
     Dune::FieldVector<IndexVector, subVolumeTotalNum> indexOnElement_;
-    std::vector<std::vector<ElementSeed> > elements_;
+    std::array<ElementSeed, subVolumeTotalNum> elements_;
+    std::bitset<subVolumeTotalNum> hasElement_;
     BCVector neumannValues_;
     BCVector dirichletValues_;
     DimVector centerVertexPos_;
@@ -259,6 +259,7 @@ public:
     //!\copydoc FvMpfaL3dInteractionVolume::reset()
     void reset()
     {
+        ParentType::reset();
         hangingNodeType_ = noHangingNode;
         existingLevel_.clear();
     }
@@ -0,0 +1,152 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test for the jump indicator with all error estimators.
+ *
+ * The jump estimators are computed for a piecewise constant field with a jump of 1 across
+ * x = 0.5 and a jump of 2 across y = 1 on a grid with anisotropic cells, such that
+ * the expected indicator values and marks are known for every element. The flux jump
+ * estimator is computed for a linear field with a flux coefficient jumping across x = 0.5.
+ */
+#include <config.h>
+
+#include <array>
+#include <cmath>
+#include <iostream>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/yaspgrid.hh>
+#include <dune/istl/bvector.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/discretization/cellcentered/tpfa/fvgridgeometry.hh>
+#include <dumux/adaptive/jumpindicator.hh>
+
+int main(int argc, char** argv) try
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+    Parameters::init([](auto&){});
+
+    // cells of size 0.1 x 0.2
+    using Grid = Dune::YaspGrid<2>;
+    const Dune::FieldVector<double, 2> upperRight({1.0, 2.0});
+    const std::array<int, 2> cells = {{10, 10}};
+    Grid grid(upperRight, cells);
+    const auto gridView = grid.leafGridView();
+
+    using FVGridGeometry = CCTpfaFVGridGeometry<Grid::LeafGridView>;
+    auto fvGridGeometry = std::make_shared<FVGridGeometry>(gridView);
+    fvGridGeometry->update();
+
+    const auto field = [](const auto& pos){ return (pos[0] > 0.5 ? 1.0 : 0.0) + (pos[1] > 1.0 ? 2.0 : 0.0); };
+    Dune::BlockVector<Dune::FieldVector<double, 1>> sol(fvGridGeometry->numDofs());
+    for (const auto& element : elements(gridView))
+        sol[fvGridGeometry->elementMapper().index(element)] = field(element.geometry().center());
+
+    // elements next to the vertical (area 0.2, distance 0.1) and horizontal (area 0.1, distance 0.2) jumps
+    const auto nextToJumpX = [](const auto& element){ return std::abs(element.geometry().center()[0] - 0.5) < 0.1; };
+    const auto nextToJumpY = [](const auto& element){ return std::abs(element.geometry().center()[1] - 1.0) < 0.2; };
+
+    const auto check = [&](const auto& indicator, const auto& expectedValue, const auto& expectedMark, const auto& name)
+    {
+        for (const auto& element : elements(gridView))
+        {
+            const auto value = indicator.value(element);
+            if (std::abs(value - expectedValue(element)) > 1e-12)
+                DUNE_THROW(Dune::Exception, name << ": wrong indicator " << value << " (expected "
+                                            << expectedValue(element) << ") at " << element.geometry().center());
+
+            if (indicator(element) != expectedMark(element))
+                DUNE_THROW(Dune::Exception, name << ": wrong mark " << indicator(element) << " (expected "
+                                            << expectedMark(element) << ") at " << element.geometry().center());
+        }
+    };
+
+    // the maximum jump is 1 or 2, the refine bound is 0.5 times the global range of 3
+    JumpIndicator<FVGridGeometry, double> maxJumpIndicator(fvGridGeometry, 0, JumpIndicatorEstimator::maxJump);
+    maxJumpIndicator.setLevels(0, 1);
+    maxJumpIndicator.calculate(sol, 0.5, 0.001);
+    check(maxJumpIndicator,
+          [&](const auto& e){ return nextToJumpY(e) ? 2.0 : (nextToJumpX(e) ? 1.0 : 0.0); },
+          [&](const auto& e){ return nextToJumpY(e) ? 1 : 0; },
+          "maxJump");
+
+    // both faces contribute area*jump^2/distance = 2, the refine bound is 0.5 times the maximum of 2
+    JumpIndicator<FVGridGeometry, double> l2JumpIndicator(fvGridGeometry, 0, JumpIndicatorEstimator::l2Jump);
+    l2JumpIndicator.setLevels(0, 1);
+    l2JumpIndicator.calculate(sol, 0.5, 0.001);
+    check(l2JumpIndicator,
+          [&](const auto& e){ return std::sqrt((nextToJumpX(e) ? 2.0 : 0.0) + (nextToJumpY(e) ? 2.0 : 0.0)); },
+          [&](const auto& e){ return nextToJumpX(e) || nextToJumpY(e) ? 1 : 0; },
+          "l2Jump");
+
+    // the gradients of the linear field u = x are reconstructed exactly, so the flux jump
+    // only differs from zero at the coefficient jump: area 0.2, distance 0.1, flux jump |1 - 2| = 1
+    Dune::BlockVector<Dune::FieldVector<double, 1>> linearSol(fvGridGeometry->numDofs());
+    for (const auto& element : elements(gridView))
+        linearSol[fvGridGeometry->elementMapper().index(element)] = element.geometry().center()[0];
+
+    JumpIndicator<FVGridGeometry, double> fluxJumpIndicator(fvGridGeometry, 0, JumpIndicatorEstimator::fluxJump);
+    fluxJumpIndicator.setLevels(0, 1);
+    fluxJumpIndicator.setFluxCoefficient([](const auto& e){ return e.geometry().center()[0] > 0.5 ? 2.0 : 1.0; });
+    fluxJumpIndicator.calculate(linearSol, 0.5, 0.001);
+    for (const auto& element : elements(gridView))
+    {
+        const auto value = fluxJumpIndicator.value(element);
+        const auto expectedValue = nextToJumpX(element) ? std::sqrt(0.02) : 0.0;
+        if (std::abs(value - expectedValue) > 1e-8)
+            DUNE_THROW(Dune::Exception, "fluxJump: wrong indicator " << value << " (expected "
+                                        << expectedValue << ") at " << element.geometry().center());
+
+        if (fluxJumpIndicator(element) != (nextToJumpX(element) ? 1 : 0))
+            DUNE_THROW(Dune::Exception, "fluxJump: wrong mark " << fluxJumpIndicator(element)
+                                        << " at " << element.geometry().center());
+    }
+
+    // with a constant coefficient, the flux of the linear field is continuous
+    // whereas its jumps are not
+    JumpIndicator<FVGridGeometry, double> constantFluxJumpIndicator(fvGridGeometry, 0, JumpIndicatorEstimator::fluxJump);
+    constantFluxJumpIndicator.setLevels(0, 1);
+    constantFluxJumpIndicator.calculate(linearSol);
+    for (const auto& element : elements(gridView))
+        if (std::abs(constantFluxJumpIndicator.value(element)) > 1e-8)
+            DUNE_THROW(Dune::Exception, "fluxJump: nonzero indicator " << constantFluxJumpIndicator.value(element)
+                                        << " for a continuous flux at " << element.geometry().center());
+
+    // without admissible levels, nothing is marked
+    JumpIndicator<FVGridGeometry, double> inactiveIndicator(fvGridGeometry, 0);
+    inactiveIndicator.calculate(sol);
+    check(inactiveIndicator, [](const auto&){ return 0.0; }, [](const auto&){ return 0; }, "inactive");
+
+    std::cout << "All jump indicator tests passed" << std::endl;
+    return 0;
+}
+catch (Dune::Exception& e) {
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+}
+catch (std::exception& e) {
+    std::cerr << "stdlib reported error: " << e.what() << std::endl;
+    return 2;
+}
@@ -45,6 +45,44 @@ int main (int argc, char *argv[]) try
     tEnd = getParamFromGroup<double>("Hulk", "TimeLoop.TEnd");
     if (tEnd != 1e6) DUNE_THROW(Dune::InvalidStateException, "TEnd should be 1e6!");
 
+    // resolve parameters once using handles
+    const ParameterHandle<double> tEndHandle("Bulk", "TimeLoop.TEnd");
+    if (tEndHandle.value() != 1e5) DUNE_THROW(Dune::InvalidStateException, "TEnd should be 1e5!");
+
+    const ParameterHandle<double> dtHandle("", "TimeLoop.DtInitial", 1.0);
+    if (dtHandle != 1.0) DUNE_THROW(Dune::InvalidStateException, "DtInitial should be 1.0!");
+
+    const auto optionalHandle = ParameterHandle<double>::optional("", "TimeLoop.MaxTimeStepSizeX");
+    if (optionalHandle.hasValue()) DUNE_THROW(Dune::InvalidStateException, "Parameter should not be specified!");
+
+    const auto optionalTEndHandle = ParameterHandle<double>::optional("", "TimeLoop.TEnd");
+    if (!optionalTEndHandle.hasValue() || optionalTEndHandle.value() != 1e6)
+        DUNE_THROW(Dune::InvalidStateException, "TEnd should be 1e6!");
+
+    // optional parameters are searched in the parent groups and without group prefix
+    const auto optionalBulkTEndHandle = ParameterHandle<double>::optional("Bulk.Sub", "TimeLoop.TEnd");
+    if (!optionalBulkTEndHandle.hasValue() || optionalBulkTEndHandle.value() != 1e5)
+        DUNE_THROW(Dune::InvalidStateException, "TEnd should be 1e5!");
+
+    const auto optionalHulkTEndHandle = ParameterHandle<double>::optional("Hulk", "TimeLoop.TEnd");
+    if (!optionalHulkTEndHandle.hasValue() || optionalHulkTEndHandle.value() != 1e6)
+        DUNE_THROW(Dune::InvalidStateException, "TEnd should be 1e6!");
+
+    const auto optionalHulkHandle = ParameterHandle<double>::optional("Hulk", "TimeLoop.MaxTimeStepSizeX");
+    if (optionalHulkHandle.hasValue()) DUNE_THROW(Dune::InvalidStateException, "Parameter should not be specified!");
+
+    // report lookups inside a region
+    Parameters::init([](Dune::ParameterTree& params){ params["Parameters.ReportHotPathLookups"] = "true"; });
+    {
+        ParameterLookupRegion region("test");
+        for (int i = 0; i < 3; ++i)
+            getParam<double>("TimeLoop.TEnd");
+    }
+    getParam<double>("TimeLoop.TEnd");
+    const auto& lookups = Detail::ParameterLookupMonitor::lookups();
+    if (lookups.size() != 1 || lookups.begin()->second != 3)
+        DUNE_THROW(Dune::InvalidStateException, "There should be three recorded lookups!");
+
     Parameters::print();
 
     // check the unused keys
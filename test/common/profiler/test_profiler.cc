@@ -0,0 +1,91 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \ingroup Tests
+ * \brief Test for the profiler: nested regions, the json summary and the chrome trace events
+ */
+#include <config.h>
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/profiler.hh>
+
+void inner()
+{
+    DUMUX_PROFILE_REGION("inner");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+int main(int argc, char* argv[]) try
+{
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    const auto& comm = mpiHelper.getCollectiveCommunication();
+
+    auto& profiler = Dumux::Profiler::instance();
+    profiler.setRecordEvents();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        DUMUX_PROFILE_REGION("outer");
+        inner();
+        inner();
+    }
+
+    profiler.report(comm);
+    profiler.writeJson("profile.json", comm);
+    profiler.writeChromeTrace("trace-" + std::to_string(mpiHelper.rank()) + ".json", mpiHelper.rank());
+
+    if (mpiHelper.rank() == 0)
+    {
+        std::ifstream json("profile.json");
+        const std::string content((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+        if (content.find("\"path\": \"outer/inner\", \"calls\": 6") == std::string::npos)
+            DUNE_THROW(Dune::InvalidStateException, "Nested region not found in the profile:\n" << content);
+    }
+
+    std::ifstream trace("trace-" + std::to_string(mpiHelper.rank()) + ".json");
+    const std::string content((std::istreambuf_iterator<char>(trace)), std::istreambuf_iterator<char>());
+    std::size_t numEvents = 0;
+    for (auto pos = content.find("\"ph\": \"X\""); pos != std::string::npos; pos = content.find("\"ph\": \"X\"", pos + 1))
+        ++numEvents;
+    if (numEvents != 9)
+        DUNE_THROW(Dune::InvalidStateException, "Expected 9 trace events, got " << numEvents);
+
+    return 0;
+}
+catch (const Dune::Exception& e)
+{
+    std::cout << e << std::endl;
+    return 1;
+}
+catch (...)
+{
+    std::cout << "Unknown exception!" << std::endl;
+    return 1;
+}
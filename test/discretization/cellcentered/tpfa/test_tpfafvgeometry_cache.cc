@@ -0,0 +1,184 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test for the grid geometry cache files of the cell-centered tpfa grid geometry
+ */
+#include <config.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/discretization/gridgeometrycache.hh>
+#include <dumux/discretization/cellcentered/tpfa/fvgridgeometry.hh>
+
+int main (int argc, char *argv[]) try
+{
+    using namespace Dumux;
+
+    // maybe initialize mpi
+    Dune::MPIHelper::instance(argc, argv);
+
+    // write the cache files to the working directory
+    Parameters::init([](auto& params){ params["Grid.GeometryCache"] = "test_tpfafvgeometry_cache"; });
+
+    using Grid = Dune::YaspGrid<2>;
+    constexpr int dim = Grid::dimension;
+    using FVGridGeometry = CCTpfaFVGridGeometry<typename Grid::LeafGridView, true>;
+    using GlobalPosition = typename FVGridGeometry::SubControlVolume::GlobalPosition;
+
+    // make a grid
+    GlobalPosition lower(0.0);
+    GlobalPosition upper(1.0);
+    std::array<unsigned int, dim> els{{10, 7}};
+    std::shared_ptr<Grid> grid = Dune::StructuredGridFactory<Grid>::createCubeGrid(lower, upper, els);
+    auto leafGridView = grid->leafGridView();
+
+    // remove cache files of earlier runs of this test
+    FVGridGeometry computed(leafGridView);
+    const auto hash = gridGeometryHash(leafGridView, computed.elementMapper(), computed.vertexMapper());
+    const auto fileName = gridGeometryCacheFileName("test_tpfafvgeometry_cache", hash);
+    std::remove(fileName.c_str());
+
+    // the first update computes the data and writes the cache file
+    computed.update();
+    if (!std::ifstream(fileName))
+        DUNE_THROW(Dune::IOError, "The cache file " << fileName << " has not been written");
+
+    // the second grid geometry reads the data from the cache file
+    FVGridGeometry cached(leafGridView);
+    cached.update();
+
+    if (cached.numScv() != computed.numScv() || cached.numScvf() != computed.numScvf()
+        || cached.numBoundaryScvf() != computed.numBoundaryScvf())
+        DUNE_THROW(Dune::InvalidStateException, "The number of scvs or scvfs of the cached grid geometry differ");
+
+    for (const auto& element : elements(leafGridView))
+    {
+        const auto eIdx = computed.elementMapper().index(element);
+        if (cached.hasBoundaryScvf(eIdx) != computed.hasBoundaryScvf(eIdx)
+            || cached.scvfIndicesOfScv(eIdx) != computed.scvfIndicesOfScv(eIdx)
+            || (cached.scv(eIdx).center() - computed.scv(eIdx).center()).two_norm() > 1e-14)
+            DUNE_THROW(Dune::InvalidStateException, "The cached scv " << eIdx << " differs");
+
+        for (auto scvfIdx : computed.scvfIndicesOfScv(eIdx))
+        {
+            const auto& a = computed.scvf(scvfIdx);
+            const auto& b = cached.scvf(scvfIdx);
+            if (a.index() != b.index() || a.boundary() != b.boundary() || a.insideScvIdx() != b.insideScvIdx()
+                || (!a.boundary() && a.outsideScvIdx() != b.outsideScvIdx()) || a.boundaryFlag() != b.boundaryFlag()
+                || a.area() != b.area() || a.center() != b.center() || a.unitOuterNormal() != b.unitOuterNormal()
+                || a.corner(0) != b.corner(0) || a.corner(1) != b.corner(1))
+                DUNE_THROW(Dune::InvalidStateException, "The cached scvf " << scvfIdx << " differs");
+        }
+
+        const auto& dataJ = computed.connectivityMap()[eIdx];
+        const auto& cachedDataJ = cached.connectivityMap()[eIdx];
+        if (dataJ.size() != cachedDataJ.size())
+            DUNE_THROW(Dune::InvalidStateException, "The cached connectivity map of element " << eIdx << " differs");
+
+        for (std::size_t j = 0; j < dataJ.size(); ++j)
+            if (dataJ[j].globalJ != cachedDataJ[j].globalJ
+                || !std::equal(dataJ[j].scvfsJ.begin(), dataJ[j].scvfsJ.end(), cachedDataJ[j].scvfsJ.begin(), cachedDataJ[j].scvfsJ.end()))
+                DUNE_THROW(Dune::InvalidStateException, "The cached connectivity map of element " << eIdx << " differs");
+    }
+
+    // change the area of an scvf in the cache file: the data has to be read from the file and not recomputed
+    std::vector<char> buffer;
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // the scvfs are stored as raw bytes, use one whose record contains the bytes of its area only once
+    using SubControlVolumeFace = typename FVGridGeometry::SubControlVolumeFace;
+    std::size_t changedScvfIdx = computed.numScvf();
+    double changedArea = 0.0;
+    for (std::size_t scvfIdx = 0; scvfIdx < computed.numScvf() && changedScvfIdx == computed.numScvf(); ++scvfIdx)
+    {
+        const auto* scvfBytes = reinterpret_cast<const char*>(&computed.scvf(scvfIdx));
+        const auto recordBegin = std::search(buffer.begin(), buffer.end(), scvfBytes, scvfBytes + sizeof(SubControlVolumeFace));
+        if (recordBegin == buffer.end())
+            DUNE_THROW(Dune::InvalidStateException, "The scvf " << scvfIdx << " is not contained in the cache file");
+
+        const auto recordEnd = recordBegin + sizeof(SubControlVolumeFace);
+        const double area = computed.scvf(scvfIdx).area();
+        const auto* areaBytes = reinterpret_cast<const char*>(&area);
+        const auto areaPos = std::search(recordBegin, recordEnd, areaBytes, areaBytes + sizeof(double));
+        if (areaPos == recordEnd || std::search(areaPos + 1, recordEnd, areaBytes, areaBytes + sizeof(double)) != recordEnd)
+            continue;
+
+        changedScvfIdx = scvfIdx;
+        changedArea = 2.0*area;
+        const auto* changedAreaBytes = reinterpret_cast<const char*>(&changedArea);
+        std::copy(changedAreaBytes, changedAreaBytes + sizeof(double), areaPos);
+    }
+
+    if (changedScvfIdx == computed.numScvf())
+        DUNE_THROW(Dune::InvalidStateException, "No scvf area could be identified in the cache file");
+
+    std::ofstream(fileName, std::ios::binary).write(buffer.data(), buffer.size());
+
+    FVGridGeometry changed(leafGridView);
+    changed.update();
+    if (changed.scvf(changedScvfIdx).area() != changedArea)
+        DUNE_THROW(Dune::InvalidStateException, "The grid geometry has not been read from the cache file");
+
+    // a cache file written for other types is not read but replaced
+    const auto otherLayout = gridGeometryCacheLayout<int, float>();
+    {
+        GridGeometryCacheWriter writer(fileName, hash, otherLayout);
+        writer.write(std::uint64_t(42));
+        writer.close();
+    }
+
+    FVGridGeometry recomputed(leafGridView);
+    recomputed.update();
+    if (recomputed.numScvf() != computed.numScvf())
+        DUNE_THROW(Dune::InvalidStateException, "The cache file with another layout has been used");
+    if (GridGeometryCacheReader(fileName, hash, otherLayout).valid())
+        DUNE_THROW(Dune::InvalidStateException, "The cache file with another layout has not been replaced");
+
+    // a refined grid has another hash and does not use the cache file of the coarse grid
+    grid->globalRefine(1);
+    cached.update();
+    if (cached.numScv() != std::size_t(leafGridView.size(0)))
+        DUNE_THROW(Dune::InvalidStateException, "The cache file of the coarse grid has been used for the refined grid");
+
+    std::cout << "Cached and computed grid geometries are identical" << std::endl;
+    return 0;
+}
+// //////////////////////////////////
+//   Error handler
+// /////////////////////////////////
+catch (Dune::Exception &e) {
+
+    std::cout << e << std::endl;
+    return 1;
+}
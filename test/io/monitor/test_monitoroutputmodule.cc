@@ -0,0 +1,181 @@
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ *
+ * \brief Test for the monitor output module with a one-phase problem (tpfa and box)
+ *
+ * The solution is set to a linear pressure field. The values sampled at the probes
+ * and along a line are compared to the cell values (tpfa) or the interpolated
+ * values (box), the volume integral to the mean pressure and the boundary integral
+ * to the length of the top boundary. Run in parallel, the probes and line samples
+ * are owned by different processes and the integrals are summed over all of them.
+ */
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/io/grid/gridmanager.hh>
+#include <dumux/io/monitoroutputmodule.hh>
+
+#include <test/porousmediumflow/1p/implicit/incompressible/problem.hh>
+
+//! throws if a sampled value differs from the expected one
+void checkValue(double value, double expected, const std::string& what)
+{
+    if (!(std::abs(value - expected) <= 1e-10*std::max(1.0, std::abs(expected))))
+        DUNE_THROW(Dune::Exception, "Wrong " << what << ": " << value << " (expected " << expected << ")");
+}
+
+template<class TypeTag>
+void testMonitorOutputModule(const std::string& name)
+{
+    using namespace Dumux;
+
+    using Grid = GetPropType<TypeTag, Properties::Grid>;
+    GridManager<Grid> gridManager;
+    gridManager.init();
+    gridManager.loadBalance();
+    const auto& leafGridView = gridManager.grid().leafGridView();
+
+    using FVGridGeometry = GetPropType<TypeTag, Properties::FVGridGeometry>;
+    auto fvGridGeometry = std::make_shared<FVGridGeometry>(leafGridView);
+    fvGridGeometry->update();
+
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    auto problem = std::make_shared<Problem>(fvGridGeometry);
+
+    // a linear pressure field
+    using GlobalPosition = typename FVGridGeometry::SubControlVolume::GlobalPosition;
+    const auto pressure = [](const GlobalPosition& pos) { return 1.0e5 + 1.0e3*pos[0] + 2.0e3*pos[1]; };
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    SolutionVector x(fvGridGeometry->numDofs());
+    for (const auto& element : elements(leafGridView))
+    {
+        auto fvGeometry = localView(*fvGridGeometry);
+        fvGeometry.bindElement(element);
+        for (const auto& scv : scvs(fvGeometry))
+            x[scv.dofIndex()] = pressure(scv.dofPosition());
+    }
+
+    using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
+    auto gridVariables = std::make_shared<GridVariables>(problem, fvGridGeometry);
+    gridVariables->init(x);
+
+    using Monitor = MonitorOutputModule<GridVariables, SolutionVector>;
+    Monitor monitor(*gridVariables, x, name);
+    monitor.addPrimaryVariable(0, "p");
+    monitor.addVolumeVariable([](const auto& v){ return v.pressure(); }, "p volvars");
+    monitor.addVolumeIntegral([](const auto& v){ return v.pressure(); }, "p integral");
+    monitor.addBoundaryIntegral([](const auto& element, const auto& fvGeometry, const auto& elemVolVars,
+                                   const auto& elemFluxVarsCache, const auto& scvf)
+                                { return scvf.ipGlobal()[1] > 1.0 - 1e-6 ? scvf.area() : 0.0; }, "top length");
+
+    // two probes at cell centers and one off-center probe
+    const std::vector<GlobalPosition> probes = {{0.45, 0.55}, {0.05, 0.95}, {0.33, 0.71}};
+    for (std::size_t i = 0; i < probes.size(); ++i)
+        monitor.addProbe(probes[i], "probe" + std::to_string(i));
+
+    // a line through the cell centers on the diagonal
+    const std::vector<GlobalPosition> linePoints = {{0.05, 0.05}, {0.95, 0.95}};
+    const std::size_t numLineSamples = 10;
+    monitor.setLine(linePoints, numLineSamples);
+    monitor.write(0.0);
+
+    // tpfa samples the cell value, box interpolates linearly (exact for the linear field)
+    constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+    const auto expectedPressure = [&](const GlobalPosition& pos)
+    {
+        if (isBox)
+            return pressure(pos);
+
+        GlobalPosition center;
+        for (int dimIdx = 0; dimIdx < 2; ++dimIdx)
+            center[dimIdx] = (std::floor(10.0*pos[dimIdx]) + 0.5)/10.0;
+        return pressure(center);
+    };
+
+    const auto probeValues = monitor.probeValues();
+    if (probeValues.size() != 2*probes.size())
+        DUNE_THROW(Dune::Exception, "Wrong number of probe values: " << probeValues.size());
+    for (std::size_t i = 0; i < probes.size(); ++i)
+    {
+        checkValue(probeValues[2*i], expectedPressure(probes[i]), "primary variable at probe " + std::to_string(i));
+        checkValue(probeValues[2*i + 1], expectedPressure(probes[i]), "volume variable at probe " + std::to_string(i));
+    }
+
+    const auto lineValues = monitor.lineValues();
+    if (lineValues.size() != 2*numLineSamples)
+        DUNE_THROW(Dune::Exception, "Wrong number of line values: " << lineValues.size());
+    for (std::size_t i = 0; i < numLineSamples; ++i)
+    {
+        auto position = linePoints[0];
+        position.axpy(double(i)/(numLineSamples - 1), linePoints[1] - linePoints[0]);
+        checkValue(lineValues[2*i], pressure(position), "primary variable at line sample " + std::to_string(i));
+        checkValue(lineValues[2*i + 1], pressure(position), "volume variable at line sample " + std::to_string(i));
+    }
+
+    // midpoint (tpfa) and trapezoidal (box) rule are exact for the linear field on the unit square
+    const auto integralValues = monitor.integralValues();
+    if (integralValues.size() != 2)
+        DUNE_THROW(Dune::Exception, "Wrong number of integrals: " << integralValues.size());
+    checkValue(integralValues[0], pressure(GlobalPosition(0.5)), "volume integral");
+    checkValue(integralValues[1], 1.0, "boundary integral");
+
+    if (leafGridView.comm().rank() == 0)
+        std::cout << "Successfully checked the monitor output of " << name << std::endl;
+}
+
+int main(int argc, char** argv) try
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+
+    Parameters::init([](auto& params){
+        params["Grid.UpperRight"] = "1 1";
+        params["Grid.Cells"] = "10 10";
+        params["Problem.Name"] = "test_monitoroutputmodule";
+        params["Problem.ExtrusionFactor"] = "1";
+        params["SpatialParams.LensLowerLeft"] = "0.2 0.2";
+        params["SpatialParams.LensUpperRight"] = "0.8 0.8";
+        params["SpatialParams.Permeability"] = "1e-10";
+        params["SpatialParams.PermeabilityLens"] = "1e-12";
+    });
+
+    testMonitorOutputModule<Properties::TTag::OnePIncompressibleTpfa>("test_monitoroutputmodule_tpfa");
+    testMonitorOutputModule<Properties::TTag::OnePIncompressibleBox>("test_monitoroutputmodule_box");
+
+    return 0;
+}
+catch (Dune::Exception& e) {
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+}
+catch (std::exception& e) {
+    std::cerr << "stdlib reported error: " << e.what() << std::endl;
+    return 2;
+}
@@ -0,0 +1,229 @@
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ *
+ * \brief Test for reading binary and appended data with the vtk reader
+ *
+ * The data of the given file is written in all output formats of the Dune vtk writer
+ * and read again. The small files in the fixtures directory cover zlib compressed data,
+ * 64 bit headers, big endian data and parallel files with several pieces. In parallel
+ * runs, the pieces are read by their processes and sequential files have to be rejected.
+ */
+#include <config.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/io/file/vtk/vtkwriter.hh>
+
+#if HAVE_DUNE_ALUGRID
+#include <dune/alugrid/grid.hh>
+#endif
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/io/vtk/vtkreader.hh>
+
+//! compare two data sets up to the single precision the data is written with
+bool dataIsEqual(const Dumux::VTKReader::Data& a, const Dumux::VTKReader::Data& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (const auto& data : a)
+    {
+        const auto it = b.find(data.first);
+        if (it == b.end() || it->second.size() != data.second.size())
+            return false;
+
+        for (std::size_t i = 0; i < data.second.size(); ++i)
+        {
+            using std::abs; using std::max;
+            const double valueA = data.second[i];
+            const double valueB = it->second[i];
+            if (abs(valueA - valueB) > 1e-5*max(abs(valueA), abs(valueB)))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//! throws if the data array read from a fixture differs from the expected values
+void checkFixtureData(const Dumux::VTKReader& reader, const std::string& fileName, const std::string& name,
+                      Dumux::VTKReader::DataType type, const std::vector<double>& expected)
+{
+    const auto values = reader.readData<std::vector<double>>(name, type);
+    if (values != expected)
+        DUNE_THROW(Dune::Exception, "Wrong data array " << name << " read from " << fileName);
+}
+
+//! checks the data of a fixture describing two unit squares next to each other
+void checkFixture(const std::string& fileName)
+{
+    using DataType = Dumux::VTKReader::DataType;
+    const Dumux::VTKReader reader(fileName);
+    checkFixtureData(reader, fileName, "cellValue", DataType::cellData, {1.5, -2.25});
+    checkFixtureData(reader, fileName, "cellId", DataType::cellData, {7, 8});
+    checkFixtureData(reader, fileName, "pointValue", DataType::pointData, {0.0, 0.5, 1.0, 1.5, 2.0, 2.5});
+
+    // the grid has the point coordinates and connectivity of the fixture
+    using Grid = GRIDTYPE;
+    Dumux::VTKReader::Data cellData, pointData;
+    Dune::GridFactory<Grid> gridFactory;
+    auto grid = reader.readGrid(gridFactory, cellData, pointData);
+    const auto& gridView = grid->leafGridView();
+    if (gridView.size(0) != 2 || gridView.size(Grid::dimension) != 6)
+        DUNE_THROW(Dune::Exception, "Wrong grid read from " << fileName);
+
+    for (const auto& vertex : vertices(gridView))
+    {
+        using std::abs;
+        const auto& pos = vertex.geometry().corner(0);
+        const auto value = pointData["pointValue"][gridFactory.insertionIndex(vertex)];
+        if (abs(value - 0.5*(pos[0] + 3.0*pos[1])) > 1e-14)
+            DUNE_THROW(Dune::Exception, "Wrong point coordinates read from " << fileName);
+    }
+
+    std::cout << "Successfully read " << fileName << std::endl;
+}
+
+//! checks the piece of the fixture with two pieces read by this process
+void checkParallelFixture(const std::string& fileName)
+{
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+    if (comm.size() != 2)
+    {
+        // the number of pieces has to match the number of processes
+        bool thrown = false;
+        try { Dumux::VTKReader reader(fileName); }
+        catch (const Dune::IOError&) { thrown = true; }
+        if (!thrown)
+            DUNE_THROW(Dune::Exception, "Reading " << fileName << " with " << comm.size() << " processes did not throw");
+        return;
+    }
+
+    using DataType = Dumux::VTKReader::DataType;
+    const Dumux::VTKReader reader(fileName);
+    const std::vector<std::vector<double>> pointValues = {{0.0, 0.5, 2.0, 1.5}, {0.5, 1.0, 2.5, 2.0}};
+    checkFixtureData(reader, fileName, "cellValue", DataType::cellData, {comm.rank() == 0 ? 1.5 : -2.25});
+    checkFixtureData(reader, fileName, "cellId", DataType::cellData, {comm.rank() == 0 ? 7.0 : 8.0});
+    checkFixtureData(reader, fileName, "pointValue", DataType::pointData, pointValues[comm.rank()]);
+
+    std::cout << "Successfully read piece " << comm.rank() << " of " << fileName << std::endl;
+}
+
+int main(int argc, char** argv) try
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    if (argc != 2)
+        DUNE_THROW(Dune::IOError, "Needs one argument, the vtk file name");
+
+    // every process reads its own piece of the parallel file
+    checkParallelFixture("fixtures/s0002-pieces.pvtu");
+
+    // the remaining files are read and written by a single process
+    if (Dune::MPIHelper::getCollectiveCommunication().size() > 1)
+    {
+        // a sequential file would be read as the data of every process
+        bool thrown = false;
+        try { Dumux::VTKReader reader("fixtures/uint64.vtu"); }
+        catch (const Dune::IOError&) { thrown = true; }
+        if (!thrown)
+            DUNE_THROW(Dune::Exception, "Reading a sequential file in parallel did not throw");
+        return 0;
+    }
+
+    checkFixture("fixtures/uint64.vtu");
+    checkFixture("fixtures/bigendian.vtu");
+#if HAVE_ZLIB
+    checkFixture("fixtures/zlib.vtu");
+#else
+    std::cout << "Skipping fixtures/zlib.vtu, zlib not found" << std::endl;
+#endif
+
+    // read the grid and data from an ascii file
+    using Grid = GRIDTYPE;
+    Dumux::VTKReader::Data cellData, pointData;
+    Dune::GridFactory<Grid> gridFactory;
+    auto grid = Dumux::VTKReader(argv[1]).readGrid(gridFactory, cellData, pointData);
+    const auto& gridView = grid->leafGridView();
+
+    // reorder the data as the vtk writer expects mapper indices
+    Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView> elementMapper(gridView, Dune::mcmgElementLayout());
+    Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView> vertexMapper(gridView, Dune::mcmgVertexLayout());
+    Dumux::VTKReader::Data reorderedCellData = cellData, reorderedPointData = pointData;
+    for (const auto& element : elements(gridView))
+    {
+        const auto eIdx = elementMapper.index(element);
+        for (const auto& data : cellData)
+            reorderedCellData[data.first][eIdx] = data.second[gridFactory.insertionIndex(element)];
+
+        for (unsigned int i = 0; i < element.subEntities(Grid::dimension); ++i)
+        {
+            const auto vertex = element.template subEntity<Grid::dimension>(i);
+            const auto vIdx = vertexMapper.index(vertex);
+            for (const auto& data : pointData)
+                reorderedPointData[data.first][vIdx] = data.second[gridFactory.insertionIndex(vertex)];
+        }
+    }
+
+    // write the data in all output formats of the Dune vtk writer and read it again
+    const std::vector<std::pair<Dune::VTK::OutputType, std::string>> outputTypes = {
+        {Dune::VTK::ascii, "ascii"}, {Dune::VTK::base64, "base64"},
+        {Dune::VTK::appendedraw, "appendedraw"}, {Dune::VTK::appendedbase64, "appendedbase64"}
+    };
+
+    for (const auto& outputType : outputTypes)
+    {
+        Dune::VTKWriter<Grid::LeafGridView> vtkWriter(gridView);
+        for (const auto& data : reorderedCellData)
+            vtkWriter.addCellData(data.second, data.first);
+        for (const auto& data : reorderedPointData)
+            vtkWriter.addVertexData(data.second, data.first);
+        const auto fileName = vtkWriter.write("test-" + outputType.second, outputType.first);
+
+        Dumux::VTKReader::Data readCellData, readPointData;
+        Dune::GridFactory<Grid> readGridFactory;
+        auto readGrid = Dumux::VTKReader(fileName).readGrid(readGridFactory, readCellData, readPointData);
+
+        if (readGrid->leafGridView().size(0) != gridView.size(0)
+            || readGrid->leafGridView().size(Grid::dimension) != gridView.size(Grid::dimension))
+            DUNE_THROW(Dune::Exception, "Grid read from " << fileName << " differs from the written grid.");
+
+        if (!dataIsEqual(readCellData, reorderedCellData) || !dataIsEqual(readPointData, reorderedPointData))
+            DUNE_THROW(Dune::Exception, "Data read from " << fileName << " differs from the written data.");
+
+        std::cout << "Successfully read " << outputType.second << " data from " << fileName << std::endl;
+    }
+
+    return 0;
+}
+catch (Dune::Exception& e) {
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+}
+catch (std::exception& e) {
+    std::cerr << "stdlib reported error: " << e.what() << std::endl;
+    return 2;
+}
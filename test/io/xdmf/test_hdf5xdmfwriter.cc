@@ -0,0 +1,142 @@
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ *
+ * \brief Test for writing a time series into a single HDF5 file with an XDMF descriptor
+ */
+#include <config.h>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <hdf5.h>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/io/xdmf/hdf5xdmfwriter.hh>
+
+//! read a data set of doubles from an HDF5 file
+std::vector<double> readDataset(const std::string& fileName, const std::string& path)
+{
+    const hid_t file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = file >= 0 ? H5Dopen2(file, path.c_str(), H5P_DEFAULT) : -1;
+    if (dataset < 0)
+        DUNE_THROW(Dune::IOError, "Could not open " << path << " in " << fileName);
+
+    const hid_t space = H5Dget_space(dataset);
+    std::vector<double> values(H5Sget_simple_extent_npoints(space));
+    H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Sclose(space);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return values;
+}
+
+int main(int argc, char** argv) try
+{
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    const auto comm = mpiHelper.getCollectiveCommunication();
+    const int rank = comm.rank();
+    const int numProcs = comm.size();
+
+    for (int compressionLevel : {0, 6})
+    {
+        const std::string name = "test_hdf5xdmfwriter-" + std::to_string(compressionLevel);
+
+        {
+            // each process writes a row of two quadrilaterals (the last one a single triangle)
+            Dumux::Hdf5XdmfWriter<std::decay_t<decltype(comm)>> writer(name, comm, compressionLevel);
+            std::vector<double> points;
+            for (int i = 0; i < 6; ++i)
+                points.insert(points.end(), {double(i%3), double(rank + i/3), 0.0});
+
+            using Writer = decltype(writer);
+            const bool isLast = rank == numProcs - 1;
+            const std::vector<int> cellTypes = isLast ? std::vector<int>{Writer::triangle}
+                                                      : std::vector<int>{Writer::quadrilateral, Writer::quadrilateral};
+            const std::vector<std::int64_t> connectivity = isLast ? std::vector<std::int64_t>{0, 1, 4}
+                                                                  : std::vector<std::int64_t>{0, 1, 4, 3, 1, 2, 5, 4};
+            writer.setMesh(std::move(points), cellTypes, connectivity);
+
+            for (int timeStep = 0; timeStep < 3; ++timeStep)
+            {
+                std::vector<double> pressure(6), velocity(18);
+                for (int i = 0; i < 6; ++i)
+                {
+                    pressure[i] = 100*timeStep + 10*rank + i;
+                    velocity[3*i] = rank; velocity[3*i + 1] = timeStep; velocity[3*i + 2] = i;
+                }
+
+                writer.addPointData("pressure", std::move(pressure));
+                writer.addPointData("velocity (m/s)", std::move(velocity), 3);
+                writer.addCellData("process rank", std::vector<double>(cellTypes.size(), rank));
+                writer.write(0.5*timeStep);
+            }
+        }
+
+        // check the written data of the last time step and the descriptor on the first process
+        if (rank != 0)
+            continue;
+
+        const auto h5FileName = name + ".h5";
+        const auto geometry = readDataset(h5FileName, "/Mesh_0/Geometry");
+        const auto topology = readDataset(h5FileName, "/Mesh_0/Topology");
+        const auto pressure = readDataset(h5FileName, "/Step_2/pressure");
+        const auto velocity = readDataset(h5FileName, "/Step_2/velocity (m_s)");
+        const auto processRank = readDataset(h5FileName, "/Step_2/process rank");
+
+        if (geometry.size() != 18*std::size_t(numProcs) || pressure.size() != 6*std::size_t(numProcs)
+            || velocity.size() != 18*std::size_t(numProcs) || processRank.size() != 2*std::size_t(numProcs) - 1
+            || topology.size() != 10*std::size_t(numProcs) - 6)
+            DUNE_THROW(Dune::Exception, "Wrong size of the data sets in " << h5FileName);
+
+        for (int p = 0; p < numProcs; ++p)
+        {
+            // the point indices of the topology are shifted by the points of the preceding processes
+            if (topology[10*p + 2] != 6*p + 1)
+                DUNE_THROW(Dune::Exception, "Wrong topology in " << h5FileName);
+
+            for (int i = 0; i < 6; ++i)
+                if (pressure[6*p + i] != 200 + 10*p + i || velocity[18*p + 3*i + 1] != 2 || geometry[18*p + 3*i + 1] != p + i/3)
+                    DUNE_THROW(Dune::Exception, "Wrong data of process " << p << " in " << h5FileName);
+        }
+
+        std::ifstream xdmfFile(name + ".xmf");
+        const std::string xdmf((std::istreambuf_iterator<char>(xdmfFile)), std::istreambuf_iterator<char>());
+        if (xdmf.find("<Time Value=\"1\" />") == std::string::npos
+            || xdmf.find("NumberOfElements=\"" + std::to_string(2*numProcs - 1) + "\"") == std::string::npos
+            || xdmf.find("</Xdmf>") == std::string::npos)
+            DUNE_THROW(Dune::Exception, "Wrong XDMF descriptor " << name << ".xmf");
+
+        std::cout << "Successfully wrote " << h5FileName << " with compression level " << compressionLevel << std::endl;
+    }
+
+    return 0;
+}
+catch (Dune::Exception& e) {
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+}
+catch (std::exception& e) {
+    std::cerr << "stdlib reported error: " << e.what() << std::endl;
+    return 2;
+}
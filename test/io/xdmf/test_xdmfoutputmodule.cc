@@ -0,0 +1,210 @@
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ *
+ * \brief Test for the XDMF output module with a one-phase problem (tpfa and box)
+ *
+ * The solution is set to the linear pressure field of the constant-velocity variant
+ * of the incompressible one-phase test. The data sets written for volume variables,
+ * fields, velocities and the process rank are compared to the values evaluated at
+ * the written points and cell centers.
+ */
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/io/grid/gridmanager.hh>
+#include <dumux/io/xdmfoutputmodule.hh>
+
+#include <test/porousmediumflow/1p/implicit/incompressible/problem.hh>
+
+//! read a data set of doubles from an HDF5 file
+std::vector<double> readDataset(const std::string& fileName, const std::string& path)
+{
+    const hid_t file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    const hid_t dataset = file >= 0 ? H5Dopen2(file, path.c_str(), H5P_DEFAULT) : -1;
+    if (dataset < 0)
+        DUNE_THROW(Dune::IOError, "Could not open " << path << " in " << fileName);
+
+    const hid_t space = H5Dget_space(dataset);
+    std::vector<double> values(H5Sget_simple_extent_npoints(space));
+    H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+    H5Sclose(space);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    return values;
+}
+
+//! throws if a data set value differs from the expected one
+void checkValue(double value, double expected, const std::string& what)
+{
+    if (std::abs(value - expected) > 1e-10*std::max(1.0, std::abs(expected)))
+        DUNE_THROW(Dune::Exception, "Wrong " << what << ": " << value << " (expected " << expected << ")");
+}
+
+template<class TypeTag>
+void testXdmfOutputModule(const std::string& name)
+{
+    using namespace Dumux;
+
+    using Grid = GetPropType<TypeTag, Properties::Grid>;
+    GridManager<Grid> gridManager;
+    gridManager.init();
+    const auto& leafGridView = gridManager.grid().leafGridView();
+
+    using FVGridGeometry = GetPropType<TypeTag, Properties::FVGridGeometry>;
+    auto fvGridGeometry = std::make_shared<FVGridGeometry>(leafGridView);
+    fvGridGeometry->update();
+
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    auto problem = std::make_shared<Problem>(fvGridGeometry);
+
+    // the linear pressure field with constant velocity
+    const auto pressure = [&](const auto& globalPos) { return problem->dirichletAtPos(globalPos)[0]; };
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    SolutionVector x(fvGridGeometry->numDofs());
+    for (const auto& element : elements(leafGridView))
+    {
+        auto fvGeometry = localView(*fvGridGeometry);
+        fvGeometry.bindElement(element);
+        for (const auto& scv : scvs(fvGeometry))
+            x[scv.dofIndex()] = pressure(scv.dofPosition());
+    }
+
+    using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
+    auto gridVariables = std::make_shared<GridVariables>(problem, fvGridGeometry);
+    gridVariables->init(x);
+
+    // fields with the x-coordinate of the element centers and vertices
+    std::vector<double> elementX(leafGridView.size(0)), vertexX(leafGridView.size(Grid::dimension));
+    for (const auto& element : elements(leafGridView))
+        elementX[fvGridGeometry->elementMapper().index(element)] = element.geometry().center()[0];
+    for (const auto& vertex : vertices(leafGridView))
+        vertexX[fvGridGeometry->vertexMapper().index(vertex)] = vertex.geometry().center()[0];
+
+    XdmfOutputModule<GridVariables, SolutionVector> xdmfWriter(*gridVariables, x, name);
+    using VelocityOutput = GetPropType<TypeTag, Properties::VelocityOutput>;
+    auto velocityOutput = std::make_shared<VelocityOutput>(*gridVariables);
+    xdmfWriter.addVelocityOutput(velocityOutput);
+    xdmfWriter.addVolumeVariable([](const auto& v){ return v.pressure(); }, "pressure");
+    xdmfWriter.addField(elementX, "elementX");
+    xdmfWriter.addField(vertexX, "vertexX");
+    xdmfWriter.write(0.0);
+    xdmfWriter.write(1.0);
+
+    // the written mesh
+    const auto h5FileName = name + ".h5";
+    const auto geometry = readDataset(h5FileName, "/Mesh_0/Geometry");
+    const auto topology = readDataset(h5FileName, "/Mesh_0/Topology");
+    const std::size_t numPoints = geometry.size()/3;
+    const std::size_t numCells = topology.size()/4;
+    if (numPoints != std::size_t(leafGridView.size(Grid::dimension)) || numCells != std::size_t(leafGridView.size(0)))
+        DUNE_THROW(Dune::Exception, "Wrong mesh size in " << h5FileName);
+
+    // the cell centers (average of the quadrilateral corners)
+    std::vector<double> centerX(numCells, 0.0), centerY(numCells, 0.0);
+    for (std::size_t cellIdx = 0; cellIdx < numCells; ++cellIdx)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto pointIdx = std::size_t(topology[4*cellIdx + i]);
+            centerX[cellIdx] += 0.25*geometry[3*pointIdx];
+            centerY[cellIdx] += 0.25*geometry[3*pointIdx + 1];
+        }
+    }
+
+    const auto step = "/Step_1/";
+    constexpr bool isBox = FVGridGeometry::discMethod == DiscretizationMethod::box;
+    const auto pressureData = readDataset(h5FileName, step + std::string("pressure"));
+    const auto velocity = readDataset(h5FileName, step + std::string("velocity_") + velocityOutput->phaseName(0) + " (m_s)");
+    const auto cellField = readDataset(h5FileName, step + std::string("elementX"));
+    const auto pointField = readDataset(h5FileName, step + std::string("vertexX"));
+    const auto processRank = readDataset(h5FileName, step + std::string("process rank"));
+
+    const auto numDofValues = isBox ? numPoints : numCells;
+    if (pressureData.size() != numDofValues || velocity.size() != 3*numDofValues
+        || cellField.size() != numCells || pointField.size() != numPoints || processRank.size() != numCells)
+        DUNE_THROW(Dune::Exception, "Wrong size of the data sets in " << h5FileName);
+
+    using GlobalPosition = typename FVGridGeometry::SubControlVolume::GlobalPosition;
+    const auto exactVelocity = problem->velocity();
+    for (std::size_t i = 0; i < numDofValues; ++i)
+    {
+        GlobalPosition pos;
+        pos[0] = isBox ? geometry[3*i] : centerX[i];
+        pos[1] = isBox ? geometry[3*i + 1] : centerY[i];
+        checkValue(pressureData[i], pressure(pos), "pressure");
+        for (int dimIdx = 0; dimIdx < 2; ++dimIdx)
+            checkValue(velocity[3*i + dimIdx], exactVelocity[dimIdx], "velocity");
+        checkValue(velocity[3*i + 2], 0.0, "velocity");
+    }
+
+    for (std::size_t cellIdx = 0; cellIdx < numCells; ++cellIdx)
+    {
+        checkValue(cellField[cellIdx], centerX[cellIdx], "cell field");
+        checkValue(processRank[cellIdx], 0.0, "process rank");
+    }
+
+    for (std::size_t pointIdx = 0; pointIdx < numPoints; ++pointIdx)
+        checkValue(pointField[pointIdx], geometry[3*pointIdx], "point field");
+
+    std::cout << "Successfully wrote and checked " << h5FileName << std::endl;
+}
+
+int main(int argc, char** argv) try
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+
+    Parameters::init([](auto& params){
+        params["Grid.UpperRight"] = "1 1";
+        params["Grid.Cells"] = "4 5";
+        params["Problem.Name"] = "test_xdmfoutputmodule";
+        params["Problem.ExtrusionFactor"] = "1";
+        params["Problem.CheckIsConstantVelocity"] = "true";
+        params["SpatialParams.LensLowerLeft"] = "0.2 0.2";
+        params["SpatialParams.LensUpperRight"] = "0.8 0.8";
+        params["SpatialParams.Permeability"] = "1e-10";
+        params["SpatialParams.PermeabilityLens"] = "1e-12";
+    });
+
+    testXdmfOutputModule<Properties::TTag::OnePIncompressibleTpfa>("test_xdmfoutputmodule_tpfa");
+    testXdmfOutputModule<Properties::TTag::OnePIncompressibleBox>("test_xdmfoutputmodule_box");
+
+    return 0;
+}
+catch (Dune::Exception& e) {
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+}
+catch (std::exception& e) {
+    std::cerr << "stdlib reported error: " << e.what() << std::endl;
+    return 2;
+}
@@ -0,0 +1,151 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test for the conversion of MultiType block matrices into BCRS matrices
+ *        with reused occupation patterns
+ */
+#include <config.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/indices.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/matrixindexset.hh>
+#include <dune/istl/multitypeblockmatrix.hh>
+#include <dune/istl/multitypeblockvector.hh>
+
+#include <dumux/linear/matrixconverter.hh>
+
+namespace Dumux {
+
+// the value of the scalar entry (row, col) of the converted matrix
+double value(std::size_t row, std::size_t col)
+{ return 1.0 + 100.0*row + col; }
+
+// set the occupation pattern (block indices) of a sub matrix
+template<class Matrix>
+void setPattern(Matrix& M, std::size_t numRows, std::size_t numCols,
+                const std::vector<std::pair<std::size_t, std::size_t>>& entries)
+{
+    Dune::MatrixIndexSet pattern(numRows, numCols);
+    for (const auto& entry : entries)
+        pattern.add(entry.first, entry.second);
+    pattern.exportIdx(M);
+}
+
+// set the values of a sub matrix starting at the scalar row and column offsets
+template<class Matrix>
+void setValues(Matrix& M, std::size_t rowOffset, std::size_t colOffset)
+{
+    using Block = typename Matrix::block_type;
+    for (auto row = M.begin(); row != M.end(); ++row)
+        for (auto col = row->begin(); col != row->end(); ++col)
+            for (int i = 0; i < Block::rows; ++i)
+                for (int j = 0; j < Block::cols; ++j)
+                    (*col)[i][j] = value(rowOffset + row.index()*Block::rows + i,
+                                         colOffset + col.index()*Block::cols + j);
+}
+
+// check the converted matrix against the expected values and the pattern of the reference
+template<class BCRSMatrix>
+void checkConversion(const BCRSMatrix& M, const BCRSMatrix& reference)
+{
+    if (M.N() != reference.N() || M.nonzeroes() != reference.nonzeroes())
+        DUNE_THROW(Dune::Exception, "The converted matrix has the wrong size");
+
+    for (auto row = M.begin(), refRow = reference.begin(); row != M.end(); ++row, ++refRow)
+    {
+        if (row->size() != refRow->size())
+            DUNE_THROW(Dune::Exception, "Wrong number of entries in row " << row.index());
+
+        for (auto col = row->begin(), refCol = refRow->begin(); col != row->end(); ++col, ++refCol)
+        {
+            if (col.index() != refCol.index())
+                DUNE_THROW(Dune::Exception, "Wrong column index " << col.index() << " in row " << row.index()
+                                             << " (expected " << refCol.index() << ")");
+            if ((*col)[0][0] != value(row.index(), col.index()))
+                DUNE_THROW(Dune::Exception, "Wrong value " << (*col)[0][0] << " of entry ("
+                                             << row.index() << ", " << col.index() << ")");
+        }
+    }
+}
+
+} // end namespace Dumux
+
+int main(int argc, char* argv[]) try
+{
+    using namespace Dumux;
+    using namespace Dune::Indices;
+
+    Dune::MPIHelper::instance(argc, argv);
+
+    // a 2x2 MultiType matrix with 3 blocks of size 2 and 2 blocks of size 1
+    using M00 = Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2>>;
+    using M01 = Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 1>>;
+    using M10 = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 2>>;
+    using M11 = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+    using Matrix = Dune::MultiTypeBlockMatrix<Dune::MultiTypeBlockVector<M00, M01>,
+                                              Dune::MultiTypeBlockVector<M10, M11>>;
+
+    // two matrices of the same size with the same number of non-zeros but different patterns
+    auto makeMatrix = [](std::size_t coupledBlock)
+    {
+        Matrix A;
+        setPattern(A[_0][_0], 3, 3, {{0, 0}, {1, 1}, {2, 2}, {0, coupledBlock}});
+        setPattern(A[_0][_1], 3, 2, {{0, 0}, {2, 1}});
+        setPattern(A[_1][_0], 2, 3, {{1, 2}});
+        setPattern(A[_1][_1], 2, 2, {{0, 0}, {1, 1}});
+        setValues(A[_0][_0], 0, 0);
+        setValues(A[_0][_1], 0, 6);
+        setValues(A[_1][_0], 6, 0);
+        setValues(A[_1][_1], 6, 6);
+        return A;
+    };
+
+    const auto A = makeMatrix(1);
+    const auto B = makeMatrix(2);
+
+    using Converter = MatrixConverter<Matrix>;
+    const auto referenceA = Converter::multiTypeToBCRSMatrix(A);
+    const auto referenceB = Converter::multiTypeToBCRSMatrix(B);
+    if (referenceA.N() != 8 || referenceA.nonzeroes() != referenceB.nonzeroes())
+        DUNE_THROW(Dune::Exception, "The test matrices should have the same size and number of non-zeros");
+
+    // convert repeatedly, switching between the patterns
+    Converter converter;
+    checkConversion(converter.convert(A), referenceA);
+    checkConversion(converter.convert(A), referenceA);
+    checkConversion(converter.convert(B), referenceB);
+    checkConversion(converter.convert(B), referenceB);
+    checkConversion(converter.convert(A), referenceA);
+
+    std::cout << "All conversions are correct" << std::endl;
+    return 0;
+}
+catch (Dune::Exception& e)
+{
+    std::cerr << e << std::endl;
+    return 1;
+}
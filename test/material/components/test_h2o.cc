@@ -0,0 +1,85 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup MaterialTests
+ * \brief Test that the phase properties of the IAPWS water component evaluated at once
+ *        coincide with the ones of the individual property functions.
+ */
+
+#include "config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/material/components/h2o.hh>
+
+//! throws if a property evaluated at once differs from the individual function
+void checkProperty(double value, double reference, const std::string& name, double temperature, double pressure)
+{
+    using std::abs; using std::max;
+    if (abs(value - reference) > 1e-12*max(abs(reference), 1e-10))
+        DUNE_THROW(Dune::Exception, "The " << name << " evaluated at once (" << value
+                                    << ") differs from the individual function (" << reference
+                                    << ") at T = " << temperature << ", p = " << pressure);
+}
+
+int main(int argc, char *argv[]) try
+{
+    using namespace Dumux;
+    using H2O = Components::H2O<double>;
+
+    // the pressures range from below the triple point pressure to 90 MPa, so both
+    // the regularized and the unregularized states of both phases are covered
+    const int numTemperatures = 35, numPressures = 50;
+    for (int i = 0; i < numTemperatures; ++i)
+    {
+        const double temperature = 275.0 + 345.0*i/(numTemperatures - 1);
+        for (int j = 0; j < numPressures; ++j)
+        {
+            using std::pow;
+            const double pressure = 100.0*pow(9e5, double(j)/(numPressures - 1));
+
+            const auto liquid = H2O::liquidProperties(temperature, pressure);
+            checkProperty(liquid.density, H2O::liquidDensity(temperature, pressure), "liquid density", temperature, pressure);
+            checkProperty(liquid.enthalpy, H2O::liquidEnthalpy(temperature, pressure), "liquid enthalpy", temperature, pressure);
+            checkProperty(liquid.internalEnergy, H2O::liquidInternalEnergy(temperature, pressure), "liquid internal energy", temperature, pressure);
+            checkProperty(liquid.heatCapacity, H2O::liquidHeatCapacity(temperature, pressure), "liquid heat capacity", temperature, pressure);
+            checkProperty(liquid.viscosity, H2O::liquidViscosity(temperature, pressure), "liquid viscosity", temperature, pressure);
+
+            const auto gas = H2O::gasProperties(temperature, pressure);
+            checkProperty(gas.density, H2O::gasDensity(temperature, pressure), "gas density", temperature, pressure);
+            checkProperty(gas.enthalpy, H2O::gasEnthalpy(temperature, pressure), "gas enthalpy", temperature, pressure);
+            checkProperty(gas.internalEnergy, H2O::gasInternalEnergy(temperature, pressure), "gas internal energy", temperature, pressure);
+            checkProperty(gas.heatCapacity, H2O::gasHeatCapacity(temperature, pressure), "gas heat capacity", temperature, pressure);
+            checkProperty(gas.viscosity, H2O::gasViscosity(temperature, pressure), "gas viscosity", temperature, pressure);
+        }
+    }
+
+    std::cout << "The phase properties of water evaluated at once coincide with the individual functions" << std::endl;
+    return 0;
+}
+catch (Dune::Exception& e) {
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+}
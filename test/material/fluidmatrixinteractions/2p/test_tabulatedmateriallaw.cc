@@ -0,0 +1,112 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup MaterialTests
+ * \brief Test comparing the tabulated material law adapter to the regularized van Genuchten law.
+ */
+
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/material/fluidmatrixinteractions/2p/regularizedvangenuchten.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/efftoabslaw.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/tabulatedmateriallaw.hh>
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+
+    using Scalar = double;
+    using EffLaw = RegularizedVanGenuchten<Scalar>;
+    using TabulatedLaw = TabulatedMaterialLaw<EffLaw>;
+    using MaterialLaw = EffToAbsLaw<TabulatedLaw>;
+
+    MaterialLaw::Params params;
+    params.setSwr(0.05);
+    params.setSnr(0.0);
+    params.setVgAlpha(3.5e-4);
+    params.setVgn(4.7);
+
+    // the reference parameters of the exact law
+    EffLaw::Params effParams;
+    effParams.setVgAlpha(3.5e-4);
+    effParams.setVgn(4.7);
+
+    Scalar maxErrorPc = 0.0, maxErrorKrw = 0.0, maxErrorKrn = 0.0, maxErrorInverse = 0.0;
+    const int numSamples = 10000;
+    for (int i = -100; i <= numSamples + 100; ++i)
+    {
+        using std::abs; using std::max;
+        const Scalar swe = Scalar(i)/numSamples;
+        const Scalar pcExact = EffLaw::pc(effParams, swe);
+        const Scalar pc = TabulatedLaw::pc(params, swe);
+        maxErrorPc = max(maxErrorPc, abs(pc - pcExact)/max(abs(pcExact), 1.0));
+        maxErrorKrw = max(maxErrorKrw, abs(TabulatedLaw::krw(params, swe) - EffLaw::krw(effParams, swe)));
+        maxErrorKrn = max(maxErrorKrn, abs(TabulatedLaw::krn(params, swe) - EffLaw::krn(effParams, swe)));
+        maxErrorInverse = max(maxErrorInverse, abs(TabulatedLaw::sw(params, pc) - swe));
+
+        // the tabulated curves have to be monotone
+        if (i > -100)
+        {
+            const Scalar sweOld = Scalar(i-1)/numSamples;
+            if (TabulatedLaw::pc(params, swe) > TabulatedLaw::pc(params, sweOld)
+                || TabulatedLaw::krw(params, swe) < TabulatedLaw::krw(params, sweOld)
+                || TabulatedLaw::krn(params, swe) > TabulatedLaw::krn(params, sweOld))
+                DUNE_THROW(Dune::Exception, "Tabulated curves not monotone at swe = " << swe);
+        }
+    }
+
+    std::cout << "Maximum relative error pc: " << maxErrorPc << "\n"
+              << "Maximum error krw: " << maxErrorKrw << "\n"
+              << "Maximum error krn: " << maxErrorKrn << "\n"
+              << "Maximum error sw(pc(swe)): " << maxErrorInverse << std::endl;
+
+    if (maxErrorPc > 1e-2 || maxErrorKrw > 1e-2 || maxErrorKrn > 1e-2)
+        DUNE_THROW(Dune::Exception, "Tabulated law deviates too much from the exact law");
+    if (maxErrorInverse > 1e-10)
+        DUNE_THROW(Dune::Exception, "Tabulated inverse is not consistent with the tabulated capillary pressure");
+
+    // parameter sets with the same values share a table
+    MaterialLaw::Params otherParams(params);
+    otherParams.resetTable();
+    if (&otherParams.table() != &params.table())
+        DUNE_THROW(Dune::Exception, "Equal parameter sets do not share the table");
+    if (otherParams.hash() != params.hash())
+        DUNE_THROW(Dune::Exception, "Equal parameter sets have different hashes");
+
+    // parameter sets with other values get their own table
+    otherParams.setVgAlpha(2.0e-4);
+    otherParams.resetTable();
+    if (&otherParams.table() == &params.table())
+        DUNE_THROW(Dune::Exception, "Different parameter sets share the table");
+
+    // the absolute law works with the adapter
+    const Scalar sw = MaterialLaw::sw(params, MaterialLaw::pc(params, 0.5));
+    using std::abs;
+    if (abs(sw - 0.5) > 1e-10)
+        DUNE_THROW(Dune::Exception, "Wrong inverse of the absolute law: " << sw);
+
+    return 0;
+}
@@ -28,8 +28,10 @@
 #ifndef DUMUX_CHECK_FLUIDSYSTEM_HH
 #define DUMUX_CHECK_FLUIDSYSTEM_HH
 
+#include <cmath>
 #include <exception>
 #include <string>
+#include <vector>
 
 #include <dune/common/classname.hh>
 
@@ -543,6 +545,31 @@ int checkFluidSystem(bool enablePhaseRestriction = true)
         {
             collectedErrors += "error: FluidSystem::molarDensity() throws exception: " + std::string(e.what()) + "\n";
         }
+        try
+        {
+            // the batched evaluation for a range of fluid states has to match the evaluation for single states
+            const std::vector<decltype(fs)> fluidStates(2, fs);
+            std::vector<Scalar> values(fluidStates.size());
+            using std::abs;
+            const auto isClose = [](Scalar a, Scalar b) { return abs(a - b) <= 1e-12*abs(b); };
+
+            FluidSystem::density(fluidStates, phaseIdx, values);
+            const Scalar density = FluidSystem::density(fs, paramCache, phaseIdx);
+            for (const auto value : values)
+                if (!isClose(value, density))
+                    collectedErrors += "error: batched FluidSystem::density() returns " + std::to_string(value)
+                                       + " instead of " + std::to_string(density) + "\n";
+
+            FluidSystem::molarDensity(fluidStates, phaseIdx, values);
+            const Scalar molarDensity = FluidSystem::molarDensity(fs, paramCache, phaseIdx);
+            for (const auto value : values)
+                if (!isClose(value, molarDensity))
+                    collectedErrors += "error: batched FluidSystem::molarDensity() returns " + std::to_string(value)
+                                       + " instead of " + std::to_string(molarDensity) + "\n";
+        } catch (const std::exception& e)
+        {
+            collectedErrors += "error: batched FluidSystem::density() throws exception: " + std::string(e.what()) + "\n";
+        }
         fs.allowPressure(true);
         fs.allowDensity(true);
         try
@@ -0,0 +1,126 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup MaterialTests
+ * \brief Test for the in-process Gaussian random field generator.
+ *
+ * Checks that a field is reproducible for a fixed seed and that the sample mean
+ * and variance over a domain much larger than the correlation length match the
+ * prescribed moments for both covariance models.
+ */
+#include <config.h>
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/yaspgrid.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/material/spatialparams/gaussianrandomfield.hh>
+
+int main(int argc, char** argv) try
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+
+    Parameters::init([](auto& params){
+        params["RandomField.Mean"] = "-11.0";
+        params["RandomField.Variance"] = "0.25";
+        params["RandomField.CorrelationLength"] = "1.0";
+        params["RandomField.NumModes"] = "1000";
+        params["RandomField.Seed"] = "0";
+    });
+
+    // a domain of 100 x 100 correlation lengths
+    using Grid = Dune::YaspGrid<2>;
+    const Dune::FieldVector<double, 2> upperRight(100.0);
+    const std::array<int, 2> cells = {{100, 100}};
+    Grid grid(upperRight, cells);
+    const auto gridView = grid.leafGridView();
+    using GridView = Grid::LeafGridView;
+    Dune::MultipleCodimMultipleGeomTypeMapper<GridView> elementMapper(gridView, Dune::mcmgElementLayout());
+
+    const double mean = getParam<double>("RandomField.Mean");
+    const double variance = getParam<double>("RandomField.Variance");
+
+    for (const auto& covariance : {std::string("Gaussian"), std::string("Exponential")})
+    {
+        Parameters::init([&](auto& params){ params["RandomField.Covariance"] = covariance; });
+
+        // the same seed gives the same field, also at arbitrary positions
+        GaussianRandomField<GridView, double> field(gridView, elementMapper);
+        field.create();
+        GaussianRandomField<GridView, double> sameField(gridView, elementMapper);
+        sameField.create();
+        if (field.data() != sameField.data())
+            DUNE_THROW(Dune::Exception, covariance << ": fields with the same seed differ");
+
+        const Dune::FieldVector<double, 2> pos = {12.3, 45.6};
+        if (field.value(pos) != sameField.value(pos))
+            DUNE_THROW(Dune::Exception, covariance << ": values with the same seed differ");
+
+        // another seed gives another field
+        GaussianRandomField<GridView, double> otherField(gridView, elementMapper);
+        otherField.setModes(1000, 1);
+        otherField.create();
+        if (field.data() == otherField.data())
+            DUNE_THROW(Dune::Exception, covariance << ": fields with different seeds are equal");
+
+        // the sample moments over the domain
+        double sum = 0.0, sumSquares = 0.0;
+        for (const auto value : field.data())
+        {
+            sum += value;
+            sumSquares += value*value;
+        }
+
+        const auto numValues = field.data().size();
+        const double sampleMean = sum/numValues;
+        const double sampleVariance = sumSquares/numValues - sampleMean*sampleMean;
+        std::cout << covariance << ": sample mean " << sampleMean << " (" << mean << "), "
+                  << "sample variance " << sampleVariance << " (" << variance << ")" << std::endl;
+
+        using std::abs; using std::sqrt;
+        if (abs(sampleMean - mean) > 0.15*sqrt(variance))
+            DUNE_THROW(Dune::Exception, covariance << ": wrong sample mean " << sampleMean);
+        if (abs(sampleVariance/variance - 1.0) > 0.1)
+            DUNE_THROW(Dune::Exception, covariance << ": wrong sample variance " << sampleVariance);
+
+        // the log10 field is the power of the Gaussian field
+        GaussianRandomField<GridView, double> logField(gridView, elementMapper);
+        logField.create(GaussianRandomField<GridView, double>::log10);
+        for (std::size_t i = 0; i < numValues; ++i)
+            if (abs(std::log10(logField.data()[i]) - field.data()[i]) > 1e-10)
+                DUNE_THROW(Dune::Exception, covariance << ": wrong log10 field");
+    }
+
+    return 0;
+}
+catch (const Dune::Exception& e)
+{
+    std::cerr << e << std::endl;
+    return 1;
+}
@@ -0,0 +1,187 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup MaterialTests
+ * \brief Test for the deduplicating storage of element-wise material law parameters
+ *        and the comparison operators of the three-phase and multi-phase parameters.
+ */
+#include <config.h>
+
+#include <cstdint>
+#include <iostream>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dumux/material/fluidmatrixinteractions/2p/vangenuchtenparams.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/efftoabslawparams.hh>
+#include <dumux/material/fluidmatrixinteractions/3p/regularizedparkervangen3pparams.hh>
+#include <dumux/material/fluidmatrixinteractions/mp/mplinearmaterialparams.hh>
+#include <dumux/material/spatialparams/materiallawparamsstorage.hh>
+
+//! check the interning and the index lookup of the storage
+void testStorage()
+{
+    using Params = Dumux::EffToAbsLawParams<Dumux::VanGenuchtenParams<double>>;
+    const auto makeParams = [](double alpha, double n, double swr)
+    {
+        Params params;
+        params.setVgAlpha(alpha);
+        params.setVgn(n);
+        params.setSwr(swr);
+        params.setSnr(0.0);
+        return params;
+    };
+
+    // three layers repeated over 100 elements, the first and the last layer are equal
+    const Params layers[3] = { makeParams(3.7e-3, 4.7, 0.05), makeParams(4.5e-4, 7.3, 0.18), makeParams(3.7e-3, 4.7, 0.05) };
+    const std::size_t numElements = 100;
+    Dumux::MaterialLawParamsStorage<Params, std::uint8_t> storage(numElements);
+    for (std::size_t eIdx = 0; eIdx < numElements; ++eIdx)
+        storage.setParams(eIdx, layers[(eIdx/7) % 3]);
+
+    if (storage.size() != numElements)
+        DUNE_THROW(Dune::Exception, "Wrong number of elements " << storage.size());
+    if (storage.numUniqueParams() != 2)
+        DUNE_THROW(Dune::Exception, "Expected 2 unique parameter sets, got " << storage.numUniqueParams());
+
+    for (std::size_t eIdx = 0; eIdx < numElements; ++eIdx)
+    {
+        const auto& expected = layers[(eIdx/7) % 3];
+        const auto expectedIndex = (eIdx/7) % 3 == 1 ? 1 : 0;
+        if (storage.index(eIdx) != expectedIndex)
+            DUNE_THROW(Dune::Exception, "Wrong index " << int(storage.index(eIdx)) << " of element " << eIdx);
+        if (!(storage[eIdx] == expected) || &storage[eIdx] != &storage.uniqueParams(storage.index(eIdx)))
+            DUNE_THROW(Dune::Exception, "Wrong parameters of element " << eIdx);
+    }
+
+    // inserting a stored set returns its index, a new set gets the next index
+    if (storage.insert(layers[1]) != 1 || storage.insert(makeParams(1e-4, 2.0, 0.1)) != 2)
+        DUNE_THROW(Dune::Exception, "Wrong index returned by insert()");
+
+    // references stay valid when new sets are inserted
+    const auto* first = &storage.uniqueParams(0);
+    for (int i = 0; i < 200; ++i)
+        storage.insert(makeParams(1e-4*(i + 2), 2.0, 0.1));
+    if (first != &storage.uniqueParams(0))
+        DUNE_THROW(Dune::Exception, "Stored parameters were moved");
+
+    // the index type limits the number of unique sets
+    bool thrown = false;
+    try {
+        for (int i = 0; i < 300; ++i)
+            storage.insert(makeParams(1.0 + i, 2.0, 0.1));
+    }
+    catch (const Dune::RangeError&) { thrown = true; }
+    if (!thrown)
+        DUNE_THROW(Dune::Exception, "Expected an exception for too many unique sets");
+
+    // set an element's index directly
+    storage.resize(numElements + 1);
+    if (storage.index(numElements) != decltype(storage)::invalidIndex)
+        DUNE_THROW(Dune::Exception, "New elements should not have parameters");
+    storage.setIndex(numElements, 1);
+    if (!(storage[numElements] == layers[1]))
+        DUNE_THROW(Dune::Exception, "Wrong parameters after setIndex()");
+
+    storage.clear();
+    if (storage.size() != 0 || storage.numUniqueParams() != 0 || storage.insert(layers[0]) != 0)
+        DUNE_THROW(Dune::Exception, "Storage not empty after clear()");
+}
+
+//! check the comparison of the three-phase parameters
+void testParkerVanGenuchten3PParams()
+{
+    using Params = Dumux::RegularizedParkerVanGen3PParams<double>;
+    const Dune::FieldVector<double, 4> residualSaturations = {0.12, 0.1, 0.01, 0.0};
+    const Params params(5e-4, 4.0, 0.0, 1500.0, residualSaturations);
+
+    Params almostEqual(params);
+    almostEqual.setVgAlpha(5e-4*(1.0 + 1e-10));
+    if (!(params == Params(params)) || !(params == almostEqual))
+        DUNE_THROW(Dune::Exception, "Equal 3p parameters compare unequal");
+
+    Params otherN(params);
+    otherN.setVgn(4.1);
+    Params otherSgr(params);
+    otherSgr.setSgr(0.02);
+    Params otherKrRegardsSnr(params);
+    otherKrRegardsSnr.setKrRegardsSnr(true);
+    Params otherRegularization(params);
+    otherRegularization.setPcLowS(2e-2);
+    if (params == otherN || params == otherSgr || params == otherKrRegardsSnr || params == otherRegularization)
+        DUNE_THROW(Dune::Exception, "Different 3p parameters compare equal");
+
+    // copies are interned
+    Dumux::MaterialLawParamsStorage<Params> storage(3);
+    storage.setParams(0, params);
+    storage.setParams(1, otherN);
+    storage.setParams(2, params);
+    if (storage.numUniqueParams() != 2 || storage.index(0) != storage.index(2))
+        DUNE_THROW(Dune::Exception, "Wrong interning of 3p parameters");
+}
+
+//! check the comparison of the multi-phase linear parameters
+void testMpLinearMaterialParams()
+{
+    using Params = Dumux::MpLinearMaterialParams<3, double>;
+    Params params;
+    for (int phaseIdx = 0; phaseIdx < 3; ++phaseIdx)
+    {
+        params.setPcMinSat(phaseIdx, -1e4*phaseIdx);
+        params.setPcMaxSat(phaseIdx, 1e3*phaseIdx);
+    }
+
+    Params almostEqual(params);
+    almostEqual.setPcMinSat(2, -2e4*(1.0 + 1e-10));
+    if (!(params == Params(params)) || !(params == almostEqual))
+        DUNE_THROW(Dune::Exception, "Equal mp parameters compare unequal");
+
+    // negative values must not break the relative tolerance
+    Params otherMin(params);
+    otherMin.setPcMinSat(2, -2.1e4);
+    Params otherMax(params);
+    otherMax.setPcMaxSat(1, 0.0);
+    if (params == otherMin || params == otherMax)
+        DUNE_THROW(Dune::Exception, "Different mp parameters compare equal");
+
+    Dumux::MaterialLawParamsStorage<Params> storage(4);
+    storage.setParams(0, params);
+    storage.setParams(1, otherMin);
+    storage.setParams(2, params);
+    storage.setParams(3, otherMin);
+    if (storage.numUniqueParams() != 2 || storage.index(1) != storage.index(3))
+        DUNE_THROW(Dune::Exception, "Wrong interning of mp parameters");
+}
+
+int main(int argc, char** argv) try
+{
+    testStorage();
+    testParkerVanGenuchten3PParams();
+    testMpLinearMaterialParams();
+
+    std::cout << "All material law parameter storage tests passed" << std::endl;
+    return 0;
+}
+catch (const Dune::Exception& e)
+{
+    std::cerr << e << std::endl;
+    return 1;
+}
@@ -32,8 +32,13 @@
 #include <dumux/common/dumuxmessage.hh>
 #include <dumux/common/defaultusagemessage.hh>
 
+#ifndef LINEARSOLVER // default to converting the system matrix for an ILU0 preconditioned solver
+#define LINEARSOLVER ILU0BiCGSTABBackend
+#endif
+
 #include <dumux/assembly/diffmethod.hh>
 #include <dumux/linear/seqsolverbackend.hh>
+#include <dumux/linear/fieldsplitsolver.hh>
 
 #include <dumux/multidomain/newtonsolver.hh>
 #include <dumux/multidomain/fvassembler.hh>
@@ -183,7 +188,7 @@ int main(int argc, char** argv) try
                                                   couplingManager);
 
     // the linear solver
-    using LinearSolver = ILU0BiCGSTABBackend;
+    using LinearSolver = LINEARSOLVER;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
@@ -37,9 +37,14 @@
 #include "problem_facet.hh"
 #include "problem_edge.hh"
 
+#ifndef LINEARSOLVER // default to converting the system matrix for an ILU0 preconditioned solver
+#define LINEARSOLVER ILU0BiCGSTABBackend
+#endif
+
 #include <dumux/assembly/diffmethod.hh>
 
 #include <dumux/linear/seqsolverbackend.hh>
+#include <dumux/linear/fieldsplitsolver.hh>
 #include <dumux/multidomain/newtonsolver.hh>
 #include <dumux/multidomain/fvassembler.hh>
 #include <dumux/multidomain/traits.hh>
@@ -169,7 +174,7 @@ int main(int argc, char** argv) try
     auto assembler = std::make_shared<Assembler>( problem.getTuple(), fvGridGeometry.getTuple(), gridVars.getTuple(), couplingManager);
 
     // the linear solver
-    using LinearSolver = ILU0BiCGSTABBackend;
+    using LinearSolver = LINEARSOLVER;
     auto linearSolver = std::make_shared<LinearSolver>();
 
     // the non-linear solver
@@ -43,6 +43,7 @@
 #include <dumux/multidomain/traits.hh>
 
 #include <dumux/geomechanics/poroelastic/couplingmanager.hh>
+#include <dumux/geomechanics/poroelastic/fixedstresssolver.hh>
 
 #include <dumux/io/vtkoutputmodule.hh>
 #include <dumux/io/grid/gridmanager.hh>
@@ -178,12 +179,21 @@ int main(int argc, char** argv) try
     using LinearSolver = ILU0BiCGSTABBackend;
     auto linearSolver = std::make_shared<LinearSolver>();
 
+#if FIXEDSTRESS
+    // the sequential fixed-stress solver (the sub-problems are solved with their own linear solver)
+    using FixedStressSolver = PoroMechanicsFixedStressSolver<Assembler, LinearSolver, LinearSolver, CouplingManager>;
+    auto fixedStressSolver = std::make_shared<FixedStressSolver>(assembler, linearSolver, std::make_shared<LinearSolver>(), couplingManager);
+
+    // solve
+    fixedStressSolver->solve(x);
+#else
     // the non-linear solver
     using NewtonSolver = Dumux::MultiDomainNewtonSolver<Assembler, LinearSolver, CouplingManager>;
     auto newtonSolver = std::make_shared<NewtonSolver>(assembler, linearSolver, couplingManager);
 
     // linearize & solve
     newtonSolver->solve(x);
+#endif
 
     // update grid variables for output
     onePGridVariables->update(x[onePId]);
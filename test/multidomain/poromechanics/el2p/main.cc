@@ -45,6 +45,7 @@
 #include <dumux/multidomain/traits.hh>
 
 #include <dumux/geomechanics/poroelastic/couplingmanager.hh>
+#include <dumux/geomechanics/poroelastic/fixedstresssolver.hh>
 
 #include <dumux/io/vtkoutputmodule.hh>
 #include <dumux/io/grid/gridmanager.hh>
@@ -186,6 +187,15 @@ int main(int argc, char** argv) try
                                                   std::make_tuple(twoPGridVariables, poroMechGridVariables),
                                                   couplingManager, timeLoop );
 
+#if FIXEDSTRESS
+    // the linear solver of the sub-problems
+    using LinearSolver = ILU0BiCGSTABBackend;
+    auto linearSolver = std::make_shared<LinearSolver>();
+
+    // the sequential fixed-stress solver (the sub-problems are solved with their own linear solver)
+    using FixedStressSolver = PoroMechanicsFixedStressSolver<Assembler, LinearSolver, LinearSolver, CouplingManager>;
+    FixedStressSolver nonLinearSolver(assembler, linearSolver, std::make_shared<LinearSolver>(), couplingManager, timeLoop);
+#else
     // the linear solver
     using LinearSolver = UMFPackBackend;
     auto linearSolver = std::make_shared<LinearSolver>();
@@ -193,6 +203,7 @@ int main(int argc, char** argv) try
     // the non-linear solver
     using NewtonSolver = Dumux::MultiDomainNewtonSolver<Assembler, LinearSolver, CouplingManager>;
     NewtonSolver nonLinearSolver(assembler, linearSolver, couplingManager);
+#endif
 
     // time loop
     timeLoop->start(); do
@@ -200,8 +211,13 @@ int main(int argc, char** argv) try
         // set previous solution for storage evaluations
         assembler->setPreviousSolution(xOld);
 
+#if FIXEDSTRESS
+        // solve the coupled system with a fixed time step size
+        nonLinearSolver.solve(x);
+#else
         // solve the non-linear system with time step control
         nonLinearSolver.solve(x, *timeLoop);
+#endif
 
         // make the new solution the old solution
         xOld = x;
@@ -231,8 +247,10 @@ int main(int argc, char** argv) try
     } while (!timeLoop->finished());
 
 
+#if !FIXEDSTRESS
     // output some Newton statistics
     nonLinearSolver.report();
+#endif
 
     timeLoop->finalize(leafGridView.comm());
 
@@ -48,6 +48,7 @@
 #include <dumux/assembly/fvassembler.hh>
 
 #include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/monitoroutputmodule.hh>
 #include <dumux/io/grid/gridmanager.hh>
 
 int main(int argc, char** argv) try
@@ -118,6 +119,24 @@ int main(int argc, char** argv) try
     IOFields::initOutputModule(vtkWriter); // Add model specific output fields
     vtkWriter.write(0.0);
 
+    // sample the pressure at the probes and along the line, the mass in place and the flux over the top boundary
+    MonitorOutputModule<GridVariables, SolutionVector> monitor(*gridVariables, x, problem->name());
+    monitor.addPrimaryVariable(0, "p");
+    monitor.addVolumeVariable([](const auto& volVars){ return volVars.density(); }, "rho");
+    monitor.addVolumeIntegral([](const auto& volVars){ return volVars.porosity()*volVars.density(); }, "mass");
+    monitor.addBoundaryIntegral([&](const auto& element, const auto& fvGeometry, const auto& elemVolVars,
+                                    const auto& elemFluxVarsCache, const auto& scvf)
+    {
+        if (scvf.ipGlobal()[1] < fvGridGeometry->bBoxMax()[1] - 1e-6)
+            return 0.0;
+
+        using FluxVariables = GetPropType<TypeTag, Properties::FluxVariables>;
+        FluxVariables fluxVars;
+        fluxVars.init(*problem, element, fvGeometry, elemVolVars, scvf, elemFluxVarsCache);
+        return fluxVars.advectiveFlux(0, [](const auto& volVars){ return volVars.density()*volVars.mobility(0); });
+    }, "top mass flux");
+    monitor.write(0.0);
+
     // instantiate time loop
     auto timeLoop = std::make_shared<CheckPointTimeLoop<Scalar>>(0.0, dt, tEnd);
     timeLoop->setMaxTimeStepSize(maxDt);
@@ -157,6 +176,9 @@ int main(int argc, char** argv) try
         if (timeLoop->isCheckPoint())
             vtkWriter.write(timeLoop->time());
 
+        // sample the solution in every time step
+        monitor.write(timeLoop->time());
+
         // report statistics of this time step
         timeLoop->reportTimeStep();
 
@@ -144,7 +144,7 @@ int main(int argc, char** argv) try
     vtkWriter.addVelocityOutput(std::make_shared<VelocityOutput>(*gridVariables));
     IOFields::initOutputModule(vtkWriter); // Add model specific output fields
 
-    // if we are using a random permeability field with gstat
+    // if we are using a random permeability field
     bool isRandomField = getParam<bool>("SpatialParams.RandomField", false);
     if(isRandomField) vtkWriter.addField(problem->spatialParams().getPermField(), "K");
 
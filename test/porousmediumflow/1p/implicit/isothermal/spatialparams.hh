@@ -28,7 +28,7 @@
 
 #include <dumux/porousmediumflow/properties.hh>
 #include <dumux/material/spatialparams/fv1p.hh>
-#include <dumux/material/spatialparams/gstatrandomfield.hh>
+#include <dumux/material/spatialparams/gaussianrandomfield.hh>
 
 namespace Dumux {
 
@@ -109,7 +109,7 @@ public:
     { return 0.4; }
 
     /*!
-     * \brief This method allows the generation of a statistical field using gstat
+     * \brief This method allows the generation of a statistical field
      *
      * \param gg The finite-volume grid geometry used by the problem
      */
@@ -117,21 +117,13 @@ public:
     {
         const auto& gridView = gg.gridView();
         const auto& elementMapper = gg.elementMapper();
-        const auto gStatControlFile = getParam<std::string>("Gstat.ControlFile");
-        const auto gStatInputFile = getParam<std::string>("Gstat.InputFile");
-        const auto outputFilePrefix = getParam<std::string>("Gstat.OutputFilePrefix");
 
         // create random permeability object
-        using RandomField = GstatRandomField<GridView, Scalar>;
+        using RandomField = GaussianRandomField<GridView, Scalar>;
         RandomField randomPermeabilityField(gridView, elementMapper);
-        randomPermeabilityField.create(gStatControlFile,
-                                       gStatInputFile,
-                                       outputFilePrefix + ".dat",
-                                       RandomField::FieldType::log10,
-                                       true);
-        randomPermeability_.resize(gridView.size(dim), 0.0);
-
-        // copy vector from the temporary gstat object
+        randomPermeabilityField.create(RandomField::FieldType::log10);
+
+        // copy vector from the temporary random field object
         randomPermeability_ = randomPermeabilityField.data();
     }
 
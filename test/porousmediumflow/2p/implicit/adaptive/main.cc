@@ -52,6 +52,7 @@
 #include <dumux/adaptive/adapt.hh>
 #include <dumux/adaptive/markelements.hh>
 #include <dumux/adaptive/initializationindicator.hh>
+#include <dumux/adaptive/loadbalance.hh>
 #include <dumux/porousmediumflow/2p/griddatatransfer.hh>
 #include <dumux/porousmediumflow/2p/gridadaptindicator.hh>
 
@@ -114,6 +115,7 @@ int main(int argc, char** argv) try
     // try to create a grid (from the given grid file or the input file)
     GridManager<GetPropType<TypeTag, Properties::Grid>> gridManager;
     gridManager.init();
+    gridManager.loadBalance();
 
     ////////////////////////////////////////////////////////////
     // run instationary non-linear problem on this grid
@@ -148,6 +150,8 @@ int main(int argc, char** argv) try
     const Scalar refineTol = getParam<Scalar>("Adaptive.RefineTolerance");
     const Scalar coarsenTol = getParam<Scalar>("Adaptive.CoarsenTolerance");
     TwoPGridAdaptIndicator<TypeTag> indicator(fvGridGeometry);
+    const Scalar loadBalanceTol = getParam<Scalar>("Adaptive.LoadBalanceTolerance", 1.1);
+    SolutionMigrationDataHandle<FVGridGeometry, SolutionVector> migrationHandle(fvGridGeometry, x);
     TwoPGridDataTransfer<TypeTag> dataTransfer(problem, fvGridGeometry, gridVariables, x);
 
     // Do initial refinement around sources/BCs
@@ -233,10 +237,14 @@ int main(int argc, char** argv) try
 
             if (wasAdapted)
             {
+                // redistribute the grid if the adaptation caused a load imbalance
+                loadBalance(gridManager.grid(), migrationHandle, loadBalanceTol);
+
                 // Note that if we were using point sources, we would have to update the map here as well
                 xOld = x; //!< Overwrite the old solution with the new (resized & interpolated) one
                 assembler->setJacobianPattern(); //!< Tell the assembler to resize the matrix and set pattern
                 assembler->setResidualSize(); //!< Tell the assembler to resize the residual
+                linearSolver->updateAfterGridAdaption(); //!< Tell the linear solver about the new ghosts and owners
                 gridVariables->updateAfterGridAdaption(x); //!< Initialize the secondary variables to the new (and "new old") solution
                 problem->computePointSourceMap(); //!< Update the point source map
             }
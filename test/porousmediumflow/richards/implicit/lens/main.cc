@@ -44,6 +44,10 @@
 
 #include <dumux/assembly/fvassembler.hh>
 
+#ifndef NUMDIFFMETHOD // default to numeric differentiation if not set by the build system
+#define NUMDIFFMETHOD DiffMethod::numeric
+#endif
+
 #include <dumux/io/vtkoutputmodule.hh>
 #include <dumux/io/grid/gridmanager.hh>
 #include <dumux/io/loadsolution.hh>
@@ -136,7 +140,7 @@ int main(int argc, char** argv) try
     timeLoop->setMaxTimeStepSize(maxDt);
 
     // the assembler with time loop for instationary problem
-    using Assembler = FVAssembler<TypeTag, DiffMethod::numeric>;
+    using Assembler = FVAssembler<TypeTag, NUMDIFFMETHOD>;
     auto assembler = std::make_shared<Assembler>(problem, fvGridGeometry, gridVariables, timeLoop);
 
     // the linear solver